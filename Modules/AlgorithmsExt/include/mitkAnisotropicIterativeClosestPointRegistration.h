@@ -21,13 +21,19 @@ found in the LICENSE file.
 #include "MitkAlgorithmsExtExports.h"
 
 // STL
+#include <array>
 #include <vector>
 
 // ITK
 #include <itkMatrix.h>
 
+// VTK
+#include <vtkSmartPointer.h>
+#include <vtkType.h>
+
 // forward declarations
 class vtkPoints;
+class vtkPolyData;
 class vtkKdTreePointLocator;
 
 namespace mitk
@@ -57,6 +63,12 @@ namespace mitk
     * Surface representation.
     *
     * \note The correspondence search is accelerated when OpenMP is enabled.
+    * The kd tree of the fixed surface is kept between registrations as long as
+    * the fixed surface is not modified, e.g. to register repeatedly acquired
+    * moving surfaces to the same preoperative surface. The anisotropic distance
+    * of the candidates is evaluated in blocks that are vectorized by the compiler.
+    * The duration of every iteration is available by GetIterationStatistics()
+    * and SetTimeLimit() bounds the runtime of the registration.
     *
     * \b Example:
     *
@@ -127,6 +139,28 @@ namespace mitk
     /** Definition of a list of correspondences.*/
     typedef std::vector<Correspondence> CorrespondenceList;
 
+  public:
+    /** Statistics of a single iteration of the algorithm.*/
+    struct IterationStatistics
+    {
+      /** The FRE after the iteration.*/
+      double FRE = 0.0;
+      /** Number of searches for correspondences, i.e. 1 + how often the search radius was doubled.*/
+      unsigned int NumberOfCorrespondenceSearches = 0;
+      /** Number of iterations of the weighted point based registration (of the last search).*/
+      int WeightedPointTransformIterations = 0;
+      /** Time spent in the correspondence search in seconds.*/
+      double CorrespondenceSeconds = 0.0;
+      /** Time spent in the weighted point based registration in seconds.*/
+      double WeightedPointTransformSeconds = 0.0;
+      /** Total time of the iteration in seconds.*/
+      double Seconds = 0.0;
+    };
+
+    typedef std::vector<IterationStatistics> IterationStatisticsList;
+
+  protected:
+
     AnisotropicIterativeClosestPointRegistration();
     ~AnisotropicIterativeClosestPointRegistration() override;
 
@@ -147,6 +181,14 @@ namespace mitk
       */
     double m_MaxIterationsInWeightedPointTransform;
 
+    /** Number of iterations without a new minimal configuration change after which the
+      * weighted point based registration stops. Default is 0 (disabled).
+      */
+    int m_MaxStagnatingIterationsInWeightedPointTransform;
+
+    /** Time limit of the registration in seconds. Default is 0.0 (no limit).*/
+    double m_TimeLimit;
+
     /** The fiducial registration error (FRE).*/
     double m_FRE;
 
@@ -156,6 +198,9 @@ namespace mitk
     /** Amount of iterations used by the algorithm.*/
     unsigned int m_NumberOfIterations;
 
+    /** Statistics of every iteration of the last registration.*/
+    IterationStatisticsList m_IterationStatistics;
+
     /** Moving surface that is transformed on the fixed surface.*/
     itk::SmartPointer<Surface> m_MovingSurface;
     /** The fixed / target surface.*/
@@ -170,6 +215,19 @@ namespace mitk
     /** The covariance matrices belonging to the moving surface (Y).*/
     CovarianceMatrixList m_CovarianceMatricesFixedSurface;
 
+    /** The kd tree of the fixed surface, kept between registrations.*/
+    vtkSmartPointer<vtkKdTreePointLocator> m_FixedSurfaceLocator;
+
+    /** Poly data of the fixed surface and its modification time when the kd tree was built.*/
+    vtkSmartPointer<vtkPolyData> m_LocatedPolyData;
+    vtkMTimeType m_LocatedPolyDataMTime;
+
+    /** Coordinates of the fixed points, one array per axis for vectorized distance computation.*/
+    std::array<std::vector<double>, 3> m_FixedPoints;
+
+    /** The six unique elements (xx, xy, xz, yy, yz, zz) of the fixed covariance matrices.*/
+    std::array<std::vector<double>, 6> m_FixedCovariances;
+
     /** The computed 3x1 translation vector.*/
     Translation m_Translation;
     /** The computed 3x3 rotation matrix.*/
@@ -186,6 +244,11 @@ namespace mitk
       * weighted based on the covariance matrices and the best weighting will be
       * used as a correspondence.
       *
+      * The squared weighted distance |W (x - y)|^2 with the weight matrix W from
+      * AnisotropicRegistrationCommon::CalculateWeightMatrix() equals the squared
+      * Mahalanobis distance (x - y)^T (sigma_X + sigma_Y)^-1 (x - y), which is
+      * computed in closed form for blocks of candidates.
+      *
       * @param X The moving point set.
       * @param Z The returned correspondences from the fixed point set.
       * @param Y The fixed point set saved in a kd tree.
@@ -206,6 +269,9 @@ namespace mitk
                                 CorrespondenceList &correspondences,
                                 const double radius);
 
+    /** Builds the kd tree of the fixed surface unless it is up to date.*/
+    void UpdateFixedSurfaceLocator();
+
   public:
     mitkClassMacroItkParent(AnisotropicIterativeClosestPointRegistration, itk::Object);
     itkFactorylessNewMacro(Self);
@@ -239,12 +305,27 @@ namespace mitk
         */
       itkSetMacro(MaxIterationsInWeightedPointTransform, double);
 
+      /** Stop the point based registration early if its configuration change did not
+        * reach a new minimum for the given number of iterations. Default is 0 (disabled).
+        * @see WeightedPointTransform::SetMaxStagnatingIterations()
+        */
+      itkSetMacro(MaxStagnatingIterationsInWeightedPointTransform, int);
+
+      /** Stop the registration after the first iteration that exceeds the given time
+        * in seconds. Default is 0.0 (no limit).
+        */
+      itkSetMacro(TimeLimit, double);
+      itkGetMacro(TimeLimit, double);
+
       /** Get the fiducial registration error (FRE).*/
       itkGetMacro(FRE, double);
 
       /** Get the number of iterations used by the algorithm.*/
       itkGetMacro(NumberOfIterations, unsigned int);
 
+      /** Get the statistics of every iteration of the last registration.*/
+      itkGetConstReferenceMacro(IterationStatistics, IterationStatisticsList);
+
       /**
         * Factor that trimms the point set in percent for
         * partial overlapping surfaces. E.g. 0.4 will use 40 precent
@@ -80,6 +80,12 @@ namespace mitk
         */
       itkSetMacro(MaxIterations, double);
 
+      /** @brief Stops the registration if the configuration change did not reach a new
+        * minimum for the given number of iterations, i.e. the iteration stagnates or
+        * oscillates above the threshold. Default value is 0 (disabled).
+        */
+      itkSetMacro(MaxStagnatingIterations, int);
+
       /** @return Returns the number of iterations of the last run
         * of the registration algorithm. Returns -1 if there was no
         * run of the registration yet.
@@ -138,6 +144,9 @@ namespace mitk
     /** Max allowed iterations used by the algorithm.*/
     int m_MaxIterations;
 
+    /** Max iterations without a new minimal configuration change.*/
+    int m_MaxStagnatingIterations;
+
     /** The amount of iterations needed by the algorithm.*/
     int m_Iterations;
 
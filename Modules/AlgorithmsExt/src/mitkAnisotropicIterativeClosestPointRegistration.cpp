@@ -22,7 +22,10 @@ found in the LICENSE file.
 #include <vtkKdTreePointLocator.h>
 #include <vtkPoints.h>
 #include <vtkPolyData.h>
-// STL pair
+#include <vtkSmartPointer.h>
+// STL
+#include <algorithm>
+#include <chrono>
 #include <utility>
 
 /** \brief Comperator implementation used to sort the CorrespondenceList in the
@@ -35,18 +38,32 @@ struct AICPComperator
   bool operator()(const Correspondence &a, const Correspondence &b) { return (a.second < b.second); }
 } AICPComp;
 
+namespace
+{
+  /** Number of candidates whose distances are computed at once.*/
+  const vtkIdType CandidateBlockSize = 8;
+
+  double SecondsSince(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
 mitk::AnisotropicIterativeClosestPointRegistration::AnisotropicIterativeClosestPointRegistration()
   : m_MaxIterations(1000),
     m_Threshold(0.000001),
     m_FRENormalizationFactor(1.0),
     m_SearchRadius(30.0),
     m_MaxIterationsInWeightedPointTransform(1000),
+    m_MaxStagnatingIterationsInWeightedPointTransform(0),
+    m_TimeLimit(0.0),
     m_FRE(0.0),
     m_TrimmFactor(0.0),
     m_NumberOfIterations(0),
     m_MovingSurface(nullptr),
     m_FixedSurface(nullptr),
-    m_WeightedPointTransform(mitk::WeightedPointTransform::New())
+    m_WeightedPointTransform(mitk::WeightedPointTransform::New()),
+    m_LocatedPolyDataMTime(0)
 {
 }
 
@@ -54,6 +71,38 @@ mitk::AnisotropicIterativeClosestPointRegistration::~AnisotropicIterativeClosest
 {
 }
 
+void mitk::AnisotropicIterativeClosestPointRegistration::UpdateFixedSurfaceLocator()
+{
+  vtkPolyData *polyData = m_FixedSurface->GetVtkPolyData();
+
+  if (m_FixedSurfaceLocator != nullptr && m_LocatedPolyData == polyData && m_LocatedPolyDataMTime == polyData->GetMTime())
+    return;
+
+  MITK_DEBUG << "Building kd tree of the fixed surface";
+
+  m_FixedSurfaceLocator = vtkSmartPointer<vtkKdTreePointLocator>::New();
+  m_FixedSurfaceLocator->SetDataSet(polyData);
+  m_FixedSurfaceLocator->BuildLocator();
+
+  m_LocatedPolyData = polyData;
+  m_LocatedPolyDataMTime = polyData->GetMTime();
+
+  // copy the fixed points to contiguous arrays
+  const vtkIdType numberOfPoints = polyData->GetNumberOfPoints();
+  double p[3];
+
+  for (auto &coordinates : m_FixedPoints)
+    coordinates.resize(numberOfPoints);
+
+  for (vtkIdType i = 0; i < numberOfPoints; ++i)
+  {
+    polyData->GetPoint(i, p);
+    m_FixedPoints[0][i] = p[0];
+    m_FixedPoints[1][i] = p[1];
+    m_FixedPoints[2][i] = p[2];
+  }
+}
+
 void mitk::AnisotropicIterativeClosestPointRegistration::ComputeCorrespondences(vtkPoints *X,
                                                                                 vtkPoints *Z,
                                                                                 vtkKdTreePointLocator *Y,
@@ -63,68 +112,116 @@ void mitk::AnisotropicIterativeClosestPointRegistration::ComputeCorrespondences(
                                                                                 CorrespondenceList &correspondences,
                                                                                 const double radius)
 {
-  typedef itk::Matrix<double, 3, 3> WeightMatrix;
-
-#pragma omp parallel for
-  for (int i = 0; i < X->GetNumberOfPoints(); ++i)
+  const double *fixedX = m_FixedPoints[0].data();
+  const double *fixedY = m_FixedPoints[1].data();
+  const double *fixedZ = m_FixedPoints[2].data();
+  const double *fixedXX = m_FixedCovariances[0].data();
+  const double *fixedXY = m_FixedCovariances[1].data();
+  const double *fixedXZ = m_FixedCovariances[2].data();
+  const double *fixedYY = m_FixedCovariances[3].data();
+  const double *fixedYZ = m_FixedCovariances[4].data();
+  const double *fixedZZ = m_FixedCovariances[5].data();
+
+#pragma omp parallel
   {
-    vtkIdType bestIdx = 0;
-    mitk::Vector3D x;
-    mitk::Vector3D y;
-    double bestDist = std::numeric_limits<double>::max();
-    vtkIdList *ids = vtkIdList::New();
-    double r = radius;
-    double p[3];
-    // get point
-    X->GetPoint(i, p);
-    // fill vector
-    x[0] = p[0];
-    x[1] = p[1];
-    x[2] = p[2];
-
-    // double the radius till we find at least one point
-    while (ids->GetNumberOfIds() <= 0)
-    {
-      Y->FindPointsWithinRadius(r, p, ids);
-      r *= 2.0;
-    }
+    auto ids = vtkSmartPointer<vtkIdList>::New();
 
-    // loop over the points in the sphere and find the point with the
-    // minimal weighted squared distance
-    for (vtkIdType j = 0; j < ids->GetNumberOfIds(); ++j)
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < X->GetNumberOfPoints(); ++i)
     {
-      // get id
-      const vtkIdType id = ids->GetId(j);
-      // compute weightmatrix
-      WeightMatrix m = mitk::AnisotropicRegistrationCommon::CalculateWeightMatrix(sigma_X[i], sigma_Y[id]);
-      // point of the fixed data set
-      Y->GetDataSet()->GetPoint(id, p);
+      vtkIdType bestIdx = 0;
+      double bestDist = std::numeric_limits<double>::max();
+      double r = radius;
+      double p[3];
+      // get point
+      X->GetPoint(i, p);
 
-      // fill mitk vector
-      y[0] = p[0];
-      y[1] = p[1];
-      y[2] = p[2];
+      // double the radius till we find at least one point
+      ids->Reset();
 
-      const mitk::Vector3D res = m * (x - y);
-
-      const double dist = res[0] * res[0] + res[1] * res[1] + res[2] * res[2];
-
-      if (dist < bestDist)
+      while (ids->GetNumberOfIds() <= 0)
       {
-        bestDist = dist;
-        bestIdx = id;
+        Y->FindPointsWithinRadius(r, p, ids);
+        r *= 2.0;
       }
-    }
 
-    // save correspondences of the fixed point set
-    Y->GetDataSet()->GetPoint(bestIdx, p);
-    Z->SetPoint(i, p);
-    sigma_Z[i] = sigma_Y[bestIdx];
+      // unique elements of the moving covariance matrix
+      const CovarianceMatrix &s = sigma_X[i];
+      const double sXX = s[0][0];
+      const double sXY = 0.5 * (s[0][1] + s[1][0]);
+      const double sXZ = 0.5 * (s[0][2] + s[2][0]);
+      const double sYY = s[1][1];
+      const double sYZ = 0.5 * (s[1][2] + s[2][1]);
+      const double sZZ = s[2][2];
+
+      const vtkIdType numberOfIds = ids->GetNumberOfIds();
+      const vtkIdType *candidates = ids->GetPointer(0);
+
+      // loop over the points in the sphere in blocks and find the point with the
+      // minimal weighted squared distance
+      for (vtkIdType start = 0; start < numberOfIds; start += CandidateBlockSize)
+      {
+        const vtkIdType count = std::min(CandidateBlockSize, numberOfIds - start);
+        const vtkIdType *block = candidates + start;
+
+        // gather the candidates, unused lanes are filled with the first candidate
+        double dx[CandidateBlockSize], dy[CandidateBlockSize], dz[CandidateBlockSize];
+        double a[CandidateBlockSize], b[CandidateBlockSize], c[CandidateBlockSize];
+        double d[CandidateBlockSize], e[CandidateBlockSize], f[CandidateBlockSize];
+        double dist[CandidateBlockSize];
+
+        for (vtkIdType j = 0; j < CandidateBlockSize; ++j)
+        {
+          const vtkIdType id = block[j < count ? j : 0];
+          dx[j] = p[0] - fixedX[id];
+          dy[j] = p[1] - fixedY[id];
+          dz[j] = p[2] - fixedZ[id];
+          a[j] = sXX + fixedXX[id];
+          b[j] = sXY + fixedXY[id];
+          c[j] = sXZ + fixedXZ[id];
+          d[j] = sYY + fixedYY[id];
+          e[j] = sYZ + fixedYZ[id];
+          f[j] = sZZ + fixedZZ[id];
+        }
+
+        // (x - y)^T (sigma_X + sigma_Y)^-1 (x - y) by the adjugate of the symmetric sum
+#pragma omp simd
+        for (vtkIdType j = 0; j < CandidateBlockSize; ++j)
+        {
+          const double adjXX = d[j] * f[j] - e[j] * e[j];
+          const double adjXY = c[j] * e[j] - b[j] * f[j];
+          const double adjXZ = b[j] * e[j] - c[j] * d[j];
+          const double adjYY = a[j] * f[j] - c[j] * c[j];
+          const double adjYZ = b[j] * c[j] - a[j] * e[j];
+          const double adjZZ = a[j] * d[j] - b[j] * b[j];
+          const double det = a[j] * adjXX + b[j] * adjXY + c[j] * adjXZ;
+
+          const double q = adjXX * dx[j] * dx[j] + adjYY * dy[j] * dy[j] + adjZZ * dz[j] * dz[j] +
+                           2.0 * (adjXY * dx[j] * dy[j] + adjXZ * dx[j] * dz[j] + adjYZ * dy[j] * dz[j]);
+
+          dist[j] = q / det;
+        }
+
+        for (vtkIdType j = 0; j < count; ++j)
+        {
+          if (dist[j] < bestDist)
+          {
+            bestDist = dist[j];
+            bestIdx = block[j];
+          }
+        }
+      }
 
-    Correspondence _pair(i, bestDist);
-    correspondences[i] = _pair;
+      // save correspondences of the fixed point set
+      p[0] = fixedX[bestIdx];
+      p[1] = fixedY[bestIdx];
+      p[2] = fixedZ[bestIdx];
+      Z->SetPoint(i, p);
+      sigma_Z[i] = sigma_Y[bestIdx];
 
-    ids->Delete();
+      Correspondence _pair(i, bestDist);
+      correspondences[i] = _pair;
+    }
   }
 }
 
@@ -155,10 +252,26 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
   CovarianceMatrixList Sigma_X_sorted;
   CovarianceMatrixList Sigma_Z_sorted;
 
-  // create kdtree for correspondence search
-  vtkKdTreePointLocator *Y = vtkKdTreePointLocator::New();
-  Y->SetDataSet(m_FixedSurface->GetVtkPolyData());
-  Y->BuildLocator();
+  // create kdtree for correspondence search or reuse it from a previous run
+  UpdateFixedSurfaceLocator();
+  vtkKdTreePointLocator *Y = m_FixedSurfaceLocator;
+
+  // unique elements of the symmetric fixed covariance matrices
+  for (auto &elements : m_FixedCovariances)
+    elements.resize(Sigma_Y.size());
+
+  for (std::size_t i = 0; i < Sigma_Y.size(); ++i)
+  {
+    const CovarianceMatrix &s = Sigma_Y[i];
+    m_FixedCovariances[0][i] = s[0][0];
+    m_FixedCovariances[1][i] = 0.5 * (s[0][1] + s[1][0]);
+    m_FixedCovariances[2][i] = 0.5 * (s[0][2] + s[2][0]);
+    m_FixedCovariances[3][i] = s[1][1];
+    m_FixedCovariances[4][i] = 0.5 * (s[1][2] + s[2][1]);
+    m_FixedCovariances[5][i] = s[2][2];
+  }
+
+  const auto registrationStart = std::chrono::steady_clock::now();
 
   // initialize local variables
   // copy the moving pointset to prevent to modify it
@@ -175,6 +288,7 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
   m_FRE = std::numeric_limits<double>::max();
   m_Rotation.SetIdentity();
   m_Translation.Fill(0.0);
+  m_IterationStatistics.clear();
 
   // compute number of correspondences based
   // on the trimmfactor
@@ -205,10 +319,16 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
 
     MITK_DEBUG << "iteration: " << k;
 
+    IterationStatistics statistics;
+    const auto iterationStart = std::chrono::steady_clock::now();
+
     do
     {
       // search correspondences
+      auto start = std::chrono::steady_clock::now();
       ComputeCorrespondences(X, Z, Y, Sigma_X, Sigma_Y, Sigma_Z, distanceList, currSearchRadius);
+      statistics.CorrespondenceSeconds += SecondsSince(start);
+      ++statistics.NumberOfCorrespondenceSearches;
 
       // tmp pointers
       vtkPoints *X_k = X;
@@ -244,10 +364,14 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
       m_WeightedPointTransform->SetCovarianceMatricesMoving(*Sigma_X_k);
       m_WeightedPointTransform->SetCovarianceMatricesFixed(*Sigma_Z_k);
       m_WeightedPointTransform->SetMaxIterations(m_MaxIterationsInWeightedPointTransform);
+      m_WeightedPointTransform->SetMaxStagnatingIterations(m_MaxStagnatingIterationsInWeightedPointTransform);
       m_WeightedPointTransform->SetFRENormalizationFactor(m_FRENormalizationFactor);
 
       // run computation
+      start = std::chrono::steady_clock::now();
       m_WeightedPointTransform->ComputeTransformation();
+      statistics.WeightedPointTransformSeconds += SecondsSince(start);
+      statistics.WeightedPointTransformIterations = m_WeightedPointTransform->GetIterations();
       // retrieve result
       RotationNew = m_WeightedPointTransform->GetTransformR();
       TranslationNew = m_WeightedPointTransform->GetTransformT();
@@ -288,6 +412,21 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
     stepSize = (stepSize == 0) ? 1 : stepSize;
     mitk::ProgressBar::GetInstance()->Progress(stepSize);
 
+    statistics.FRE = m_FRE;
+    statistics.Seconds = SecondsSince(iterationStart);
+    m_IterationStatistics.push_back(statistics);
+
+    MITK_DEBUG << "correspondences: " << statistics.CorrespondenceSeconds
+               << " s, weighted registration: " << statistics.WeightedPointTransformSeconds << " s ("
+               << statistics.WeightedPointTransformIterations << " iterations)";
+
+    if (m_TimeLimit > 0.0 && SecondsSince(registrationStart) > m_TimeLimit && diff > m_Threshold && k < m_MaxIterations)
+    {
+      MITK_WARN << "A-ICP stopped after " << k << " iterations since the time limit of " << m_TimeLimit
+                << " s was exceeded";
+      break;
+    }
+
   } while (diff > m_Threshold && k < m_MaxIterations);
 
   m_NumberOfIterations = k;
@@ -298,7 +437,6 @@ void mitk::AnisotropicIterativeClosestPointRegistration::Update()
     mitk::ProgressBar::GetInstance()->Progress(steps);
 
   // free memory
-  Y->Delete();
   Z->Delete();
   X->Delete();
   X_sorted->Delete();
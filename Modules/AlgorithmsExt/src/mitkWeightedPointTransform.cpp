@@ -47,6 +47,7 @@ static void IsotropicRegistration(vtkPoints *X,
 mitk::WeightedPointTransform::WeightedPointTransform()
   : m_Threshold(1.0e-4),
     m_MaxIterations(1000),
+    m_MaxStagnatingIterations(0),
     m_Iterations(-1),
     m_FRE(-1.0),
     m_FRENormalizationFactor(1.0),
@@ -234,6 +235,8 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
   double initialFRE = 0.0;
   // set config_change to infinite (max double) at start
   double config_change = std::numeric_limits<double>::max();
+  double min_config_change = std::numeric_limits<double>::max();
+  int stagnating_iterations = 0;
   Rotation initial_TransformationR;
   initial_TransformationR.SetIdentity();
   Translation initial_TransformationT;
@@ -307,12 +310,17 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
     //          current method: treat the problem as a minimization problem, because this is what the
     //          "backslash"-operator also does with "high" matrices.
     //                          (and we will have those matrices in most cases)
+    //
+    //          The least squares solution is computed by the 6 x 6 normal equations instead of the
+    //          pseudo inverse of the 3N x 6 matrix, which is much faster for large point sets.
 
     C_maker(X_transformed, W, iA);
     E_maker(X_transformed, Y, W, iB);
 
-    vnl_matrix_inverse<double> myInverse(iA.GetVnlMatrix());
-    vnl_vector<double> q = myInverse.pinverse(iB.size()) * iB;
+    const vnl_matrix<double> &A = iA.GetVnlMatrix();
+    const vnl_matrix<double> A_T = A.transpose();
+    vnl_svd<double> normalEquations(A_T * A);
+    vnl_vector<double> q = normalEquations.solve(A_T * iB);
     //'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''
 
     if (n > 1)
@@ -363,13 +371,28 @@ void mitk::WeightedPointTransform::WeightedPointRegister(vtkPoints *X,
     // calculate config change
     config_change = CalculateConfigChange(X_transformed, X_transformedNew);
 
+    // count the iterations since the last minimal config change
+    if (config_change < min_config_change)
+    {
+      min_config_change = config_change;
+      stagnating_iterations = 0;
+    }
+    else
+    {
+      ++stagnating_iterations;
+    }
+
     // swap the pointers the old set for the next iteration is
     // the new set of the last iteration
     vtkPoints *tmp = X_transformed;
     X_transformed = X_transformedNew;
     X_transformedNew = tmp;
 
-  } while (config_change > Threshold && n < MaxIterations);
+  } while (config_change > Threshold && n < MaxIterations &&
+           (m_MaxStagnatingIterations <= 0 || stagnating_iterations < m_MaxStagnatingIterations));
+
+  if (config_change > Threshold && n < MaxIterations)
+    MITK_DEBUG << "Stopped weighted point registration after " << n << " iterations without improvement";
 
   // calculate FRE with current transform
   FRE = ComputeWeightedFRE(X, Y, Sigma_X, Sigma_Y, m_FRENormalizationFactor, W, TransformationR, TransformationT);
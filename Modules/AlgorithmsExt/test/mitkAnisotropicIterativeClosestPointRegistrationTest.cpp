@@ -31,6 +31,8 @@ class mitkAnisotropicIterativeClosestPointRegistrationTestSuite : public mitk::T
   CPPUNIT_TEST_SUITE(mitkAnisotropicIterativeClosestPointRegistrationTestSuite);
   MITK_TEST(testAicpRegistration);
   MITK_TEST(testTrimmedAicpregistration);
+  MITK_TEST(testRepeatedAicpRegistration);
+  MITK_TEST(testAicpRegistrationTimeLimit);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -163,6 +165,79 @@ public:
     CPPUNIT_ASSERT_MESSAGE("mitkAnisotropicIterativeClosestPointRegistrationTest:AicpRegistration Test TRE",
                            mitk::Equal(tre, expTRE, 0.01));
   }
+
+  void testRepeatedAicpRegistration()
+  {
+    mitk::AnisotropicIterativeClosestPointRegistration::Pointer aICP =
+      mitk::AnisotropicIterativeClosestPointRegistration::New();
+
+    aICP->SetMovingSurface(m_MovingSurface);
+    aICP->SetFixedSurface(m_FixedSurface);
+    aICP->SetCovarianceMatricesMovingSurface(m_SigmasMovingSurface);
+    aICP->SetCovarianceMatricesFixedSurface(m_SigmasFixedSurface);
+    aICP->SetFRENormalizationFactor(m_FRENormalizationFactor);
+    aICP->SetThreshold(0.000001);
+
+    aICP->Update();
+    const double fre = aICP->GetFRE();
+    const auto iterations = aICP->GetNumberOfIterations();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::size_t>(iterations), aICP->GetIterationStatistics().size());
+    CPPUNIT_ASSERT(mitk::Equal(aICP->GetIterationStatistics().back().FRE, fre, 0.0000001));
+
+    double seconds = 0.0;
+    for (const auto &statistics : aICP->GetIterationStatistics())
+    {
+      CPPUNIT_ASSERT(statistics.NumberOfCorrespondenceSearches >= 1);
+      CPPUNIT_ASSERT(statistics.CorrespondenceSeconds + statistics.WeightedPointTransformSeconds <= statistics.Seconds);
+      seconds += statistics.Seconds;
+    }
+
+    MITK_INFO << "A-ICP: " << iterations << " iterations in " << seconds << " s";
+
+    // the kd tree of the fixed surface is reused and must give the same result
+    aICP->Update();
+
+    CPPUNIT_ASSERT_EQUAL(iterations, aICP->GetNumberOfIterations());
+    CPPUNIT_ASSERT(mitk::Equal(aICP->GetFRE(), fre, 0.0000001));
+
+    // a modified fixed surface results in a new kd tree
+    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
+    transform->Translate(1.0, 0.0, 0.0);
+    vtkSmartPointer<vtkTransformPolyDataFilter> transformFilter = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
+    transformFilter->SetInputData(m_FixedSurface->GetVtkPolyData());
+    transformFilter->SetTransform(transform);
+    transformFilter->Update();
+    m_FixedSurface->GetVtkPolyData()->DeepCopy(transformFilter->GetOutput());
+
+    const Vector3 translation = aICP->GetTranslation();
+    aICP->Update();
+
+    CPPUNIT_ASSERT_MESSAGE("Translation of the fixed surface is not part of the result",
+                           mitk::Equal(aICP->GetTranslation()[0], translation[0] + 1.0, 0.001));
+    CPPUNIT_ASSERT(mitk::Equal(aICP->GetFRE(), fre, 0.0001));
+  }
+
+  void testAicpRegistrationTimeLimit()
+  {
+    mitk::AnisotropicIterativeClosestPointRegistration::Pointer aICP =
+      mitk::AnisotropicIterativeClosestPointRegistration::New();
+
+    aICP->SetMovingSurface(m_MovingSurface);
+    aICP->SetFixedSurface(m_FixedSurface);
+    aICP->SetCovarianceMatricesMovingSurface(m_SigmasMovingSurface);
+    aICP->SetCovarianceMatricesFixedSurface(m_SigmasFixedSurface);
+    aICP->SetFRENormalizationFactor(m_FRENormalizationFactor);
+    aICP->SetThreshold(0.000001);
+    aICP->SetMaxStagnatingIterationsInWeightedPointTransform(10);
+    aICP->SetTimeLimit(1.0e-9);
+
+    aICP->Update();
+
+    // the first iteration already exceeds the time limit
+    CPPUNIT_ASSERT_EQUAL(1u, aICP->GetNumberOfIterations());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), aICP->GetIterationStatistics().size());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkAnisotropicIterativeClosestPointRegistration)
@@ -0,0 +1,145 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkArithmeticExpression_h
+#define mitkArithmeticExpression_h
+
+#include <mitkImage.h>
+#include <MitkBasicImageProcessingExports.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Lazily evaluated chain of element-wise arithmetic operations on images
+  *
+  * In contrast to ArithmeticOperation, building an expression does not compute anything. All operations are
+  * recorded and executed by Evaluate() in a single multi-threaded pass over the input images, without any
+  * intermediate images. Intermediate values are calculated in double precision and only the final value is
+  * converted to the requested output pixel type.
+  *
+  * \code
+  * auto result = (mitk::ArithmeticExpression(imageA) * 2.0 - mitk::ArithmeticExpression(imageB)).Exp().Evaluate(
+  *   mitk::MakeScalarPixelType<float>());
+  * \endcode
+  *
+  * All input images must be scalar images with identical dimensions. The geometry of the result is taken from
+  * the first input image of the expression. Division by zero follows IEEE 754 semantics. Results outside of the
+  * range of an integer output pixel type are saturated to its limits and NaN is stored as 0.
+  */
+  class MITKBASICIMAGEPROCESSING_EXPORT ArithmeticExpression
+  {
+  public:
+    /** \brief Expression that yields the pixel values of an image.*/
+    explicit ArithmeticExpression(const Image *image);
+
+    /** \brief Expression that yields a constant value.*/
+    ArithmeticExpression(double value);
+
+    ArithmeticExpression Pow(double exponent) const;
+    ArithmeticExpression Tan() const;
+    ArithmeticExpression Atan() const;
+    ArithmeticExpression Cos() const;
+    ArithmeticExpression Acos() const;
+    ArithmeticExpression Sin() const;
+    ArithmeticExpression Asin() const;
+    ArithmeticExpression Square() const;
+    ArithmeticExpression Sqrt() const;
+    ArithmeticExpression Abs() const;
+    ArithmeticExpression Exp() const;
+    ArithmeticExpression ExpNeg() const;
+    ArithmeticExpression Log10() const;
+
+    /** \brief Calculate the expression for all pixels.
+    * \param outputPixelType Scalar pixel type of the result.
+    * \throw mitk::Exception if the expression has no input image or the input images do not match.
+    */
+    Image::Pointer Evaluate(const PixelType &outputPixelType) const;
+
+    /** \brief Calculate the expression for all pixels.
+    * \param outputAsDouble Generate a double image. Otherwise, the pixel type of the first input image is used.
+    */
+    Image::Pointer Evaluate(bool outputAsDouble = true) const;
+
+    friend ArithmeticExpression operator+(const ArithmeticExpression &a, const ArithmeticExpression &b)
+    {
+      return ApplyBinary(Operation::Add, a, b);
+    }
+
+    friend ArithmeticExpression operator-(const ArithmeticExpression &a, const ArithmeticExpression &b)
+    {
+      return ApplyBinary(Operation::Subtract, a, b);
+    }
+
+    friend ArithmeticExpression operator*(const ArithmeticExpression &a, const ArithmeticExpression &b)
+    {
+      return ApplyBinary(Operation::Multiply, a, b);
+    }
+
+    friend ArithmeticExpression operator/(const ArithmeticExpression &a, const ArithmeticExpression &b)
+    {
+      return ApplyBinary(Operation::Divide, a, b);
+    }
+
+  private:
+    enum class Operation
+    {
+      Input,
+      Constant,
+      Add,
+      Subtract,
+      Multiply,
+      Divide,
+      Pow,
+      Tan,
+      Atan,
+      Cos,
+      Acos,
+      Sin,
+      Asin,
+      Square,
+      Sqrt,
+      Abs,
+      Exp,
+      ExpNeg,
+      Log10
+    };
+
+    /** Operations are stored in postfix order and executed on a stack of pixel blocks.*/
+    struct Instruction
+    {
+      Operation Op;
+      double Value;
+      std::size_t Input;
+    };
+
+    /** Converts count pixels beginning at offset to double.*/
+    using LoadFunction = void (*)(const void *data, std::size_t offset, std::size_t count, double *block);
+
+    ArithmeticExpression ApplyUnary(Operation operation, double value = 0.0) const;
+    static ArithmeticExpression ApplyBinary(Operation operation, const ArithmeticExpression &a, const ArithmeticExpression &b);
+
+    std::size_t GetStackDepth() const;
+
+    /** Returns the block of results, which is the bottom of the stack.*/
+    const double *EvaluateBlock(const std::vector<LoadFunction> &loaders,
+                                const std::vector<const void *> &inputData,
+                                std::size_t offset,
+                                std::size_t count,
+                                double *stack) const;
+
+    std::vector<Instruction> m_Program;
+    std::vector<Image::ConstPointer> m_Inputs;
+  };
+}
+
+#endif
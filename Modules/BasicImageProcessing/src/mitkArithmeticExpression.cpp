@@ -0,0 +1,475 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkArithmeticExpression.h"
+
+#include <mitkExceptionMacro.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkImageIOBase.h>
+#include <itkMultiThreaderBase.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace
+{
+  // Pixels are processed in blocks that fit into the L1 cache. Each operation runs over a whole block,
+  // which allows the compiler to vectorize the loops.
+  constexpr std::size_t BlockSize = 256;
+  constexpr std::size_t BlocksPerTask = 64;
+
+  template <typename T>
+  struct TypeTag
+  {
+    using Type = T;
+  };
+
+  template <typename TFunction>
+  void CallWithComponentType(itk::IOComponentEnum componentType, TFunction &&function)
+  {
+    switch (componentType)
+    {
+      case itk::IOComponentEnum::UCHAR:
+        function(TypeTag<unsigned char>());
+        break;
+      case itk::IOComponentEnum::CHAR:
+        function(TypeTag<char>());
+        break;
+      case itk::IOComponentEnum::USHORT:
+        function(TypeTag<unsigned short>());
+        break;
+      case itk::IOComponentEnum::SHORT:
+        function(TypeTag<short>());
+        break;
+      case itk::IOComponentEnum::UINT:
+        function(TypeTag<unsigned int>());
+        break;
+      case itk::IOComponentEnum::INT:
+        function(TypeTag<int>());
+        break;
+      case itk::IOComponentEnum::ULONG:
+        function(TypeTag<unsigned long>());
+        break;
+      case itk::IOComponentEnum::LONG:
+        function(TypeTag<long>());
+        break;
+      case itk::IOComponentEnum::ULONGLONG:
+        function(TypeTag<unsigned long long>());
+        break;
+      case itk::IOComponentEnum::LONGLONG:
+        function(TypeTag<long long>());
+        break;
+      case itk::IOComponentEnum::FLOAT:
+        function(TypeTag<float>());
+        break;
+      case itk::IOComponentEnum::DOUBLE:
+        function(TypeTag<double>());
+        break;
+      default:
+        mitkThrow() << "Pixel component type " << itk::ImageIOBase::GetComponentTypeAsString(componentType)
+                    << " is not supported by mitk::ArithmeticExpression";
+    }
+  }
+
+  template <typename TPixel>
+  void LoadBlock(const void *data, std::size_t offset, std::size_t count, double *block)
+  {
+    const auto *input = static_cast<const TPixel *>(data) + offset;
+
+    for (std::size_t i = 0; i < count; ++i)
+      block[i] = static_cast<double>(input[i]);
+  }
+
+  /** Converts a value to the pixel type. Integer pixels saturate at the limits of their type and NaN becomes 0.
+   * Float pixels become infinite beyond their range, like an IEEE 754 conversion.
+   */
+  template <typename TPixel>
+  TPixel ConvertValue(double value)
+  {
+    if constexpr (std::is_same<TPixel, double>::value)
+    {
+      return value;
+    }
+    else if constexpr (std::is_floating_point<TPixel>::value)
+    {
+      constexpr double max = std::numeric_limits<TPixel>::max();
+
+      if (value > max)
+        return std::numeric_limits<TPixel>::infinity();
+      if (value < -max)
+        return -std::numeric_limits<TPixel>::infinity();
+
+      return static_cast<TPixel>(value);
+    }
+    else
+    {
+      // max() of 64 bit types is not representable as double and rounds up, hence >= instead of >
+      constexpr double lowest = static_cast<double>(std::numeric_limits<TPixel>::lowest());
+      constexpr double max = static_cast<double>(std::numeric_limits<TPixel>::max());
+
+      if (std::isnan(value))
+        return 0;
+      if (value <= lowest)
+        return std::numeric_limits<TPixel>::lowest();
+      if (value >= max)
+        return std::numeric_limits<TPixel>::max();
+
+      return static_cast<TPixel>(value);
+    }
+  }
+
+  template <typename TPixel>
+  void StoreBlock(const double *block, std::size_t offset, std::size_t count, void *data)
+  {
+    auto *output = static_cast<TPixel *>(data) + offset;
+
+    for (std::size_t i = 0; i < count; ++i)
+      output[i] = ConvertValue<TPixel>(block[i]);
+  }
+
+  using StoreFunction = void (*)(const double *block, std::size_t offset, std::size_t count, void *data);
+
+  void CheckScalarPixelType(const mitk::PixelType &pixelType)
+  {
+    if (1 != pixelType.GetNumberOfComponents())
+      mitkThrow() << "mitk::ArithmeticExpression only supports scalar images, but pixel type "
+                  << pixelType.GetPixelTypeAsString() << " has " << pixelType.GetNumberOfComponents() << " components";
+  }
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(const Image *image)
+{
+  if (nullptr == image)
+    mitkThrow() << "Input image of mitk::ArithmeticExpression must not be nullptr";
+
+  m_Inputs.emplace_back(image);
+  m_Program.push_back({ Operation::Input, 0.0, 0 });
+}
+
+mitk::ArithmeticExpression::ArithmeticExpression(double value)
+{
+  m_Program.push_back({ Operation::Constant, value, 0 });
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Pow(double exponent) const
+{
+  return this->ApplyUnary(Operation::Pow, exponent);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Tan() const
+{
+  return this->ApplyUnary(Operation::Tan);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Atan() const
+{
+  return this->ApplyUnary(Operation::Atan);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Cos() const
+{
+  return this->ApplyUnary(Operation::Cos);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Acos() const
+{
+  return this->ApplyUnary(Operation::Acos);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sin() const
+{
+  return this->ApplyUnary(Operation::Sin);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Asin() const
+{
+  return this->ApplyUnary(Operation::Asin);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Square() const
+{
+  return this->ApplyUnary(Operation::Square);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Sqrt() const
+{
+  return this->ApplyUnary(Operation::Sqrt);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Abs() const
+{
+  return this->ApplyUnary(Operation::Abs);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Exp() const
+{
+  return this->ApplyUnary(Operation::Exp);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ExpNeg() const
+{
+  return this->ApplyUnary(Operation::ExpNeg);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::Log10() const
+{
+  return this->ApplyUnary(Operation::Log10);
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ApplyUnary(Operation operation, double value) const
+{
+  ArithmeticExpression result(*this);
+  result.m_Program.push_back({ operation, value, 0 });
+  return result;
+}
+
+mitk::ArithmeticExpression mitk::ArithmeticExpression::ApplyBinary(Operation operation,
+                                                                   const ArithmeticExpression &a,
+                                                                   const ArithmeticExpression &b)
+{
+  ArithmeticExpression result(a);
+
+  // Images used in both operands are read only once
+  std::vector<std::size_t> inputIndices;
+
+  for (const auto &input : b.m_Inputs)
+  {
+    auto iter = std::find(result.m_Inputs.begin(), result.m_Inputs.end(), input);
+    inputIndices.push_back(static_cast<std::size_t>(iter - result.m_Inputs.begin()));
+
+    if (iter == result.m_Inputs.end())
+      result.m_Inputs.push_back(input);
+  }
+
+  for (auto instruction : b.m_Program)
+  {
+    if (instruction.Op == Operation::Input)
+      instruction.Input = inputIndices[instruction.Input];
+
+    result.m_Program.push_back(instruction);
+  }
+
+  result.m_Program.push_back({ operation, 0.0, 0 });
+  return result;
+}
+
+std::size_t mitk::ArithmeticExpression::GetStackDepth() const
+{
+  std::size_t depth = 0;
+  std::size_t maximumDepth = 0;
+
+  for (const auto &instruction : m_Program)
+  {
+    switch (instruction.Op)
+    {
+      case Operation::Input:
+      case Operation::Constant:
+        maximumDepth = std::max(maximumDepth, ++depth);
+        break;
+      case Operation::Add:
+      case Operation::Subtract:
+      case Operation::Multiply:
+      case Operation::Divide:
+        --depth;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return maximumDepth;
+}
+
+const double *mitk::ArithmeticExpression::EvaluateBlock(const std::vector<LoadFunction> &loaders,
+                                                       const std::vector<const void *> &inputData,
+                                                       std::size_t offset,
+                                                       std::size_t count,
+                                                       double *stack) const
+{
+  double *top = stack; // Next free block
+
+  auto unary = [&top, count](auto function) {
+    double *a = top - BlockSize;
+
+    for (std::size_t i = 0; i < count; ++i)
+      a[i] = function(a[i]);
+  };
+
+  auto binary = [&top, count](auto function) {
+    top -= BlockSize;
+    const double *b = top;
+    double *a = top - BlockSize;
+
+    for (std::size_t i = 0; i < count; ++i)
+      a[i] = function(a[i], b[i]);
+  };
+
+  for (const auto &instruction : m_Program)
+  {
+    const double value = instruction.Value;
+
+    switch (instruction.Op)
+    {
+      case Operation::Input:
+        loaders[instruction.Input](inputData[instruction.Input], offset, count, top);
+        top += BlockSize;
+        break;
+      case Operation::Constant:
+        std::fill_n(top, count, value);
+        top += BlockSize;
+        break;
+      case Operation::Add:
+        binary([](double a, double b) { return a + b; });
+        break;
+      case Operation::Subtract:
+        binary([](double a, double b) { return a - b; });
+        break;
+      case Operation::Multiply:
+        binary([](double a, double b) { return a * b; });
+        break;
+      case Operation::Divide:
+        binary([](double a, double b) { return a / b; });
+        break;
+      case Operation::Pow:
+        unary([value](double a) { return std::pow(a, value); });
+        break;
+      case Operation::Tan:
+        unary([](double a) { return std::tan(a); });
+        break;
+      case Operation::Atan:
+        unary([](double a) { return std::atan(a); });
+        break;
+      case Operation::Cos:
+        unary([](double a) { return std::cos(a); });
+        break;
+      case Operation::Acos:
+        unary([](double a) { return std::acos(a); });
+        break;
+      case Operation::Sin:
+        unary([](double a) { return std::sin(a); });
+        break;
+      case Operation::Asin:
+        unary([](double a) { return std::asin(a); });
+        break;
+      case Operation::Square:
+        unary([](double a) { return a * a; });
+        break;
+      case Operation::Sqrt:
+        unary([](double a) { return std::sqrt(a); });
+        break;
+      case Operation::Abs:
+        unary([](double a) { return std::abs(a); });
+        break;
+      case Operation::Exp:
+        unary([](double a) { return std::exp(a); });
+        break;
+      case Operation::ExpNeg:
+        unary([](double a) { return std::exp(-a); });
+        break;
+      case Operation::Log10:
+        unary([](double a) { return std::log10(a); });
+        break;
+    }
+  }
+
+  return stack;
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(const PixelType &outputPixelType) const
+{
+  if (m_Inputs.empty())
+    mitkThrow() << "mitk::ArithmeticExpression without an input image cannot be evaluated";
+
+  CheckScalarPixelType(outputPixelType);
+
+  const Image *referenceImage = m_Inputs.front();
+  const auto dimension = referenceImage->GetDimension();
+  std::size_t numberOfPixels = 1;
+
+  for (unsigned int i = 0; i < dimension; ++i)
+    numberOfPixels *= referenceImage->GetDimension(i);
+
+  std::vector<std::unique_ptr<ImageReadAccessor>> inputAccessors;
+  std::vector<const void *> inputData;
+  std::vector<LoadFunction> loaders;
+
+  for (const auto &input : m_Inputs)
+  {
+    CheckScalarPixelType(input->GetPixelType());
+
+    if (input->GetDimension() != dimension ||
+        !std::equal(referenceImage->GetDimensions(), referenceImage->GetDimensions() + dimension, input->GetDimensions()))
+    {
+      mitkThrow() << "Input images of mitk::ArithmeticExpression have different dimensions";
+    }
+
+    inputAccessors.push_back(std::make_unique<ImageReadAccessor>(input));
+    inputData.push_back(inputAccessors.back()->GetData());
+
+    CallWithComponentType(input->GetPixelType().GetComponentType(), [&loaders](auto tag) {
+      loaders.push_back(&LoadBlock<typename decltype(tag)::Type>);
+    });
+  }
+
+  StoreFunction store = nullptr;
+
+  CallWithComponentType(outputPixelType.GetComponentType(), [&store](auto tag) {
+    store = &StoreBlock<typename decltype(tag)::Type>;
+  });
+
+  auto outputImage = Image::New();
+  outputImage->Initialize(outputPixelType, dimension, referenceImage->GetDimensions());
+  outputImage->SetTimeGeometry(referenceImage->GetTimeGeometry()->Clone());
+
+  ImageWriteAccessor outputAccessor(outputImage);
+  void *outputData = outputAccessor.GetData();
+
+  const std::size_t stackSize = this->GetStackDepth() * BlockSize;
+  const std::size_t numberOfBlocks = (numberOfPixels + BlockSize - 1) / BlockSize;
+  const std::size_t numberOfTasks = (numberOfBlocks + BlocksPerTask - 1) / BlocksPerTask;
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfTasks,
+    [&](itk::SizeValueType task) {
+      std::vector<double> stack(stackSize);
+      const std::size_t lastBlock = std::min(numberOfBlocks, (task + 1) * BlocksPerTask);
+
+      for (std::size_t block = task * BlocksPerTask; block < lastBlock; ++block)
+      {
+        const std::size_t offset = block * BlockSize;
+        const std::size_t count = std::min(BlockSize, numberOfPixels - offset);
+
+        store(this->EvaluateBlock(loaders, inputData, offset, count, stack.data()), offset, count, outputData);
+      }
+    },
+    nullptr);
+
+  return outputImage;
+}
+
+mitk::Image::Pointer mitk::ArithmeticExpression::Evaluate(bool outputAsDouble) const
+{
+  if (m_Inputs.empty())
+    mitkThrow() << "mitk::ArithmeticExpression without an input image cannot be evaluated";
+
+  return this->Evaluate(outputAsDouble
+    ? MakeScalarPixelType<double>()
+    : m_Inputs.front()->GetPixelType());
+}
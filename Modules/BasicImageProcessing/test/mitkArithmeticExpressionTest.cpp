@@ -0,0 +1,142 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkArithmeticExpression.h>
+#include <mitkArithmeticOperation.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageReadAccessor.h>
+
+#include <itkImage.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Compares mitk::ArithmeticExpression with mitk::ArithmeticOperation for several pixel types.
+ *
+ * The results of ArithmeticOperation are calculated as double images. Integer results of the expression are
+ * expected to be saturated to the range of the pixel type, with NaN stored as 0.
+ */
+class mitkArithmeticExpressionTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkArithmeticExpressionTestSuite);
+  MITK_TEST(TestUnsignedChar);
+  MITK_TEST(TestShort);
+  MITK_TEST(TestInt);
+  MITK_TEST(TestFloat);
+  MITK_TEST(TestDouble);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void TestUnsignedChar() { this->CompareWithArithmeticOperation<unsigned char>(); }
+  void TestShort() { this->CompareWithArithmeticOperation<short>(); }
+  void TestInt() { this->CompareWithArithmeticOperation<int>(); }
+  void TestFloat() { this->CompareWithArithmeticOperation<float>(); }
+  void TestDouble() { this->CompareWithArithmeticOperation<double>(); }
+
+private:
+  template <typename TPixel>
+  void CompareWithArithmeticOperation()
+  {
+    auto imageA = CreateImage<TPixel>({0, 1, 2, 3, 50, 100});
+    auto imageB = CreateImage<TPixel>({5, 0, 7, 0, 9, 100});
+    const mitk::ArithmeticExpression a(imageA);
+    const mitk::ArithmeticExpression b(imageB);
+
+    // ArithmeticOperation always generates double images for two images
+    CheckEqual<double>(mitk::ArithmeticOperation::Add(imageA, imageB), (a + b).Evaluate(true));
+    CheckEqual<double>(mitk::ArithmeticOperation::Multiply(imageA, imageB), (a * b).Evaluate(true));
+
+    // overflow and underflow of the input pixel type
+    CheckEqual<TPixel>(mitk::ArithmeticOperation::Multiply(imageA, 1e6, true), (a * 1e6).Evaluate(false));
+    CheckEqual<TPixel>(mitk::ArithmeticOperation::Subtract(imageA, 1e6, true), (a - 1e6).Evaluate(false));
+    CheckEqual<TPixel>(mitk::ArithmeticOperation::Exp(imageA, true), a.Exp().Evaluate(false));
+
+    // division by zero yields inf and, for 0 / 0, NaN
+    CheckEqual<double>(mitk::ArithmeticOperation::Divide(imageA, 0.0, true), (a / 0.0).Evaluate(true));
+    CheckEqual<TPixel>(mitk::ArithmeticOperation::Divide(imageA, 0.0, true), (a / 0.0).Evaluate(false));
+    CheckEqual<TPixel>(mitk::ArithmeticOperation::Divide(-1.0, imageB, true), (-1.0 / b).Evaluate(false));
+  }
+
+  template <typename TPixel>
+  static mitk::Image::Pointer CreateImage(const std::vector<double> &values)
+  {
+    using ImageType = itk::Image<TPixel, 3>;
+
+    typename ImageType::SizeType size = {{static_cast<itk::SizeValueType>(values.size()), 1, 1}};
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+    std::transform(values.begin(), values.end(), image->GetBufferPointer(), [](double value) {
+      return static_cast<TPixel>(value);
+    });
+
+    return mitk::GrabItkImageMemory(image.GetPointer());
+  }
+
+  /** Conversion of a double result to the pixel type as expected from ArithmeticExpression.*/
+  template <typename TPixel>
+  static TPixel ToPixel(double value)
+  {
+    if constexpr (std::is_floating_point<TPixel>::value)
+    {
+      if (std::abs(value) > std::numeric_limits<TPixel>::max())
+        return std::copysign(std::numeric_limits<TPixel>::infinity(), value);
+
+      return static_cast<TPixel>(value);
+    }
+    else
+    {
+      if (std::isnan(value))
+        return 0;
+
+      const double clamped = std::min(std::max(value, static_cast<double>(std::numeric_limits<TPixel>::lowest())),
+                                      static_cast<double>(std::numeric_limits<TPixel>::max()));
+      return static_cast<TPixel>(clamped);
+    }
+  }
+
+  template <typename TPixel>
+  static void CheckEqual(const mitk::Image *reference, const mitk::Image *result)
+  {
+    CPPUNIT_ASSERT(reference->GetPixelType() == mitk::MakeScalarPixelType<double>());
+    CPPUNIT_ASSERT(result->GetPixelType() == mitk::MakeScalarPixelType<TPixel>());
+    CPPUNIT_ASSERT_EQUAL(reference->GetDimension(0), result->GetDimension(0));
+
+    mitk::ImageReadAccessor referenceAccessor(reference);
+    mitk::ImageReadAccessor resultAccessor(result);
+    const auto *referenceValues = static_cast<const double *>(referenceAccessor.GetData());
+    const auto *resultValues = static_cast<const TPixel *>(resultAccessor.GetData());
+
+    for (unsigned int i = 0; i < reference->GetDimension(0); ++i)
+    {
+      const TPixel expected = ToPixel<TPixel>(referenceValues[i]);
+
+      if (std::isnan(static_cast<double>(expected)))
+      {
+        CPPUNIT_ASSERT_MESSAGE("Result should be NaN", std::isnan(static_cast<double>(resultValues[i])));
+      }
+      else
+      {
+        CPPUNIT_ASSERT_EQUAL(expected, resultValues[i]);
+      }
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkArithmeticExpression)
@@ -205,6 +205,12 @@ public:
 
   itkGetMacro(Quantifier, IntensityQuantifier::Pointer);
 
+  /** Cache used to determine intensity ranges and quantifiers. Can be shared between feature instances that are
+  calculated for the same image and mask. Instances with the same quantifier settings then also share their
+  quantifier. nullptr disables caching (default).*/
+  itkSetObjectMacro(IntensityRangeCache, IntensityRangeCache);
+  itkGetObjectMacro(IntensityRangeCache, IntensityRangeCache);
+
   itkGetConstMacro(Direction, int);
 
   itkSetMacro(MinimumIntensity, double);
@@ -270,6 +276,9 @@ protected:
   /**Initializes the quantifier gigen the quantifier relevant variables and the passed arguments.*/
   void InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins = 256);
 
+  /**Initializes the passed quantifier according to the quantifier relevant variables of the instance.*/
+  void InitializeQuantifierBySettings(IntensityQuantifier* quantifier, const Image* image, const Image* mask, unsigned int defaultBins) const;
+
   /** Helper that encodes the quantifier parameters in a string (e.g. used for the legacy feature name)*/
   std::string QuantifierParameterString() const;
 
@@ -319,6 +328,7 @@ private:
 
 
   IntensityQuantifier::Pointer m_Quantifier;
+  IntensityRangeCache::Pointer m_IntensityRangeCache;
   //Quantifier relevant variables
   double m_MinimumIntensity = 0;
   bool m_UseMinimumIntensity = false;
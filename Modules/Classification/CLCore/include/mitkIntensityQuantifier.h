@@ -18,6 +18,7 @@ found in the LICENSE file.
 
 #include <mitkBaseData.h>
 #include <mitkImage.h>
+#include <mitkIntensityRangeCache.h>
 
 namespace mitk
 {
@@ -57,6 +58,9 @@ public:
   itkGetConstMacro(Minimum, double);
   itkGetConstMacro(Maximum, double);
 
+  /** \brief Set a cache that is used to determine intensity ranges from images (optional).*/
+  itkSetObjectMacro(RangeCache, IntensityRangeCache);
+
 public:
 
 //#ifndef DOXYGEN_SKIP
@@ -79,11 +83,14 @@ public:
 
 
 private:
+  void CalculateRange(const Image* image, const Image* mask, double& minimum, double& maximum);
+
   bool m_Initialized;
   unsigned int m_Bins;
   double m_Binsize;
   double m_Minimum;
   double m_Maximum;
+  IntensityRangeCache::Pointer m_RangeCache;
 
 };
 }
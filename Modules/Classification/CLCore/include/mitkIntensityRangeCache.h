@@ -0,0 +1,102 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIntensityRangeCache_h
+#define mitkIntensityRangeCache_h
+
+#include <MitkCLCoreExports.h>
+
+#include <mitkImage.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace mitk
+{
+  class IntensityQuantifier;
+
+  /**
+  * \brief Caches the intensity range and the quantifiers of images and of masked image regions.
+  *
+  * If several feature classes are calculated for the same image and mask, each of them initializes its own
+  * IntensityQuantifier and thus walks the image to find the minimum and maximum intensity. Sharing a cache
+  * between the feature classes (see AbstractGlobalImageFeature::SetIntensityRangeCache()) reduces this to a
+  * single pass per image / mask pair. Feature classes with the same quantifier settings share a single
+  * initialized quantifier as well.
+  *
+  * The cache is thread-safe. Concurrent requests for the same entry wait for a single calculation.
+  * Entries are identified by the images and their modified times.
+  */
+  class MITKCLCORE_EXPORT IntensityRangeCache : public itk::LightObject
+  {
+  public:
+    mitkClassMacroItkParent(IntensityRangeCache, itk::LightObject);
+    itkFactorylessNewMacro(Self);
+
+    /** \brief Get the minimum and maximum intensity of the whole image.*/
+    void GetImageRange(const Image* image, double& minimum, double& maximum);
+
+    /** \brief Get the minimum and maximum intensity of all voxels inside the mask.*/
+    void GetImageRegionRange(const Image* image, const Image* mask, double& minimum, double& maximum);
+
+    /** \brief Get the quantifier of an image / mask pair for the given settings.
+    * The first request creates the quantifier and initializes it with the passed function. Later requests with
+    * the same images and settings return the same instance, which therefore must not be modified.
+    * \param settings Identifies the initialization, i.e. has to differ for differently initialized quantifiers.
+    */
+    itk::SmartPointer<IntensityQuantifier> GetQuantifier(const Image* image,
+                                                         const Image* mask,
+                                                         const std::string& settings,
+                                                         const std::function<void(IntensityQuantifier*)>& initialize);
+
+    void Clear();
+
+    /** \brief Calculate the intensity range of an image without caching.
+    * \param mask Only voxels inside the mask are considered. May be nullptr to consider the whole image.
+    */
+    static void CalculateRange(const Image* image, const Image* mask, double& minimum, double& maximum);
+
+  protected:
+    IntensityRangeCache();
+    ~IntensityRangeCache() override;
+
+  private:
+    struct Range
+    {
+      std::once_flag Calculated;
+      double Minimum = 0.0;
+      double Maximum = 0.0;
+    };
+
+    struct Quantifier
+    {
+      std::once_flag Initialized;
+      itk::SmartPointer<IntensityQuantifier> Instance;
+    };
+
+    using KeyType = std::tuple<const Image*, itk::ModifiedTimeType, const Image*, itk::ModifiedTimeType>;
+
+    static KeyType CreateKey(const Image* image, const Image* mask);
+
+    std::shared_ptr<Range> GetRange(const Image* image, const Image* mask);
+
+    std::mutex m_Mutex;
+    std::map<KeyType, std::shared_ptr<Range>> m_Ranges;
+    std::map<std::pair<KeyType, std::string>, std::shared_ptr<Quantifier>> m_Quantifiers;
+  };
+}
+
+#endif
@@ -14,7 +14,9 @@ found in the LICENSE file.
 
 #include <mitkImageCast.h>
 #include <mitkITKImageImport.h>
+#include <iomanip>
 #include <iterator>
+#include <sstream>
 
 
 bool mitk::FeatureID::operator < (const FeatureID& rh) const
@@ -255,46 +257,67 @@ void mitk::AbstractGlobalImageFeature::ConfigureSettingsByParameters(const Param
 
 void  mitk::AbstractGlobalImageFeature::InitializeQuantifier(const Image* image, const Image* mask, unsigned int defaultBins)
 {
-  m_Quantifier = IntensityQuantifier::New();
+  if (m_IntensityRangeCache.IsNull())
+  {
+    m_Quantifier = IntensityQuantifier::New();
+    this->InitializeQuantifierBySettings(m_Quantifier, image, mask, defaultBins);
+    return;
+  }
+
+  // Feature classes with the same settings share a single quantifier
+  std::stringstream settings;
+  settings.imbue(std::locale::classic());
+  settings << std::setprecision(17) << GetUseMinimumIntensity() << ' ' << GetMinimumIntensity() << ' '
+    << GetUseMaximumIntensity() << ' ' << GetMaximumIntensity() << ' ' << GetUseBinsize() << ' ' << GetBinsize() << ' '
+    << GetUseBins() << ' ' << GetBins() << ' ' << GetIgnoreMask() << ' ' << defaultBins;
+
+  m_Quantifier = m_IntensityRangeCache->GetQuantifier(image, mask, settings.str(), [&](IntensityQuantifier* quantifier) {
+    quantifier->SetRangeCache(m_IntensityRangeCache);
+    this->InitializeQuantifierBySettings(quantifier, image, mask, defaultBins);
+  });
+}
+
+void  mitk::AbstractGlobalImageFeature::InitializeQuantifierBySettings(IntensityQuantifier* quantifier, const Image* image, const Image* mask, unsigned int defaultBins) const
+{
   if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBinsize())
-    m_Quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByBinsizeAndMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseBins() && GetUseBinsize())
-    m_Quantifier->InitializeByBinsizeAndBins(GetMinimumIntensity(), GetBins(), GetBinsize());
+    quantifier->InitializeByBinsizeAndBins(GetMinimumIntensity(), GetBins(), GetBinsize());
   else if (GetUseMinimumIntensity() && GetUseMaximumIntensity() && GetUseBins())
-    m_Quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByMinimumMaximum(GetMinimumIntensity(), GetMaximumIntensity(), GetBins());
   // Intialize from Image and Binsize
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMinimum(image, GetMinimumIntensity(), GetBinsize());
+    quantifier->InitializeByImageAndBinsizeAndMinimum(image, GetMinimumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndBinsizeAndMaximum(image, GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByImageAndBinsizeAndMaximum(image, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetIgnoreMask())
-    m_Quantifier->InitializeByImageAndBinsize(image, GetBinsize());
+    quantifier->InitializeByImageAndBinsize(image, GetBinsize());
   // Initialize form Image, Mask and Binsize
   else if (GetUseBinsize() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMinimum(image, mask, GetMinimumIntensity(), GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsizeAndMinimum(image, mask, GetMinimumIntensity(), GetBinsize());
   else if (GetUseBinsize() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndBinsizeAndMaximum(image, mask, GetMaximumIntensity(), GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsizeAndMaximum(image, mask, GetMaximumIntensity(), GetBinsize());
   else if (GetUseBinsize())
-    m_Quantifier->InitializeByImageRegionAndBinsize(image, mask, GetBinsize());
+    quantifier->InitializeByImageRegionAndBinsize(image, mask, GetBinsize());
   // Intialize from Image and Bins
   else if (GetUseBins() && GetIgnoreMask() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageAndMinimum(image, GetMinimumIntensity(), GetBins());
+    quantifier->InitializeByImageAndMinimum(image, GetMinimumIntensity(), GetBins());
   else if (GetUseBins() && GetIgnoreMask() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageAndMaximum(image, GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByImageAndMaximum(image, GetMaximumIntensity(), GetBins());
   else if (GetUseBins())
-    m_Quantifier->InitializeByImage(image, GetBins());
+    quantifier->InitializeByImage(image, GetBins());
   // Intialize from Image, Mask and Bins
   else if (GetUseBins() && GetUseMinimumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMinimum(image, mask, GetMinimumIntensity(), GetBins());
+    quantifier->InitializeByImageRegionAndMinimum(image, mask, GetMinimumIntensity(), GetBins());
   else if (GetUseBins() && GetUseMaximumIntensity())
-    m_Quantifier->InitializeByImageRegionAndMaximum(image, mask, GetMaximumIntensity(), GetBins());
+    quantifier->InitializeByImageRegionAndMaximum(image, mask, GetMaximumIntensity(), GetBins());
   else if (GetUseBins())
-    m_Quantifier->InitializeByImageRegion(image, mask, GetBins());
+    quantifier->InitializeByImageRegion(image, mask, GetBins());
   // Default
   else if (GetIgnoreMask())
-    m_Quantifier->InitializeByImage(image, GetBins());
+    quantifier->InitializeByImage(image, GetBins());
   else
-    m_Quantifier->InitializeByImageRegion(image, mask, defaultBins);
+    quantifier->InitializeByImageRegion(image, mask, defaultBins);
 }
 
 std::string mitk::AbstractGlobalImageFeature::GenerateLegacyFeatureName(const FeatureID& id) const
@@ -13,61 +13,7 @@ found in the LICENSE file.
 #include <mitkIntensityQuantifier.h>
 
 // STD
-#include <numeric>
-
-// ITK
-#include <itkImageRegionConstIterator.h>
-
-// MITK
-#include <mitkImageCast.h>
-#include <mitkImageAccessByItk.h>
-
-template<typename TPixel, unsigned int VImageDimension>
-static void
-CalculateImageMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, double &minimum, double &maximum)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-
-  minimum = std::numeric_limits<TPixel>::max();
-  maximum = std::numeric_limits<TPixel>::lowest();
-
-  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
-
-  while (!iter.IsAtEnd())
-  {
-    minimum = std::min<TPixel>(minimum, iter.Get());
-    maximum = std::max<TPixel>(maximum, iter.Get());
-    ++iter;
-  }
-}
-
-template<typename TPixel, unsigned int VImageDimension>
-static void
-CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, double &minimum, double &maximum)
-{
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<int, VImageDimension> MaskType;
-
-  typename MaskType::Pointer itkMask = MaskType::New();
-  mitk::CastToItkImage(mask, itkMask);
-
-  minimum = std::numeric_limits<TPixel>::max();
-  maximum = std::numeric_limits<TPixel>::lowest();
-
-  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
-  itk::ImageRegionConstIterator<MaskType> maskIter(itkMask, itkMask->GetLargestPossibleRegion());
-
-  while (!iter.IsAtEnd())
-  {
-    if (maskIter.Get() > 0)
-    {
-      minimum = std::min<TPixel>(minimum, iter.Get());
-      maximum = std::max<TPixel>(maximum, iter.Get());
-    }
-    ++iter;
-    ++maskIter;
-  }
-}
+#include <cmath>
 
 mitk::IntensityQuantifier::IntensityQuantifier() :
       m_Initialized(false),
@@ -103,76 +49,88 @@ void mitk::IntensityQuantifier::InitializeByBinsizeAndMaximum(double minimum, do
 
 void mitk::IntensityQuantifier::InitializeByImage(const Image* image, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  this->CalculateRange(image, nullptr, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMinimum(const Image* image, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  this->CalculateRange(image, nullptr, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndMaximum(const Image* image, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  this->CalculateRange(image, nullptr, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegion(const Image* image, const Image* mask, unsigned int bins) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  this->CalculateRange(image, mask, minimum, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMinimum(const Image* image, const Image* mask, double minimum, unsigned int bins) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  this->CalculateRange(image, mask, tmp, maximum);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndMaximum(const Image* image, const Image* mask, double maximum, unsigned int bins) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  this->CalculateRange(image, mask, minimum, tmp);
   InitializeByMinimumMaximum(minimum, maximum, bins);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsize(const Image* image, double binsize) {
   double minimum, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  this->CalculateRange(image, nullptr, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMinimum(const Image* image, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_2(image, CalculateImageMinMax, tmp, maximum);
+  this->CalculateRange(image, nullptr, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageAndBinsizeAndMaximum(const Image* image, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_2(image, CalculateImageMinMax, minimum, tmp);
+  this->CalculateRange(image, nullptr, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsize(const Image* image, const Image* mask, double binsize) {
   double minimum, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  this->CalculateRange(image, mask, minimum, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMinimum(const Image* image, const Image* mask, double minimum, double binsize) {
   double tmp, maximum;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, tmp, maximum);
+  this->CalculateRange(image, mask, tmp, maximum);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
 void mitk::IntensityQuantifier::InitializeByImageRegionAndBinsizeAndMaximum(const Image* image, const Image* mask, double maximum, double binsize) {
   double minimum, tmp;
-  AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, tmp);
+  this->CalculateRange(image, mask, minimum, tmp);
   InitializeByBinsizeAndMaximum(minimum, maximum, binsize);
 }
 
+void mitk::IntensityQuantifier::CalculateRange(const Image* image, const Image* mask, double& minimum, double& maximum)
+{
+  if (m_RangeCache.IsNotNull())
+  {
+    m_RangeCache->GetImageRegionRange(image, mask, minimum, maximum);
+  }
+  else
+  {
+    IntensityRangeCache::CalculateRange(image, mask, minimum, maximum);
+  }
+}
+
 unsigned int mitk::IntensityQuantifier::IntensityToIndex(double intensity)
 {
   double index = std::floor((intensity - m_Minimum) / m_Binsize);
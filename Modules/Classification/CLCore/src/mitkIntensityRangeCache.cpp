@@ -0,0 +1,158 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIntensityRangeCache.h>
+#include <mitkIntensityQuantifier.h>
+
+// ITK
+#include <itkImageRegionConstIterator.h>
+
+// MITK
+#include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
+
+template<typename TPixel, unsigned int VImageDimension>
+static void
+CalculateImageMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, double &minimum, double &maximum)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+
+  minimum = std::numeric_limits<TPixel>::max();
+  maximum = std::numeric_limits<TPixel>::lowest();
+
+  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+
+  while (!iter.IsAtEnd())
+  {
+    minimum = std::min<TPixel>(minimum, iter.Get());
+    maximum = std::max<TPixel>(maximum, iter.Get());
+    ++iter;
+  }
+}
+
+template<typename TPixel, unsigned int VImageDimension>
+static void
+CalculateImageRegionMinMax(const itk::Image<TPixel, VImageDimension>* itkImage, const mitk::Image* mask, double &minimum, double &maximum)
+{
+  typedef itk::Image<TPixel, VImageDimension> ImageType;
+  typedef itk::Image<int, VImageDimension> MaskType;
+
+  typename MaskType::Pointer itkMask = MaskType::New();
+  mitk::CastToItkImage(mask, itkMask);
+
+  minimum = std::numeric_limits<TPixel>::max();
+  maximum = std::numeric_limits<TPixel>::lowest();
+
+  itk::ImageRegionConstIterator<ImageType> iter(itkImage, itkImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<MaskType> maskIter(itkMask, itkMask->GetLargestPossibleRegion());
+
+  while (!iter.IsAtEnd())
+  {
+    if (maskIter.Get() > 0)
+    {
+      minimum = std::min<TPixel>(minimum, iter.Get());
+      maximum = std::max<TPixel>(maximum, iter.Get());
+    }
+    ++iter;
+    ++maskIter;
+  }
+}
+
+mitk::IntensityRangeCache::IntensityRangeCache()
+{
+}
+
+mitk::IntensityRangeCache::~IntensityRangeCache()
+{
+}
+
+void mitk::IntensityRangeCache::CalculateRange(const Image* image, const Image* mask, double& minimum, double& maximum)
+{
+  if (nullptr == mask)
+  {
+    AccessByItk_2(image, CalculateImageMinMax, minimum, maximum);
+  }
+  else
+  {
+    AccessByItk_3(image, CalculateImageRegionMinMax, mask, minimum, maximum);
+  }
+}
+
+void mitk::IntensityRangeCache::GetImageRange(const Image* image, double& minimum, double& maximum)
+{
+  this->GetImageRegionRange(image, nullptr, minimum, maximum);
+}
+
+void mitk::IntensityRangeCache::GetImageRegionRange(const Image* image, const Image* mask, double& minimum, double& maximum)
+{
+  auto range = this->GetRange(image, mask);
+
+  // Calculated outside of the lock, so that ranges of different image / mask pairs can be calculated concurrently
+  std::call_once(range->Calculated, [&]() { CalculateRange(image, mask, range->Minimum, range->Maximum); });
+
+  minimum = range->Minimum;
+  maximum = range->Maximum;
+}
+
+mitk::IntensityQuantifier::Pointer mitk::IntensityRangeCache::GetQuantifier(const Image* image,
+  const Image* mask,
+  const std::string& settings,
+  const std::function<void(IntensityQuantifier*)>& initialize)
+{
+  std::shared_ptr<Quantifier> quantifier;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    auto& entry = m_Quantifiers[std::make_pair(CreateKey(image, mask), settings)];
+
+    if (nullptr == entry)
+      entry = std::make_shared<Quantifier>();
+
+    quantifier = entry;
+  }
+
+  // Initialized outside of the lock, as the initialization usually requests a range of this cache
+  std::call_once(quantifier->Initialized, [&]() {
+    auto instance = IntensityQuantifier::New();
+    initialize(instance);
+    quantifier->Instance = instance;
+  });
+
+  return quantifier->Instance;
+}
+
+void mitk::IntensityRangeCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Ranges.clear();
+  m_Quantifiers.clear();
+}
+
+mitk::IntensityRangeCache::KeyType mitk::IntensityRangeCache::CreateKey(const Image* image, const Image* mask)
+{
+  return KeyType(image, image->GetMTime(), mask, nullptr != mask ? mask->GetMTime() : 0);
+}
+
+std::shared_ptr<mitk::IntensityRangeCache::Range> mitk::IntensityRangeCache::GetRange(const Image* image, const Image* mask)
+{
+  const auto key = CreateKey(image, mask);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto& range = m_Ranges[key];
+
+  if (nullptr == range)
+    range = std::make_shared<Range>();
+
+  return range;
+}
@@ -38,6 +38,7 @@ found in the LICENSE file.
 #include <mitkGIFIntensityVolumeHistogramFeatures.h>
 #include <mitkGIFNeighbourhoodGreyToneDifferenceFeatures.h>
 #include <mitkGIFNeighbouringGreyLevelDependenceFeatures.h>
+#include <mitkGlobalImageFeatureExtractor.h>
 #include <mitkImageAccessByItk.h>
 #include <mitkImageCast.h>
 #include <mitkITKImageImport.h>
@@ -47,11 +48,18 @@ found in the LICENSE file.
 #include <mitkCLResultXMLWriter.h>
 #include <mitkVersion.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <locale>
+#include <map>
+#include <mutex>
+#include <thread>
 
 #include <itkImageDuplicator.h>
 #include <itkImageRegionIterator.h>
+#include <itksys/SystemTools.hxx>
 
 
 #include "itkNearestNeighborInterpolateImageFunction.h"
@@ -359,7 +367,7 @@ void SaveSliceOrImageAsPNG(mitk::Image::Pointer image, mitk::Image::Pointer mask
   }
 }
 
-int main(int argc, char* argv[])
+static std::vector<mitk::AbstractGlobalImageFeature::Pointer> CreateFeatures()
 {
   // Commented : Updated to a common interface, include, if possible, mask is type unsigned short, uses Quantification, Comments
   //                                 Name follows standard scheme with Class Name::Feature Name
@@ -399,77 +407,68 @@ int main(int argc, char* argv[])
   features.push_back(ipCalculator.GetPointer());
   features.push_back(ngtdCalculator.GetPointer());
 
-  mitkCommandLineParser parser;
-  parser.setArgumentPrefix("--", "-");
-  mitk::cl::GlobalImageFeaturesParameter param;
-  param.AddParameter(parser);
+  return features;
+}
 
-  parser.addArgument("--","-", mitkCommandLineParser::String, "---", "---", us::Any(),true);
+static void ConfigureFeatures(const std::vector<mitk::AbstractGlobalImageFeature::Pointer>& features,
+                              const mitk::cl::GlobalImageFeaturesParameter& param,
+                              const std::map<std::string, us::Any>& parsedArgs,
+                              int direction)
+{
   for (auto cFeature : features)
   {
-    cFeature->AddArguments(parser);
-  }
-
-  parser.addArgument("--", "-", mitkCommandLineParser::String, "---", "---", us::Any(), true);
-  parser.addArgument("description","d",mitkCommandLineParser::String,"Text","Description that is added to the output",us::Any());
-  parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
-  parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
-  parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
-    " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
-
-  // Miniapp Infos
-  parser.setCategory("Classification Tools");
-  parser.setTitle("Global Image Feature calculator");
-  parser.setDescription("Calculates different global statistics for a given segmentation / image combination");
-  parser.setContributor("German Cancer Research Center (DKFZ)");
-
-  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
-  param.ParseParameter(parsedArgs);
-
-  if (parsedArgs.size()==0)
-  {
-    return EXIT_FAILURE;
-  }
-  if ( parsedArgs.count("help") || parsedArgs.count("h"))
-  {
-    return EXIT_SUCCESS;
-  }
-
-  std::string version = "Version: 1.23";
-  MITK_INFO << version;
-
-  std::ofstream log;
-  if (param.useLogfile)
-  {
-    log.open(param.logfilePath, std::ios::app);
-    log << std::endl;
-    log << version;
-    log << "Image: " << param.imagePath;
-    log << "Mask: " << param.maskPath;
-  }
-
-
-  if (param.useDecimalPoint)
-  {
-    std::cout.imbue(std::locale(std::cout.getloc(), new punct_facet<char>(param.decimalPoint)));
+    if (param.defineGlobalMinimumIntensity)
+    {
+      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
+      cFeature->SetUseMinimumIntensity(true);
+    }
+    if (param.defineGlobalMaximumIntensity)
+    {
+      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
+      cFeature->SetUseMaximumIntensity(true);
+    }
+    if (param.defineGlobalNumberOfBins)
+    {
+      cFeature->SetBins(param.globalNumberOfBins);
+      MITK_INFO << param.globalNumberOfBins;
+    }
+    cFeature->SetParameters(parsedArgs);
+    cFeature->SetDirection(direction);
+    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
   }
+}
 
-
+/** Loads the image and masks of a case and adapts them to each other as specified by the parameters.
+ * Returns false if the image and the mask do not match.
+ */
+static bool
+PrepareCase(const mitk::cl::GlobalImageFeaturesParameter& param,
+            const std::string& imagePath,
+            const std::string& maskPath,
+            const std::string& morphPath,
+            mitk::Image::Pointer& loadedImage,
+            mitk::Image::Pointer& loadedMask,
+            mitk::Image::Pointer& image,
+            mitk::Image::Pointer& mask,
+            mitk::Image::Pointer& morphMask,
+            mitk::Image::Pointer& maskNoNaN,
+            std::ostream& log)
+{
   //representing the original loaded image data without any prepropcessing that might come.
-  mitk::Image::Pointer loadedImage = mitk::IOUtil::Load<mitk::Image>(param.imagePath);
+  loadedImage = mitk::IOUtil::Load<mitk::Image>(imagePath);
   //representing the original loaded mask data without any prepropcessing that might come.
-  mitk::Image::Pointer loadedMask = mitk::IOUtil::Load<mitk::Image>(param.maskPath);
+  loadedMask = mitk::IOUtil::Load<mitk::Image>(maskPath);
 
-  mitk::Image::Pointer image = loadedImage;
-  mitk::Image::Pointer mask = loadedMask;
+  image = loadedImage;
+  mask = loadedMask;
 
   mitk::Image::Pointer tmpImage = loadedImage;
   mitk::Image::Pointer tmpMask = loadedMask;
 
-  mitk::Image::Pointer morphMask = mask;
-  if (param.useMorphMask)
+  morphMask = mask;
+  if (!morphPath.empty())
   {
-    morphMask = mitk::IOUtil::Load<mitk::Image>(param.morphPath);
+    morphMask = mitk::IOUtil::Load<mitk::Image>(morphPath);
   }
 
   log << " Check for Dimensions -";
@@ -493,12 +492,6 @@ int main(int argc, char* argv[])
     }
   }
 
-  int writeDirection = 0;
-  if (parsedArgs.count("output-mode"))
-  {
-    writeDirection = us::any_cast<int>(parsedArgs["output-mode"]);
-  }
-
   log << " Check for Resolution -";
   if (param.resampleToFixIsotropic)
   {
@@ -526,7 +519,7 @@ int main(int argc, char* argv[])
       image->GetGeometry(0)->SetOrigin(mask->GetGeometry(0)->GetOrigin());
     } else
     {
-      return -1;
+      return false;
     }
   }
 
@@ -544,22 +537,394 @@ int main(int argc, char* argv[])
     {
       MITK_INFO << "The spacing of the mask and the input images is not equal.";
       MITK_INFO << "Terminating the programm. You may use the '-fi' option";
-      return -1;
+      return false;
     }
   }
 
+  MITK_INFO << "Start creating Mask without NaN";
+
+  maskNoNaN = mitk::Image::New();
+  AccessByItk_2(image, CreateNoNaNMask,  mask, maskNoNaN);
+  //CreateNoNaNMask(mask, image, maskNoNaN);
+
+  return true;
+}
+
+struct BatchCase
+{
+  std::string imagePath;
+  std::string maskPath;
+  std::string morphPath;
+};
+
+/** Reads a batch manifest. Each line specifies a case as "image;mask" or "image;mask;morph-mask".
+ * Cases without a morphological mask use defaultMorphPath (may be empty).
+ * Empty lines and lines starting with '#' are ignored.
+ */
+static std::vector<BatchCase> ReadBatchManifest(const std::string& path, const std::string& defaultMorphPath)
+{
+  std::vector<BatchCase> cases;
+  std::ifstream manifest(path);
+
+  if (!manifest.is_open())
+  {
+    MITK_ERROR << "Could not open batch manifest " << path;
+    return cases;
+  }
+
+  std::string line;
+  while (std::getline(manifest, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    std::vector<std::string> entries;
+    std::istringstream lineStream(line);
+    std::string entry;
+    while (std::getline(lineStream, entry, ';'))
+      entries.push_back(entry);
+
+    if (entries.size() < 2 || entries.size() > 3)
+    {
+      MITK_ERROR << "Ignoring invalid line in batch manifest: " << line;
+      continue;
+    }
+
+    BatchCase batchCase;
+    batchCase.imagePath = entries[0];
+    batchCase.maskPath = entries[1];
+    batchCase.morphPath = entries.size() == 3 ? entries[2] : defaultMorphPath;
+
+    cases.push_back(batchCase);
+  }
+
+  return cases;
+}
+
+/** Processes all cases of a batch manifest.
+ *
+ * The images of the cases are loaded and prepared by a single loader thread, while the features of the
+ * previously loaded cases are calculated by a pool of workers. At most as many prepared cases as there
+ * are workers are kept in advance, which bounds the memory consumption. The results are written in the
+ * order of the manifest as soon as all preceding cases are finished.
+ */
+static int
+ProcessBatch(const std::vector<BatchCase>& cases,
+             const mitk::cl::GlobalImageFeaturesParameter& param,
+             const std::map<std::string, us::Any>& parsedArgs,
+             int direction,
+             mitk::cl::FeatureResultWriter& writer,
+             const std::string& description,
+             bool addDescription,
+             std::ostream& log)
+{
+  struct PreparedCase
+  {
+    std::size_t index = 0;
+    bool valid = false;
+    mitk::Image::Pointer image;
+    mitk::Image::Pointer mask;
+    mitk::Image::Pointer maskNoNaN;
+    mitk::Image::Pointer morphMask;
+  };
+
+  struct CaseResult
+  {
+    bool valid = false;
+    mitk::AbstractGlobalImageFeature::FeatureListType stats;
+  };
+
+  const unsigned int numberOfWorkers = std::max(1u, std::min<unsigned int>(
+    0 != param.numberOfThreads ? param.numberOfThreads : std::thread::hardware_concurrency(),
+    static_cast<unsigned int>(cases.size())));
+
+  std::mutex queueMutex;
+  std::condition_variable queueCondition;
+  std::deque<PreparedCase> queue;
+  bool loadingFinished = false;
+
+  std::mutex resultMutex;
+  std::map<std::size_t, CaseResult> results;
+  std::size_t nextResultToWrite = 0;
+  bool headerWritten = false;
+  int returnCode = EXIT_SUCCESS;
+
+  auto loader = [&]()
+  {
+    for (std::size_t i = 0; i < cases.size(); ++i)
+    {
+      {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueCondition.wait(lock, [&]() { return queue.size() < numberOfWorkers; });
+      }
+
+      PreparedCase preparedCase;
+      preparedCase.index = i;
+
+      try
+      {
+        log << " Load case " << cases[i].imagePath << " -";
+        mitk::Image::Pointer loadedImage, loadedMask;
+        preparedCase.valid = PrepareCase(param, cases[i].imagePath, cases[i].maskPath, cases[i].morphPath,
+          loadedImage, loadedMask, preparedCase.image, preparedCase.mask, preparedCase.morphMask, preparedCase.maskNoNaN, log);
+      }
+      catch (const std::exception& e)
+      {
+        MITK_ERROR << "Could not load case " << cases[i].imagePath << ": " << e.what();
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(preparedCase);
+      }
+      queueCondition.notify_all();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      loadingFinished = true;
+    }
+    queueCondition.notify_all();
+  };
+
+  auto worker = [&]()
+  {
+    auto features = CreateFeatures();
+    ConfigureFeatures(features, param, parsedArgs, direction);
+
+    mitk::GlobalImageFeatureExtractor extractor;
+    extractor.SetFeatures(features);
+    extractor.SetNumberOfThreads(1);
+
+    while (true)
+    {
+      PreparedCase preparedCase;
+
+      {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueCondition.wait(lock, [&]() { return !queue.empty() || loadingFinished; });
+
+        if (queue.empty())
+          return;
+
+        preparedCase = queue.front();
+        queue.pop_front();
+      }
+      queueCondition.notify_all();
+
+      const auto index = preparedCase.index;
+      CaseResult result;
+
+      if (preparedCase.valid)
+      {
+        try
+        {
+          for (auto cFeature : features)
+          {
+            cFeature->SetMorphMask(preparedCase.morphMask);
+          }
+
+          result.stats = extractor.CalculateFeatures(preparedCase.image, preparedCase.mask, preparedCase.maskNoNaN, !param.calculateAllFeatures);
+          result.valid = true;
+        }
+        catch (const std::exception& e)
+        {
+          MITK_ERROR << "Could not calculate features of case " << cases[index].imagePath << ": " << e.what();
+        }
+      }
+
+      // Release the images before waiting for the writer
+      preparedCase = PreparedCase();
+
+      std::lock_guard<std::mutex> lock(resultMutex);
+      results[index] = result;
+
+      // Write all results that are not preceded by unfinished cases
+      for (auto iter = results.find(nextResultToWrite); iter != results.end(); iter = results.find(nextResultToWrite))
+      {
+        const auto& batchCase = cases[iter->first];
+
+        if (iter->second.valid)
+        {
+          if (!headerWritten && param.useHeader)
+          {
+            writer.AddColumn("SoftwareVersion");
+            writer.AddColumn("Patient");
+            writer.AddColumn("Image");
+            writer.AddColumn("Segmentation");
+            writer.AddHeader(description, 0, iter->second.stats, true, addDescription);
+          }
+          headerWritten = true;
+
+          writer.AddSubjectInformation(MITK_REVISION);
+          writer.AddSubjectInformation(itksys::SystemTools::GetFilenamePath(batchCase.imagePath));
+          writer.AddSubjectInformation(itksys::SystemTools::GetFilenameName(batchCase.imagePath));
+          writer.AddSubjectInformation(itksys::SystemTools::GetFilenameName(batchCase.maskPath));
+          writer.AddResult(description, 0, iter->second.stats, param.useHeader, addDescription);
+          writer.Flush();
+
+          MITK_INFO << "Finished case " << (iter->first + 1) << " of " << cases.size() << ": " << batchCase.imagePath;
+        }
+        else
+        {
+          returnCode = EXIT_FAILURE;
+        }
+
+        results.erase(iter);
+        ++nextResultToWrite;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < numberOfWorkers; ++i)
+  {
+    workers.emplace_back(worker);
+  }
+
+  loader();
+
+  for (auto& thread : workers)
+  {
+    thread.join();
+  }
+
+  return returnCode;
+}
+
+int main(int argc, char* argv[])
+{
+  auto features = CreateFeatures();
+
+  mitkCommandLineParser parser;
+  parser.setArgumentPrefix("--", "-");
+  mitk::cl::GlobalImageFeaturesParameter param;
+  param.AddParameter(parser);
+
+  parser.addArgument("--","-", mitkCommandLineParser::String, "---", "---", us::Any(),true);
+  for (auto cFeature : features)
+  {
+    cFeature->AddArguments(parser);
+  }
+
+  parser.addArgument("--", "-", mitkCommandLineParser::String, "---", "---", us::Any(), true);
+  parser.addArgument("description","d",mitkCommandLineParser::String,"Text","Description that is added to the output",us::Any());
+  parser.addArgument("direction", "dir", mitkCommandLineParser::String, "Int", "Allows to specify the direction for Cooc and RL. 0: All directions, 1: Only single direction (Test purpose), 2,3,4... Without dimension 0,1,2... ", us::Any());
+  parser.addArgument("slice-wise", "slice", mitkCommandLineParser::String, "Int", "Allows to specify if the image is processed slice-wise (number giving direction) ", us::Any());
+  parser.addArgument("output-mode", "omode", mitkCommandLineParser::Int, "Int", "Defines the format of the output. 0: (Default) results of an image / slice are written in a single row;"
+    " 1: results of an image / slice are written in a single column; 2: store the result of on image as structured radiomocs report (XML).");
+
+  // Miniapp Infos
+  parser.setCategory("Classification Tools");
+  parser.setTitle("Global Image Feature calculator");
+  parser.setDescription("Calculates different global statistics for a given segmentation / image combination");
+  parser.setContributor("German Cancer Research Center (DKFZ)");
+
+  std::map<std::string, us::Any> parsedArgs = parser.parseArguments(argc, argv);
+  param.ParseParameter(parsedArgs);
+
+  if (parsedArgs.size()==0)
+  {
+    return EXIT_FAILURE;
+  }
+  if ( parsedArgs.count("help") || parsedArgs.count("h"))
+  {
+    return EXIT_SUCCESS;
+  }
+
+  std::string version = "Version: 1.23";
+  MITK_INFO << version;
+
+  std::ofstream log;
+  if (param.useLogfile)
+  {
+    log.open(param.logfilePath, std::ios::app);
+    log << std::endl;
+    log << version;
+    log << "Image: " << param.imagePath;
+    log << "Mask: " << param.maskPath;
+  }
+
+
+  if (param.useDecimalPoint)
+  {
+    std::cout.imbue(std::locale(std::cout.getloc(), new punct_facet<char>(param.decimalPoint)));
+  }
+
+
+  int writeDirection = 0;
+  if (parsedArgs.count("output-mode"))
+  {
+    writeDirection = us::any_cast<int>(parsedArgs["output-mode"]);
+  }
+
   int direction = 0;
   if (parsedArgs.count("direction"))
   {
     direction = mitk::cl::splitDouble(parsedArgs["direction"].ToString(), ';')[0];
   }
 
-  MITK_INFO << "Start creating Mask without NaN";
+  bool addDescription = parsedArgs.count("description");
 
-  mitk::Image::Pointer maskNoNaN = mitk::Image::New();
-  AccessByItk_2(image, CreateNoNaNMask,  mask, maskNoNaN);
-  //CreateNoNaNMask(mask, image, maskNoNaN);
+  std::string description = "";
+  if (addDescription)
+  {
+    description = parsedArgs["description"].ToString();
+  }
+
+  if (param.useBatch)
+  {
+    if (parsedArgs.count("slice-wise") || !param.outputXMLPath.empty() || param.writePNGScreenshots || param.writeAnalysisImage || param.writeAnalysisMask)
+    {
+      MITK_ERROR << "Slice-wise processing, XML output and saving of images are not supported in batch mode";
+      return EXIT_FAILURE;
+    }
 
+    auto cases = ReadBatchManifest(param.batchPath, param.useMorphMask ? param.morphPath : "");
+    if (cases.empty())
+    {
+      MITK_ERROR << "No cases to process in batch manifest " << param.batchPath;
+      return EXIT_FAILURE;
+    }
+
+    mitk::cl::FeatureResultWriter writer(param.outputPath, writeDirection);
+    if (param.useDecimalPoint)
+    {
+      writer.SetDecimalPoint(param.decimalPoint);
+    }
+
+    log << " Begin Batch Processing -";
+    int returnCode = ProcessBatch(cases, param, parsedArgs, direction, writer, description, addDescription, log);
+
+    if (param.useLogfile)
+    {
+      log << "Finished calculation" << std::endl;
+      log.close();
+    }
+    return returnCode;
+  }
+
+  if (param.imagePath.empty() || param.maskPath.empty())
+  {
+    MITK_ERROR << "An image and a mask or a batch manifest have to be specified";
+    return EXIT_FAILURE;
+  }
+
+  mitk::Image::Pointer loadedImage;
+  mitk::Image::Pointer loadedMask;
+  mitk::Image::Pointer image;
+  mitk::Image::Pointer mask;
+  mitk::Image::Pointer morphMask;
+  mitk::Image::Pointer maskNoNaN;
+
+  if (!PrepareCase(param, param.imagePath, param.maskPath, param.useMorphMask ? param.morphPath : "",
+                   loadedImage, loadedMask, image, mask, morphMask, maskNoNaN, log))
+  {
+    return -1;
+  }
 
   bool sliceWise = false;
   int sliceDirection = 0;
@@ -582,29 +947,8 @@ int main(int argc, char* argv[])
   }
 
   log << " Configure features -";
-  for (auto cFeature : features)
-  {
-    if (param.defineGlobalMinimumIntensity)
-    {
-      cFeature->SetMinimumIntensity(param.globalMinimumIntensity);
-      cFeature->SetUseMinimumIntensity(true);
-    }
-    if (param.defineGlobalMaximumIntensity)
-    {
-      cFeature->SetMaximumIntensity(param.globalMaximumIntensity);
-      cFeature->SetUseMaximumIntensity(true);
-    }
-    if (param.defineGlobalNumberOfBins)
-    {
-      cFeature->SetBins(param.globalNumberOfBins);
-      MITK_INFO << param.globalNumberOfBins;
-    }
-    cFeature->SetParameters(parsedArgs);
-    cFeature->SetDirection(direction);
-    cFeature->SetEncodeParametersInFeaturePrefix(param.encodeParameter);
-  }
+  ConfigureFeatures(features, param, parsedArgs, direction);
 
-  bool addDescription = parsedArgs.count("description");
   mitk::cl::FeatureResultWriter writer(param.outputPath, writeDirection);
 
   if (param.useDecimalPoint)
@@ -612,12 +956,6 @@ int main(int argc, char* argv[])
     writer.SetDecimalPoint(param.decimalPoint);
   }
 
-  std::string description = "";
-  if (addDescription)
-  {
-    description = parsedArgs["description"].ToString();
-  }
-
   mitk::Image::Pointer cImage = image;
   mitk::Image::Pointer cMask = mask;
   mitk::Image::Pointer cMaskNoNaN = maskNoNaN;
@@ -639,6 +977,10 @@ int main(int argc, char* argv[])
 
   std::vector<mitk::AbstractGlobalImageFeature::FeatureListType> allStats;
 
+  mitk::GlobalImageFeatureExtractor extractor;
+  extractor.SetFeatures(features);
+  extractor.SetNumberOfThreads(param.numberOfThreads);
+
   log << " Begin Processing -";
   while (imageToProcess)
   {
@@ -668,13 +1010,23 @@ int main(int argc, char* argv[])
       mitk::IOUtil::Save(cMask, param.analysisMaskPath);
     }
 
-    mitk::AbstractGlobalImageFeature::FeatureListType stats;
-
     for (auto cFeature : features)
     {
-      log << " Calculating " << cFeature->GetFeatureClassName() << " -";
       cFeature->SetMorphMask(cMorphMask);
-      cFeature->CalculateAndAppendFeatures(cImage, cMask, cMaskNoNaN, stats, !param.calculateAllFeatures);
+    }
+
+    log << " Calculating features -";
+    auto stats = extractor.CalculateFeatures(cImage, cMask, cMaskNoNaN, !param.calculateAllFeatures);
+
+    if (param.reportTimings)
+    {
+      for (const auto& timing : extractor.GetTimings())
+      {
+        if (timing.Calculated)
+        {
+          std::cout << "Timing " << timing.FeatureClassName << " - " << timing.Milliseconds << " ms" << std::endl;
+        }
+      }
     }
 
     for (std::size_t i = 0; i < stats.size(); ++i)
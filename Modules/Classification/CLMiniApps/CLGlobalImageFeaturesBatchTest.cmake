@@ -0,0 +1,65 @@
+# Compares the output of CLGlobalImageFeatures in batch mode with the output of
+# single-case runs of the same cases.
+#
+# Usage: cmake -DAPP=<CLGlobalImageFeatures> -DDATA_DIR=<MITK-Data> -DOUTPUT_DIR=<dir>
+#              -P CLGlobalImageFeaturesBatchTest.cmake
+
+foreach(var APP DATA_DIR OUTPUT_DIR)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+set(small_image "${DATA_DIR}/Radiomics/IBSI_Phantom_Image_Small.nrrd")
+set(small_mask "${DATA_DIR}/Radiomics/IBSI_Phantom_Mask_Small.nrrd")
+set(large_image "${DATA_DIR}/Radiomics/IBSI_Phantom_Image_Large.nrrd")
+set(large_mask "${DATA_DIR}/Radiomics/IBSI_Phantom_Mask_Large.nrrd")
+
+set(features --first-order-numeric --volume)
+
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+set(manifest "${OUTPUT_DIR}/manifest.txt")
+set(batch_output "${OUTPUT_DIR}/batch.csv")
+set(single_output "${OUTPUT_DIR}/single.csv")
+file(REMOVE "${batch_output}" "${single_output}")
+
+# The first case uses the morphological mask given by --morph-mask, the second one its own
+file(WRITE "${manifest}" "# image;mask;morph-mask\n${small_image};${small_mask}\n${large_image};${large_mask};${large_mask}\n")
+
+execute_process(
+  COMMAND "${APP}" --batch "${manifest}" --morph-mask "${small_mask}" -o "${batch_output}" ${features}
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Batch run failed: ${result}")
+endif()
+
+execute_process(
+  COMMAND "${APP}" -i "${small_image}" -m "${small_mask}" --morph-mask "${small_mask}" -o "${single_output}" ${features}
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Single run of the first case failed: ${result}")
+endif()
+
+execute_process(
+  COMMAND "${APP}" -i "${large_image}" -m "${large_mask}" --morph-mask "${large_mask}" -o "${single_output}" ${features}
+  RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "Single run of the second case failed: ${result}")
+endif()
+
+file(STRINGS "${batch_output}" batch_rows)
+file(STRINGS "${single_output}" single_rows)
+
+list(LENGTH batch_rows batch_row_count)
+list(LENGTH single_rows single_row_count)
+if(NOT batch_row_count EQUAL 2 OR NOT single_row_count EQUAL 2)
+  message(FATAL_ERROR "Expected two rows, got ${batch_row_count} in batch mode and ${single_row_count} in single-case mode")
+endif()
+
+foreach(i RANGE 1)
+  list(GET batch_rows ${i} batch_row)
+  list(GET single_rows ${i} single_row)
+  if(NOT batch_row STREQUAL single_row)
+    message(FATAL_ERROR "Row ${i} differs:\n  batch:  ${batch_row}\n  single: ${single_row}")
+  endif()
+endforeach()
@@ -28,6 +28,7 @@ set(CPP_FILES
   GlobalImageFeatures/mitkGIFIntensityVolumeHistogramFeatures.cpp
   GlobalImageFeatures/mitkGIFNeighbourhoodGreyToneDifferenceFeatures.cpp
   GlobalImageFeatures/mitkGIFCurvatureStatistic.cpp
+  GlobalImageFeatures/mitkGlobalImageFeatureExtractor.cpp
 
   MiniAppUtils/mitkGlobalImageFeaturesParameter.cpp
   MiniAppUtils/mitkSplitParameterToVector.cpp
@@ -0,0 +1,79 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkGlobalImageFeatureExtractor_h
+#define mitkGlobalImageFeatureExtractor_h
+
+#include <MitkCLUtilitiesExports.h>
+
+#include <mitkAbstractGlobalImageFeature.h>
+
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Calculates a set of feature classes for an image / mask pair.
+  *
+  * All feature classes share one IntensityRangeCache for the image / mask pair, so that the intensity
+  * range required to initialize their quantifiers is determined only once, and feature classes with the same
+  * quantifier settings share one quantifier. The remaining state, e.g. the casted mask or the quantized
+  * matrices, depends on the feature class and is not shared. Independent feature classes are
+  * calculated concurrently. The resulting feature list has the same order as if the feature classes were
+  * calculated one after another in the order in which they were passed to SetFeatures().
+  *
+  * The wall-clock time spent in each feature class is available via GetTimings() after the calculation.
+  */
+  class MITKCLUTILITIES_EXPORT GlobalImageFeatureExtractor
+  {
+  public:
+    using FeatureListType = AbstractGlobalImageFeature::FeatureListType;
+    using FeatureVectorType = std::vector<AbstractGlobalImageFeature::Pointer>;
+
+    struct FeatureTiming
+    {
+      std::string FeatureClassName;
+      double Milliseconds = 0.0;
+      bool Calculated = false; // false if the feature class is not activated in its parameters
+    };
+
+    using TimingListType = std::vector<FeatureTiming>;
+
+    GlobalImageFeatureExtractor();
+
+    void SetFeatures(const FeatureVectorType& features);
+    const FeatureVectorType& GetFeatures() const;
+
+    /** \brief Maximum number of feature classes that are calculated concurrently (default: 0).
+    * 0 uses the number of hardware threads, 1 calculates all feature classes one after another.
+    */
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** \brief Calculate all feature classes.
+    * \param checkParameterActivation Only calculate feature classes that are activated in their parameters
+    * (see AbstractGlobalImageFeature::CalculateAndAppendFeatures()).
+    * \throw The first exception thrown by a feature class, in the order of the feature classes.
+    */
+    FeatureListType CalculateFeatures(const Image* image, const Image* mask, const Image* maskNoNaN, bool checkParameterActivation = true);
+
+    const TimingListType& GetTimings() const;
+
+  private:
+    FeatureVectorType m_Features;
+    unsigned int m_NumberOfThreads;
+    TimingListType m_Timings;
+  };
+}
+
+#endif
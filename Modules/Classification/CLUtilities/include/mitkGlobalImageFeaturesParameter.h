@@ -37,6 +37,9 @@ namespace mitk
       std::string outputPath;
       std::string outputXMLPath;
 
+      bool useBatch;
+      std::string batchPath;
+
       std::string morphPath;
       std::string morphName;
       bool useMorphMask;
@@ -70,6 +73,8 @@ namespace mitk
       bool encodeParameter;
       std::string pipelineUID;
       bool calculateAllFeatures;
+      unsigned int numberOfThreads;
+      bool reportTimings;
 
     private:
       void ParseFileLocations(std::map<std::string, us::Any> &parsedArgs);
@@ -19,12 +19,13 @@ found in the LICENSE file.
 
 // ITK
 #include <itkEnhancedScalarImageToTextureFeaturesFilter.h>
-#include <itkShapedNeighborhoodIterator.h>
-#include <itkImageRegionConstIterator.h>
+#include <itkNeighborhood.h>
 
 // STL
+#include <algorithm>
 #include <sstream>
 #include <cmath>
+#include <vector>
 
 namespace mitk
 {
@@ -211,51 +212,99 @@ double mitk::CoocurenceMatrixHolder::IndexToMaxIntensity(int index)
 
 template<typename TPixel, unsigned int VImageDimension>
 void
-CalculateCoOcMatrix(const itk::Image<TPixel, VImageDimension>* itkImage,
-                    const itk::Image<unsigned short, VImageDimension>* mask,
+QuantizeImage(const itk::Image<TPixel, VImageDimension>* itkImage,
+              const itk::Image<unsigned short, VImageDimension>* mask,
+              mitk::CoocurenceMatrixHolder &holder,
+              std::vector<int> &binIndices)
+{
+  // Bin index of every voxel, -1 for voxels outside of the mask or with NaN intensity.
+  // Computed once and shared by all directions.
+  const auto region = mask->GetLargestPossibleRegion();
+  const auto lineLength = region.GetSize(0);
+  const int numberOfLines = static_cast<int>(region.GetNumberOfPixels() / lineLength);
+  const TPixel* imageBuffer = itkImage->GetBufferPointer();
+  const unsigned short* maskBuffer = mask->GetBufferPointer();
+
+  binIndices.resize(region.GetNumberOfPixels());
+
+#pragma omp parallel for
+  for (int line = 0; line < numberOfLines; ++line)
+  {
+    const std::size_t lineStart = static_cast<std::size_t>(line) * lineLength;
+    for (std::size_t x = lineStart; x < lineStart + lineLength; ++x)
+    {
+      const TPixel value = imageBuffer[x];
+      binIndices[x] = (maskBuffer[x] > 0 && value == value)
+        ? holder.IntensityToIndex(value)
+        : -1;
+    }
+  }
+}
+
+template<unsigned int VImageDimension>
+void
+CalculateCoOcMatrix(const std::vector<int> &binIndices,
+                    const itk::Size<VImageDimension> &size,
                     itk::Offset<VImageDimension> offset,
-                    int range,
                     mitk::CoocurenceMatrixHolder &holder)
 {
-  typedef itk::Image<TPixel, VImageDimension> ImageType;
-  typedef itk::Image<unsigned short, VImageDimension> MaskImageType;
-  typedef itk::ShapedNeighborhoodIterator<ImageType> ShapeIterType;
-  typedef itk::ShapedNeighborhoodIterator<MaskImageType> ShapeMaskIterType;
-  typedef itk::ImageRegionConstIterator<ImageType> ConstIterType;
-  typedef itk::ImageRegionConstIterator<MaskImageType> ConstMaskIterType;
-
-
-  itk::Size<VImageDimension> radius;
-  radius.Fill(range+1);
-  ShapeIterType imageOffsetIter(radius, itkImage, itkImage->GetLargestPossibleRegion());
-  ShapeMaskIterType maskOffsetIter(radius, mask, mask->GetLargestPossibleRegion());
-  imageOffsetIter.ActivateOffset(offset);
-  maskOffsetIter.ActivateOffset(offset);
-  ConstIterType imageIter(itkImage, itkImage->GetLargestPossibleRegion());
-  ConstMaskIterType maskIter(mask, mask->GetLargestPossibleRegion());
-  //  iterator.GetIndex() + ci.GetNeighborhoodOffset()
-  auto region = mask->GetLargestPossibleRegion();
-
-
-  while (!maskIter.IsAtEnd())
+  // Image lines along the first dimension are distributed over the threads. Each thread
+  // accumulates its own matrix, which are summed up afterwards.
+  long long offsetStride = 0;
+  long long stride = 1;
+  for (unsigned int d = 0; d < VImageDimension; ++d)
+  {
+    offsetStride += offset[d] * stride;
+    stride *= size[d];
+  }
+
+  const long long lineLength = size[0];
+  const int numberOfLines = static_cast<int>(binIndices.size() / size[0]);
+  const long long firstX = std::max<long long>(0, -offset[0]);
+  const long long lastX = std::min<long long>(lineLength, lineLength - offset[0]);
+  const int numberOfBins = holder.m_NumberOfBins;
+
+#pragma omp parallel
   {
-    auto ciMask = maskOffsetIter.Begin();
-    auto ciValue = imageOffsetIter.Begin();
-    if (maskIter.Value() > 0 &&
-      ciMask.Get() > 0 &&
-      imageIter.Get() == imageIter.Get() &&
-      ciValue.Get() == ciValue.Get() &&
-      region.IsInside(maskOffsetIter.GetIndex() + ciMask.GetNeighborhoodOffset()))
+    Eigen::MatrixXd localMatrix = Eigen::MatrixXd::Zero(numberOfBins, numberOfBins);
+
+#pragma omp for
+    for (int line = 0; line < numberOfLines; ++line)
     {
-      int i = holder.IntensityToIndex(imageIter.Get());
-      int j = holder.IntensityToIndex(ciValue.Get());
-      holder.m_Matrix(i, j) += 1;
-      holder.m_Matrix(j, i) += 1;
+      // Skip lines whose neighbour line lies outside of the image
+      bool isInside = true;
+      long long remainder = line;
+      for (unsigned int d = 1; d < VImageDimension; ++d)
+      {
+        const long long dimensionSize = size[d];
+        const long long neighbourIndex = remainder % dimensionSize + offset[d];
+        remainder /= dimensionSize;
+        if (neighbourIndex < 0 || neighbourIndex >= dimensionSize)
+        {
+          isInside = false;
+          break;
+        }
+      }
+      if (!isInside)
+      {
+        continue;
+      }
+
+      const long long lineStart = line * lineLength;
+      for (long long x = lineStart + firstX; x < lineStart + lastX; ++x)
+      {
+        const int i = binIndices[x];
+        const int j = binIndices[x + offsetStride];
+        if (i >= 0 && j >= 0)
+        {
+          localMatrix(i, j) += 1;
+          localMatrix(j, i) += 1;
+        }
+      }
     }
-    ++imageOffsetIter;
-    ++maskOffsetIter;
-    ++imageIter;
-    ++maskIter;
+
+#pragma omp critical
+    holder.m_Matrix += localMatrix;
   }
 }
 
@@ -264,85 +313,75 @@ void CalculateFeatures(
   mitk::CoocurenceMatrixFeatures & results
   )
 {
-  auto pijMatrix = holder.m_Matrix;
-  auto piMatrix = holder.m_Matrix;
-  auto pjMatrix = holder.m_Matrix;
   double Ng = holder.m_NumberOfBins;
   int NgSize = holder.m_NumberOfBins;
-  pijMatrix /= pijMatrix.sum();
-  piMatrix.rowwise().normalize();
-  pjMatrix.colwise().normalize();
+  const double log2 = std::log(2);
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
-    {
-      if (pijMatrix(i, j) != pijMatrix(i, j))
-        pijMatrix(i, j) = 0;
-      if (piMatrix(i, j) != piMatrix(i, j))
-        piMatrix(i, j) = 0;
-      if (pjMatrix(i, j) != pjMatrix(i, j))
-        pjMatrix(i, j) = 0;
-    }
-
-  Eigen::VectorXd piVector = pijMatrix.colwise().sum();
-  Eigen::VectorXd pjVector = pijMatrix.rowwise().sum();
-  double sigmai = 0;;
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
+  Eigen::MatrixXd pijMatrix = holder.m_Matrix;
+  const double totalCount = pijMatrix.sum();
+  if (totalCount > 0)
   {
-    double iInt = i + 1;// holder.IndexToMeanIntensity(i);
-    results.RowAverage += iInt * piVector(i);
-    if (piVector(i) > 0)
-    {
-      results.RowEntropy -= piVector(i) * std::log(piVector(i)) / std::log(2);
-    }
+    pijMatrix /= totalCount;
   }
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
+  else
   {
-    double iInt = i + 1; // holder.IndexToMeanIntensity(i);
-    results.RowVariance += (iInt - results.RowAverage)*(iInt - results.RowAverage) * piVector(i);
+    pijMatrix.setZero();
   }
+
+  // Intensities are represented by the (one-based) bin index
+  const Eigen::ArrayXd intensities = Eigen::ArrayXd::LinSpaced(NgSize, 1, NgSize);
+  const Eigen::ArrayXd piVector = pijMatrix.colwise().sum().transpose().array();
+  const Eigen::ArrayXd pjVector = pijMatrix.rowwise().sum().array();
+  const Eigen::ArrayXd piLogPi = (piVector > 0).select(piVector * piVector.log(), 0.0);
+  const Eigen::ArrayXd pjLogPj = (pjVector > 0).select(pjVector * pjVector.log(), 0.0);
+
+  results.RowAverage = (intensities * piVector).sum();
+  results.RowEntropy = -piLogPi.sum() / log2;
+  results.RowVariance = ((intensities - results.RowAverage).square() * piVector).sum();
   results.RowMaximum = piVector.maxCoeff();
-  sigmai = std::sqrt(results.RowVariance);
+  double sigmai = std::sqrt(results.RowVariance);
 
-  Eigen::VectorXd pimj(NgSize);
+  // Sum over all i, k of p_i p_k log(p_i p_k), separated into the marginal sums
+  results.SecondRowColumnEntropy = -(pjVector.sum() * piLogPi.sum() + piVector.sum() * pjLogPj.sum()) / log2;
+
+  Eigen::ArrayXd pimj(NgSize);
   pimj.fill(0);
-  Eigen::VectorXd pipj(2*NgSize);
+  Eigen::ArrayXd pipj(2*NgSize);
   pipj.fill(0);
 
-
   results.JointMaximum += pijMatrix.maxCoeff();
+  results.JointAverage = (intensities * pjVector).sum();
+  results.JointVariance = ((intensities - results.JointAverage).square() * pjVector).sum();
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
+  // The matrix is sparse for high numbers of bins. All remaining sums vanish for p_{i,k} = 0,
+  // so only the non-zero entries are visited.
+  for (int j = 0; j < NgSize; ++j)
   {
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
+    for (int i = 0; i < NgSize; ++i)
     {
-      //double iInt = holder.IndexToMeanIntensity(i);
-      //double jInt = holder.IndexToMeanIntensity(j);
+      double pij = pijMatrix(i, j);
+      if (pij <= 0)
+      {
+        continue;
+      }
+
       double iInt = i + 1;// holder.IndexToMeanIntensity(i);
       double jInt = j + 1;// holder.IndexToMeanIntensity(j);
-      double pij = pijMatrix(i, j);
+      double difference = std::abs<double>(iInt - jInt);
+      double squaredDifference = difference * difference;
 
-      int deltaK = (i - j)>0?(i-j) : (j-i);
-      pimj(deltaK) += pij;
+      pimj(std::abs(i - j)) += pij;
       pipj(i + j) += pij;
 
-      results.JointAverage += iInt * pij;
-      if (pij > 0)
-      {
-        results.JointEntropy -= pij * std::log(pij) / std::log(2);
-        results.FirstRowColumnEntropy -= pij * std::log(piVector(i)*pjVector(j)) / std::log(2);
-      }
-      if (piVector(i) > 0 && pjVector(j) > 0 )
-      {
-        results.SecondRowColumnEntropy -= piVector(i)*pjVector(j) * std::log(piVector(i)*pjVector(j)) / std::log(2);
-      }
+      results.JointEntropy -= pij * std::log(pij) / log2;
+      results.FirstRowColumnEntropy -= pij * std::log(piVector(i)*pjVector(j)) / log2;
       results.AngularSecondMoment += pij*pij;
-      results.Contrast += (iInt - jInt)* (iInt - jInt) * pij;
-      results.Dissimilarity += std::abs<double>(iInt - jInt) * pij;
-      results.InverseDifference += pij / (1 + (std::abs<double>(iInt - jInt)));
-      results.InverseDifferenceNormalised += pij / (1 + (std::abs<double>(iInt - jInt) / Ng));
-      results.InverseDifferenceMoment += pij / (1 + (iInt - jInt)*(iInt - jInt));
-      results.InverseDifferenceMomentNormalised += pij / (1 + (iInt - jInt)*(iInt - jInt)/Ng/Ng);
+      results.Contrast += squaredDifference * pij;
+      results.Dissimilarity += difference * pij;
+      results.InverseDifference += pij / (1 + difference);
+      results.InverseDifferenceNormalised += pij / (1 + difference / Ng);
+      results.InverseDifferenceMoment += pij / (1 + squaredDifference);
+      results.InverseDifferenceMomentNormalised += pij / (1 + squaredDifference/Ng/Ng);
       results.Autocorrelation += iInt*jInt * pij;
       double cluster = (iInt + jInt - 2 * results.RowAverage);
       results.ClusterTendency += cluster*cluster * pij;
@@ -350,7 +389,7 @@ void CalculateFeatures(
       results.ClusterProminence += cluster*cluster*cluster*cluster * pij;
       if (iInt != jInt)
       {
-        results.InverseVariance += pij / (iInt - jInt) / (iInt - jInt);
+        results.InverseVariance += pij / squaredDifference;
       }
     }
   }
@@ -365,58 +404,15 @@ void CalculateFeatures(
     results.SecondMeasureOfInformationCorrelation = 0;
   }
 
-  for (int i = 0; i < holder.m_NumberOfBins; ++i)
-  {
-    for (int j = 0; j < holder.m_NumberOfBins; ++j)
-    {
-      //double iInt = holder.IndexToMeanIntensity(i);
-      //double jInt = holder.IndexToMeanIntensity(j);
-      double iInt = i + 1;
-      double pij = pijMatrix(i, j);
-
-      results.JointVariance += (iInt - results.JointAverage)* (iInt - results.JointAverage)*pij;
-    }
-  }
-
-  for (int k = 0; k < NgSize; ++k)
-  {
-    results.DifferenceAverage += k* pimj(k);
-    if (pimj(k) > 0)
-    {
-      results.DifferenceEntropy -= pimj(k) * log(pimj(k)) / std::log(2);
-    }
-  }
-  for (int k = 0; k < NgSize; ++k)
-  {
-    results.DifferenceVariance += (results.DifferenceAverage-k)* (results.DifferenceAverage-k)*pimj(k);
-  }
-
-
-  for (int k = 0; k <2* NgSize ; ++k)
-  {
-    results.SumAverage += (2+k)* pipj(k);
-    if (pipj(k) > 0)
-    {
-      results.SumEntropy -= pipj(k) * log(pipj(k)) / std::log(2);
-    }
-  }
-  for (int k = 0; k < 2*NgSize; ++k)
-  {
-    results.SumVariance += (2+k - results.SumAverage)* (2+k - results.SumAverage)*pipj(k);
-  }
-
-  //MITK_INFO << std::endl << holder.m_Matrix;
-  //MITK_INFO << std::endl << pijMatrix;
-  //MITK_INFO << std::endl << piMatrix;
-  //MITK_INFO << std::endl << pjMatrix;
-
-  //for (int i = 0; i < holder.m_NumberOfBins; ++i)
-  //{
-  //  MITK_INFO << "Bin " << i << " Min: " << holder.IndexToMinIntensity(i) << " Max: " << holder.IndexToMaxIntensity(i);
-  //}
-  //MITK_INFO << pimj;
-  //MITK_INFO << pipj;
+  const Eigen::ArrayXd differences = Eigen::ArrayXd::LinSpaced(NgSize, 0, NgSize - 1);
+  results.DifferenceAverage = (differences * pimj).sum();
+  results.DifferenceEntropy = -(pimj > 0).select(pimj * pimj.log(), 0.0).sum() / log2;
+  results.DifferenceVariance = ((results.DifferenceAverage - differences).square() * pimj).sum();
 
+  const Eigen::ArrayXd sums = Eigen::ArrayXd::LinSpaced(2 * NgSize, 2, 2 * NgSize + 1);
+  results.SumAverage = (sums * pipj).sum();
+  results.SumEntropy = -(pipj > 0).select(pipj * pipj.log(), 0.0).sum() / log2;
+  results.SumVariance = ((sums - results.SumAverage).square() * pipj).sum();
 }
 
 template<typename TPixel, unsigned int VImageDimension>
@@ -466,9 +462,14 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
     offset[2] = 1;
   }
 
-  std::vector<mitk::CoocurenceMatrixFeatures> resultVector;
   mitk::CoocurenceMatrixHolder holderOverall(rangeMin, rangeMax, numberOfBins);
   mitk::CoocurenceMatrixFeatures overallFeature;
+
+  std::vector<int> binIndices;
+  QuantizeImage<TPixel, VImageDimension>(itkImage, maskImage, holderOverall, binIndices);
+  const auto size = maskImage->GetLargestPossibleRegion().GetSize();
+
+  std::vector<mitk::CoocurenceMatrixHolder> holders;
   for (std::size_t i = 0; i < offsetVector.size(); ++i)
   {
     if (config.direction > 1)
@@ -479,14 +480,18 @@ CalculateCoocurenceFeatures(const itk::Image<TPixel, VImageDimension>* itkImage,
       }
     }
 
-
     offset = offsetVector[i];
     mitk::CoocurenceMatrixHolder holder(rangeMin, rangeMax, numberOfBins);
-    mitk::CoocurenceMatrixFeatures coocResults;
-    CalculateCoOcMatrix<TPixel, VImageDimension>(itkImage, maskImage, offset, config.range, holder);
+    CalculateCoOcMatrix<VImageDimension>(binIndices, size, offset, holder);
     holderOverall.m_Matrix += holder.m_Matrix;
-    CalculateFeatures(holder, coocResults);
-    resultVector.push_back(coocResults);
+    holders.push_back(holder);
+  }
+
+  std::vector<mitk::CoocurenceMatrixFeatures> resultVector(holders.size());
+#pragma omp parallel for
+  for (int i = 0; i < static_cast<int>(holders.size()); ++i)
+  {
+    CalculateFeatures(holders[i], resultVector[i]);
   }
   CalculateFeatures(holderOverall, overallFeature);
   //NormalizeMatrixFeature(overallFeature, offsetVector.size());
@@ -0,0 +1,122 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGlobalImageFeatureExtractor.h>
+
+#include <mitkIntensityRangeCache.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+mitk::GlobalImageFeatureExtractor::GlobalImageFeatureExtractor()
+  : m_NumberOfThreads(0)
+{
+}
+
+void mitk::GlobalImageFeatureExtractor::SetFeatures(const FeatureVectorType& features)
+{
+  m_Features = features;
+}
+
+const mitk::GlobalImageFeatureExtractor::FeatureVectorType& mitk::GlobalImageFeatureExtractor::GetFeatures() const
+{
+  return m_Features;
+}
+
+void mitk::GlobalImageFeatureExtractor::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::GlobalImageFeatureExtractor::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+const mitk::GlobalImageFeatureExtractor::TimingListType& mitk::GlobalImageFeatureExtractor::GetTimings() const
+{
+  return m_Timings;
+}
+
+mitk::GlobalImageFeatureExtractor::FeatureListType mitk::GlobalImageFeatureExtractor::CalculateFeatures(const Image* image, const Image* mask, const Image* maskNoNaN, bool checkParameterActivation)
+{
+  const auto numberOfFeatures = m_Features.size();
+
+  auto rangeCache = IntensityRangeCache::New();
+
+  for (auto& feature : m_Features)
+    feature->SetIntensityRangeCache(rangeCache);
+
+  std::vector<FeatureListType> results(numberOfFeatures);
+  std::vector<std::exception_ptr> exceptions(numberOfFeatures);
+  m_Timings.assign(numberOfFeatures, FeatureTiming());
+
+  std::atomic_size_t nextFeature(0);
+
+  auto worker = [&]()
+  {
+    for (auto i = nextFeature++; i < numberOfFeatures; i = nextFeature++)
+    {
+      auto& feature = m_Features[i];
+      m_Timings[i].FeatureClassName = feature->GetFeatureClassName();
+
+      const auto start = std::chrono::steady_clock::now();
+
+      try
+      {
+        feature->CalculateAndAppendFeatures(image, mask, maskNoNaN, results[i], checkParameterActivation);
+      }
+      catch (...)
+      {
+        exceptions[i] = std::current_exception();
+      }
+
+      m_Timings[i].Milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      m_Timings[i].Calculated = !checkParameterActivation || 0 != feature->GetParameters().count(feature->GetLongName());
+    }
+  };
+
+  unsigned int numberOfThreads = 0 != m_NumberOfThreads
+    ? m_NumberOfThreads
+    : std::max(1u, std::thread::hardware_concurrency());
+
+  numberOfThreads = static_cast<unsigned int>(std::min<std::size_t>(numberOfThreads, numberOfFeatures));
+
+  std::vector<std::thread> threads;
+
+  for (unsigned int i = 1; i < numberOfThreads; ++i)
+    threads.emplace_back(worker);
+
+  worker();
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto& feature : m_Features)
+    feature->SetIntensityRangeCache(nullptr);
+
+  for (const auto& exception : exceptions)
+  {
+    if (nullptr != exception)
+      std::rethrow_exception(exception);
+  }
+
+  FeatureListType featureList;
+
+  for (auto& result : results)
+    featureList.insert(featureList.end(), result.begin(), result.end());
+
+  return featureList;
+}
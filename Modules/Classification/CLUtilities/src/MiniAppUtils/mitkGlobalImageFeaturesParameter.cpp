@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include <mitkGlobalImageFeaturesParameter.h>
 
 
+#include <algorithm>
 #include <fstream>
 #include <itkFileTools.h>
 #include <itksys/SystemTools.hxx>
@@ -30,8 +31,9 @@ static bool fileExists(const std::string& filename)
 void mitk::cl::GlobalImageFeaturesParameter::AddParameter(mitkCommandLineParser &parser)
 {
   // Required Parameter
-  parser.addArgument("image",   "i", mitkCommandLineParser::Image, "Input Image", "Path to the input image file", us::Any(), false, false, false, mitkCommandLineParser::Input);
-  parser.addArgument("mask", "m", mitkCommandLineParser::Image, "Input Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1)", us::Any(), false, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("image",   "i", mitkCommandLineParser::Image, "Input Image", "Path to the input image file. Required if no batch manifest is given.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("mask", "m", mitkCommandLineParser::Image, "Input Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1). Required if no batch manifest is given.", us::Any(), true, false, false, mitkCommandLineParser::Input);
+  parser.addArgument("batch", "batch", mitkCommandLineParser::File, "Batch manifest", "Path to a text file with one case per line, given as 'image;mask' or 'image;mask;morph-mask'. Cases without a morphological mask use the one given by --morph-mask, if any. All cases are processed concurrently and written to the output file.", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("morph-mask", "morph", mitkCommandLineParser::Image, "Morphological Image Mask", "Path to the mask Image that specifies the area over for the statistic (Values = 1)", us::Any(), true, false, false, mitkCommandLineParser::Input);
   parser.addArgument("output",  "o", mitkCommandLineParser::File, "Output text file", "Path to output file. The output statistic is appended to this file.", us::Any(), false, false, false, mitkCommandLineParser::Output);
 
@@ -58,6 +60,8 @@ void mitk::cl::GlobalImageFeaturesParameter::AddParameter(mitkCommandLineParser
   parser.addArgument("encode-parameter-in-name", "encode-parameter", mitkCommandLineParser::Bool, "Bool", "If true, the parameters used for each feature is encoded in its name.", us::Any());
   parser.addArgument("pipeline-uid", "p", mitkCommandLineParser::String, "Pipeline UID", "UID that is stored in the XML output and identifies the processing pipeline the app is used in.", us::Any());
   parser.addArgument("all-features", "a", mitkCommandLineParser::Bool, "Calculate all features", "If true, all features will be calculated and the feature specific activation will be ignored.", us::Any());
+  parser.addArgument("threads", "threads", mitkCommandLineParser::Int, "Int", "Maximum number of feature classes (or cases in batch mode) that are calculated concurrently. 0 (default) uses all hardware threads.", us::Any());
+  parser.addArgument("report-timings", "report-timings", mitkCommandLineParser::Bool, "Bool", "If true, the time spent in each feature class is reported.", us::Any());
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseParameter(std::map<std::string, us::Any> parsedArgs)
@@ -75,10 +79,26 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseFileLocations(std::map<std::st
   //
   // Read input and output file informations
   //
-  imagePath = parsedArgs["image"].ToString();
-  maskPath = parsedArgs["mask"].ToString();
+  imagePath = "";
+  if (parsedArgs.count("image"))
+  {
+    imagePath = parsedArgs["image"].ToString();
+  }
+  maskPath = "";
+  if (parsedArgs.count("mask"))
+  {
+    maskPath = parsedArgs["mask"].ToString();
+  }
   outputPath = parsedArgs["output"].ToString();
 
+  useBatch = false;
+  batchPath = "";
+  if (parsedArgs.count("batch"))
+  {
+    useBatch = true;
+    batchPath = parsedArgs["batch"].ToString();
+  }
+
   imageFolder = itksys::SystemTools::GetFilenamePath(imagePath);
   imageName = itksys::SystemTools::GetFilenameName(imagePath);
   maskFolder = itksys::SystemTools::GetFilenamePath(maskPath);
@@ -153,6 +173,14 @@ void mitk::cl::GlobalImageFeaturesParameter::ParseAdditionalOutputs(std::map<std
   }
 
   calculateAllFeatures = parsedArgs.count("all-features");
+
+  numberOfThreads = 0;
+  if (parsedArgs.count("threads"))
+  {
+    numberOfThreads = std::max(0, us::any_cast<int>(parsedArgs["threads"]));
+  }
+
+  reportTimings = parsedArgs.count("report-timings");
 }
 
 void mitk::cl::GlobalImageFeaturesParameter::ParseHeaderInformation(std::map<std::string, us::Any> &parsedArgs)
@@ -182,3 +182,20 @@ void mitk::cl::FeatureResultWriter::AddHeader(std::string, int slice, mitk::Abst
     NewRow("EndOfMeasurement");
   }
 }
+
+void mitk::cl::FeatureResultWriter::Flush()
+{
+  if ((m_Mode != 0) && (m_Mode != 2))
+  {
+    return;
+  }
+
+  for (std::size_t i = 0; i < m_CurrentRow; ++i)
+  {
+    m_Output << m_List[i] << std::endl;
+  }
+  m_Output.flush();
+
+  m_List.erase(m_List.begin(), m_List.begin() + m_CurrentRow);
+  m_CurrentRow = 0;
+}
@@ -13,6 +13,7 @@ set(MODULE_TESTS
   mitkGIFNeighbouringGreyLevelDependenceFeatureTest.cpp
   mitkGIFVolumetricDensityStatisticsTest.cpp
   mitkGIFVolumetricStatisticsTest.cpp
+  mitkGlobalImageFeatureExtractorTest.cpp
   #mitkSmoothedClassProbabilitesTest.cpp
   #mitkGlobalFeaturesTest.cpp
 )
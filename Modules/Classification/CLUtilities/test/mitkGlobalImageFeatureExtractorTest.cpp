@@ -0,0 +1,110 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+#include "mitkIOUtil.h"
+
+#include <mitkGIFCooccurenceMatrix2.h>
+#include <mitkGIFFirstOrderStatistics.h>
+#include <mitkGIFGreyLevelSizeZone.h>
+#include <mitkGlobalImageFeatureExtractor.h>
+
+class mitkGlobalImageFeatureExtractorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGlobalImageFeatureExtractorTestSuite);
+
+  MITK_TEST(CalculateFeatures_Serial_EqualsSingleFeatures);
+  MITK_TEST(CalculateFeatures_Concurrent_EqualsSingleFeatures);
+
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_IBSI_Phantom_Image_Large;
+  mitk::Image::Pointer m_IBSI_Phantom_Mask_Large;
+
+  mitk::GlobalImageFeatureExtractor::FeatureVectorType CreateFeatures()
+  {
+    mitk::GlobalImageFeatureExtractor::FeatureVectorType features;
+    features.push_back(mitk::GIFFirstOrderStatistics::New().GetPointer());
+    features.push_back(mitk::GIFCooccurenceMatrix2::New().GetPointer());
+    features.push_back(mitk::GIFGreyLevelSizeZone::New().GetPointer());
+
+    for (auto& feature : features)
+    {
+      feature->SetUseBins(true);
+      feature->SetBins(6);
+    }
+
+    return features;
+  }
+
+  void CheckFeatures(unsigned int numberOfThreads)
+  {
+    mitk::AbstractGlobalImageFeature::FeatureListType expected;
+
+    for (auto& feature : this->CreateFeatures())
+    {
+      feature->CalculateAndAppendFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, expected, false);
+    }
+
+    mitk::GlobalImageFeatureExtractor extractor;
+    extractor.SetFeatures(this->CreateFeatures());
+    extractor.SetNumberOfThreads(numberOfThreads);
+
+    auto featureList = extractor.CalculateFeatures(m_IBSI_Phantom_Image_Large, m_IBSI_Phantom_Mask_Large, m_IBSI_Phantom_Mask_Large, false);
+
+    CPPUNIT_ASSERT_EQUAL(expected.size(), featureList.size());
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      CPPUNIT_ASSERT_EQUAL(expected[i].first.legacyName, featureList[i].first.legacyName);
+
+      if (expected[i].second == expected[i].second) // not NaN
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(expected[i].first.legacyName, expected[i].second, featureList[i].second, 1e-9);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), extractor.GetTimings().size());
+
+    for (const auto& timing : extractor.GetTimings())
+    {
+      CPPUNIT_ASSERT(timing.Calculated);
+      CPPUNIT_ASSERT(timing.Milliseconds >= 0.0);
+    }
+
+    // All feature classes use the same quantifier settings
+    const auto& features = extractor.GetFeatures();
+    CPPUNIT_ASSERT(features[0]->GetQuantifier().IsNotNull());
+    CPPUNIT_ASSERT(features[0]->GetQuantifier() == features[1]->GetQuantifier());
+    CPPUNIT_ASSERT(features[0]->GetQuantifier() == features[2]->GetQuantifier());
+  }
+
+public:
+
+  void setUp(void) override
+  {
+    m_IBSI_Phantom_Image_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Image_Large.nrrd"));
+    m_IBSI_Phantom_Mask_Large = mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("Radiomics/IBSI_Phantom_Mask_Large.nrrd"));
+  }
+
+  void CalculateFeatures_Serial_EqualsSingleFeatures()
+  {
+    this->CheckFeatures(1);
+  }
+
+  void CalculateFeatures_Concurrent_EqualsSingleFeatures()
+  {
+    this->CheckFeatures(3);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGlobalImageFeatureExtractor)
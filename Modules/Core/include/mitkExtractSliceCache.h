@@ -0,0 +1,130 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkExtractSliceCache_h
+#define mitkExtractSliceCache_h
+
+#include <MitkCoreExports.h>
+
+#include <itkIntTypes.h>
+
+#include <vtkImageData.h>
+#include <vtkSmartPointer.h>
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace mitk
+{
+  /**
+  \brief Process-wide, memory-capped cache of slices resliced by ExtractSliceFilter.
+
+  Multiple render windows and mappers frequently request the very same slice of an image, e.g. in
+  multi-widget layouts. The cache stores resliced vtkImageData objects keyed on everything that
+  determines the result of vtkImageReslice: the identity and modified time of the input, the time step,
+  the reslice axes, the reslice transform, the output extent and spacing, the interpolation mode and
+  the background level.
+
+  Since modified times are unique, modified inputs never produce false hits. Pixel data must however be
+  marked as modified (Image::Modified()) after being changed, which is required for rendering anyway.
+
+  Least recently used slices are evicted once the memory occupied by all cached slices exceeds
+  GetMaximumMemory(). All methods are thread-safe.
+
+  \sa ExtractSliceFilter::SetUseSliceCache()
+  */
+  class MITKCORE_EXPORT ExtractSliceCache
+  {
+  public:
+    struct MITKCORE_EXPORT Key
+    {
+      const void *Input = nullptr;
+      itk::ModifiedTimeType InputMTime = 0;
+      unsigned int TimeStep = 0;
+      int InterpolationMode = 0;
+      std::array<double, 16> ResliceAxes = {};
+      std::array<double, 16> ResliceTransform = {}; // All zero if no reslice transform is used
+      std::array<int, 6> OutputExtent = {};
+      std::array<double, 3> OutputSpacing = {};
+      double BackgroundLevel = 0.0;
+
+      bool operator==(const Key &other) const;
+    };
+
+    static ExtractSliceCache *GetInstance();
+
+    /** \brief Get a cached slice.
+     *
+     * The returned slice is shared between all users of the cache and must not be modified.
+     * \return nullptr if there is no slice for the key.
+     */
+    vtkSmartPointer<vtkImageData> Find(const Key &key);
+
+    /** \brief Store a copy of a slice.
+     *
+     * Slices of older modified times of the same input are dropped. Slices larger than the maximum
+     * memory are not stored.
+     */
+    void Insert(const Key &key, vtkImageData *slice);
+
+    void Clear();
+
+    /** \brief Set the maximum number of bytes occupied by cached slices (default: 128 MiB).
+     */
+    void SetMaximumMemory(std::size_t maximumMemory);
+    std::size_t GetMaximumMemory() const;
+
+    std::size_t GetMemoryUsage() const;
+    std::size_t GetNumberOfEntries() const;
+
+    std::uint64_t GetNumberOfHits() const;
+    std::uint64_t GetNumberOfMisses() const;
+    void ResetStatistics();
+
+    ExtractSliceCache();
+    ~ExtractSliceCache();
+
+    ExtractSliceCache(const ExtractSliceCache &) = delete;
+    ExtractSliceCache &operator=(const ExtractSliceCache &) = delete;
+
+  private:
+    struct KeyHash
+    {
+      std::size_t operator()(const Key &key) const;
+    };
+
+    struct Entry
+    {
+      Key CacheKey;
+      vtkSmartPointer<vtkImageData> Slice;
+      std::size_t Size;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    void Erase(EntryList::iterator entry);
+    void EvictToMaximumMemory();
+
+    mutable std::mutex m_Mutex;
+    EntryList m_Entries; // Most recently used entry first
+    std::unordered_map<Key, EntryList::iterator, KeyHash> m_Index;
+    std::size_t m_MaximumMemory;
+    std::size_t m_MemoryUsage;
+    std::uint64_t m_NumberOfHits;
+    std::uint64_t m_NumberOfMisses;
+  };
+}
+
+#endif
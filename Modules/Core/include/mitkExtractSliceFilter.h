@@ -59,6 +59,10 @@ namespace mitk
   - time step 0.
   - component 0.
   - resample by geometry false (Corresponds to input image).
+
+  If the slice cache is enabled (SetUseSliceCache()) and only vtk output is requested, slices are looked up in
+  and stored to the process-wide ExtractSliceCache, so that identical slices requested by several renderers
+  or filters are resliced only once.
   */
   class MITKCORE_EXPORT ExtractSliceFilter : public ImageToImageFilter
   {
@@ -135,7 +139,7 @@ namespace mitk
     vtkImageData *GetVtkOutput()
     {
       m_VtkOutputRequested = true;
-      return m_Reslicer->GetOutput();
+      return m_UseSliceCache ? m_VtkOutput.GetPointer() : m_Reslicer->GetOutput();
     }
 
     /** Set VtkOutPutRequest to suppress the conversion of the image.
@@ -162,6 +166,14 @@ namespace mitk
       this->m_InterpolationMode = interpolation;
     }
 
+    /** \brief Look up and store slices in the ExtractSliceCache (default: false).
+    * Only applies to vtk output of planar slices.
+    * Note: Has to be set before GetVtkOutput() is called, as it determines the returned object.
+    * The vtk output must not be modified by the caller if the cache is used.
+    */
+    void SetUseSliceCache(bool useSliceCache) { m_UseSliceCache = useSliceCache; }
+    bool GetUseSliceCache() const { return m_UseSliceCache; }
+
   protected:
     ExtractSliceFilter(vtkImageReslice *reslicer = nullptr);
     ~ExtractSliceFilter() override;
@@ -195,12 +207,17 @@ namespace mitk
 
     unsigned int m_Component;
 
+    bool m_UseSliceCache;
+
   private:
     BaseGeometry::ConstPointer m_ResliceTransform;
     /* Axis vectors of the relevant geometry. Set in GenerateOutputInformation() and also used in GenerateData().*/
     Vector3D m_Right, m_Bottom;
     /* Bounds of the relevant plane. Set in GenerateOutputInformation() and also used in GenerateData().*/
     int m_XMin, m_XMax, m_YMin, m_YMax;
+    /* Output returned by GetVtkOutput() if the slice cache is used. Shares its data with either the
+    reslicer output or a cached slice.*/
+    vtkSmartPointer<vtkImageData> m_VtkOutput;
 
   };
 }
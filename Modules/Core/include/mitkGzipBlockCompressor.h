@@ -0,0 +1,76 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkGzipBlockCompressor_h
+#define mitkGzipBlockCompressor_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace mitk
+{
+  /**
+   * \brief Multi-threaded gzip compression.
+   *
+   * The input is split into blocks which are deflated concurrently. Each block is primed with the
+   * last 32 KiB of its predecessor and ends on a byte boundary (sync flush), so the blocks are
+   * concatenated into a single standard gzip member that any gzip reader (zlib, NIfTI, teem, ...)
+   * can decompress. The compression ratio is close to the one of a single-threaded deflate.
+   *
+   * Input streams are processed in batches of one block per thread, i.e. the memory consumption is
+   * bounded independently of the size of the input.
+   */
+  class MITKCORE_EXPORT GzipBlockCompressor
+  {
+  public:
+    enum class Strategy
+    {
+      Default,  ///< Regular deflate
+      RunLength ///< Only matches of distance one (zlib Z_RLE). Much faster, well suited for label images.
+    };
+
+    GzipBlockCompressor();
+
+    /** Compression level between 0 (no compression, stored blocks only) and 9 (best compression). Default is 6.*/
+    void SetCompressionLevel(int level);
+    int GetCompressionLevel() const;
+
+    void SetStrategy(Strategy strategy);
+    Strategy GetStrategy() const;
+
+    /** Size of the independently compressed blocks in bytes. Default is 1 MiB, minimum is 64 KiB.*/
+    void SetBlockSize(std::size_t blockSize);
+    std::size_t GetBlockSize() const;
+
+    /** Number of threads. 0 (default) uses the global default number of threads of itk::MultiThreaderBase.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** \brief Compresses the given buffer and appends the gzip stream to output.
+     *  \throw mitk::Exception if deflate fails or output cannot be written.*/
+    void Compress(const char *data, std::size_t size, std::ostream &output) const;
+
+    /** \brief Compresses the remaining content of input and appends the gzip stream to output.
+     *  \throw mitk::Exception if deflate fails or input/output cannot be read/written.*/
+    void Compress(std::istream &input, std::ostream &output) const;
+
+  private:
+    int m_CompressionLevel;
+    Strategy m_Strategy;
+    std::size_t m_BlockSize;
+    unsigned int m_NumberOfThreads;
+  };
+}
+
+#endif
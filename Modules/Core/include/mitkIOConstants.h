@@ -48,6 +48,14 @@ namespace mitk
     static std::string SIZE_Y();
     static std::string SIZE_Z();
     static std::string SIZE_T();
+
+    static std::string COMPRESSION_LEVEL();
+    static std::string COMPRESSION_STRATEGY();
+    static std::string COMPRESSION_STRATEGY_DEFAULT();
+    static std::string COMPRESSION_STRATEGY_RUN_LENGTH();
+    static std::string COMPRESSION_STRATEGY_ENUM();
+
+    static std::string MEMORY_MAPPING();
   };
 }
 
@@ -17,6 +17,8 @@ found in the LICENSE file.
 #include <MitkCoreExports.h>
 #include "mitkImageDescriptor.h"
 
+#include <memory>
+
 class vtkImageData;
 
 namespace mitk
@@ -90,6 +92,10 @@ namespace mitk
     PixelType GetPixelType() const { return *m_PixelType; }
     void SetTimestep(int t) { m_Timestep = t; }
     void SetManageMemory(bool b) { m_ManageMemory = b; }
+    /** Keeps an object alive as long as the item exists, e.g. the memory mapped file that backs
+     *  externally provided data (see Image::ReferenceMemory).*/
+    void SetMemoryOwner(std::shared_ptr<const void> owner) { m_MemoryOwner = owner; }
+    std::shared_ptr<const void> GetMemoryOwner() const { return m_MemoryOwner; }
     int GetDimension() const { return m_Dimension; }
     int GetDimension(int i) const
     {
@@ -150,6 +156,8 @@ namespace mitk
 
     ImageDataItem::ConstPointer m_Parent;
 
+    std::shared_ptr<const void> m_MemoryOwner;
+
     unsigned int m_Dimension;
 
     unsigned int m_Dimensions[MAX_IMAGE_DIMENSIONS];
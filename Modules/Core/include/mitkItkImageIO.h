@@ -57,8 +57,12 @@ namespace mitk
     static PropertyList::Pointer ExtractMetaDataAsPropertyList(const itk::MetaDataDictionary& dictionary, const std::string& mimeTypeName, const std::vector<std::string>& defaultMetaDataKeys);
 
     /** Helper function that van be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
-    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
-    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path);
+    Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...
+    @param useMemoryMapping If true, uncompressed scalar NIfTI, NRRD and MetaImage files in native byte order are
+    not read but memory mapped (copy-on-write): Pixel data is loaded on first access and modifications are never
+    written back to the file. The mapping is released together with the image. All other files are read as usual.
+    See also the reader option IOConstants::MEMORY_MAPPING().*/
+    static Image::Pointer LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, bool useMemoryMapping = false);
 
     /** Helper function that van be used to extract a raw mitk image for the passed path using the also passed ImageIOBase instance.
     Raw means, that only the pixel data and geometry information is loaded. But e.g. no properties etc...*/
@@ -66,6 +70,18 @@ namespace mitk
 
     static void SavePropertyListAsMetaData(itk::MetaDataDictionary& dictionary, const PropertyList* properties, const std::string& mimeTypeName);
 
+    /** Default writer options to select the compression of NIfTI and NRRD files (IOConstants::COMPRESSION_LEVEL()
+    and IOConstants::COMPRESSION_STRATEGY()).*/
+    static IFileWriter::Options GetDefaultCompressionOptions();
+
+    /** Helper function that writes the pixel data with an imageIO prepared by PreparImageIOToWriteImage().
+    For gzip compressed NIfTI (*.nii.gz) and NRRD (*.nrrd) files, the imageIO only writes the header (of a single voxel
+    image to a temporary file). The pixel data is compressed from the buffer by multiple threads (see GzipBlockCompressor).
+    The resulting files are standard gzip streams. All other files are written by the imageIO itself with compression enabled.
+    @param options Writer options, see GetDefaultCompressionOptions(). A compression level of 0 disables the compression,
+    i.e. NRRD files are written raw encoded and *.nii.gz files are gzip streams of stored (uncompressed) blocks.*/
+    static void WriteImageIO(itk::ImageIOBase* imageIO, const std::string& path, const void* buffer, const IFileWriter::Options& options);
+
 
   protected:
     virtual std::vector<std::string> FixUpImageIOExtensions(const std::string &imageIOName);
@@ -0,0 +1,74 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkMemoryMappedFile_h
+#define mitkMemoryMappedFile_h
+
+#include <MitkCoreExports.h>
+
+#include <cstddef>
+#include <string>
+
+namespace mitk
+{
+  /**
+   * \brief Maps a whole file into memory.
+   *
+   * Pages are loaded by the operating system on first access, so opening even very large
+   * files is almost free and only the parts that are actually accessed occupy memory.
+   *
+   * In CopyOnWrite mode, the mapping may be modified. Modified pages become private copies
+   * and are never written back to the file.
+   *
+   * The mapping is released on Close() or destruction.
+   */
+  class MITKCORE_EXPORT MemoryMappedFile
+  {
+  public:
+    enum class AccessMode
+    {
+      ReadOnly,
+      CopyOnWrite
+    };
+
+    MemoryMappedFile();
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile &) = delete;
+    MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+
+    /**
+     * \brief Map a file (UTF-8 encoded path).
+     * \throw mitk::Exception if the file cannot be opened or mapped.
+     */
+    void Open(const std::string &path, AccessMode accessMode = AccessMode::ReadOnly);
+    void Close();
+
+    bool IsOpen() const;
+
+    /** \return nullptr if no file is mapped or the file is empty. */
+    const char *GetData() const;
+
+    /** \return nullptr if no file is mapped in CopyOnWrite mode. */
+    char *GetWritableData();
+
+    std::size_t GetSize() const;
+
+  private:
+    char *m_Data;
+    std::size_t m_Size;
+    AccessMode m_AccessMode;
+    bool m_IsOpen;
+  };
+}
+
+#endif
@@ -14,12 +14,21 @@ found in the LICENSE file.
 #define mitkPointSetVtkMapper3D_h
 
 #include "mitkBaseRenderer.h"
+#include "mitkPointSet.h"
 #include "mitkVtkMapper.h"
 #include <MitkCoreExports.h>
 #include <vtkSmartPointer.h>
 
+#include <vector>
+
 class vtkActor;
 class vtkCellArray;
+class vtkConeSource;
+class vtkCubeSource;
+class vtkCylinderSource;
+class vtkGlyph3DMapper;
+class vtkSphereSource;
+class vtkUnsignedCharArray;
 class vtkPropAssembly;
 class vtkAppendPolyData;
 class vtkPolyData;
@@ -29,8 +38,6 @@ class vtkTransformPolyDataFilter;
 
 namespace mitk
 {
-  class PointSet;
-
   /**
   * @brief Vtk-based mapper for PointSet
   *
@@ -50,6 +57,17 @@ namespace mitk
   * Then the three Actors are combined inside a vtkPropAssembly and this
   * object is returned in GetProp() and so hooked up into the rendering
   * pipeline.
+  *
+  * If no labels are shown, the points are instead rendered by a single
+  * vtkGlyph3DMapper. It instances one shared geometry per point type
+  * (sphere, cube, cone, cylinder) at the point positions. Glyph type,
+  * selection state and color of each point are stored in point data arrays.
+  * The world positions are kept between updates and compared with the
+  * transformed input, so only the entries of moved, retyped or (de)selected
+  * points are rewritten and only the affected arrays are marked as modified.
+  * Updates without changes therefore cause no upload at all. Note that
+  * vtkGlyph3DMapper still rebuilds its complete instance buffer once one of
+  * its arrays is modified.
 
   * Properties that can be set for point sets and influence the PointSetVTKMapper3D are:
   *
@@ -122,8 +140,10 @@ namespace mitk
         /* destructor */
         ~LocalStorage();
 
-        /// All point positions, already in world coordinates
+        /// All point positions, already in world coordinates. Kept between updates, see m_MovedPoints
         vtkSmartPointer<vtkPoints> m_WorldPositions;
+        /// Ascending indices of the points whose world position changed in the last update
+        std::vector<vtkIdType> m_MovedPoints;
         /// All connections between two points (used for contour drawing)
         vtkSmartPointer<vtkCellArray> m_PointConnections;
 
@@ -150,6 +170,20 @@ namespace mitk
 
         vtkSmartPointer<vtkPropAssembly> m_PointsAssembly;
 
+        /// Instanced glyph rendering of all points (used if no labels are shown)
+        vtkSmartPointer<vtkPolyData> m_GlyphPolyData;
+        vtkSmartPointer<vtkUnsignedCharArray> m_GlyphTypes;
+        vtkSmartPointer<vtkUnsignedCharArray> m_GlyphSelection;
+        vtkSmartPointer<vtkUnsignedCharArray> m_GlyphColors;
+        vtkSmartPointer<vtkSphereSource> m_GlyphSphereSource;
+        vtkSmartPointer<vtkCubeSource> m_GlyphCubeSource;
+        vtkSmartPointer<vtkConeSource> m_GlyphConeSource;
+        vtkSmartPointer<vtkCylinderSource> m_GlyphCylinderSource;
+        vtkSmartPointer<vtkGlyph3DMapper> m_GlyphMapper;
+        vtkSmartPointer<vtkActor> m_GlyphActor;
+        /// Ascending indices of the glyphs whose position, type or selection changed in the last update
+        std::vector<vtkIdType> m_ChangedGlyphs;
+
         // variables to be able to log, how many inputs have been added to PolyDatas
         unsigned int m_NumberOfSelectedAdded;
         unsigned int m_NumberOfUnselectedAdded;
@@ -170,6 +204,18 @@ namespace mitk
     virtual void CreateContour(vtkPoints *points, vtkCellArray *connections, mitk::BaseRenderer* renderer);
     virtual void CreateVTKRenderObjects(mitk::BaseRenderer* renderer);
 
+    /** \brief Update the instanced glyphs from the world positions and the point data.
+    *
+    * The glyphs share the world positions, so moved points are already up to date. Type and selection
+    * entries are only rewritten for points whose type or selection state changed. The indices of all
+    * changed glyphs are stored in LocalStorage::m_ChangedGlyphs.
+    */
+    virtual void UpdateGlyphs(mitk::BaseRenderer *renderer,
+                              const mitk::PointSet::DataType *itkPointSet,
+                              bool pointDataBroken,
+                              bool isInputDevice);
+    virtual void UpdateGlyphColors(mitk::BaseRenderer *renderer, const double selectedColor[3], const double unselectedColor[3]);
+
     // help for contour between points
     vtkSmartPointer<vtkAppendPolyData> m_vtkTextList;
 
@@ -0,0 +1,174 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkRenderingProfiler_h
+#define mitkRenderingProfiler_h
+
+#include <MitkCoreExports.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace mitk
+{
+  class BaseRenderer;
+  class DataNode;
+  class Mapper;
+
+  /**
+  \brief Process-wide collector of rendering timings.
+
+  RenderingManager and VtkPropRenderer report the duration of each frame, of each render pass and of
+  each mapper update (Mapper::Update(), which calls GenerateDataForRenderer()) to the profiler. The profiler
+  keeps rolling frame time statistics per renderer, accumulated update times per data node and a bounded
+  list of events that can be exported in the Chrome trace event format (chrome://tracing, Perfetto).
+
+  The profiler is disabled by default. While disabled, an instrumented scope costs a single atomic load.
+  All methods are thread-safe.
+
+  \sa RenderingProfiler::Scope
+  */
+  class MITKCORE_EXPORT RenderingProfiler
+  {
+  public:
+    enum class EventCategory
+    {
+      Frame,        ///< Rendering of a whole render window
+      RenderPass,   ///< A render pass of VtkPropRenderer::Render()
+      MapperUpdate, ///< Mapper::Update() of a single data node
+      Other
+    };
+
+    struct FrameStatistics
+    {
+      std::size_t NumberOfFrames = 0; ///< Frames in the rolling window
+      double LastFrameTime = 0.0;     ///< Milliseconds
+      double MeanFrameTime = 0.0;     ///< Milliseconds
+      double MinimumFrameTime = 0.0;  ///< Milliseconds
+      double MaximumFrameTime = 0.0;  ///< Milliseconds
+    };
+
+    struct UpdateStatistics
+    {
+      std::size_t NumberOfUpdates = 0;
+      double TotalTime = 0.0;   ///< Milliseconds
+      double MaximumTime = 0.0; ///< Milliseconds
+    };
+
+    /** \brief Measures the time between construction and destruction if the profiler is enabled.
+     *
+     * Names are only looked up on destruction of an active scope, so scopes are cheap while the profiler
+     * is disabled.
+     */
+    class MITKCORE_EXPORT Scope
+    {
+    public:
+      Scope(EventCategory category, const char *name, const BaseRenderer *renderer);
+      Scope(const DataNode *node, const Mapper *mapper, const BaseRenderer *renderer);
+      ~Scope();
+
+      Scope(const Scope &) = delete;
+      Scope &operator=(const Scope &) = delete;
+
+    private:
+      bool m_Active;
+      EventCategory m_Category;
+      const char *m_Name;
+      const DataNode *m_Node;
+      const Mapper *m_Mapper;
+      const BaseRenderer *m_Renderer;
+      std::chrono::steady_clock::time_point m_Begin;
+    };
+
+    static RenderingProfiler *GetInstance();
+
+    void SetEnabled(bool enabled);
+
+    bool IsEnabled() const
+    {
+      return m_Enabled.load(std::memory_order_relaxed);
+    }
+
+    void AddEvent(EventCategory category,
+                  const std::string &name,
+                  const std::string &rendererName,
+                  std::chrono::steady_clock::time_point begin,
+                  std::chrono::steady_clock::time_point end);
+
+    /** \brief Get statistics of the frames of the render window with the given renderer name.
+     */
+    FrameStatistics GetFrameStatistics(const std::string &rendererName) const;
+
+    /** \brief Get the accumulated mapper update times per data node name.
+     */
+    std::map<std::string, UpdateStatistics> GetUpdateStatistics() const;
+
+    /** \brief Set the number of frames per renderer used for frame statistics (default: 100).
+     */
+    void SetFrameWindowSize(std::size_t frameWindowSize);
+    std::size_t GetFrameWindowSize() const;
+
+    /** \brief Set the maximum number of stored events (default: 100000). Oldest events are dropped first.
+     */
+    void SetMaximumNumberOfEvents(std::size_t maximumNumberOfEvents);
+    std::size_t GetMaximumNumberOfEvents() const;
+
+    std::size_t GetNumberOfEvents() const;
+
+    /** \brief Remove all events and statistics.
+     */
+    void Clear();
+
+    /** \brief Write all stored events in the Chrome trace event format.
+     */
+    void WriteChromeTrace(std::ostream &stream) const;
+
+    /** \brief Write all stored events in the Chrome trace event format to a file.
+     * \return false if the file could not be written.
+     */
+    bool WriteChromeTrace(const std::string &fileName) const;
+
+    RenderingProfiler();
+    ~RenderingProfiler();
+
+    RenderingProfiler(const RenderingProfiler &) = delete;
+    RenderingProfiler &operator=(const RenderingProfiler &) = delete;
+
+  private:
+    struct Event
+    {
+      EventCategory Category;
+      std::string Name;
+      std::string RendererName;
+      std::int64_t Begin;    // Microseconds since m_StartTime
+      std::int64_t Duration; // Microseconds
+    };
+
+    std::atomic<bool> m_Enabled;
+
+    mutable std::mutex m_Mutex;
+    std::chrono::steady_clock::time_point m_StartTime;
+    std::deque<Event> m_Events;
+    std::size_t m_MaximumNumberOfEvents;
+    std::map<std::string, std::deque<double>> m_FrameTimes;
+    std::size_t m_FrameWindowSize;
+    std::map<std::string, UpdateStatistics> m_UpdateStatistics;
+  };
+}
+
+#endif
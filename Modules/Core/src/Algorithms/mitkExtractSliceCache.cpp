@@ -0,0 +1,222 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceCache.h>
+
+#include <iterator>
+
+namespace
+{
+  // FNV-1a
+  class Hasher
+  {
+  public:
+    template <typename T>
+    void Add(const T &value)
+    {
+      auto bytes = reinterpret_cast<const unsigned char *>(&value);
+
+      for (std::size_t i = 0; i < sizeof(T); ++i)
+      {
+        m_Hash ^= bytes[i];
+        m_Hash *= 1099511628211ULL;
+      }
+    }
+
+    template <typename T, std::size_t N>
+    void Add(const std::array<T, N> &values)
+    {
+      for (const auto &value : values)
+        this->Add(value);
+    }
+
+    std::uint64_t GetHash() const
+    {
+      return m_Hash;
+    }
+
+  private:
+    std::uint64_t m_Hash = 14695981039346656037ULL;
+  };
+}
+
+bool mitk::ExtractSliceCache::Key::operator==(const Key &other) const
+{
+  return Input == other.Input &&
+         InputMTime == other.InputMTime &&
+         TimeStep == other.TimeStep &&
+         InterpolationMode == other.InterpolationMode &&
+         ResliceAxes == other.ResliceAxes &&
+         ResliceTransform == other.ResliceTransform &&
+         OutputExtent == other.OutputExtent &&
+         OutputSpacing == other.OutputSpacing &&
+         BackgroundLevel == other.BackgroundLevel;
+}
+
+std::size_t mitk::ExtractSliceCache::KeyHash::operator()(const Key &key) const
+{
+  Hasher hasher;
+
+  hasher.Add(key.Input);
+  hasher.Add(key.InputMTime);
+  hasher.Add(key.TimeStep);
+  hasher.Add(key.InterpolationMode);
+  hasher.Add(key.ResliceAxes);
+  hasher.Add(key.ResliceTransform);
+  hasher.Add(key.OutputExtent);
+  hasher.Add(key.OutputSpacing);
+  hasher.Add(key.BackgroundLevel);
+
+  return static_cast<std::size_t>(hasher.GetHash());
+}
+
+mitk::ExtractSliceCache *mitk::ExtractSliceCache::GetInstance()
+{
+  static ExtractSliceCache instance;
+  return &instance;
+}
+
+mitk::ExtractSliceCache::ExtractSliceCache()
+  : m_MaximumMemory(128 * 1024 * 1024),
+    m_MemoryUsage(0),
+    m_NumberOfHits(0),
+    m_NumberOfMisses(0)
+{
+}
+
+mitk::ExtractSliceCache::~ExtractSliceCache()
+{
+}
+
+vtkSmartPointer<vtkImageData> mitk::ExtractSliceCache::Find(const Key &key)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto iter = m_Index.find(key);
+
+  if (iter == m_Index.end())
+  {
+    ++m_NumberOfMisses;
+    return nullptr;
+  }
+
+  ++m_NumberOfHits;
+
+  // Mark as most recently used
+  m_Entries.splice(m_Entries.begin(), m_Entries, iter->second);
+
+  return iter->second->Slice;
+}
+
+void mitk::ExtractSliceCache::Insert(const Key &key, vtkImageData *slice)
+{
+  if (nullptr == slice)
+    return;
+
+  const std::size_t size = static_cast<std::size_t>(slice->GetActualMemorySize()) * 1024;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (size > m_MaximumMemory)
+    return;
+
+  for (auto iter = m_Entries.begin(); iter != m_Entries.end();)
+  {
+    auto entry = iter++;
+
+    // Slices of outdated versions of the input will never be requested again
+    if (entry->CacheKey.Input == key.Input && entry->CacheKey.InputMTime < key.InputMTime)
+      this->Erase(entry);
+  }
+
+  auto existingEntry = m_Index.find(key);
+
+  if (existingEntry != m_Index.end())
+    this->Erase(existingEntry->second);
+
+  auto copy = vtkSmartPointer<vtkImageData>::New();
+  copy->DeepCopy(slice);
+
+  m_Entries.push_front({ key, copy, size });
+  m_Index[key] = m_Entries.begin();
+  m_MemoryUsage += size;
+
+  this->EvictToMaximumMemory();
+}
+
+void mitk::ExtractSliceCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Index.clear();
+  m_Entries.clear();
+  m_MemoryUsage = 0;
+}
+
+void mitk::ExtractSliceCache::SetMaximumMemory(std::size_t maximumMemory)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_MaximumMemory = maximumMemory;
+  this->EvictToMaximumMemory();
+}
+
+std::size_t mitk::ExtractSliceCache::GetMaximumMemory() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumMemory;
+}
+
+std::size_t mitk::ExtractSliceCache::GetMemoryUsage() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MemoryUsage;
+}
+
+std::size_t mitk::ExtractSliceCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+std::uint64_t mitk::ExtractSliceCache::GetNumberOfHits() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfHits;
+}
+
+std::uint64_t mitk::ExtractSliceCache::GetNumberOfMisses() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfMisses;
+}
+
+void mitk::ExtractSliceCache::ResetStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_NumberOfHits = 0;
+  m_NumberOfMisses = 0;
+}
+
+void mitk::ExtractSliceCache::Erase(EntryList::iterator entry)
+{
+  m_MemoryUsage -= entry->Size;
+  m_Index.erase(entry->CacheKey);
+  m_Entries.erase(entry);
+}
+
+void mitk::ExtractSliceCache::EvictToMaximumMemory()
+{
+  while (m_MemoryUsage > m_MaximumMemory && !m_Entries.empty())
+    this->Erase(std::prev(m_Entries.end()));
+}
@@ -13,6 +13,7 @@ found in the LICENSE file.
 #include "mitkExtractSliceFilter.h"
 
 #include <mitkAbstractTransformGeometry.h>
+#include <mitkExtractSliceCache.h>
 #include <mitkPlaneClipping.h>
 
 #include <vtkGeneralTransform.h>
@@ -45,6 +46,8 @@ mitk::ExtractSliceFilter::ExtractSliceFilter(vtkImageReslice *reslicer): m_XMin(
   m_VtkOutputRequested = false;
   m_BackgroundLevel = -32768.0;
   m_Component = 0;
+  m_UseSliceCache = false;
+  m_VtkOutput = vtkSmartPointer<vtkImageData>::New();
 }
 
 mitk::ExtractSliceFilter::~ExtractSliceFilter()
@@ -416,6 +419,45 @@ void mitk::ExtractSliceFilter::GenerateData()
 
   m_Reslicer->SetOutputSpacing(m_OutPutSpacing[0], m_OutPutSpacing[1], m_ZSpacing);
 
+  // curved planes and non-linear reslice transforms are not cached
+  const bool useSliceCache = m_UseSliceCache && m_VtkOutputRequested && nullptr == abstractGeometry &&
+                             nullptr == dynamic_cast<const AbstractTransformGeometry *>(m_ResliceTransform.GetPointer());
+
+  ExtractSliceCache::Key sliceCacheKey;
+
+  if (useSliceCache)
+  {
+    auto inputVtkImage = input->GetVtkImageData(m_TimeStep);
+
+    sliceCacheKey.Input = inputVtkImage;
+    sliceCacheKey.InputMTime = std::max<itk::ModifiedTimeType>(input->GetMTime(), inputVtkImage->GetMTime());
+    sliceCacheKey.TimeStep = m_TimeStep;
+    sliceCacheKey.InterpolationMode = m_Reslicer->GetInterpolationMode();
+    sliceCacheKey.BackgroundLevel = m_Reslicer->GetBackgroundLevel();
+
+    auto resliceAxes = m_Reslicer->GetResliceAxes();
+    for (int i = 0; i < 16; ++i)
+      sliceCacheKey.ResliceAxes[i] = resliceAxes->GetElement(i / 4, i % 4);
+
+    if (m_ResliceTransform.IsNotNull())
+    {
+      auto resliceTransform = m_ResliceTransform->GetVtkTransform()->GetMatrix();
+      for (int i = 0; i < 16; ++i)
+        sliceCacheKey.ResliceTransform[i] = resliceTransform->GetElement(i / 4, i % 4);
+    }
+
+    m_Reslicer->GetOutputExtent(sliceCacheKey.OutputExtent.data());
+    m_Reslicer->GetOutputSpacing(sliceCacheKey.OutputSpacing.data());
+
+    auto cachedSlice = ExtractSliceCache::GetInstance()->Find(sliceCacheKey);
+
+    if (nullptr != cachedSlice)
+    {
+      m_VtkOutput->ShallowCopy(cachedSlice);
+      return;
+    }
+  }
+
   // TODO check the following lines, they are responsible whether vtk error outputs appear or not
   m_Reslicer->UpdateWholeExtent(); // this produces a bad allocation error for 2D images
   // m_Reslicer->GetOutput()->UpdateInformation();
@@ -430,6 +472,12 @@ void mitk::ExtractSliceFilter::GenerateData()
     // no conversion to mitk
     // no mitk geometry will be set, as the output is vtkImageData only!!!
     // no image component will be extracted, as the caller might need the whole multi-component image as vtk output
+    if (useSliceCache)
+    {
+      m_VtkOutput->ShallowCopy(m_Reslicer->GetOutput());
+      ExtractSliceCache::GetInstance()->Insert(sliceCacheKey, m_Reslicer->GetOutput());
+    }
+
     return;
   }
   else
@@ -17,6 +17,7 @@ found in the LICENSE file.
 #include <mitkNodePredicateNot.h>
 #include <mitkNodePredicateProperty.h>
 #include <mitkProportionalTimeGeometry.h>
+#include <mitkRenderingProfiler.h>
 
 #include <vtkCamera.h>
 #include <vtkRenderWindow.h>
@@ -238,6 +239,7 @@ namespace mitk
       // Note: this is a very important step which should be called before the VTK render!
       // If you modify the camera anywhere else or after the render call, the scene cannot be seen.
       auto *vPR = dynamic_cast<VtkPropRenderer *>(BaseRenderer::GetInstance(renderWindow));
+      RenderingProfiler::Scope profilerScope(RenderingProfiler::EventCategory::Frame, "Frame", vPR);
       if (vPR)
         vPR->PrepareRender();
       // Execute rendering
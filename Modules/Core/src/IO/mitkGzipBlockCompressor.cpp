@@ -0,0 +1,291 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGzipBlockCompressor.h>
+
+#include <mitkExceptionMacro.h>
+
+#include <itkMultiThreaderBase.h>
+#include <itk_zlib.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // Maximum distance of deflate back-references
+  constexpr std::size_t DictionarySize = 32768;
+  constexpr std::size_t MinimumBlockSize = 65536;
+  constexpr std::size_t MaximumBlockSize = 1u << 30;
+
+  struct CompressedBlock
+  {
+    std::vector<unsigned char> Data;
+    uLong Crc = 0;
+    std::string Error;
+  };
+
+  /** \brief Deflates a block into a raw deflate stream.
+   *
+   * All but the last block end with a sync flush, i.e. on a byte boundary and without the final
+   * block bit, so that the compressed blocks can simply be concatenated. Errors are reported via
+   * block.Error since this function runs in worker threads.
+   */
+  void DeflateBlock(const char* data, std::size_t size, const char* dictionary, std::size_t dictionarySize,
+    bool isLast, int level, int strategy, CompressedBlock& block)
+  {
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+
+    if (Z_OK != deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, strategy))
+    {
+      block.Error = "deflateInit2 failed";
+      return;
+    }
+
+    if (dictionarySize > 0)
+      deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary), static_cast<uInt>(dictionarySize));
+
+    const int flush = isLast ? Z_FINISH : Z_SYNC_FLUSH;
+
+    block.Data.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = block.Data.data();
+    stream.avail_out = static_cast<uInt>(block.Data.size());
+
+    while (true)
+    {
+      if (stream.avail_out == 0)
+      {
+        const auto used = block.Data.size();
+        block.Data.resize(2 * used);
+        stream.next_out = block.Data.data() + used;
+        stream.avail_out = static_cast<uInt>(block.Data.size() - used);
+      }
+
+      const auto result = deflate(&stream, flush);
+
+      if (Z_STREAM_ERROR == result || (Z_BUF_ERROR == result && stream.avail_out != 0))
+      {
+        block.Error = "deflate failed";
+        break;
+      }
+
+      if (isLast ? Z_STREAM_END == result : (stream.avail_in == 0 && stream.avail_out != 0))
+        break;
+    }
+
+    block.Data.resize(stream.total_out);
+    block.Crc = crc32(0L, reinterpret_cast<const Bytef*>(data), static_cast<uInt>(size));
+
+    deflateEnd(&stream);
+  }
+
+  void WriteLittleEndian32(std::ostream& output, std::uint32_t value)
+  {
+    const char bytes[4] = {
+      static_cast<char>(value & 0xff),
+      static_cast<char>((value >> 8) & 0xff),
+      static_cast<char>((value >> 16) & 0xff),
+      static_cast<char>((value >> 24) & 0xff)
+    };
+
+    output.write(bytes, 4);
+  }
+
+  /** \brief Writes a single gzip member from consecutive chunks of the input.
+   */
+  class GzipMemberWriter
+  {
+  public:
+    GzipMemberWriter(std::ostream& output, int level, int strategy, std::size_t blockSize, unsigned int numberOfThreads)
+      : m_Output(output),
+        m_Level(level),
+        m_Strategy(strategy),
+        m_BlockSize(blockSize),
+        m_MultiThreader(itk::MultiThreaderBase::New()),
+        m_Crc(crc32(0L, Z_NULL, 0)),
+        m_TotalSize(0)
+    {
+      m_MultiThreader->SetMaximumNumberOfThreads(numberOfThreads);
+      m_MultiThreader->SetNumberOfWorkUnits(numberOfThreads);
+
+      // Magic number, deflate, no flags, no modification time, extra flags, unknown OS
+      const unsigned char extraFlags = level == 9 ? 2 : (level == 1 ? 4 : 0);
+      const char header[10] = { '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, static_cast<char>(extraFlags), '\xff' };
+      m_Output.write(header, 10);
+    }
+
+    /** \brief Compresses buffer[offset, offset + size).
+     *
+     * The bytes before offset must be the preceding input (up to 32 KiB are used as dictionary).
+     */
+    void Write(const char* buffer, std::size_t offset, std::size_t size, bool isFinal)
+    {
+      auto numBlocks = static_cast<unsigned int>((size + m_BlockSize - 1) / m_BlockSize);
+
+      if (isFinal && numBlocks == 0)
+        numBlocks = 1; // The final (possibly empty) block terminates the deflate stream
+
+      std::vector<CompressedBlock> blocks(numBlocks);
+
+      m_MultiThreader->ParallelizeArray(
+        0,
+        numBlocks,
+        [&](itk::SizeValueType i) {
+          const auto start = offset + i * m_BlockSize;
+          const auto blockSize = std::min(m_BlockSize, offset + size - start);
+          const auto dictionarySize = std::min(DictionarySize, start);
+          const bool isLast = isFinal && i + 1 == numBlocks;
+
+          DeflateBlock(buffer + start, blockSize, buffer + start - dictionarySize, dictionarySize, isLast, m_Level, m_Strategy, blocks[i]);
+        },
+        nullptr);
+
+      for (unsigned int i = 0; i < numBlocks; ++i)
+      {
+        if (!blocks[i].Error.empty())
+          mitkThrow() << "Gzip compression failed: " << blocks[i].Error;
+
+        const auto blockSize = std::min(m_BlockSize, size - i * m_BlockSize);
+        m_Crc = crc32_combine(m_Crc, blocks[i].Crc, static_cast<z_off_t>(blockSize));
+        m_TotalSize += blockSize;
+
+        m_Output.write(reinterpret_cast<const char*>(blocks[i].Data.data()), blocks[i].Data.size());
+      }
+
+      if (isFinal)
+      {
+        WriteLittleEndian32(m_Output, static_cast<std::uint32_t>(m_Crc));
+        WriteLittleEndian32(m_Output, static_cast<std::uint32_t>(m_TotalSize & 0xffffffff));
+      }
+
+      if (!m_Output)
+        mitkThrow() << "Cannot write compressed data.";
+    }
+
+  private:
+    std::ostream& m_Output;
+    int m_Level;
+    int m_Strategy;
+    std::size_t m_BlockSize;
+    itk::MultiThreaderBase::Pointer m_MultiThreader;
+    uLong m_Crc;
+    std::uint64_t m_TotalSize;
+  };
+}
+
+mitk::GzipBlockCompressor::GzipBlockCompressor()
+  : m_CompressionLevel(6),
+    m_Strategy(Strategy::Default),
+    m_BlockSize(1u << 20),
+    m_NumberOfThreads(0)
+{
+}
+
+void mitk::GzipBlockCompressor::SetCompressionLevel(int level)
+{
+  m_CompressionLevel = std::min(std::max(level, 0), 9);
+}
+
+int mitk::GzipBlockCompressor::GetCompressionLevel() const
+{
+  return m_CompressionLevel;
+}
+
+void mitk::GzipBlockCompressor::SetStrategy(Strategy strategy)
+{
+  m_Strategy = strategy;
+}
+
+mitk::GzipBlockCompressor::Strategy mitk::GzipBlockCompressor::GetStrategy() const
+{
+  return m_Strategy;
+}
+
+void mitk::GzipBlockCompressor::SetBlockSize(std::size_t blockSize)
+{
+  m_BlockSize = std::min(std::max(blockSize, MinimumBlockSize), MaximumBlockSize);
+}
+
+std::size_t mitk::GzipBlockCompressor::GetBlockSize() const
+{
+  return m_BlockSize;
+}
+
+void mitk::GzipBlockCompressor::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::GzipBlockCompressor::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+void mitk::GzipBlockCompressor::Compress(const char* data, std::size_t size, std::ostream& output) const
+{
+  const auto numThreads = m_NumberOfThreads != 0 ? m_NumberOfThreads : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const auto batchSize = numThreads * m_BlockSize;
+  const int strategy = m_Strategy == Strategy::RunLength ? Z_RLE : Z_DEFAULT_STRATEGY;
+
+  GzipMemberWriter writer(output, m_CompressionLevel, strategy, m_BlockSize, numThreads);
+
+  std::size_t offset = 0;
+
+  do
+  {
+    const auto count = std::min(batchSize, size - offset);
+    writer.Write(data, offset, count, offset + count == size);
+    offset += count;
+  } while (offset < size);
+}
+
+void mitk::GzipBlockCompressor::Compress(std::istream& input, std::ostream& output) const
+{
+  const auto numThreads = m_NumberOfThreads != 0 ? m_NumberOfThreads : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const auto batchSize = numThreads * m_BlockSize;
+  const int strategy = m_Strategy == Strategy::RunLength ? Z_RLE : Z_DEFAULT_STRATEGY;
+
+  GzipMemberWriter writer(output, m_CompressionLevel, strategy, m_BlockSize, numThreads);
+
+  // The tail of the previous batch is kept in front of the current batch as dictionary
+  std::vector<char> buffer(DictionarySize + batchSize);
+  std::size_t dictionarySize = 0;
+
+  while (true)
+  {
+    input.read(buffer.data() + dictionarySize, static_cast<std::streamsize>(batchSize));
+    const auto count = static_cast<std::size_t>(input.gcount());
+
+    if (input.bad())
+      mitkThrow() << "Cannot read data to compress.";
+
+    const bool isFinal = !input || std::istream::traits_type::eq_int_type(input.peek(), std::istream::traits_type::eof());
+
+    writer.Write(buffer.data(), dictionarySize, count, isFinal);
+
+    if (isFinal)
+      break;
+
+    const auto available = dictionarySize + count;
+    const auto keep = std::min(DictionarySize, available);
+    std::memmove(buffer.data(), buffer.data() + available - keep, keep);
+    dictionarySize = keep;
+  }
+}
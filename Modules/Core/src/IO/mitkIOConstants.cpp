@@ -133,4 +133,40 @@ namespace mitk
     static std::string s("org.mitk.io.Size t");
     return s;
   }
+
+  std::string IOConstants::COMPRESSION_LEVEL()
+  {
+    static std::string s("org.mitk.io.Compression Level");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_STRATEGY()
+  {
+    static std::string s("org.mitk.io.Compression Strategy");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_STRATEGY_DEFAULT()
+  {
+    static std::string s("Default");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_STRATEGY_RUN_LENGTH()
+  {
+    static std::string s("Run-length (fast)");
+    return s;
+  }
+
+  std::string IOConstants::COMPRESSION_STRATEGY_ENUM()
+  {
+    static std::string s("org.mitk.io.Compression Strategy.enum");
+    return s;
+  }
+
+  std::string IOConstants::MEMORY_MAPPING()
+  {
+    static std::string s("org.mitk.io.Memory Mapping");
+    return s;
+  }
 }
@@ -15,20 +15,40 @@ found in the LICENSE file.
 #include <mitkArbitraryTimeGeometry.h>
 #include <mitkCoreServices.h>
 #include <mitkCustomMimeType.h>
+#include <mitkGzipBlockCompressor.h>
+#include <mitkIOConstants.h>
 #include <mitkIOMimeTypes.h>
+#include <mitkIOUtil.h>
 #include <mitkIPropertyPersistence.h>
 #include <mitkImage.h>
 #include <mitkImageReadAccessor.h>
 #include <mitkLocaleSwitch.h>
+#include <mitkMemoryMappedFile.h>
 #include <mitkUIDManipulator.h>
 
+#include <itkByteSwapper.h>
 #include <itkImage.h>
 #include <itkImageFileReader.h>
 #include <itkImageIOFactory.h>
 #include <itkImageIORegion.h>
 #include <itkMetaDataObject.h>
 
+#include <itksys/SystemTools.hxx>
+
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <utility>
+#include <vector>
 
 namespace mitk
 {
@@ -38,6 +58,530 @@ namespace mitk
   const char *const PROPERTY_KEY_TIMEGEOMETRY_TIMEPOINTS = "org_mitk_timegeometry_timepoints";
   const char* const PROPERTY_KEY_UID = "org_mitk_uid";
 
+  namespace
+  {
+    bool EndsWith(const std::string &path, const std::string &suffix)
+    {
+      const auto lowerPath = itksys::SystemTools::LowerCase(path);
+      return lowerPath.size() >= suffix.size() && 0 == lowerPath.compare(lowerPath.size() - suffix.size(), suffix.size(), suffix);
+    }
+
+    bool SupportsBlockCompression(const itk::ImageIOBase *imageIO)
+    {
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      return imageIOName == "NiftiImageIO" || imageIOName == "NrrdImageIO";
+    }
+
+    GzipBlockCompressor GetCompressor(const IFileWriter::Options &options)
+    {
+      GzipBlockCompressor compressor;
+
+      auto iter = options.find(IOConstants::COMPRESSION_LEVEL());
+      if (iter != options.end() && iter->second.Type() == typeid(int))
+        compressor.SetCompressionLevel(us::any_cast<int>(iter->second));
+
+      iter = options.find(IOConstants::COMPRESSION_STRATEGY());
+      if (iter != options.end() && iter->second.ToString() == IOConstants::COMPRESSION_STRATEGY_RUN_LENGTH())
+        compressor.SetStrategy(GzipBlockCompressor::Strategy::RunLength);
+
+      return compressor;
+    }
+
+    /** Removes the temporary file when leaving the scope.*/
+    class TemporaryFile
+    {
+    public:
+      explicit TemporaryFile(const std::string &templateName) : m_Path(IOUtil::CreateTemporaryFile(templateName)) {}
+
+      ~TemporaryFile() { std::remove(m_Path.c_str()); }
+
+      const std::string &GetPath() const { return m_Path; }
+
+    private:
+      std::string m_Path;
+    };
+
+    /** Read-only stream buffer over consecutive memory segments, e.g. a file header followed by the pixel data.*/
+    class SegmentedMemoryBuffer : public std::streambuf
+    {
+    public:
+      void Append(const char *data, std::size_t size)
+      {
+        if (size > 0)
+          m_Segments.emplace_back(data, size);
+      }
+
+    protected:
+      int_type underflow() override
+      {
+        while (this->gptr() == this->egptr())
+        {
+          if (m_NextSegment == m_Segments.size())
+            return traits_type::eof();
+
+          auto *begin = const_cast<char *>(m_Segments[m_NextSegment].first);
+          this->setg(begin, begin, begin + m_Segments[m_NextSegment].second);
+          ++m_NextSegment;
+        }
+
+        return traits_type::to_int_type(*this->gptr());
+      }
+
+    private:
+      std::vector<std::pair<const char *, std::size_t>> m_Segments;
+      std::size_t m_NextSegment = 0;
+    };
+
+    /** Writes the image with the imageIO as if it consisted of a single voxel and returns the content of the file.
+    Apart from the image size, the header equals the one of the complete image.*/
+    std::string WriteSingleVoxelImage(itk::ImageIOBase *imageIO, const void *buffer, const std::string &templateName)
+    {
+      const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+      const auto ioRegion = imageIO->GetIORegion();
+      std::vector<itk::SizeValueType> dimensions(numberOfDimensions);
+      itk::ImageIORegion voxelRegion(numberOfDimensions);
+
+      for (unsigned int i = 0; i < numberOfDimensions; ++i)
+      {
+        dimensions[i] = imageIO->GetDimensions(i);
+        imageIO->SetDimensions(i, 1);
+        voxelRegion.SetSize(i, 1);
+      }
+
+      imageIO->SetIORegion(voxelRegion);
+
+      auto restoreDimensions = [&]() {
+        for (unsigned int i = 0; i < numberOfDimensions; ++i)
+          imageIO->SetDimensions(i, dimensions[i]);
+
+        imageIO->SetIORegion(ioRegion);
+      };
+
+      TemporaryFile file(templateName);
+
+      try
+      {
+        imageIO->UseCompressionOff();
+        imageIO->SetFileName(file.GetPath());
+        imageIO->Write(buffer);
+      }
+      catch (...)
+      {
+        restoreDimensions();
+        throw;
+      }
+
+      restoreDimensions();
+
+      std::ifstream input(file.GetPath(), std::ios_base::binary);
+      std::ostringstream content;
+      content << input.rdbuf();
+
+      return content.str();
+    }
+
+    /** Creates the header of a gzip encoded NRRD file from the single voxel file written by WriteSingleVoxelImage().
+    @return False, if the header has an unexpected format.*/
+    bool GetNrrdHeader(const std::string &singleVoxelImage, const itk::ImageIOBase *imageIO, std::string &header)
+    {
+      std::istringstream input(singleVoxelImage);
+      std::ostringstream output;
+      std::string line;
+      bool rawEncoding = false;
+      bool sizesFound = false;
+
+      while (std::getline(input, line))
+      {
+        if (line.empty())
+        {
+          output << '\n'; // End of header
+          header = output.str();
+          return rawEncoding && sizesFound;
+        }
+
+        if (line[0] == '#' || line.find(":=") != std::string::npos)
+        {
+          // Comments and key/value pairs are copied as they are
+        }
+        else if (line == "encoding: raw")
+        {
+          line = "encoding: gzip";
+          rawEncoding = true;
+        }
+        else if (0 == line.compare(0, 6, "sizes:"))
+        {
+          // The first axis holds the components of non-scalar images
+          std::istringstream sizesStream(line.substr(6));
+          std::vector<std::string> sizes{ std::istream_iterator<std::string>(sizesStream), std::istream_iterator<std::string>() };
+          const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+
+          if (sizes.size() < numberOfDimensions || sizes.size() > numberOfDimensions + 1)
+            return false;
+
+          const auto firstDimension = sizes.size() - numberOfDimensions;
+          line = "sizes:";
+
+          for (std::size_t i = 0; i < sizes.size(); ++i)
+            line += " " + (i < firstDimension ? sizes[i] : std::to_string(imageIO->GetDimensions(i - firstDimension)));
+
+          sizesFound = true;
+        }
+        else if (0 == line.compare(0, 10, "data file:"))
+        {
+          return false;
+        }
+
+        output << line << '\n';
+      }
+
+      return false;
+    }
+
+    /** Extracts the header of an uncompressed NIfTI-1 file from the single voxel file written by
+    WriteSingleVoxelImage() and sets the image size.
+    @return False, if the header has an unexpected format or the image size does not fit into NIfTI-1.*/
+    bool GetNiftiHeader(const std::string &singleVoxelImage, const itk::ImageIOBase *imageIO, std::string &header)
+    {
+      if (singleVoxelImage.size() < 352 || imageIO->GetNumberOfComponents() != 1)
+        return false; // Components of non-scalar images are not interleaved in NIfTI files
+
+      std::int32_t headerSize = 0;
+      std::int16_t dim[8];
+      float voxelOffset = 0.0f;
+      std::memcpy(&headerSize, singleVoxelImage.data(), 4);
+      std::memcpy(dim, singleVoxelImage.data() + 40, 16);
+      std::memcpy(&voxelOffset, singleVoxelImage.data() + 108, 4);
+
+      const auto numberOfDimensions = imageIO->GetNumberOfDimensions();
+      const auto dataOffset = static_cast<std::size_t>(voxelOffset);
+
+      if (348 != headerSize || 0 != std::memcmp(singleVoxelImage.data() + 344, "n+1", 4) ||
+          dim[0] < static_cast<std::int16_t>(numberOfDimensions) || dim[0] > 7 ||
+          dataOffset + imageIO->GetComponentSize() != singleVoxelImage.size())
+        return false;
+
+      for (unsigned int i = 0; i < numberOfDimensions; ++i)
+      {
+        if (imageIO->GetDimensions(i) > static_cast<itk::SizeValueType>(std::numeric_limits<std::int16_t>::max()))
+          return false;
+
+        dim[i + 1] = static_cast<std::int16_t>(imageIO->GetDimensions(i));
+      }
+
+      header = singleVoxelImage.substr(0, dataOffset);
+      std::memcpy(&header[40], dim, 16);
+      return true;
+    }
+
+    bool SupportsMemoryMapping(const itk::ImageIOBase *imageIO)
+    {
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      return imageIOName == "NiftiImageIO" || imageIOName == "NrrdImageIO" || imageIOName == "MetaImageIO";
+    }
+
+    /** Location of the uncompressed pixel data of an image file.*/
+    struct RawPixelData
+    {
+      std::string FileName;
+      std::size_t Offset = 0;
+    };
+
+    /** Checks an "endian" or "...ByteOrderMSB" header value against the byte order of this machine.*/
+    bool IsNativeByteOrder(bool isBigEndian)
+    {
+      return isBigEndian == itk::ByteSwapper<int>::SystemIsBigEndian();
+    }
+
+    /** Attached, raw encoded NRRD files. The pixel data follows the empty line that terminates the header.*/
+    bool LocateNrrdPixelData(const std::string &path, RawPixelData &pixelData)
+    {
+      std::ifstream file(path, std::ios_base::binary);
+      std::string line;
+
+      if (!std::getline(file, line) || 0 != line.compare(0, 4, "NRRD"))
+        return false;
+
+      bool rawEncoding = false;
+
+      while (std::getline(file, line))
+      {
+        if (line.empty())
+        {
+          pixelData.FileName = path;
+          pixelData.Offset = static_cast<std::size_t>(file.tellg());
+          return rawEncoding;
+        }
+
+        if (line[0] == '#' || line.find(":=") != std::string::npos)
+          continue; // Comments and key/value pairs
+
+        const auto separator = line.find(':');
+
+        if (std::string::npos == separator)
+          return false;
+
+        // Field names are case insensitive and some of them may be written with or without spaces
+        auto field = itksys::SystemTools::LowerCase(line.substr(0, separator));
+        field.erase(std::remove(field.begin(), field.end(), ' '), field.end());
+        const auto value = itksys::SystemTools::TrimWhitespace(line.substr(separator + 1));
+
+        if (field == "encoding")
+        {
+          rawEncoding = value == "raw";
+        }
+        else if (field == "endian")
+        {
+          if (!IsNativeByteOrder(value == "big"))
+            return false;
+        }
+        else if (field == "datafile" || ((field == "lineskip" || field == "byteskip") && value != "0"))
+        {
+          return false;
+        }
+      }
+
+      return false;
+    }
+
+    /** Single file NIfTI-1 images (*.nii) in native byte order without intensity scaling.*/
+    bool LocateNiftiPixelData(const std::string &path, RawPixelData &pixelData)
+    {
+      char header[348];
+      std::ifstream file(path, std::ios_base::binary);
+
+      // Gzip compressed files are rejected by the header size as well
+      if (!file.read(header, sizeof(header)))
+        return false;
+
+      std::int32_t headerSize = 0;
+      float voxelOffset = 0.0f;
+      float slope = 0.0f;
+      float intercept = 0.0f;
+
+      std::memcpy(&headerSize, header, 4);
+      std::memcpy(&voxelOffset, header + 108, 4);
+      std::memcpy(&slope, header + 112, 4);
+      std::memcpy(&intercept, header + 116, 4);
+
+      if (348 != headerSize || 0 != std::memcmp(header + 344, "n+1", 4))
+        return false;
+
+      // ITK converts rescaled pixels to floating point
+      if (0.0f != slope && (1.0f != slope || 0.0f != intercept))
+        return false;
+
+      if (voxelOffset < 348.0f || voxelOffset != std::floor(voxelOffset))
+        return false;
+
+      pixelData.FileName = path;
+      pixelData.Offset = static_cast<std::size_t>(voxelOffset);
+      return true;
+    }
+
+    /** MetaImage files with local (*.mha) or a single external uncompressed pixel data file (*.mhd and *.raw).*/
+    bool LocateMetaImagePixelData(const std::string &path, std::size_t pixelDataSize, RawPixelData &pixelData)
+    {
+      std::ifstream file(path, std::ios_base::binary);
+      std::string line;
+      long long headerSize = 0;
+
+      while (std::getline(file, line))
+      {
+        const auto separator = line.find('=');
+
+        if (std::string::npos == separator)
+          continue;
+
+        const auto key = itksys::SystemTools::TrimWhitespace(line.substr(0, separator));
+        const auto value = itksys::SystemTools::TrimWhitespace(line.substr(separator + 1));
+        const bool isTrue = itksys::SystemTools::LowerCase(value) == "true";
+
+        if (key == "CompressedData" && isTrue)
+        {
+          return false;
+        }
+        else if (key == "BinaryDataByteOrderMSB" || key == "ElementByteOrderMSB")
+        {
+          if (!IsNativeByteOrder(isTrue))
+            return false;
+        }
+        else if (key == "HeaderSize")
+        {
+          headerSize = std::strtoll(value.c_str(), nullptr, 10);
+        }
+        else if (key == "ElementDataFile") // Always the last field of the header
+        {
+          if (value == "LOCAL")
+          {
+            if (0 != headerSize)
+              return false;
+
+            pixelData.FileName = path;
+            pixelData.Offset = static_cast<std::size_t>(file.tellg());
+            return true;
+          }
+
+          // Lists of slice files and file name patterns
+          if (0 == itksys::SystemTools::LowerCase(value).compare(0, 4, "list") || value.find(' ') != std::string::npos)
+            return false;
+
+          pixelData.FileName = itksys::SystemTools::CollapseFullPath(value, itksys::SystemTools::GetFilenamePath(path));
+
+          if (headerSize >= 0)
+          {
+            pixelData.Offset = static_cast<std::size_t>(headerSize);
+          }
+          else // The pixel data is located at the end of the file
+          {
+            const auto fileSize = static_cast<std::size_t>(itksys::SystemTools::FileLength(pixelData.FileName));
+
+            if (fileSize < pixelDataSize)
+              return false;
+
+            pixelData.Offset = fileSize - pixelDataSize;
+          }
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    /** Maps the pixel data of an image file into memory (copy-on-write).
+    @param offset Position of the pixel data in the mapped file.
+    @return Nullptr, if the pixel data is not stored uncompressed as a whole in native byte order
+    or cannot be mapped. The image has to be read regularly in that case.*/
+    std::shared_ptr<MemoryMappedFile> MapPixelData(const itk::ImageIOBase *imageIO, const std::string &path, std::size_t &offset)
+    {
+      if (!SupportsMemoryMapping(imageIO) || 1 != imageIO->GetNumberOfComponents())
+        return nullptr;
+
+      const std::string imageIOName = imageIO->GetNameOfClass();
+      const auto pixelDataSize = static_cast<std::size_t>(imageIO->GetImageSizeInBytes());
+
+      RawPixelData pixelData;
+      bool isLocated = false;
+
+      if (imageIOName == "NrrdImageIO")
+      {
+        isLocated = LocateNrrdPixelData(path, pixelData);
+      }
+      else if (imageIOName == "NiftiImageIO")
+      {
+        isLocated = LocateNiftiPixelData(path, pixelData);
+      }
+      else
+      {
+        isLocated = LocateMetaImagePixelData(path, pixelDataSize, pixelData);
+      }
+
+      // Pixels must be aligned for direct access
+      if (!isLocated || 0 != pixelData.Offset % imageIO->GetComponentSize())
+      {
+        MITK_DEBUG << "Pixel data of " << path << " cannot be memory mapped. Reading it instead.";
+        return nullptr;
+      }
+
+      auto mappedFile = std::make_shared<MemoryMappedFile>();
+
+      try
+      {
+        mappedFile->Open(pixelData.FileName, MemoryMappedFile::AccessMode::CopyOnWrite);
+      }
+      catch (const Exception &e)
+      {
+        MITK_WARN << e.GetDescription() << " Reading the pixel data instead.";
+        return nullptr;
+      }
+
+      if (pixelData.Offset + pixelDataSize > mappedFile->GetSize() || nullptr == mappedFile->GetWritableData())
+      {
+        MITK_WARN << "Pixel data of " << path << " exceeds the file. Reading it instead.";
+        return nullptr;
+      }
+
+      offset = pixelData.Offset;
+      return mappedFile;
+    }
+  }
+
+  IFileWriter::Options ItkImageIO::GetDefaultCompressionOptions()
+  {
+    IFileWriter::Options options;
+    options[IOConstants::COMPRESSION_LEVEL()] = 6;
+    options[IOConstants::COMPRESSION_STRATEGY()] = IOConstants::COMPRESSION_STRATEGY_DEFAULT();
+
+    std::vector<std::string> strategyEnum;
+    strategyEnum.push_back(IOConstants::COMPRESSION_STRATEGY_DEFAULT());
+    strategyEnum.push_back(IOConstants::COMPRESSION_STRATEGY_RUN_LENGTH());
+    options[IOConstants::COMPRESSION_STRATEGY_ENUM()] = strategyEnum;
+
+    return options;
+  }
+
+  void ItkImageIO::WriteImageIO(itk::ImageIOBase *imageIO, const std::string &path, const void *buffer, const IFileWriter::Options &options)
+  {
+    const auto compressor = GetCompressor(options);
+    const std::string imageIOName = imageIO->GetNameOfClass();
+    const bool isNifti = imageIOName == "NiftiImageIO" && EndsWith(path, ".nii.gz");
+    const bool isNrrd = imageIOName == "NrrdImageIO" && EndsWith(path, ".nrrd");
+
+    LocaleSwitch localeSwitch("C");
+
+    // The NIfTI imageIO always gzips *.nii.gz files, so level 0 writes stored (uncompressed) deflate blocks.
+    // Raw encoded NRRD files are written by the imageIO itself.
+    if (isNifti || (isNrrd && compressor.GetCompressionLevel() > 0))
+    {
+      // Only the header is written by the imageIO. The pixel data is compressed directly from the buffer.
+      const auto singleVoxelImage = WriteSingleVoxelImage(imageIO, buffer, isNifti ? "XXXXXX.nii" : "XXXXXX.nrrd");
+      std::string header;
+
+      if (isNifti ? GetNiftiHeader(singleVoxelImage, imageIO, header) : GetNrrdHeader(singleVoxelImage, imageIO, header))
+      {
+        std::ofstream output(path, std::ios_base::binary | std::ios_base::trunc);
+
+        if (!output)
+          mitkThrow() << "Cannot open " << path << ".";
+
+        const auto *data = static_cast<const char *>(buffer);
+        const auto size = static_cast<std::size_t>(imageIO->GetImageSizeInBytes());
+
+        // Gzip compressed NIfTI files are completely compressed, NRRD files only after the header
+        if (isNifti)
+        {
+          SegmentedMemoryBuffer segments;
+          segments.Append(header.data(), header.size());
+          segments.Append(data, size);
+
+          std::istream input(&segments);
+          compressor.Compress(input, output);
+        }
+        else
+        {
+          output.write(header.data(), header.size());
+          compressor.Compress(data, size, output);
+        }
+
+        return;
+      }
+
+      MITK_DEBUG << "Unexpected image header. Falling back to single-threaded compression.";
+    }
+
+    if (compressor.GetCompressionLevel() > 0)
+    {
+      imageIO->UseCompressionOn();
+    }
+    else
+    {
+      imageIO->UseCompressionOff();
+    }
+
+    imageIO->SetFileName(path);
+    imageIO->Write(buffer);
+  }
+
   ItkImageIO::ItkImageIO(const ItkImageIO &other)
     : AbstractFileIO(other), m_ImageIO(dynamic_cast<itk::ImageIOBase *>(other.m_ImageIO->Clone().GetPointer()))
   {
@@ -193,6 +737,18 @@ namespace mitk
     this->SetReaderDescription(description);
     this->SetWriterDescription(description);
 
+    if (SupportsBlockCompression(m_ImageIO))
+    {
+      this->SetDefaultWriterOptions(GetDefaultCompressionOptions());
+    }
+
+    if (SupportsMemoryMapping(m_ImageIO))
+    {
+      Options readerOptions;
+      readerOptions[IOConstants::MEMORY_MAPPING()] = false;
+      this->SetDefaultReaderOptions(readerOptions);
+    }
+
     this->RegisterService();
   }
 
@@ -214,6 +770,18 @@ namespace mitk
       this->AbstractFileWriter::SetRanking(rank);
     }
 
+    if (SupportsBlockCompression(m_ImageIO))
+    {
+      this->SetDefaultWriterOptions(GetDefaultCompressionOptions());
+    }
+
+    if (SupportsMemoryMapping(m_ImageIO))
+    {
+      Options readerOptions;
+      readerOptions[IOConstants::MEMORY_MAPPING()] = false;
+      this->SetDefaultReaderOptions(readerOptions);
+    }
+
     this->RegisterService();
   }
 
@@ -237,7 +805,7 @@ namespace mitk
     return result;
   };
 
-  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path)
+  Image::Pointer ItkImageIO::LoadRawMitkImageFromImageIO(itk::ImageIOBase* imageIO, const std::string& path, bool useMemoryMapping)
   {
     LocaleSwitch localeSwitch("C");
 
@@ -309,11 +877,29 @@ namespace mitk
 
     MITK_INFO << "ioRegion: " << ioRegion << std::endl;
     imageIO->SetIORegion(ioRegion);
-    void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
-    imageIO->Read(buffer);
+
+    std::shared_ptr<MemoryMappedFile> mappedFile;
+    std::size_t pixelDataOffset = 0;
+
+    if (useMemoryMapping && ndim == imageIO->GetNumberOfDimensions())
+    {
+      mappedFile = MapPixelData(imageIO, path, pixelDataOffset);
+    }
 
     image->Initialize(MakePixelType(imageIO), ndim, dimensions);
-    image->SetImportChannel(buffer, 0, Image::ManageMemory);
+
+    if (nullptr != mappedFile)
+    {
+      // Pages are loaded on first access. Modified pages become private copies, the file is never written.
+      image->SetImportChannel(mappedFile->GetWritableData() + pixelDataOffset, 0, Image::ReferenceMemory);
+      image->GetChannelData(0)->SetMemoryOwner(mappedFile);
+    }
+    else
+    {
+      void* buffer = new unsigned char[imageIO->GetImageSizeInBytes()];
+      imageIO->Read(buffer);
+      image->SetImportChannel(buffer, 0, Image::ManageMemory);
+    }
 
     const itk::MetaDataDictionary& dictionary = imageIO->GetMetaDataDictionary();
 
@@ -526,7 +1112,12 @@ namespace mitk
   {
     std::vector<BaseData::Pointer> result;
 
-    auto image = LoadRawMitkImageFromImageIO(this->m_ImageIO, this->GetLocalFileName());
+    // Streams are read via temporary files, which must not be mapped
+    const auto memoryMapping = this->GetReaderOption(IOConstants::MEMORY_MAPPING());
+    const bool useMemoryMapping = nullptr == this->GetInputStream() && !memoryMapping.Empty() &&
+                                  memoryMapping.Type() == typeid(bool) && us::any_cast<bool>(memoryMapping);
+
+    auto image = LoadRawMitkImageFromImageIO(this->m_ImageIO, this->GetLocalFileName(), useMemoryMapping);
 
     const itk::MetaDataDictionary& dictionary = this->m_ImageIO->GetMetaDataDictionary();
 
@@ -730,12 +1321,8 @@ namespace mitk
       itk::EncapsulateMetaData<std::string>(m_ImageIO->GetMetaDataDictionary(), PROPERTY_KEY_UID, image->GetUID());
 
       // use compression if available
-      m_ImageIO->UseCompressionOn();
-      m_ImageIO->SetFileName(path);
-
       ImageReadAccessor imageAccess(image);
-      LocaleSwitch localeSwitch2("C");
-      m_ImageIO->Write(imageAccess.GetData());
+      WriteImageIO(m_ImageIO, path, imageAccess.GetData(), this->GetWriterOptions());
     }
     catch (const std::exception &e)
     {
@@ -0,0 +1,159 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkMemoryMappedFile.h>
+#include <mitkExceptionMacro.h>
+#include <mitkUtf8Util.h>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+mitk::MemoryMappedFile::MemoryMappedFile()
+  : m_Data(nullptr),
+    m_Size(0),
+    m_AccessMode(AccessMode::ReadOnly),
+    m_IsOpen(false)
+{
+}
+
+mitk::MemoryMappedFile::~MemoryMappedFile()
+{
+  this->Close();
+}
+
+void mitk::MemoryMappedFile::Open(const std::string &path, AccessMode accessMode)
+{
+  this->Close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(Utf8Util::Utf8ToLocal8Bit(path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (INVALID_HANDLE_VALUE == file)
+    mitkThrow() << "Cannot open " << path << " for memory mapping.";
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    mitkThrow() << "Cannot determine size of " << path << ".";
+  }
+
+  m_Size = static_cast<std::size_t>(size.QuadPart);
+
+  if (0 != m_Size)
+  {
+    const bool copyOnWrite = AccessMode::CopyOnWrite == accessMode;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (nullptr == mapping)
+      mitkThrow() << "Cannot memory map " << path << ".";
+
+    const DWORD access = copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+    m_Data = static_cast<char *>(MapViewOfFile(mapping, access, 0, 0, 0));
+    CloseHandle(mapping); // The view keeps the mapping alive
+
+    if (nullptr == m_Data)
+    {
+      m_Size = 0;
+      mitkThrow() << "Cannot memory map " << path << ".";
+    }
+  }
+  else
+  {
+    CloseHandle(file);
+  }
+#else
+  const int file = open(path.c_str(), O_RDONLY);
+
+  if (-1 == file)
+    mitkThrow() << "Cannot open " << path << " for memory mapping.";
+
+  struct stat status;
+  if (0 != fstat(file, &status))
+  {
+    close(file);
+    mitkThrow() << "Cannot determine size of " << path << ".";
+  }
+
+  m_Size = static_cast<std::size_t>(status.st_size);
+
+  if (0 != m_Size)
+  {
+    const int protection = AccessMode::CopyOnWrite == accessMode ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *data = mmap(nullptr, m_Size, protection, MAP_PRIVATE, file, 0);
+    close(file); // The mapping keeps the file alive
+
+    if (MAP_FAILED == data)
+    {
+      m_Size = 0;
+      mitkThrow() << "Cannot memory map " << path << ".";
+    }
+
+    m_Data = static_cast<char *>(data);
+  }
+  else
+  {
+    close(file);
+  }
+#endif
+
+  m_AccessMode = accessMode;
+  m_IsOpen = true;
+}
+
+void mitk::MemoryMappedFile::Close()
+{
+  if (nullptr != m_Data)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(m_Data);
+#else
+    munmap(m_Data, m_Size);
+#endif
+  }
+
+  m_Data = nullptr;
+  m_Size = 0;
+  m_IsOpen = false;
+}
+
+bool mitk::MemoryMappedFile::IsOpen() const
+{
+  return m_IsOpen;
+}
+
+const char *mitk::MemoryMappedFile::GetData() const
+{
+  return m_Data;
+}
+
+char *mitk::MemoryMappedFile::GetWritableData()
+{
+  return AccessMode::CopyOnWrite == m_AccessMode
+    ? m_Data
+    : nullptr;
+}
+
+std::size_t mitk::MemoryMappedFile::GetSize() const
+{
+  return m_Size;
+}
@@ -1119,6 +1119,8 @@ mitk::ImageVtkMapper2D::LocalStorage::LocalStorage()
   m_Actors = vtkSmartPointer<vtkPropAssembly>::New();
   m_EmptyActors = vtkSmartPointer<vtkPropAssembly>::New();
   m_Reslicer = mitk::ExtractSliceFilter::New();
+  // slices shown in several render windows are resliced only once
+  m_Reslicer->SetUseSliceCache(true);
   m_TSFilter = vtkSmartPointer<vtkMitkThickSlicesFilter>::New();
   m_OutlinePolyData = vtkSmartPointer<vtkPolyData>::New();
   m_ReslicedImage = vtkSmartPointer<vtkImageData>::New();
@@ -23,6 +23,8 @@ found in the LICENSE file.
 #include <vtkConeSource.h>
 #include <vtkCubeSource.h>
 #include <vtkCylinderSource.h>
+#include <vtkGlyph3DMapper.h>
+#include <vtkPointData.h>
 #include <vtkPolyDataAlgorithm.h>
 #include <vtkPolyDataMapper.h>
 #include <vtkPropAssembly.h>
@@ -32,8 +34,10 @@ found in the LICENSE file.
 #include <vtkTransform.h>
 #include <vtkTransformPolyDataFilter.h>
 #include <vtkTubeFilter.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkVectorText.h>
 
+#include <algorithm>
 #include <cstdlib>
 
 #include <mitkPropertyObserver.h>
@@ -48,6 +52,7 @@ mitk::PointSetVtkMapper3D::LocalStorage::LocalStorage()
 {
   /// All point positions, already in world coordinates
   m_WorldPositions = vtkSmartPointer<vtkPoints>::New();
+  m_WorldPositions->SetDataTypeToDouble();
   /// All connections between two points (used for contour drawing)
   m_PointConnections = vtkSmartPointer<vtkCellArray>::New(); // m_PointConnections between points
 
@@ -70,6 +75,43 @@ mitk::PointSetVtkMapper3D::LocalStorage::LocalStorage()
 
   // propassembly
   m_PointsAssembly = vtkSmartPointer<vtkPropAssembly>::New();
+
+  // instanced glyphs: one shared source per point type, selected by the "GlyphType" array
+  m_GlyphPolyData = vtkSmartPointer<vtkPolyData>::New();
+  m_GlyphPolyData->SetPoints(m_WorldPositions);
+
+  m_GlyphTypes = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  m_GlyphTypes->SetName("GlyphType");
+  m_GlyphSelection = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  m_GlyphSelection->SetName("Selected");
+  m_GlyphColors = vtkSmartPointer<vtkUnsignedCharArray>::New();
+  m_GlyphColors->SetName("Colors");
+  m_GlyphColors->SetNumberOfComponents(3);
+
+  m_GlyphPolyData->GetPointData()->AddArray(m_GlyphTypes);
+  m_GlyphPolyData->GetPointData()->AddArray(m_GlyphSelection);
+  m_GlyphPolyData->GetPointData()->SetScalars(m_GlyphColors);
+
+  m_GlyphSphereSource = vtkSmartPointer<vtkSphereSource>::New();
+  m_GlyphCubeSource = vtkSmartPointer<vtkCubeSource>::New();
+  m_GlyphConeSource = vtkSmartPointer<vtkConeSource>::New();
+  m_GlyphCylinderSource = vtkSmartPointer<vtkCylinderSource>::New();
+
+  m_GlyphMapper = vtkSmartPointer<vtkGlyph3DMapper>::New();
+  m_GlyphMapper->SetInputData(m_GlyphPolyData);
+  m_GlyphMapper->SetSourceConnection(0, m_GlyphSphereSource->GetOutputPort());
+  m_GlyphMapper->SetSourceConnection(1, m_GlyphCubeSource->GetOutputPort());
+  m_GlyphMapper->SetSourceConnection(2, m_GlyphConeSource->GetOutputPort());
+  m_GlyphMapper->SetSourceConnection(3, m_GlyphCylinderSource->GetOutputPort());
+  m_GlyphMapper->SourceIndexingOn();
+  m_GlyphMapper->SetSourceIndexArray("GlyphType");
+  m_GlyphMapper->ScalingOff();
+  m_GlyphMapper->OrientOff();
+  m_GlyphMapper->ScalarVisibilityOn();
+  m_GlyphMapper->SetColorModeToDirectScalars();
+
+  m_GlyphActor = vtkSmartPointer<vtkActor>::New();
+  m_GlyphActor->SetMapper(m_GlyphMapper);
 }
 
 // destructor LocalStorage
@@ -116,6 +158,7 @@ void mitk::PointSetVtkMapper3D::ReleaseGraphicsResources(mitk::BaseRenderer *ren
     ls->m_MarkedActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
     ls->m_HidedActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
     ls->m_ContourActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
+    ls->m_GlyphActor->ReleaseGraphicsResources(renderer->GetRenderWindow());
 }
 
 void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* renderer)
@@ -135,6 +178,8 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* rende
       ls->m_PointsAssembly->RemovePart(ls->m_HidedActor);
   if (ls->m_PointsAssembly->GetParts()->IsItemPresent(ls->m_MarkedActor))
       ls->m_PointsAssembly->RemovePart(ls->m_MarkedActor);
+  if (ls->m_PointsAssembly->GetParts()->IsItemPresent(ls->m_GlyphActor))
+    ls->m_PointsAssembly->RemovePart(ls->m_GlyphActor);
 
   // exceptional displaying for PositionTracker -> MouseOrientationTool
   int mapperID;
@@ -213,14 +258,37 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* rende
   ls->m_NumberOfUnselectedAdded = 0;
   ls->m_NumberOfHidedAdded = 0;
   ls->m_NumberOfMarkedAdded = 0;
-  vtkSmartPointer<vtkPoints> localPoints = vtkSmartPointer<vtkPoints>::New();
-  ls->m_WorldPositions = vtkSmartPointer<vtkPoints>::New();
   ls->m_PointConnections = vtkSmartPointer<vtkCellArray>::New(); // m_PointConnections between points
+
+  // the world positions are kept between updates, only the entries of moved points are rewritten
+  vtkSmartPointer<vtkLinearTransform> vtktransform = this->GetDataNode()->GetVtkTransform(this->GetTimestep());
+  const vtkIdType numberOfPositions = itkPointSet->GetPoints()->Size();
+  const bool resized = ls->m_WorldPositions->GetNumberOfPoints() != numberOfPositions;
+  if (resized)
+    ls->m_WorldPositions->SetNumberOfPoints(numberOfPositions);
+
+  ls->m_MovedPoints.clear();
   for (ptIdx = 0, pointsIter = itkPointSet->GetPoints()->Begin(); pointsIter != itkPointSet->GetPoints()->End();
        pointsIter++, ptIdx++)
   {
     itk::Point<float> currentPoint = pointsIter->Value();
-    localPoints->InsertPoint(ptIdx, currentPoint[0], currentPoint[1], currentPoint[2]);
+    const double localPosition[3] = {currentPoint[0], currentPoint[1], currentPoint[2]};
+    double worldPosition[3];
+    vtktransform->TransformPoint(localPosition, worldPosition);
+
+    bool moved = resized;
+    if (!moved)
+    {
+      double cachedPosition[3];
+      ls->m_WorldPositions->GetPoint(ptIdx, cachedPosition);
+      moved = !std::equal(worldPosition, worldPosition + 3, cachedPosition);
+    }
+
+    if (moved)
+    {
+      ls->m_WorldPositions->SetPoint(ptIdx, worldPosition);
+      ls->m_MovedPoints.push_back(ptIdx);
+    }
 
     if (makeContour && ptIdx < contourPointLimit)
     {
@@ -229,8 +297,8 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* rende
     }
   }
 
-  vtkSmartPointer<vtkLinearTransform> vtktransform = this->GetDataNode()->GetVtkTransform(this->GetTimestep());
-  vtktransform->TransformPoints(localPoints, ls->m_WorldPositions);
+  if (!ls->m_MovedPoints.empty())
+    ls->m_WorldPositions->Modified();
 
   // create contour
   if (makeContour)
@@ -242,6 +310,17 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* rende
   // inserted manually and can not be visualized according to the PointData (selected/unselected)
   bool pointDataBroken = (itkPointSet->GetPointData()->Size() != itkPointSet->GetPoints()->Size());
 
+  // labels need individual geometry per point, everything else is rendered as instanced glyphs
+  if (!showLabel)
+  {
+    this->UpdateGlyphs(renderer, itkPointSet, pointDataBroken, isInputDevice);
+
+    if (nbPoints > 0)
+      ls->m_PointsAssembly->AddPart(ls->m_GlyphActor);
+
+    return;
+  }
+
   // now add an object for each point in data
   mitk::PointSet::PointDataContainer::Iterator pointDataIter = itkPointSet->GetPointData()->Begin();
   for (ptIdx = 0; ptIdx < nbPoints; ++ptIdx) // pointDataIter moved at end of loop
@@ -473,6 +552,136 @@ void mitk::PointSetVtkMapper3D::CreateVTKRenderObjects(mitk::BaseRenderer* rende
   }
 }
 
+void mitk::PointSetVtkMapper3D::UpdateGlyphs(mitk::BaseRenderer *renderer,
+                                             const mitk::PointSet::DataType *itkPointSet,
+                                             bool pointDataBroken,
+                                             bool isInputDevice)
+{
+  LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
+
+  // the sources only re-tessellate if one of their parameters actually changes
+  const int resolution = isInputDevice ? 10 : 20; // MouseOrientation Tool (PositionTracker)
+  ls->m_GlyphSphereSource->SetRadius(m_PointSize / 2.0);
+  ls->m_GlyphSphereSource->SetThetaResolution(resolution);
+  ls->m_GlyphSphereSource->SetPhiResolution(resolution);
+  ls->m_GlyphCubeSource->SetXLength(m_PointSize / 2);
+  ls->m_GlyphCubeSource->SetYLength(m_PointSize / 2);
+  ls->m_GlyphCubeSource->SetZLength(m_PointSize / 2);
+  ls->m_GlyphConeSource->SetRadius(m_PointSize / 2.0);
+  ls->m_GlyphConeSource->SetResolution(20);
+  ls->m_GlyphCylinderSource->SetRadius(m_PointSize / 2.0);
+  ls->m_GlyphCylinderSource->SetResolution(20);
+
+  // the glyphs are placed at the world positions, which are only rewritten for moved points
+  const vtkIdType numberOfPoints = ls->m_WorldPositions->GetNumberOfPoints();
+  const bool resized = ls->m_GlyphTypes->GetNumberOfTuples() != numberOfPoints;
+
+  if (resized)
+  {
+    ls->m_GlyphTypes->SetNumberOfTuples(numberOfPoints);
+    ls->m_GlyphSelection->SetNumberOfTuples(numberOfPoints);
+    ls->m_GlyphColors->SetNumberOfTuples(numberOfPoints);
+    ls->m_GlyphColors->FillValue(0);
+  }
+
+  bool flagsChanged = false;
+
+  ls->m_ChangedGlyphs.clear();
+  auto movedIter = ls->m_MovedPoints.cbegin();
+  const auto movedEnd = ls->m_MovedPoints.cend();
+
+  auto pointDataIter = itkPointSet->GetPointData()->Begin();
+  const auto pointDataEnd = itkPointSet->GetPointData()->End();
+
+  for (vtkIdType ptIdx = 0; ptIdx < numberOfPoints; ++ptIdx)
+  {
+    bool changed = resized;
+
+    if (movedIter != movedEnd && *movedIter == ptIdx)
+    {
+      changed = true;
+      ++movedIter;
+    }
+
+    int pointType = mitk::PTUNDEFINED;
+    bool selected = false;
+    if (!pointDataBroken && pointDataIter != pointDataEnd)
+    {
+      pointType = pointDataIter.Value().pointSpec;
+      selected = pointDataIter.Value().selected;
+      ++pointDataIter;
+    }
+
+    // index of the glyph source, see LocalStorage()
+    unsigned char glyphType = 0;
+    switch (pointType)
+    {
+      case mitk::PTSTART:
+        glyphType = 1;
+        break;
+      case mitk::PTCORNER:
+        glyphType = 2;
+        break;
+      case mitk::PTEDGE:
+        glyphType = 3;
+        break;
+      default:
+        break;
+    }
+
+    const unsigned char selectionFlag = selected ? 1 : 0;
+
+    if (resized || ls->m_GlyphTypes->GetValue(ptIdx) != glyphType || ls->m_GlyphSelection->GetValue(ptIdx) != selectionFlag)
+    {
+      ls->m_GlyphTypes->SetValue(ptIdx, glyphType);
+      ls->m_GlyphSelection->SetValue(ptIdx, selectionFlag);
+      flagsChanged = true;
+      changed = true;
+    }
+
+    if (changed)
+      ls->m_ChangedGlyphs.push_back(ptIdx);
+  }
+
+  if (flagsChanged)
+  {
+    ls->m_GlyphTypes->Modified();
+    ls->m_GlyphSelection->Modified();
+  }
+}
+
+void mitk::PointSetVtkMapper3D::UpdateGlyphColors(mitk::BaseRenderer *renderer,
+                                                  const double selectedColor[3],
+                                                  const double unselectedColor[3])
+{
+  LocalStorage *ls = m_LSH.GetLocalStorage(renderer);
+
+  unsigned char colors[2][3];
+  for (int i = 0; i < 3; ++i)
+  {
+    colors[0][i] = static_cast<unsigned char>(std::min(std::max(unselectedColor[i], 0.0), 1.0) * 255.0 + 0.5);
+    colors[1][i] = static_cast<unsigned char>(std::min(std::max(selectedColor[i], 0.0), 1.0) * 255.0 + 0.5);
+  }
+
+  bool colorsChanged = false;
+  const vtkIdType numberOfPoints = ls->m_GlyphColors->GetNumberOfTuples();
+
+  for (vtkIdType ptIdx = 0; ptIdx < numberOfPoints; ++ptIdx)
+  {
+    const unsigned char *color = colors[ls->m_GlyphSelection->GetValue(ptIdx) != 0 ? 1 : 0];
+    unsigned char *glyphColor = ls->m_GlyphColors->GetPointer(3 * ptIdx);
+
+    if (!std::equal(color, color + 3, glyphColor))
+    {
+      std::copy(color, color + 3, glyphColor);
+      colorsChanged = true;
+    }
+  }
+
+  if (colorsChanged)
+    ls->m_GlyphColors->Modified();
+}
+
 void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *renderer)
 {
   LocalStorage* ls = m_LSH.GetLocalStorage(renderer);
@@ -485,6 +694,7 @@ void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rend
     ls->m_ContourActor->VisibilityOff();
     ls->m_MarkedActor->VisibilityOff();
     ls->m_HidedActor->VisibilityOff();
+    ls->m_GlyphActor->VisibilityOff();
     return;
   }
 
@@ -516,6 +726,7 @@ void mitk::PointSetVtkMapper3D::GenerateDataForRenderer(mitk::BaseRenderer *rend
   ls->m_SelectedActor->SetVisibility(showPoints);
   ls->m_MarkedActor->SetVisibility(showPoints);
   ls->m_HidedActor->SetVisibility(false);
+  ls->m_GlyphActor->SetVisibility(showPoints);
 
   if (false && dynamic_cast<mitk::FloatProperty *>(this->GetDataNode()->GetProperty("opacity")) != nullptr)
   {
@@ -681,6 +892,9 @@ void mitk::PointSetVtkMapper3D::ApplyAllProperties(mitk::BaseRenderer *renderer,
 
   ls->m_MarkedActor->GetProperty()->SetColor(markedColor);
   ls->m_MarkedActor->GetProperty()->SetOpacity(opacity);
+
+  this->UpdateGlyphColors(renderer, selectedColor, unselectedColor);
+  ls->m_GlyphActor->GetProperty()->SetOpacity(opacity);
 }
 
 void mitk::PointSetVtkMapper3D::CreateContour(vtkPoints* points, vtkCellArray* PointConnections, mitk::BaseRenderer* renderer)
@@ -0,0 +1,288 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRenderingProfiler.h>
+
+#include <mitkBaseRenderer.h>
+#include <mitkDataNode.h>
+#include <mitkMapper.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+namespace
+{
+  const char *GetCategoryName(mitk::RenderingProfiler::EventCategory category)
+  {
+    switch (category)
+    {
+      case mitk::RenderingProfiler::EventCategory::Frame:
+        return "Frame";
+      case mitk::RenderingProfiler::EventCategory::RenderPass:
+        return "RenderPass";
+      case mitk::RenderingProfiler::EventCategory::MapperUpdate:
+        return "MapperUpdate";
+      default:
+        return "Other";
+    }
+  }
+
+  std::string GetRendererName(const mitk::BaseRenderer *renderer)
+  {
+    return nullptr != renderer && nullptr != renderer->GetName()
+      ? renderer->GetName()
+      : std::string();
+  }
+}
+
+mitk::RenderingProfiler::Scope::Scope(EventCategory category, const char *name, const BaseRenderer *renderer)
+  : m_Active(RenderingProfiler::GetInstance()->IsEnabled()),
+    m_Category(category),
+    m_Name(name),
+    m_Node(nullptr),
+    m_Mapper(nullptr),
+    m_Renderer(renderer)
+{
+  if (m_Active)
+    m_Begin = std::chrono::steady_clock::now();
+}
+
+mitk::RenderingProfiler::Scope::Scope(const DataNode *node, const Mapper *mapper, const BaseRenderer *renderer)
+  : m_Active(RenderingProfiler::GetInstance()->IsEnabled()),
+    m_Category(EventCategory::MapperUpdate),
+    m_Name(nullptr),
+    m_Node(node),
+    m_Mapper(mapper),
+    m_Renderer(renderer)
+{
+  if (m_Active)
+    m_Begin = std::chrono::steady_clock::now();
+}
+
+mitk::RenderingProfiler::Scope::~Scope()
+{
+  if (!m_Active)
+    return;
+
+  const auto end = std::chrono::steady_clock::now();
+  std::string name;
+
+  if (nullptr != m_Name)
+  {
+    name = m_Name;
+  }
+  else if (nullptr != m_Node)
+  {
+    name = m_Node->GetName();
+
+    if (nullptr != m_Mapper)
+      name += std::string(" (") + m_Mapper->GetNameOfClass() + ')';
+  }
+
+  RenderingProfiler::GetInstance()->AddEvent(m_Category, name, GetRendererName(m_Renderer), m_Begin, end);
+}
+
+mitk::RenderingProfiler *mitk::RenderingProfiler::GetInstance()
+{
+  static RenderingProfiler instance;
+  return &instance;
+}
+
+mitk::RenderingProfiler::RenderingProfiler()
+  : m_Enabled(false),
+    m_StartTime(std::chrono::steady_clock::now()),
+    m_MaximumNumberOfEvents(100000),
+    m_FrameWindowSize(100)
+{
+}
+
+mitk::RenderingProfiler::~RenderingProfiler()
+{
+}
+
+void mitk::RenderingProfiler::SetEnabled(bool enabled)
+{
+  m_Enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void mitk::RenderingProfiler::AddEvent(EventCategory category,
+                                       const std::string &name,
+                                       const std::string &rendererName,
+                                       std::chrono::steady_clock::time_point begin,
+                                       std::chrono::steady_clock::time_point end)
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  const double milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  if (category == EventCategory::Frame)
+  {
+    auto &frameTimes = m_FrameTimes[rendererName];
+    frameTimes.push_back(milliseconds);
+
+    while (frameTimes.size() > m_FrameWindowSize)
+      frameTimes.pop_front();
+  }
+  else if (category == EventCategory::MapperUpdate)
+  {
+    auto &statistics = m_UpdateStatistics[name];
+    ++statistics.NumberOfUpdates;
+    statistics.TotalTime += milliseconds;
+    statistics.MaximumTime = std::max(statistics.MaximumTime, milliseconds);
+  }
+
+  if (0 == m_MaximumNumberOfEvents)
+    return;
+
+  while (m_Events.size() >= m_MaximumNumberOfEvents)
+    m_Events.pop_front();
+
+  m_Events.push_back({ category,
+                       name,
+                       rendererName,
+                       duration_cast<microseconds>(begin - m_StartTime).count(),
+                       duration_cast<microseconds>(end - begin).count() });
+}
+
+mitk::RenderingProfiler::FrameStatistics mitk::RenderingProfiler::GetFrameStatistics(const std::string &rendererName) const
+{
+  FrameStatistics statistics;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto iter = m_FrameTimes.find(rendererName);
+
+  if (iter == m_FrameTimes.end() || iter->second.empty())
+    return statistics;
+
+  const auto &frameTimes = iter->second;
+  const auto minMax = std::minmax_element(frameTimes.begin(), frameTimes.end());
+
+  statistics.NumberOfFrames = frameTimes.size();
+  statistics.LastFrameTime = frameTimes.back();
+  statistics.MeanFrameTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / frameTimes.size();
+  statistics.MinimumFrameTime = *minMax.first;
+  statistics.MaximumFrameTime = *minMax.second;
+
+  return statistics;
+}
+
+std::map<std::string, mitk::RenderingProfiler::UpdateStatistics> mitk::RenderingProfiler::GetUpdateStatistics() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_UpdateStatistics;
+}
+
+void mitk::RenderingProfiler::SetFrameWindowSize(std::size_t frameWindowSize)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_FrameWindowSize = std::max<std::size_t>(1, frameWindowSize);
+
+  for (auto &frameTimes : m_FrameTimes)
+  {
+    while (frameTimes.second.size() > m_FrameWindowSize)
+      frameTimes.second.pop_front();
+  }
+}
+
+std::size_t mitk::RenderingProfiler::GetFrameWindowSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_FrameWindowSize;
+}
+
+void mitk::RenderingProfiler::SetMaximumNumberOfEvents(std::size_t maximumNumberOfEvents)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_MaximumNumberOfEvents = maximumNumberOfEvents;
+
+  while (m_Events.size() > m_MaximumNumberOfEvents)
+    m_Events.pop_front();
+}
+
+std::size_t mitk::RenderingProfiler::GetMaximumNumberOfEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumNumberOfEvents;
+}
+
+std::size_t mitk::RenderingProfiler::GetNumberOfEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events.size();
+}
+
+void mitk::RenderingProfiler::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  m_Events.clear();
+  m_FrameTimes.clear();
+  m_UpdateStatistics.clear();
+}
+
+void mitk::RenderingProfiler::WriteChromeTrace(std::ostream &stream) const
+{
+  auto traceEvents = nlohmann::json::array();
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    // Chrome trace viewers group events by thread id, so each renderer gets its own track
+    std::map<std::string, int> trackIds;
+
+    for (const auto &event : m_Events)
+    {
+      auto trackId = trackIds.emplace(event.RendererName, static_cast<int>(trackIds.size()) + 1).first->second;
+
+      traceEvents.push_back({ { "name", event.Name },
+                              { "cat", GetCategoryName(event.Category) },
+                              { "ph", "X" },
+                              { "ts", event.Begin },
+                              { "dur", event.Duration },
+                              { "pid", 1 },
+                              { "tid", trackId },
+                              { "args", { { "renderer", event.RendererName } } } });
+    }
+
+    for (const auto &trackId : trackIds)
+    {
+      traceEvents.push_back({ { "name", "thread_name" },
+                              { "ph", "M" },
+                              { "pid", 1 },
+                              { "tid", trackId.second },
+                              { "args", { { "name", trackId.first.empty() ? "Unknown renderer" : trackId.first } } } });
+    }
+  }
+
+  stream << nlohmann::json{ { "traceEvents", traceEvents }, { "displayTimeUnit", "ms" } }.dump();
+}
+
+bool mitk::RenderingProfiler::WriteChromeTrace(const std::string &fileName) const
+{
+  std::ofstream stream(fileName);
+
+  if (!stream.is_open())
+    return false;
+
+  this->WriteChromeTrace(stream);
+
+  return stream.good();
+}
@@ -27,6 +27,7 @@ found in the LICENSE file.
 #include <mitkPlaneGeometry.h>
 #include <mitkProperties.h>
 #include <mitkRenderingManager.h>
+#include <mitkRenderingProfiler.h>
 #include <mitkSurface.h>
 #include <mitkVtkInteractorStyle.h>
 
@@ -162,9 +163,13 @@ int mitk::VtkPropRenderer::Render(mitk::VtkPropRenderer::RenderType type)
   if (m_DataStorage.IsNull())
     return 0;
 
+  static const char *renderPassNames[] = { "Opaque", "Translucent", "Overlay", "Volumetric" };
+  RenderingProfiler::Scope profilerScope(RenderingProfiler::EventCategory::RenderPass, renderPassNames[type], this);
+
   // Update mappers and prepare mapper queue
   if (type == VtkPropRenderer::Opaque)
   {
+    RenderingProfiler::Scope prepareScope(RenderingProfiler::EventCategory::RenderPass, "PrepareMapperQueue", this);
     this->PrepareMapperQueue();
     // Share vtkInformation, there might be new mappers
     this->PropagateRenderInfoToMappers();
@@ -183,6 +188,7 @@ int mitk::VtkPropRenderer::Render(mitk::VtkPropRenderer::RenderType type)
   {
     if (m_TextCollection.size() > 0)
     {
+      RenderingProfiler::Scope textScope(RenderingProfiler::EventCategory::RenderPass, "Text", this);
       m_TextRenderer->SetViewport(this->GetVtkRenderer()->GetViewport());
       for (auto it = m_TextCollection.begin(); it != m_TextCollection.end(); ++it)
         m_TextRenderer->AddViewProp((*it).second);
@@ -295,7 +301,10 @@ void mitk::VtkPropRenderer::Update(mitk::DataNode *datatreenode)
     {
       if (GetCurrentWorldPlaneGeometry()->IsValid())
       {
-        mapper->Update(this);
+        {
+          RenderingProfiler::Scope updateScope(datatreenode, mapper, this);
+          mapper->Update(this);
+        }
         {
           auto *vtkmapper = dynamic_cast<VtkMapper *>(mapper.GetPointer());
           if (vtkmapper != nullptr)
@@ -82,7 +82,9 @@ set(MODULE_TESTS
   mitkVectorTest.cpp
   mitkClippedSurfaceBoundsCalculatorTest.cpp
   mitkExceptionTest.cpp
+  mitkExtractSliceCacheTest.cpp
   mitkExtractSliceFilterTest.cpp
+  mitkRenderingProfilerTest.cpp
   mitkLogTest.cpp
   mitkImageDimensionConverterTest.cpp
   mitkLoggingAdapterTest.cpp
@@ -110,6 +112,8 @@ set(MODULE_TESTS
   mitkLineTest.cpp
   mitkArbitraryTimeGeometryTest.cpp
   mitkItkImageIOTest.cpp
+  mitkGzipBlockCompressorTest.cpp
+  mitkImageMemoryMappingTest.cpp
   mitkLevelWindowManagerTest.cpp
   mitkVectorPropertyTest.cpp
   mitkTemporoSpatialStringPropertyTest.cpp
@@ -127,6 +131,7 @@ set(MODULE_RENDERING_TESTS
   mitkPointSetDataInteractorTest.cpp
   mitkSurfaceVtkMapper2DTest.cpp
   mitkSurfaceVtkMapper2D3DTest.cpp
+  mitkPointSetVtkMapper3DTest.cpp
 )
 
 # test with image filename as an extra command line parameter
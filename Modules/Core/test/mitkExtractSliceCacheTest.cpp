@@ -0,0 +1,111 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkExtractSliceCache.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <algorithm>
+
+class mitkExtractSliceCacheTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkExtractSliceCacheTestSuite);
+  MITK_TEST(TestHitAndMiss);
+  MITK_TEST(TestOutdatedInput);
+  MITK_TEST(TestMaximumMemory);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  int m_Input;
+
+  vtkSmartPointer<vtkImageData> CreateSlice(unsigned char value)
+  {
+    auto slice = vtkSmartPointer<vtkImageData>::New();
+    slice->SetDimensions(64, 64, 1);
+    slice->AllocateScalars(VTK_UNSIGNED_CHAR, 1);
+    std::fill_n(static_cast<unsigned char *>(slice->GetScalarPointer()), 64 * 64, value);
+    return slice;
+  }
+
+  mitk::ExtractSliceCache::Key CreateKey(itk::ModifiedTimeType mTime, double originZ)
+  {
+    mitk::ExtractSliceCache::Key key;
+    key.Input = &m_Input;
+    key.InputMTime = mTime;
+    key.ResliceAxes[11] = originZ;
+    key.OutputExtent = { 0, 63, 0, 63, 0, 0 };
+    key.OutputSpacing = { 1.0, 1.0, 1.0 };
+    return key;
+  }
+
+public:
+  void TestHitAndMiss()
+  {
+    mitk::ExtractSliceCache cache;
+
+    CPPUNIT_ASSERT(nullptr == cache.Find(this->CreateKey(1, 0.0)));
+
+    cache.Insert(this->CreateKey(1, 0.0), this->CreateSlice(7));
+    auto slice = cache.Find(this->CreateKey(1, 0.0));
+
+    CPPUNIT_ASSERT(nullptr != slice);
+    CPPUNIT_ASSERT_EQUAL(7, static_cast<int>(*static_cast<unsigned char *>(slice->GetScalarPointer())));
+    CPPUNIT_ASSERT(nullptr == cache.Find(this->CreateKey(1, 1.0)));
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(1), cache.GetNumberOfHits());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(2), cache.GetNumberOfMisses());
+
+    cache.ResetStatistics();
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), cache.GetNumberOfHits());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), cache.GetNumberOfMisses());
+  }
+
+  void TestOutdatedInput()
+  {
+    mitk::ExtractSliceCache cache;
+
+    cache.Insert(this->CreateKey(1, 0.0), this->CreateSlice(1));
+    cache.Insert(this->CreateKey(1, 1.0), this->CreateSlice(1));
+    cache.Insert(this->CreateKey(2, 0.0), this->CreateSlice(2));
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), cache.GetNumberOfEntries());
+    CPPUNIT_ASSERT(nullptr == cache.Find(this->CreateKey(1, 0.0)));
+    CPPUNIT_ASSERT(nullptr != cache.Find(this->CreateKey(2, 0.0)));
+  }
+
+  void TestMaximumMemory()
+  {
+    mitk::ExtractSliceCache cache;
+
+    cache.Insert(this->CreateKey(1, 0.0), this->CreateSlice(0));
+    const auto sliceSize = cache.GetMemoryUsage();
+    CPPUNIT_ASSERT(sliceSize > 0);
+
+    cache.SetMaximumMemory(2 * sliceSize);
+    cache.Insert(this->CreateKey(1, 1.0), this->CreateSlice(1));
+    cache.Find(this->CreateKey(1, 0.0));
+    cache.Insert(this->CreateKey(1, 2.0), this->CreateSlice(2));
+
+    // The least recently used slice is evicted
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), cache.GetNumberOfEntries());
+    CPPUNIT_ASSERT(cache.GetMemoryUsage() <= cache.GetMaximumMemory());
+    CPPUNIT_ASSERT(nullptr != cache.Find(this->CreateKey(1, 0.0)));
+    CPPUNIT_ASSERT(nullptr == cache.Find(this->CreateKey(1, 1.0)));
+    CPPUNIT_ASSERT(nullptr != cache.Find(this->CreateKey(1, 2.0)));
+
+    cache.Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.GetNumberOfEntries());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), cache.GetMemoryUsage());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkExtractSliceCache)
@@ -0,0 +1,271 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkGzipBlockCompressor.h>
+
+#include <mitkIOConstants.h>
+#include <mitkIOUtil.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkItkImageIO.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImage.h>
+#include <itkImageIOFactory.h>
+#include <itkImageRegionIterator.h>
+#include <itk_zlib.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+class mitkGzipBlockCompressorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkGzipBlockCompressorTestSuite);
+  MITK_TEST(CompressBufferTest);
+  MITK_TEST(CompressStreamTest);
+  MITK_TEST(CompressEmptyInputTest);
+  MITK_TEST(WriteNiftiTest);
+  MITK_TEST(WriteNrrdTest);
+  MITK_TEST(ThroughputTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::vector<char> m_Data;
+  mitk::Image::Pointer m_Image;
+
+  /** Decompresses a single gzip member and checks that no data follows it.*/
+  static std::vector<char> Decompress(const std::string &compressed, std::size_t expectedSize)
+  {
+    std::vector<char> result(expectedSize + 1);
+
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    CPPUNIT_ASSERT_EQUAL(Z_OK, inflateInit2(&stream, 16 + MAX_WBITS));
+
+    stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    stream.next_out = reinterpret_cast<Bytef *>(result.data());
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    const auto ret = inflate(&stream, Z_FINISH);
+    const auto remainingInput = stream.avail_in;
+    result.resize(stream.total_out);
+    inflateEnd(&stream);
+
+    CPPUNIT_ASSERT_EQUAL(Z_STREAM_END, ret);
+    CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(remainingInput));
+
+    return result;
+  }
+
+  static std::string ReadFile(const std::string &path)
+  {
+    std::ifstream stream(path, std::ios_base::binary);
+    std::ostringstream content;
+    content << stream.rdbuf();
+    return content.str();
+  }
+
+  static mitk::Image::Pointer CreateLabelImage(unsigned int size)
+  {
+    using ImageType = itk::Image<unsigned short, 3>;
+
+    auto itkImage = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize(0, size);
+    region.SetSize(1, size);
+    region.SetSize(2, size / 2);
+    itkImage->SetRegions(region);
+    itkImage->Allocate();
+
+    itk::ImageRegionIterator<ImageType> iter(itkImage, region);
+
+    for (; !iter.IsAtEnd(); ++iter)
+    {
+      const auto index = iter.GetIndex();
+      iter.Set(static_cast<unsigned short>((index[0] / 7 + index[1] / 5 + index[2] / 3) % 4));
+    }
+
+    return mitk::GrabItkImageMemory(itkImage);
+  }
+
+public:
+  void setUp() override
+  {
+    // Mixture of compressible runs and noise, spanning several blocks and batches
+    m_Data.resize(5 * 65536 + 123);
+    unsigned int state = 1;
+
+    for (std::size_t i = 0; i < m_Data.size(); ++i)
+    {
+      state = state * 1103515245u + 12345u;
+      m_Data[i] = (i / 1000) % 4 == 0 ? static_cast<char>(state >> 24) : static_cast<char>((i / 300) % 5);
+    }
+
+    m_Image = CreateLabelImage(64);
+  }
+
+  void tearDown() override
+  {
+    m_Data.clear();
+    m_Image = nullptr;
+  }
+
+  void CompressBufferTest()
+  {
+    for (int level : { 0, 1, 6, 9 })
+    {
+      for (auto strategy : { mitk::GzipBlockCompressor::Strategy::Default, mitk::GzipBlockCompressor::Strategy::RunLength })
+      {
+        mitk::GzipBlockCompressor compressor;
+        compressor.SetCompressionLevel(level);
+        compressor.SetStrategy(strategy);
+        compressor.SetBlockSize(65536);
+        compressor.SetNumberOfThreads(2);
+
+        std::ostringstream output;
+        compressor.Compress(m_Data.data(), m_Data.size(), output);
+
+        CPPUNIT_ASSERT_MESSAGE("Level " + std::to_string(level), Decompress(output.str(), m_Data.size()) == m_Data);
+      }
+    }
+  }
+
+  void CompressStreamTest()
+  {
+    mitk::GzipBlockCompressor compressor;
+    compressor.SetBlockSize(65536);
+    compressor.SetNumberOfThreads(3);
+
+    std::istringstream input(std::string(m_Data.data(), m_Data.size()));
+    std::ostringstream streamOutput;
+    compressor.Compress(input, streamOutput);
+
+    CPPUNIT_ASSERT(Decompress(streamOutput.str(), m_Data.size()) == m_Data);
+
+    // Streams and buffers are split into the same blocks
+    std::ostringstream bufferOutput;
+    compressor.Compress(m_Data.data(), m_Data.size(), bufferOutput);
+    CPPUNIT_ASSERT(streamOutput.str() == bufferOutput.str());
+  }
+
+  void CompressEmptyInputTest()
+  {
+    mitk::GzipBlockCompressor compressor;
+
+    std::ostringstream bufferOutput;
+    compressor.Compress(nullptr, 0, bufferOutput);
+    CPPUNIT_ASSERT(Decompress(bufferOutput.str(), 0).empty());
+
+    std::istringstream input;
+    std::ostringstream streamOutput;
+    compressor.Compress(input, streamOutput);
+    CPPUNIT_ASSERT(Decompress(streamOutput.str(), 0).empty());
+  }
+
+  void WriteNiftiTest()
+  {
+    const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX.nii.gz");
+    mitk::IOUtil::Save(m_Image, path);
+
+    const auto content = ReadFile(path);
+    CPPUNIT_ASSERT(content.size() > 2 && content[0] == '\x1f' && content[1] == '\x8b');
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    MITK_ASSERT_EQUAL(m_Image, loadedImage, "Written NIfTI image differs from the original.");
+
+    // Level 0 still writes a gzip stream because of the extension, but without compressing the data
+    auto options = mitk::ItkImageIO::GetDefaultCompressionOptions();
+    options[mitk::IOConstants::COMPRESSION_LEVEL()] = 0;
+    mitk::IOUtil::Save(m_Image, path, options);
+
+    const auto storedContent = ReadFile(path);
+    const auto pixelDataSize = m_Image->GetPixelType().GetSize() * 64 * 64 * 32;
+    CPPUNIT_ASSERT(storedContent.size() > 2 && storedContent[0] == '\x1f' && storedContent[1] == '\x8b');
+    CPPUNIT_ASSERT(storedContent.size() > pixelDataSize);
+
+    loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    MITK_ASSERT_EQUAL(m_Image, loadedImage, "Written NIfTI image differs from the original.");
+
+    std::remove(path.c_str());
+  }
+
+  void WriteNrrdTest()
+  {
+    auto options = mitk::ItkImageIO::GetDefaultCompressionOptions();
+    options[mitk::IOConstants::COMPRESSION_LEVEL()] = 1;
+    options[mitk::IOConstants::COMPRESSION_STRATEGY()] = mitk::IOConstants::COMPRESSION_STRATEGY_RUN_LENGTH();
+
+    const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX.nrrd");
+    mitk::IOUtil::Save(m_Image, path, options);
+
+    CPPUNIT_ASSERT(ReadFile(path).find("encoding: gzip\n") != std::string::npos);
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    MITK_ASSERT_EQUAL(m_Image, loadedImage, "Written NRRD image differs from the original.");
+
+    // Level 0 writes the data raw encoded
+    options[mitk::IOConstants::COMPRESSION_LEVEL()] = 0;
+    mitk::IOUtil::Save(m_Image, path, options);
+    CPPUNIT_ASSERT(ReadFile(path).find("encoding: raw\n") != std::string::npos);
+    loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    MITK_ASSERT_EQUAL(m_Image, loadedImage, "Written NRRD image differs from the original.");
+
+    std::remove(path.c_str());
+  }
+
+  /** Compares the ITK writer with its built-in (single-threaded) compression to the block compressed writing.
+   * Only reports the throughput, as timings depend on the machine.*/
+  void ThroughputTest()
+  {
+    auto image = CreateLabelImage(256);
+    mitk::ImageReadAccessor accessor(image);
+    const double megabytes = image->GetPixelType().GetSize() * 256.0 * 256.0 * 128.0 / (1024.0 * 1024.0);
+
+    for (const std::string extension : { ".nii.gz", ".nrrd" })
+    {
+      const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX" + extension);
+
+      auto imageIO = itk::ImageIOFactory::CreateImageIO(path.c_str(), itk::IOFileModeEnum::WriteMode);
+      CPPUNIT_ASSERT(imageIO.IsNotNull());
+      mitk::ItkImageIO::PreparImageIOToWriteImage(imageIO, image);
+
+      auto start = std::chrono::steady_clock::now();
+      imageIO->UseCompressionOn();
+      imageIO->SetFileName(path);
+      imageIO->Write(accessor.GetData());
+      const double itkSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      const auto itkSize = ReadFile(path).size();
+
+      for (const auto &strategy : { mitk::IOConstants::COMPRESSION_STRATEGY_DEFAULT(), mitk::IOConstants::COMPRESSION_STRATEGY_RUN_LENGTH() })
+      {
+        auto options = mitk::ItkImageIO::GetDefaultCompressionOptions();
+        options[mitk::IOConstants::COMPRESSION_STRATEGY()] = strategy;
+
+        start = std::chrono::steady_clock::now();
+        mitk::ItkImageIO::WriteImageIO(imageIO, path, accessor.GetData(), options);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        MITK_INFO << extension << ": ITK " << megabytes / itkSeconds << " MiB/s (" << itkSize << " bytes), block compression ("
+                  << strategy << ") " << megabytes / seconds << " MiB/s (" << ReadFile(path).size() << " bytes)";
+      }
+
+      std::remove(path.c_str());
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkGzipBlockCompressor)
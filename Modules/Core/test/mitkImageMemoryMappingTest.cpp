@@ -0,0 +1,162 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOConstants.h>
+#include <mitkIOUtil.h>
+#include <mitkITKImageImport.h>
+#include <mitkImageDataItem.h>
+#include <mitkImagePixelWriteAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkImage.h>
+#include <itkImageRegionIterator.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+class mitkImageMemoryMappingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkImageMemoryMappingTestSuite);
+  MITK_TEST(MapNrrdTest);
+  MITK_TEST(MapNiftiTest);
+  MITK_TEST(MapMetaImageTest);
+  MITK_TEST(CompressedFallbackTest);
+  MITK_TEST(DisabledByDefaultTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::Image::Pointer m_Image;
+  mitk::IFileReader::Options m_ReaderOptions;
+  mitk::IFileWriter::Options m_WriterOptions;
+
+  static bool IsMemoryMapped(const mitk::Image *image)
+  {
+    return nullptr != image->GetChannelData(0)->GetMemoryOwner();
+  }
+
+  /** Loads the file memory mapped, modifies the image and checks that the file is not affected.*/
+  void CheckMapping(const std::string &extension)
+  {
+    const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX" + extension);
+    mitk::IOUtil::Save(m_Image, path, m_WriterOptions);
+
+    auto mappedImage = mitk::IOUtil::Load<mitk::Image>(path, m_ReaderOptions);
+    CPPUNIT_ASSERT_MESSAGE(extension, IsMemoryMapped(mappedImage));
+    MITK_ASSERT_EQUAL(m_Image, mappedImage, "Memory mapped " + extension + " image differs from the original.");
+
+    {
+      mitk::ImagePixelWriteAccessor<short, 3> accessor(mappedImage);
+      accessor.SetPixelByIndex({ { 1, 2, 3 } }, 1000);
+      CPPUNIT_ASSERT_EQUAL(short(1000), accessor.GetPixelByIndex({ { 1, 2, 3 } }));
+    }
+
+    // Modifications are private copies of the mapped pages
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT(!IsMemoryMapped(loadedImage));
+    MITK_ASSERT_EQUAL(m_Image, loadedImage, "Modification of the memory mapped image changed " + extension + " file.");
+
+    // The mapping is released with the image, i.e. the file can be removed on all platforms
+    mappedImage = nullptr;
+    CPPUNIT_ASSERT_EQUAL(0, std::remove(path.c_str()));
+  }
+
+public:
+  void setUp() override
+  {
+    using ImageType = itk::Image<short, 3>;
+
+    auto itkImage = ImageType::New();
+    ImageType::RegionType region;
+    region.SetSize(0, 32);
+    region.SetSize(1, 24);
+    region.SetSize(2, 8);
+    itkImage->SetRegions(region);
+    itkImage->Allocate();
+
+    itk::ImageRegionIterator<ImageType> iter(itkImage, region);
+
+    for (short value = 0; !iter.IsAtEnd(); ++iter, ++value)
+      iter.Set(value);
+
+    m_Image = mitk::GrabItkImageMemory(itkImage);
+
+    m_ReaderOptions[mitk::IOConstants::MEMORY_MAPPING()] = true;
+    m_WriterOptions[mitk::IOConstants::COMPRESSION_LEVEL()] = 0;
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_ReaderOptions.clear();
+    m_WriterOptions.clear();
+  }
+
+  void MapNrrdTest()
+  {
+    // Compression level 0 writes raw encoded NRRD files, which can be mapped
+    const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX.nrrd");
+    mitk::IOUtil::Save(m_Image, path, m_WriterOptions);
+
+    std::ifstream file(path, std::ios_base::binary);
+    std::string line;
+    bool rawEncoding = false;
+
+    while (std::getline(file, line) && !line.empty())
+      rawEncoding = rawEncoding || line == "encoding: raw";
+
+    file.close();
+    std::remove(path.c_str());
+    CPPUNIT_ASSERT_MESSAGE("NRRD file written with compression level 0 is not raw encoded.", rawEncoding);
+
+    CheckMapping(".nrrd");
+  }
+
+  void MapNiftiTest()
+  {
+    CheckMapping(".nii");
+  }
+
+  void MapMetaImageTest()
+  {
+    CheckMapping(".mha");
+  }
+
+  void CompressedFallbackTest()
+  {
+    for (const std::string extension : { ".nii.gz", ".nrrd" })
+    {
+      const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX" + extension);
+      mitk::IOUtil::Save(m_Image, path);
+
+      auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path, m_ReaderOptions);
+      CPPUNIT_ASSERT_MESSAGE(extension, !IsMemoryMapped(loadedImage));
+      MITK_ASSERT_EQUAL(m_Image, loadedImage, "Compressed " + extension + " image differs from the original.");
+
+      std::remove(path.c_str());
+    }
+  }
+
+  void DisabledByDefaultTest()
+  {
+    const auto path = mitk::IOUtil::CreateTemporaryFile("XXXXXX.nrrd");
+    mitk::IOUtil::Save(m_Image, path, m_WriterOptions);
+
+    auto loadedImage = mitk::IOUtil::Load<mitk::Image>(path);
+    CPPUNIT_ASSERT(!IsMemoryMapped(loadedImage));
+
+    std::remove(path.c_str());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkImageMemoryMapping)
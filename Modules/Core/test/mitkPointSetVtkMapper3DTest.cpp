@@ -0,0 +1,157 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// MITK
+#include <mitkPointSet.h>
+#include <mitkPointSetVtkMapper3D.h>
+#include <mitkRenderingTestHelper.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+// VTK
+#include <vtkPoints.h>
+#include <vtkUnsignedCharArray.h>
+
+/**
+  Tests that PointSetVtkMapper3D only rewrites the glyph entries of changed points.
+*/
+class mitkPointSetVtkMapper3DTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkPointSetVtkMapper3DTestSuite);
+  MITK_TEST(InitialUpdate_AllGlyphsChanged);
+  MITK_TEST(UnchangedPoints_NoGlyphChanged);
+  MITK_TEST(MovedPoint_OnlyItsGlyphChanged);
+  MITK_TEST(SelectedPoint_OnlyItsGlyphChanged);
+  MITK_TEST(InsertedPoint_AllGlyphsChanged);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  /** Members used inside the different test methods. All members are initialized via setUp().*/
+  mitk::RenderingTestHelper m_RenderingTestHelper;
+  mitk::PointSet::Pointer m_PointSet;
+  mitk::DataNode::Pointer m_Node;
+
+  static const int NumberOfPoints = 10;
+
+public:
+  mitkPointSetVtkMapper3DTestSuite() : m_RenderingTestHelper(300, 300) {}
+
+  void setUp() override
+  {
+    m_RenderingTestHelper = mitk::RenderingTestHelper(300, 300);
+
+    m_PointSet = mitk::PointSet::New();
+    for (int i = 0; i < NumberOfPoints; ++i)
+    {
+      mitk::Point3D point;
+      mitk::FillVector3D(point, i, 2.0 * i, 3.0 * i);
+      m_PointSet->InsertPoint(i, point);
+    }
+
+    m_Node = mitk::DataNode::New();
+    m_Node->SetData(m_PointSet);
+    m_RenderingTestHelper.AddNodeToStorage(m_Node);
+    m_RenderingTestHelper.SetMapperIDToRender3D();
+    m_RenderingTestHelper.Render();
+  }
+
+  void tearDown() override
+  {
+    m_Node = nullptr;
+    m_PointSet = nullptr;
+  }
+
+  void InitialUpdate_AllGlyphsChanged()
+  {
+    auto localStorage = this->GetLocalStorage();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfPoints), localStorage->m_ChangedGlyphs.size());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(NumberOfPoints), localStorage->m_WorldPositions->GetNumberOfPoints());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(NumberOfPoints), localStorage->m_GlyphTypes->GetNumberOfTuples());
+  }
+
+  void UnchangedPoints_NoGlyphChanged()
+  {
+    auto localStorage = this->GetLocalStorage();
+    const auto positionsMTime = localStorage->m_WorldPositions->GetMTime();
+    const auto typesMTime = localStorage->m_GlyphTypes->GetMTime();
+
+    m_PointSet->Modified();
+    m_RenderingTestHelper.Render();
+
+    CPPUNIT_ASSERT(localStorage->m_ChangedGlyphs.empty());
+    CPPUNIT_ASSERT_EQUAL(positionsMTime, localStorage->m_WorldPositions->GetMTime());
+    CPPUNIT_ASSERT_EQUAL(typesMTime, localStorage->m_GlyphTypes->GetMTime());
+  }
+
+  void MovedPoint_OnlyItsGlyphChanged()
+  {
+    auto localStorage = this->GetLocalStorage();
+    const auto typesMTime = localStorage->m_GlyphTypes->GetMTime();
+
+    mitk::Point3D point;
+    mitk::FillVector3D(point, 100.0, 200.0, 300.0);
+    m_PointSet->SetPoint(3, point);
+    m_RenderingTestHelper.Render();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), localStorage->m_ChangedGlyphs.size());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(3), localStorage->m_ChangedGlyphs[0]);
+
+    double position[3];
+    localStorage->m_WorldPositions->GetPoint(3, position);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(100.0, position[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(200.0, position[1], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(300.0, position[2], mitk::eps);
+
+    CPPUNIT_ASSERT_EQUAL(typesMTime, localStorage->m_GlyphTypes->GetMTime());
+  }
+
+  void SelectedPoint_OnlyItsGlyphChanged()
+  {
+    auto localStorage = this->GetLocalStorage();
+    const auto positionsMTime = localStorage->m_WorldPositions->GetMTime();
+
+    m_PointSet->SetSelectInfo(7, true);
+    m_PointSet->Modified();
+    m_RenderingTestHelper.Render();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), localStorage->m_ChangedGlyphs.size());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(7), localStorage->m_ChangedGlyphs[0]);
+    CPPUNIT_ASSERT_EQUAL(1, int(localStorage->m_GlyphSelection->GetValue(7)));
+    CPPUNIT_ASSERT_EQUAL(positionsMTime, localStorage->m_WorldPositions->GetMTime());
+  }
+
+  void InsertedPoint_AllGlyphsChanged()
+  {
+    auto localStorage = this->GetLocalStorage();
+
+    mitk::Point3D point;
+    mitk::FillVector3D(point, -1.0, -1.0, -1.0);
+    m_PointSet->InsertPoint(NumberOfPoints, point);
+    m_RenderingTestHelper.Render();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(NumberOfPoints + 1), localStorage->m_ChangedGlyphs.size());
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(NumberOfPoints + 1), localStorage->m_WorldPositions->GetNumberOfPoints());
+  }
+
+private:
+  mitk::PointSetVtkMapper3D::LocalStorage* GetLocalStorage()
+  {
+    auto renderer = mitk::BaseRenderer::GetInstance(m_RenderingTestHelper.GetVtkRenderWindow());
+    auto mapper = dynamic_cast<mitk::PointSetVtkMapper3D*>(m_Node->GetMapper(mitk::BaseRenderer::Standard3D));
+    CPPUNIT_ASSERT(mapper != nullptr);
+
+    return mapper->m_LSH.GetLocalStorage(renderer);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkPointSetVtkMapper3D)
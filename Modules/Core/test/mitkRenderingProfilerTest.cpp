@@ -0,0 +1,148 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRenderingProfiler.h>
+#include <mitkDataNode.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <sstream>
+
+class mitkRenderingProfilerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRenderingProfilerTestSuite);
+  MITK_TEST(TestDisabledScope);
+  MITK_TEST(TestFrameStatistics);
+  MITK_TEST(TestUpdateStatistics);
+  MITK_TEST(TestMaximumNumberOfEvents);
+  MITK_TEST(TestChromeTrace);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::RenderingProfiler *m_Profiler;
+
+  void AddFrame(const std::string &rendererName, int milliseconds)
+  {
+    const auto begin = std::chrono::steady_clock::now();
+    m_Profiler->AddEvent(mitk::RenderingProfiler::EventCategory::Frame,
+                         "Frame",
+                         rendererName,
+                         begin,
+                         begin + std::chrono::milliseconds(milliseconds));
+  }
+
+public:
+  void setUp() override
+  {
+    m_Profiler = mitk::RenderingProfiler::GetInstance();
+    m_Profiler->Clear();
+    m_Profiler->SetEnabled(false);
+    m_Profiler->SetFrameWindowSize(100);
+    m_Profiler->SetMaximumNumberOfEvents(100000);
+  }
+
+  void tearDown() override
+  {
+    m_Profiler->SetEnabled(false);
+    m_Profiler->Clear();
+  }
+
+  void TestDisabledScope()
+  {
+    {
+      mitk::RenderingProfiler::Scope scope(mitk::RenderingProfiler::EventCategory::Other, "Disabled", nullptr);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Profiler->GetNumberOfEvents());
+
+    m_Profiler->SetEnabled(true);
+
+    {
+      mitk::RenderingProfiler::Scope scope(mitk::RenderingProfiler::EventCategory::Other, "Enabled", nullptr);
+    }
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Profiler->GetNumberOfEvents());
+  }
+
+  void TestFrameStatistics()
+  {
+    m_Profiler->SetFrameWindowSize(3);
+
+    this->AddFrame("stdmulti.widget0", 40);
+    this->AddFrame("stdmulti.widget0", 10);
+    this->AddFrame("stdmulti.widget0", 20);
+    this->AddFrame("stdmulti.widget0", 30);
+    this->AddFrame("stdmulti.widget1", 5);
+
+    auto statistics = m_Profiler->GetFrameStatistics("stdmulti.widget0");
+
+    // The first frame dropped out of the rolling window
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics.NumberOfFrames);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, statistics.LastFrameTime, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, statistics.MeanFrameTime, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, statistics.MinimumFrameTime, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, statistics.MaximumFrameTime, 1e-6);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), m_Profiler->GetFrameStatistics("stdmulti.widget1").NumberOfFrames);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), m_Profiler->GetFrameStatistics("unknown").NumberOfFrames);
+  }
+
+  void TestUpdateStatistics()
+  {
+    auto node = mitk::DataNode::New();
+    node->SetName("Image");
+
+    m_Profiler->SetEnabled(true);
+
+    for (int i = 0; i < 3; ++i)
+    {
+      mitk::RenderingProfiler::Scope scope(node, nullptr, nullptr);
+    }
+
+    auto statistics = m_Profiler->GetUpdateStatistics();
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.size());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), statistics["Image"].NumberOfUpdates);
+    CPPUNIT_ASSERT(statistics["Image"].MaximumTime <= statistics["Image"].TotalTime);
+  }
+
+  void TestMaximumNumberOfEvents()
+  {
+    m_Profiler->SetMaximumNumberOfEvents(2);
+
+    for (int i = 0; i < 5; ++i)
+      this->AddFrame("stdmulti.widget0", i);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), m_Profiler->GetNumberOfEvents());
+
+    // Statistics do not depend on stored events
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), m_Profiler->GetFrameStatistics("stdmulti.widget0").NumberOfFrames);
+  }
+
+  void TestChromeTrace()
+  {
+    this->AddFrame("stdmulti.widget0", 16);
+    this->AddFrame("stdmulti.widget1", 8);
+
+    std::ostringstream stream;
+    m_Profiler->WriteChromeTrace(stream);
+    const auto trace = stream.str();
+
+    const std::string header = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    CPPUNIT_ASSERT_EQUAL(header, trace.substr(0, header.size()));
+    CPPUNIT_ASSERT(std::string::npos != trace.find("\"cat\":\"Frame\",\"dur\":16000,"));
+    CPPUNIT_ASSERT(std::string::npos != trace.find("\"cat\":\"Frame\",\"dur\":8000,"));
+    CPPUNIT_ASSERT(std::string::npos != trace.find("\"name\":\"stdmulti.widget1\"},\"name\":\"thread_name\",\"ph\":\"M\""));
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRenderingProfiler)
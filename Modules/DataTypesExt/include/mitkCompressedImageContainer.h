@@ -21,6 +21,15 @@ found in the LICENSE file.
 
 namespace mitk
 {
+  /** \brief Holds an LZ4-compressed copy of an image, slice by slice.
+   *
+   * Slices are compressed and decompressed concurrently.
+   *
+   * If a reference image of identical geometry and pixel type is passed to CompressImage(), only the
+   * XOR difference to the reference is stored (delta mode). The difference is run-length encoded before
+   * compression and slices that are identical to the reference are not stored at all. The same reference
+   * image must be passed to DecompressImage() to restore the original image.
+   */
   class MITKDATATYPESEXT_EXPORT CompressedImageContainer
   {
   public:
@@ -30,15 +39,40 @@ namespace mitk
     CompressedImageContainer(const CompressedImageContainer&) = delete;
     CompressedImageContainer& operator=(const CompressedImageContainer&) = delete;
 
-    void CompressImage(const Image* image);
-    Image::Pointer DecompressImage() const;
+    /** \brief Compress an image, optionally as difference to a reference image.
+     *
+     * Falls back to full compression if the reference image is not compatible to the image.
+     */
+    void CompressImage(const Image* image, const Image* referenceImage = nullptr);
+
+    /** \brief Decompress the image.
+     *
+     * \pre The reference image is the same as passed to CompressImage() if IsDelta() returns true.
+     * \return nullptr if the container is empty or the reference image is missing or incompatible.
+     */
+    Image::Pointer DecompressImage(const Image* referenceImage = nullptr) const;
+
+    /** \brief Check if the container stores a difference to a reference image instead of the full image.
+     */
+    bool IsDelta() const;
+
+    /** \brief Total number of bytes occupied by compressed slice data.
+     */
+    std::size_t GetCompressedSize() const;
 
   private:
-    using CompressedSliceData = std::pair<int, char*>;
+    struct CompressedSliceData
+    {
+      int CompressedSize = 0; // Size of Data
+      int EncodedSize = 0;    // Size of the (run-length encoded) slice before LZ4 compression
+      char* Data = nullptr;
+    };
+
     using CompressedTimeStepData = std::vector<CompressedSliceData>;
     using CompressedImageData = std::vector<CompressedTimeStepData>;
 
     void ClearCompressedImageData();
+    bool IsCompatible(const Image* image) const;
 
     CompressedImageData m_CompressedImageData;
 
@@ -46,6 +80,7 @@ namespace mitk
     TimeGeometry::Pointer m_TimeGeometry;
     std::array<unsigned int, 2> m_SliceDimensions;
     unsigned int m_Dimension;
+    bool m_IsDelta;
   };
 }
 
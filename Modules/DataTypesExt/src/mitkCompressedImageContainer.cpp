@@ -15,12 +15,121 @@ found in the LICENSE file.
 #include <mitkImageReadAccessor.h>
 #include <mitkImageWriteAccessor.h>
 
+#include <itkMultiThreaderBase.h>
+
 #include <lz4.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace
+{
+  // Zero runs shorter than this are kept inside of literal runs to bound the encoding overhead
+  constexpr std::size_t MinZeroRunLength = 8;
+  constexpr std::size_t RunHeaderSize = 2 * sizeof(std::uint32_t);
+
+  /** Calls function for the indices 0, ..., count - 1 in parallel. The number of threads is the global default of
+   *  ITK. The indices are split into up to ITK_MAX_THREADS work units to balance slices of different cost.*/
+  void ParallelizeArray(unsigned int count, const std::function<void(itk::SizeValueType)>& function)
+  {
+    if (0 == count)
+      return;
+
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->SetNumberOfWorkUnits(count);
+    multiThreader->ParallelizeArray(0, count, function, nullptr);
+  }
+
+  /** \brief Encode runs of zeros as (zero run length, literal run length, literal bytes) tuples.
+   *
+   * \return Size of the encoded data or 0 if it would not fit into the destination buffer.
+   */
+  std::size_t RunLengthEncodeZeros(const char* src, std::size_t size, char* dest, std::size_t destCapacity)
+  {
+    std::size_t i = 0;
+    std::size_t pos = 0;
+
+    while (i < size)
+    {
+      const auto zeroRunBegin = i;
+
+      while (i < size && 0 == src[i])
+        ++i;
+
+      const auto zeroRunLength = static_cast<std::uint32_t>(i - zeroRunBegin);
+      const auto literalBegin = i;
+
+      while (i < size)
+      {
+        if (0 != src[i])
+        {
+          ++i;
+          continue;
+        }
+
+        auto j = i;
+
+        while (j < size && 0 == src[j] && j - i < MinZeroRunLength)
+          ++j;
+
+        if (j - i >= MinZeroRunLength || j == size)
+          break;
+
+        i = j;
+      }
+
+      const auto literalLength = static_cast<std::uint32_t>(i - literalBegin);
+
+      if (pos + RunHeaderSize + literalLength > destCapacity)
+        return 0;
+
+      std::memcpy(dest + pos, &zeroRunLength, sizeof(std::uint32_t));
+      std::memcpy(dest + pos + sizeof(std::uint32_t), &literalLength, sizeof(std::uint32_t));
+      pos += RunHeaderSize;
+
+      std::memcpy(dest + pos, src + literalBegin, literalLength);
+      pos += literalLength;
+    }
+
+    return pos;
+  }
+
+  bool RunLengthDecodeZeros(const char* src, std::size_t srcSize, char* dest, std::size_t size)
+  {
+    std::size_t pos = 0;
+    std::size_t out = 0;
+
+    while (pos < srcSize)
+    {
+      if (pos + RunHeaderSize > srcSize)
+        return false;
+
+      std::uint32_t zeroRunLength = 0;
+      std::uint32_t literalLength = 0;
+      std::memcpy(&zeroRunLength, src + pos, sizeof(std::uint32_t));
+      std::memcpy(&literalLength, src + pos + sizeof(std::uint32_t), sizeof(std::uint32_t));
+      pos += RunHeaderSize;
+
+      if (out + zeroRunLength + literalLength > size || pos + literalLength > srcSize)
+        return false;
+
+      std::memset(dest + out, 0, zeroRunLength);
+      out += zeroRunLength;
+
+      std::memcpy(dest + out, src + pos, literalLength);
+      out += literalLength;
+      pos += literalLength;
+    }
+
+    return out == size;
+  }
+}
 
 mitk::CompressedImageContainer::CompressedImageContainer()
-  : m_Dimension(0)
+  : m_Dimension(0),
+    m_IsDelta(false)
 {
 }
 
@@ -34,7 +143,7 @@ void mitk::CompressedImageContainer::ClearCompressedImageData()
   for (const auto& image : m_CompressedImageData)
   {
     for (auto slice : image)
-      delete[] slice.second;
+      delete[] slice.Data;
   }
 
   m_CompressedImageData.clear();
@@ -44,9 +153,43 @@ void mitk::CompressedImageContainer::ClearCompressedImageData()
   m_SliceDimensions[0] = 0;
   m_SliceDimensions[1] = 0;
   m_Dimension = 0;
+  m_IsDelta = false;
+}
+
+bool mitk::CompressedImageContainer::IsDelta() const
+{
+  return m_IsDelta;
+}
+
+std::size_t mitk::CompressedImageContainer::GetCompressedSize() const
+{
+  std::size_t size = 0;
+
+  for (const auto& image : m_CompressedImageData)
+  {
+    for (const auto& slice : image)
+      size += static_cast<std::size_t>(slice.CompressedSize);
+  }
+
+  return size;
+}
+
+bool mitk::CompressedImageContainer::IsCompatible(const Image* image) const
+{
+  if (nullptr == image || nullptr == m_PixelType || m_CompressedImageData.empty())
+    return false;
+
+  if (image->GetPixelType() != *m_PixelType || image->GetDimension() != m_Dimension)
+    return false;
+
+  if (image->GetDimension(0) != m_SliceDimensions[0] || image->GetDimension(1) != m_SliceDimensions[1])
+    return false;
+
+  return image->GetDimension(2) == m_CompressedImageData[0].size() &&
+         image->GetTimeSteps() == m_CompressedImageData.size();
 }
 
-void mitk::CompressedImageContainer::CompressImage(const Image* image)
+void mitk::CompressedImageContainer::CompressImage(const Image* image, const Image* referenceImage)
 {
   this->ClearCompressedImageData();
 
@@ -63,45 +206,100 @@ void mitk::CompressedImageContainer::CompressImage(const Image* image)
   const auto numSlices = image->GetDimension(2);
   const auto numSliceBytes = image->GetPixelType().GetSize() * image->GetDimension(0) * image->GetDimension(1);
 
-  m_CompressedImageData.reserve(numTimeSteps);
+  m_CompressedImageData.assign(numTimeSteps, CompressedTimeStepData(numSlices));
+
+  if (nullptr != referenceImage)
+  {
+    m_IsDelta = this->IsCompatible(referenceImage);
+
+    if (!m_IsDelta)
+      MITK_DEBUG << "Reference image is not compatible. Falling back to full compression.";
+  }
+
+  // Accessors are created upfront as they must not be created concurrently for the same image
+  std::vector<std::unique_ptr<ImageReadAccessor>> accessors;
+  std::vector<std::unique_ptr<ImageReadAccessor>> referenceAccessors;
 
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    CompressedTimeStepData slices;
-    slices.reserve(numSlices);
+    accessors.push_back(std::make_unique<ImageReadAccessor>(image, image->GetVolumeData(t)));
+
+    if (m_IsDelta)
+      referenceAccessors.push_back(std::make_unique<ImageReadAccessor>(referenceImage, referenceImage->GetVolumeData(t)));
+  }
+
+  const auto destCapacity = LZ4_compressBound(static_cast<int>(numSliceBytes));
 
-    ImageReadAccessor accessor(image, image->GetVolumeData(t));
+  ParallelizeArray(numTimeSteps * numSlices, [&](unsigned int i) {
+    const auto t = i / numSlices;
+    const auto s = i % numSlices;
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
+    const auto* src = reinterpret_cast<const char*>(accessors[t]->GetData()) + numSliceBytes * s;
+    auto& slice = m_CompressedImageData[t][s];
+
+    std::vector<char> diff;
+    std::vector<char> encoded;
+    auto numEncodedBytes = numSliceBytes;
+
+    if (m_IsDelta)
     {
-      const auto* src = reinterpret_cast<const char*>(accessor.GetData()) + numSliceBytes * s;
-      char* dest = new char[numSliceBytes];
-      const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numSliceBytes), static_cast<int>(numSliceBytes));
+      const auto* ref = reinterpret_cast<const char*>(referenceAccessors[t]->GetData()) + numSliceBytes * s;
 
-      if (0 == destSize)
-      {
-        MITK_ERROR << "LZ4 compression failed!";
-        delete[] dest;
-        slices.emplace_back(0, nullptr);
-      }
-      else
+      diff.resize(numSliceBytes);
+      char changed = 0;
+
+      for (std::size_t j = 0; j < numSliceBytes; ++j)
       {
-        char* shrinkedDest = new char[destSize];
-        std::copy(dest, dest + destSize, shrinkedDest);
-        delete[] dest;
-        slices.emplace_back(destSize, shrinkedDest);
+        diff[j] = src[j] ^ ref[j];
+        changed |= diff[j];
       }
+
+      if (0 == changed)
+        return; // Identical to reference, nothing to store
+
+      encoded.resize(numSliceBytes - 1);
+      numEncodedBytes = RunLengthEncodeZeros(diff.data(), numSliceBytes, encoded.data(), encoded.size());
+
+      if (0 == numEncodedBytes)
+        numEncodedBytes = numSliceBytes;
+
+      src = numEncodedBytes < numSliceBytes
+        ? encoded.data()
+        : diff.data();
     }
 
-    m_CompressedImageData.push_back(slices);
-  }
+    slice.EncodedSize = static_cast<int>(numEncodedBytes);
+
+    char* dest = new char[destCapacity];
+    const auto destSize = LZ4_compress_default(src, dest, static_cast<int>(numEncodedBytes), destCapacity);
+
+    if (0 == destSize)
+    {
+      MITK_ERROR << "LZ4 compression failed!";
+      delete[] dest;
+    }
+    else
+    {
+      char* shrinkedDest = new char[destSize];
+      std::copy(dest, dest + destSize, shrinkedDest);
+      delete[] dest;
+      slice.CompressedSize = destSize;
+      slice.Data = shrinkedDest;
+    }
+  });
 }
 
-mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
+mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage(const Image* referenceImage) const
 {
   if (m_CompressedImageData.empty())
     return nullptr;
 
+  if (m_IsDelta && !this->IsCompatible(referenceImage))
+  {
+    MITK_ERROR << "Cannot decompress image without compatible reference image!";
+    return nullptr;
+  }
+
   const auto numSlices = static_cast<unsigned int>(m_CompressedImageData[0].size());
   const auto numTimeSteps = static_cast<unsigned int>(m_CompressedImageData.size());
   const auto numSliceBytes = m_PixelType->GetSize() * m_SliceDimensions[0] * m_SliceDimensions[1];
@@ -115,20 +313,63 @@ mitk::Image::Pointer mitk::CompressedImageContainer::DecompressImage() const
   auto image = Image::New();
   image->Initialize(*m_PixelType, m_Dimension, dimensions.data());
 
+  std::vector<std::unique_ptr<ImageWriteAccessor>> accessors;
+  std::vector<std::unique_ptr<ImageReadAccessor>> referenceAccessors;
+
   for (std::remove_const_t<decltype(numTimeSteps)> t = 0; t < numTimeSteps; ++t)
   {
-    ImageWriteAccessor accessor(image, image->GetVolumeData(static_cast<int>(t)));
+    accessors.push_back(std::make_unique<ImageWriteAccessor>(image, image->GetVolumeData(static_cast<int>(t))));
+
+    if (m_IsDelta)
+      referenceAccessors.push_back(std::make_unique<ImageReadAccessor>(referenceImage, referenceImage->GetVolumeData(t)));
+  }
 
-    for (std::remove_const_t<decltype(numSlices)> s = 0; s < numSlices; ++s)
+  ParallelizeArray(numTimeSteps * numSlices, [&](unsigned int i) {
+    const auto t = i / numSlices;
+    const auto s = i % numSlices;
+
+    auto* dest = reinterpret_cast<char*>(accessors[t]->GetData()) + numSliceBytes * s;
+    const auto& slice = m_CompressedImageData[t][s];
+    const char* ref = m_IsDelta
+      ? reinterpret_cast<const char*>(referenceAccessors[t]->GetData()) + numSliceBytes * s
+      : nullptr;
+
+    if (m_IsDelta && 0 == slice.EncodedSize)
     {
-      auto* dest = reinterpret_cast<char*>(accessor.GetData()) + numSliceBytes * s;
-      const auto& slice = m_CompressedImageData[t][s];
-      const auto destSize = LZ4_decompress_safe(slice.second, dest, slice.first, static_cast<int>(numSliceBytes));
+      std::copy(ref, ref + numSliceBytes, dest);
+      return;
+    }
 
-      if (0 > destSize)
-        MITK_ERROR << "LZ4 decompression failed!";
+    const auto numEncodedBytes = static_cast<std::size_t>(slice.EncodedSize);
+    std::vector<char> encoded;
+
+    if (numEncodedBytes < numSliceBytes)
+      encoded.resize(numEncodedBytes);
+
+    auto* decompressed = encoded.empty()
+      ? dest
+      : encoded.data();
+
+    const auto destSize = LZ4_decompress_safe(slice.Data, decompressed, slice.CompressedSize, slice.EncodedSize);
+
+    if (0 > destSize)
+    {
+      MITK_ERROR << "LZ4 decompression failed!";
+      return;
     }
-  }
+
+    if (!encoded.empty() && !RunLengthDecodeZeros(encoded.data(), encoded.size(), dest, numSliceBytes))
+    {
+      MITK_ERROR << "Run-length decoding failed!";
+      return;
+    }
+
+    if (m_IsDelta)
+    {
+      for (std::size_t j = 0; j < numSliceBytes; ++j)
+        dest[j] ^= ref[j];
+    }
+  });
 
   image->SetTimeGeometry(m_TimeGeometry->Clone());
 
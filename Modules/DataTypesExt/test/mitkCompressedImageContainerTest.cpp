@@ -15,6 +15,10 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include "mitkImageDataItem.h"
 #include "mitkImageReadAccessor.h"
+#include "mitkImageWriteAccessor.h"
+
+#include <algorithm>
+#include <cstring>
 
 class mitkCompressedImageContainerTestClass
 {
@@ -107,6 +111,75 @@ public:
       }
     }
   }
+
+  static void TestDelta(mitk::Image *image, unsigned int &numberFailed)
+  {
+    mitk::Image::Pointer modifiedImage = image->Clone();
+
+    {
+      // modify a few bytes in the middle of the first time step
+      mitk::ImageWriteAccessor accessor(modifiedImage, modifiedImage->GetVolumeData(0));
+      auto *data = static_cast<unsigned char *>(accessor.GetData());
+      const auto numBytes = (modifiedImage->GetPixelType().GetBpe() >> 3) * modifiedImage->GetDimension(0) *
+                            modifiedImage->GetDimension(1) * modifiedImage->GetDimension(2);
+
+      for (unsigned long byte = numBytes / 2; byte < std::min(numBytes, numBytes / 2 + 100); ++byte)
+        data[byte] = static_cast<unsigned char>(~data[byte]);
+    }
+
+    mitk::CompressedImageContainer fullContainer;
+    fullContainer.CompressImage(modifiedImage);
+
+    mitk::CompressedImageContainer deltaContainer;
+    deltaContainer.CompressImage(modifiedImage, image);
+
+    if (!deltaContainer.IsDelta())
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Image was not compressed as difference to reference image." << std::endl;
+      return;
+    }
+
+    if (deltaContainer.GetCompressedSize() > fullContainer.GetCompressedSize())
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Delta compression is larger than full compression (delta: "
+                << deltaContainer.GetCompressedSize() << ", full: " << fullContainer.GetCompressedSize() << ")"
+                << std::endl;
+    }
+
+    if (deltaContainer.DecompressImage().IsNotNull())
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Delta decompression without reference image did not fail." << std::endl;
+    }
+
+    mitk::Image::Pointer uncompressedImage = deltaContainer.DecompressImage(image);
+
+    if (uncompressedImage.IsNull())
+    {
+      ++numberFailed;
+      std::cerr << "  (EE) Delta decompression failed." << std::endl;
+      return;
+    }
+
+    for (unsigned int timeStep = 0; timeStep < modifiedImage->GetTimeSteps(); ++timeStep)
+    {
+      mitk::ImageReadAccessor modifiedImgAcc(modifiedImage, modifiedImage->GetVolumeData(timeStep));
+      mitk::ImageReadAccessor unCompImgAcc(uncompressedImage, uncompressedImage->GetVolumeData(timeStep));
+
+      const auto numBytes = (modifiedImage->GetPixelType().GetBpe() >> 3) * modifiedImage->GetDimension(0) *
+                            modifiedImage->GetDimension(1) * modifiedImage->GetDimension(2);
+
+      if (0 != memcmp(modifiedImgAcc.GetData(), unCompImgAcc.GetData(), numBytes))
+      {
+        ++numberFailed;
+        std::cerr << "  (EE) Pixel data in timestep " << timeStep << " not identical after delta uncompression."
+                  << std::endl;
+        break;
+      }
+    }
+  }
 };
 
 /// ctest entry point
@@ -150,6 +223,7 @@ int mitkCompressedImageContainerTest(int argc, char *argv[])
 
     // some real work
     mitkCompressedImageContainerTestClass::Test(&container, image, numberFailed);
+    mitkCompressedImageContainerTestClass::TestDelta(image, numberFailed);
 
     std::cout << "Testing destruction" << std::endl;
   }
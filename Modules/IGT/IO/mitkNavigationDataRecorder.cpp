@@ -20,7 +20,8 @@ mitk::NavigationDataRecorder::NavigationDataRecorder()
    m_StandardizeTime(false),
    m_StandardizedTimeInitialized(false),
    m_RecordCountLimit(-1),
-   m_RecordOnlyValidData(false)
+   m_RecordOnlyValidData(false),
+   m_RecordToMemory(true)
 {
 
 }
@@ -28,6 +29,9 @@ mitk::NavigationDataRecorder::NavigationDataRecorder()
 mitk::NavigationDataRecorder::~NavigationDataRecorder()
 {
   //mitk::IGTTimeStamp::GetInstance()->Stop(this); //commented out because of bug 18952
+
+  if (m_StreamWriter.IsNotNull())
+    m_StreamWriter->Close();
 }
 
 void mitk::NavigationDataRecorder::GenerateData()
@@ -67,15 +71,19 @@ void mitk::NavigationDataRecorder::GenerateData()
   }
 
   // if limitation is set and has been reached, stop recording
-  if ((m_RecordCountLimit > 0) && (m_NavigationDataSet->Size() >= static_cast<unsigned int>(m_RecordCountLimit)))
+  if ((m_RecordCountLimit > 0) && (this->GetNumberOfRecordedSteps() >= m_RecordCountLimit))
     m_Recording = false;
   // We can skip the rest of the method, if recording is deactivated
   if (!m_Recording) return;
   // We can skip the rest of the method, if we read only valid data
   if (m_RecordOnlyValidData && atLeastOneInputIsInvalid) return;
 
+  if (m_StreamWriter.IsNotNull())
+    m_StreamWriter->Append(clonedDatas);
+
   // Add data to set
-  m_NavigationDataSet->AddNavigationDatas(clonedDatas);
+  if (m_RecordToMemory)
+    m_NavigationDataSet->AddNavigationDatas(clonedDatas);
 }
 
 void mitk::NavigationDataRecorder::StartRecording()
@@ -94,6 +102,22 @@ void mitk::NavigationDataRecorder::StartRecording()
 
   if (m_NavigationDataSet.IsNull())
     m_NavigationDataSet = mitk::NavigationDataSet::New(GetNumberOfIndexedInputs());
+
+  if (!m_StreamFileName.empty() && m_StreamWriter.IsNull())
+  {
+    m_StreamWriter = mitk::NavigationDataStreamWriter::New();
+
+    try
+    {
+      m_StreamWriter->Open(m_StreamFileName, GetNumberOfIndexedInputs());
+    }
+    catch (...)
+    {
+      m_StreamWriter = nullptr;
+      m_Recording = false;
+      throw;
+    }
+  }
 }
 
 void mitk::NavigationDataRecorder::StopRecording()
@@ -104,12 +128,27 @@ void mitk::NavigationDataRecorder::StopRecording()
     return;
   }
   m_Recording = false;
+
+  if (m_StreamWriter.IsNotNull())
+    m_StreamWriter->Flush();
 }
 
 void mitk::NavigationDataRecorder::ResetRecording()
 {
   m_NavigationDataSet = mitk::NavigationDataSet::New(GetNumberOfIndexedInputs());
 
+  if (m_StreamWriter.IsNotNull())
+  {
+    m_StreamWriter->Close();
+    m_StreamWriter = nullptr;
+  }
+
+  if (m_Recording && !m_StreamFileName.empty())
+  {
+    m_StreamWriter = mitk::NavigationDataStreamWriter::New();
+    m_StreamWriter->Open(m_StreamFileName, GetNumberOfIndexedInputs());
+  }
+
   if (m_Recording)
   {
     mitk::IGTTimeStamp::GetInstance()->Stop(this);
@@ -119,5 +158,8 @@ void mitk::NavigationDataRecorder::ResetRecording()
 
 int mitk::NavigationDataRecorder::GetNumberOfRecordedSteps()
 {
+  if (!m_RecordToMemory && m_StreamWriter.IsNotNull())
+    return static_cast<int>(m_StreamWriter->GetNumberOfFrames());
+
   return m_NavigationDataSet->Size();
 }
@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkNavigationDataToNavigationDataFilter.h"
 #include "mitkNavigationData.h"
 #include "mitkNavigationDataSet.h"
+#include "mitkNavigationDataStreamWriter.h"
 
 namespace mitk
 {
@@ -27,6 +28,12 @@ namespace mitk
   * With StopRecording() the stream is stopped, but can be resumed anytime.
   * To start recording to a new NavigationDataSet, call ResetRecording();
   *
+  * If a stream file name is set, every recorded frame is additionally appended to a binary stream file
+  * by a mitk::NavigationDataStreamWriter. The file is written from a background thread while recording,
+  * so long recordings are not lost if the application crashes. Disable RecordToMemory to keep the memory
+  * consumption constant for such recordings; the NavigationDataSet then stays empty and the recording can be
+  * loaded with mitk::NavigationDataStreamReader.
+  *
   * \warning Do not add inputs while the recorder ist recording. The recorder can't handle that and will cause a nullpointer exception.
   * \ingroup IGT
   */
@@ -78,6 +85,20 @@ namespace mitk
     */
     itkGetMacro(RecordOnlyValidData, bool);
 
+    /**
+    * \brief Sets the binary stream file that recorded frames are appended to. An empty name (default) disables streaming.
+    *
+    * The file is created (or overwritten) by the first StartRecording() after construction or ResetRecording().
+    */
+    itkSetStringMacro(StreamFileName);
+    itkGetStringMacro(StreamFileName);
+
+    /**
+    * \brief If set to false, frames are only written to the stream file and not kept in the NavigationDataSet. Default is true.
+    */
+    itkSetMacro(RecordToMemory, bool);
+    itkGetMacro(RecordToMemory, bool);
+
     /**
     * \brief Starts recording NavigationData into the NavigationDataSet
     */
@@ -125,6 +146,12 @@ namespace mitk
     int m_RecordCountLimit; ///< limits the number of frames, recording will be stopped if the limit is reached. -1 disables the limit
 
     bool m_RecordOnlyValidData; ///< indicates whether only valid data is recorded
+
+    std::string m_StreamFileName; ///< binary stream file the recorded frames are appended to, empty if disabled
+
+    bool m_RecordToMemory; ///< indicates whether recorded frames are added to the NavigationDataSet
+
+    mitk::NavigationDataStreamWriter::Pointer m_StreamWriter;
   };
 }
 #endif
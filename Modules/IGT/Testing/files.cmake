@@ -23,7 +23,9 @@ set(MODULE_TESTS
    mitkNavigationDataObjectVisualizationFilterTest.cpp
    mitkNavigationDataSetTest.cpp
    mitkNavigationDataTest.cpp
+   mitkNavigationDataPoseStoreTest.cpp
    mitkNavigationDataRecorderTest.cpp
+   mitkNavigationDataStreamTest.cpp
    mitkNavigationDataReferenceTransformFilterTest.cpp
    mitkNavigationDataSequentialPlayerTest.cpp
    mitkNavigationDataSetReaderWriterXMLTest.cpp
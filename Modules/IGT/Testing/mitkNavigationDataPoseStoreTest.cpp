@@ -0,0 +1,152 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIGTException.h>
+#include <mitkIOUtil.h>
+#include <mitkNavigationDataPoseStore.h>
+#include <mitkNavigationDataStreamWriter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkMath.h>
+
+#include <cmath>
+#include <cstdio>
+
+class mitkNavigationDataPoseStoreTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNavigationDataPoseStoreTestSuite);
+  MITK_TEST(TestNavigationDataSet);
+  MITK_TEST(TestFindFrame);
+  MITK_TEST(TestInterpolate);
+  MITK_TEST(TestOpenStream);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::NavigationDataSet::Pointer m_NavigationDataSet;
+  std::string m_FileName;
+
+  static std::vector<mitk::NavigationData::Pointer> CreateFrame(unsigned int frameIndex)
+  {
+    std::vector<mitk::NavigationData::Pointer> frame;
+
+    for (unsigned int toolIndex = 0; toolIndex < 2; ++toolIndex)
+    {
+      // The first tool rotates by 90 degrees around the z axis per frame
+      const double angle = 0.25 * itk::Math::pi * frameIndex;
+
+      auto data = mitk::NavigationData::New();
+      mitk::NavigationData::PositionType position;
+      position[0] = 10.0 * frameIndex;
+      position[1] = toolIndex;
+      position[2] = 0.0;
+      data->SetPosition(position);
+      data->SetOrientation(0 == toolIndex
+        ? mitk::NavigationData::OrientationType(0.0, 0.0, std::sin(angle), std::cos(angle))
+        : mitk::NavigationData::OrientationType(0.0, 0.0, 0.0, 1.0));
+      data->SetIGTTimeStamp(100.0 * frameIndex + 100.0);
+      data->SetDataValid(frameIndex != 5);
+      frame.push_back(data);
+    }
+
+    return frame;
+  }
+
+public:
+  void setUp() override
+  {
+    m_NavigationDataSet = mitk::NavigationDataSet::New(2);
+
+    for (unsigned int i = 0; i < 10; ++i)
+      m_NavigationDataSet->AddNavigationDatas(CreateFrame(i));
+
+    m_FileName = mitk::IOUtil::GetTempPath() + "NavigationDataPoseStoreTest.nds";
+  }
+
+  void tearDown() override
+  {
+    std::remove(m_FileName.c_str());
+    std::remove(mitk::NavigationDataStream::GetIndexFileName(m_FileName).c_str());
+  }
+
+  void TestNavigationDataSet()
+  {
+    auto store = mitk::NavigationDataPoseStore::New();
+    store->SetNavigationDataSet(m_NavigationDataSet);
+
+    CPPUNIT_ASSERT_EQUAL(2u, store->GetNumberOfTools());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), store->GetNumberOfFrames());
+
+    auto toolRecords = store->GetToolRecords(1);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), toolRecords.size());
+    CPPUNIT_ASSERT_EQUAL(70.0, toolRecords[7].Position[0]);
+    CPPUNIT_ASSERT_EQUAL(1.0, toolRecords[7].Position[1]);
+    CPPUNIT_ASSERT(&toolRecords[7] == &store->GetRecord(7, 1));
+
+    CPPUNIT_ASSERT(mitk::Equal(*m_NavigationDataSet->GetNavigationDataForIndex(3, 0), *store->GetNavigationData(3, 0)));
+    CPPUNIT_ASSERT_THROW(store->GetFrame(10), mitk::IGTException);
+  }
+
+  void TestFindFrame()
+  {
+    auto store = mitk::NavigationDataPoseStore::New();
+    store->SetNavigationDataSet(m_NavigationDataSet);
+
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), store->FindFrame(0.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), store->FindFrame(100.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(3), store->FindFrame(450.0));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(4), store->FindFrame(500.0, 1));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(9), store->FindFrame(5000.0));
+  }
+
+  void TestInterpolate()
+  {
+    auto store = mitk::NavigationDataPoseStore::New();
+    store->SetNavigationDataSet(m_NavigationDataSet);
+
+    auto record = store->Interpolate(0, 150.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, record.Position[0], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sin(0.125 * itk::Math::pi), record.Orientation[2], mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::cos(0.125 * itk::Math::pi), record.Orientation[3], mitk::eps);
+    CPPUNIT_ASSERT(record.Flags & mitk::NavigationDataRecord::DataValid);
+
+    // Interpolation involving an invalid frame is invalid
+    record = store->Interpolate(0, 620.0);
+    CPPUNIT_ASSERT(!(record.Flags & mitk::NavigationDataRecord::DataValid));
+
+    // Clamped to the recording
+    CPPUNIT_ASSERT_EQUAL(0.0, store->Interpolate(0, 0.0).Position[0]);
+    CPPUNIT_ASSERT_EQUAL(90.0, store->Interpolate(0, 5000.0).Position[0]);
+  }
+
+  void TestOpenStream()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->Open(m_FileName, 2);
+    for (auto iter = m_NavigationDataSet->Begin(); iter != m_NavigationDataSet->End(); ++iter)
+      writer->Append(*iter);
+    writer->Close();
+
+    auto store = mitk::NavigationDataPoseStore::New();
+    store->OpenStream(m_FileName);
+
+    CPPUNIT_ASSERT_EQUAL(2u, store->GetNumberOfTools());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(10), store->GetNumberOfFrames());
+    CPPUNIT_ASSERT(mitk::Equal(*m_NavigationDataSet->GetNavigationDataForIndex(8, 1), *store->GetNavigationData(8, 1)));
+    CPPUNIT_ASSERT_EQUAL(std::size_t(6), store->FindFrame(777.0));
+
+    store->Clear();
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), store->GetNumberOfFrames());
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNavigationDataPoseStore)
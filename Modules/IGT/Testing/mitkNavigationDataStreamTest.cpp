@@ -0,0 +1,202 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkIOUtil.h>
+#include <mitkNavigationDataRecorder.h>
+#include <mitkNavigationDataSequentialPlayer.h>
+#include <mitkNavigationDataStreamReader.h>
+#include <mitkNavigationDataStreamWriter.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+class mitkNavigationDataStreamTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNavigationDataStreamTestSuite);
+  MITK_TEST(TestWriteAndRead);
+  MITK_TEST(TestFindFrame);
+  MITK_TEST(TestTruncatedStream);
+  MITK_TEST(TestFlushWithoutTools);
+  MITK_TEST(TestRecorderStreaming);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_FileName;
+
+  std::vector<mitk::NavigationData::Pointer> CreateFrame(unsigned int frameIndex, unsigned int numberOfTools)
+  {
+    std::vector<mitk::NavigationData::Pointer> frame;
+
+    for (unsigned int toolIndex = 0; toolIndex < numberOfTools; ++toolIndex)
+    {
+      auto data = mitk::NavigationData::New();
+      mitk::NavigationData::PositionType position;
+      position[0] = frameIndex;
+      position[1] = toolIndex;
+      position[2] = 0.5 * frameIndex;
+      data->SetPosition(position);
+      data->SetOrientation(mitk::NavigationData::OrientationType(0.0, 0.0, 0.6, 0.8));
+      data->SetIGTTimeStamp(10.0 * frameIndex + 10.0);
+      data->SetPositionAccuracy(0.25);
+      data->SetDataValid(0 != frameIndex % 3);
+      frame.push_back(data);
+    }
+
+    return frame;
+  }
+
+  void WriteFrames(unsigned int numberOfFrames, unsigned int numberOfTools, unsigned int framesPerChunk)
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->SetFramesPerChunk(framesPerChunk);
+    writer->Open(m_FileName, numberOfTools);
+
+    for (unsigned int i = 0; i < numberOfFrames; ++i)
+      writer->Append(this->CreateFrame(i, numberOfTools));
+
+    writer->Close();
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(numberOfFrames), writer->GetNumberOfWrittenFrames());
+  }
+
+public:
+  void setUp() override
+  {
+    m_FileName = mitk::IOUtil::GetTempPath() + "NavigationDataStreamTest.nds";
+  }
+
+  void tearDown() override
+  {
+    std::remove(m_FileName.c_str());
+    std::remove(mitk::NavigationDataStream::GetIndexFileName(m_FileName).c_str());
+  }
+
+  void TestWriteAndRead()
+  {
+    this->WriteFrames(100, 2, 16);
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+
+    CPPUNIT_ASSERT_EQUAL(2u, reader->GetNumberOfTools());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(100), reader->GetNumberOfFrames());
+
+    auto frame = reader->GetFrame(37);
+    auto reference = this->CreateFrame(37, 2);
+
+    for (unsigned int toolIndex = 0; toolIndex < 2; ++toolIndex)
+    {
+      CPPUNIT_ASSERT(mitk::Equal(*reference[toolIndex], *frame[toolIndex]));
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0625, frame[toolIndex]->GetCovErrorMatrix()[0][0], mitk::eps);
+    }
+
+    auto navigationDataSet = reader->ReadNavigationDataSet();
+    CPPUNIT_ASSERT_EQUAL(100u, navigationDataSet->Size());
+  }
+
+  void TestFindFrame()
+  {
+    this->WriteFrames(100, 1, 16);
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), reader->FindFrame(0.0));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(0), reader->FindFrame(10.0));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(42), reader->FindFrame(435.0));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(48), reader->FindFrame(490.0));
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(99), reader->FindFrame(1e6));
+  }
+
+  void TestTruncatedStream()
+  {
+    this->WriteFrames(100, 2, 16);
+
+    // Simulate a crash: cut the last frame in half and drop the index
+    std::string content;
+    {
+      std::ifstream file(m_FileName, std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream file(m_FileName, std::ios::binary | std::ios::trunc);
+      file.write(content.data(), content.size() - sizeof(mitk::NavigationDataRecord));
+    }
+    std::remove(mitk::NavigationDataStream::GetIndexFileName(m_FileName).c_str());
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(99), reader->GetNumberOfFrames());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(49), reader->FindFrame(505.0));
+  }
+
+  void TestFlushWithoutTools()
+  {
+    auto writer = mitk::NavigationDataStreamWriter::New();
+    writer->Open(m_FileName, 0);
+
+    writer->Append(this->CreateFrame(0, 0));
+    writer->Append(this->CreateFrame(1, 0));
+
+    // Must not block, although no frame is ever written
+    writer->Flush();
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(2), writer->GetNumberOfFrames());
+
+    writer->Close();
+    CPPUNIT_ASSERT(!writer->IsOpen());
+  }
+
+  void TestRecorderStreaming()
+  {
+    std::string path = GetTestDataFilePath("IGT-Data/RecordedNavigationData.xml");
+    mitk::NavigationDataSet::Pointer navigationDataSet = dynamic_cast<mitk::NavigationDataSet*>(mitk::IOUtil::Load(path)[0].GetPointer());
+
+    auto player = mitk::NavigationDataSequentialPlayer::New();
+    player->SetNavigationDataSet(navigationDataSet);
+
+    auto recorder = mitk::NavigationDataRecorder::New();
+    recorder->SetStandardizeTime(false);
+    recorder->SetStreamFileName(m_FileName);
+    recorder->SetRecordToMemory(false);
+    recorder->ConnectTo(player);
+
+    recorder->StartRecording();
+    while (!player->IsAtEnd())
+    {
+      recorder->Update();
+      player->GoToNextSnapshot();
+    }
+    recorder->StopRecording();
+
+    CPPUNIT_ASSERT_EQUAL(0u, recorder->GetNavigationDataSet()->Size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(navigationDataSet->Size()), recorder->GetNumberOfRecordedSteps());
+
+    auto reader = mitk::NavigationDataStreamReader::New();
+    reader->Open(m_FileName);
+
+    CPPUNIT_ASSERT_EQUAL(navigationDataSet->GetNumberOfTools(), reader->GetNumberOfTools());
+    CPPUNIT_ASSERT_EQUAL(std::uint64_t(navigationDataSet->Size()), reader->GetNumberOfFrames());
+
+    auto frame = reader->GetFrame(5);
+    for (unsigned int toolIndex = 0; toolIndex < reader->GetNumberOfTools(); ++toolIndex)
+    {
+      auto reference = navigationDataSet->GetNavigationDataForIndex(5, toolIndex);
+      CPPUNIT_ASSERT(mitk::Equal(reference->GetPosition(), frame[toolIndex]->GetPosition()));
+      CPPUNIT_ASSERT(mitk::Equal(reference->GetOrientation(), frame[toolIndex]->GetOrientation()));
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNavigationDataStream)
@@ -4,6 +4,10 @@ set(CPP_FILES
   mitkRealTimeClock.cpp
   mitkNavigationData.cpp
   mitkNavigationDataSet.cpp
+  mitkNavigationDataPoseStore.cpp
+  mitkNavigationDataRecord.cpp
+  mitkNavigationDataStreamReader.cpp
+  mitkNavigationDataStreamWriter.cpp
   mitkStaticIGTHelperFunctions.cpp
   mitkQuaternionAveraging.cpp
   mitkIGTMimeTypes.cpp
@@ -0,0 +1,125 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataPoseStore_h
+#define mitkNavigationDataPoseStore_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationDataRecord.h"
+#include "mitkNavigationDataSet.h"
+
+#include <mitkMemoryMappedFile.h>
+
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Compact random-access storage of recorded poses.
+  *
+  * In contrast to mitk::NavigationDataSet, which holds one mitk::NavigationData object per tool and
+  * time step, the poses are stored as plain mitk::NavigationDataRecord structs in a single contiguous
+  * block, frame by frame. This is the layout of the binary stream files written by
+  * mitk::NavigationDataStreamWriter, so such files are memory mapped by OpenStream() without reading
+  * or converting anything. Pages are only loaded when they are accessed, which makes opening and
+  * scrubbing through recordings of several hours instantaneous.
+  *
+  * All accessors return references into the storage (zero-copy). FindFrame() and Interpolate() use a
+  * binary search and require ascending time stamps per tool, as enforced by mitk::NavigationDataSet
+  * and produced by recording.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGTBASE_EXPORT NavigationDataPoseStore : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataPoseStore, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Strided view of the records of a single tool.
+    */
+    class ToolRecords
+    {
+    public:
+      ToolRecords(const NavigationDataRecord *first, unsigned int stride, std::size_t size)
+        : m_First(first), m_Stride(stride), m_Size(size)
+      {
+      }
+
+      std::size_t size() const { return m_Size; }
+      const NavigationDataRecord &operator[](std::size_t frameIndex) const { return m_First[frameIndex * m_Stride]; }
+
+    private:
+      const NavigationDataRecord *m_First;
+      unsigned int m_Stride;
+      std::size_t m_Size;
+    };
+
+    /**
+    * \brief Copy all poses of a navigation data set.
+    */
+    void SetNavigationDataSet(const NavigationDataSet *navigationDataSet);
+
+    /**
+    * \brief Memory map a binary navigation data stream file.
+    *
+    * A partially written last frame (e.g. after a crash during recording) is ignored.
+    * @throw mitk::IGTIOException if the file cannot be mapped or is not a navigation data stream
+    */
+    void OpenStream(const std::string &fileName);
+
+    void Clear();
+
+    unsigned int GetNumberOfTools() const;
+    std::size_t GetNumberOfFrames() const;
+
+    /**
+    * \brief Records of all tools of a frame in tool order.
+    */
+    const NavigationDataRecord *GetFrame(std::size_t frameIndex) const;
+    const NavigationDataRecord &GetRecord(std::size_t frameIndex, unsigned int toolIndex) const;
+    ToolRecords GetToolRecords(unsigned int toolIndex) const;
+
+    /**
+    * \brief Find the last frame at or before the given time stamp of a tool in O(log n).
+    * \return 0 if the time stamp is before the first frame.
+    */
+    std::size_t FindFrame(NavigationData::TimeStampType timeStamp, unsigned int toolIndex = 0) const;
+
+    /**
+    * \brief Pose of a tool at an arbitrary time stamp.
+    *
+    * Positions and accuracies are interpolated linearly, orientations spherically between the two
+    * enclosing frames. The result is only valid if both frames are valid. Time stamps outside of the
+    * recording are clamped to the first or last frame.
+    */
+    NavigationDataRecord Interpolate(unsigned int toolIndex, NavigationData::TimeStampType timeStamp) const;
+
+    NavigationData::Pointer GetNavigationData(std::size_t frameIndex, unsigned int toolIndex) const;
+    NavigationData::Pointer GetInterpolatedNavigationData(unsigned int toolIndex, NavigationData::TimeStampType timeStamp) const;
+
+  protected:
+    NavigationDataPoseStore();
+    ~NavigationDataPoseStore() override;
+
+  private:
+    std::vector<NavigationDataRecord> m_Records; ///< storage if the poses are not memory mapped
+    MemoryMappedFile m_MappedFile;
+
+    const NavigationDataRecord *m_Data;
+    unsigned int m_NumberOfTools;
+    std::size_t m_NumberOfFrames;
+  };
+}
+
+#endif
@@ -0,0 +1,108 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataRecord_h
+#define mitkNavigationDataRecord_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationData.h"
+
+#include <cstdint>
+
+namespace mitk
+{
+  /**
+  * \brief Fixed-size binary representation of a single mitk::NavigationData.
+  *
+  * Records are the unit of the binary navigation data stream files written by
+  * mitk::NavigationDataStreamWriter and read by mitk::NavigationDataStreamReader.
+  * A stream file consists of a NavigationDataStreamHeader followed by one frame after
+  * another, where each frame holds one record per tool in tool order. Thus, the location
+  * of every record can be computed from its frame and tool index.
+  *
+  * All values are stored in the byte order of the writing machine (little-endian on all
+  * supported platforms).
+  */
+  struct NavigationDataRecord
+  {
+    enum Flags : std::uint32_t
+    {
+      DataValid = 1,
+      HasPosition = 2,
+      HasOrientation = 4
+    };
+
+    double TimeStamp;
+    double Position[3];
+    double Orientation[4]; ///< x, y, z, r (same order as vnl_quaternion)
+    double PositionAccuracy;
+    double OrientationAccuracy;
+    std::uint32_t ToolIndex;
+    std::uint32_t Flags;
+  };
+
+  static_assert(sizeof(NavigationDataRecord) == 88, "NavigationDataRecord must not contain padding");
+
+  /**
+  * \brief Header at the beginning of a binary navigation data stream file.
+  */
+  struct NavigationDataStreamHeader
+  {
+    char Magic[8];                ///< "MITKNDS"
+    std::uint32_t Version;
+    std::uint32_t NumberOfTools;
+    std::uint32_t RecordSize;     ///< sizeof(NavigationDataRecord) of the writer
+    std::uint32_t FramesPerChunk; ///< number of frames between two index entries
+  };
+
+  /**
+  * \brief Entry of the index file ("<stream file>.idx") which is written next to a stream file.
+  *
+  * There is one entry for the first frame of every chunk, which allows to seek to a time stamp
+  * without reading the whole stream. The index file starts with a NavigationDataStreamHeader
+  * with the magic "MITKNDI".
+  */
+  struct NavigationDataStreamIndexEntry
+  {
+    std::uint64_t FrameIndex;
+    double TimeStamp;
+  };
+
+  namespace NavigationDataStream
+  {
+    const std::uint32_t Version = 1;
+    const char StreamMagic[8] = "MITKNDS";
+    const char IndexMagic[8] = "MITKNDI";
+
+    MITKIGTBASE_EXPORT std::string GetIndexFileName(const std::string &streamFileName);
+
+    /**
+    * \brief Check if a header belongs to a stream file that can be read by this version.
+    */
+    MITKIGTBASE_EXPORT bool IsSupportedStreamHeader(const NavigationDataStreamHeader &header);
+
+    /**
+    * \brief Convert a navigation data into a record.
+    *
+    * The accuracies are derived from the first diagonal element of the position and orientation
+    * part of the error covariance matrix (see NavigationData::SetPositionAccuracy()).
+    */
+    MITKIGTBASE_EXPORT NavigationDataRecord ToRecord(const NavigationData *data, unsigned int toolIndex);
+
+    /**
+    * \brief Convert a record into a new navigation data.
+    */
+    MITKIGTBASE_EXPORT NavigationData::Pointer FromRecord(const NavigationDataRecord &record);
+  }
+}
+
+#endif
@@ -0,0 +1,88 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataStreamReader_h
+#define mitkNavigationDataStreamReader_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationDataRecord.h"
+#include "mitkNavigationDataSet.h"
+
+#include <fstream>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Reads binary navigation data stream files written by mitk::NavigationDataStreamWriter.
+  *
+  * Only complete frames are considered, so files of interrupted recordings can be read as well.
+  * The chunk index is read from the index file. Entries that are missing, e.g. because the index
+  * file was not flushed before a crash, are restored from the first record of the respective chunk.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGTBASE_EXPORT NavigationDataStreamReader : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataStreamReader, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * @throw mitk::IGTIOException if the file cannot be opened or is not a navigation data stream
+    */
+    void Open(const std::string &fileName);
+    void Close();
+
+    unsigned int GetNumberOfTools() const;
+    std::uint64_t GetNumberOfFrames() const;
+
+    /**
+    * \brief Read the records of all tools of a frame.
+    * @throw mitk::IGTIOException if the frame cannot be read
+    */
+    void ReadFrame(std::uint64_t frameIndex, std::vector<NavigationDataRecord> &records);
+
+    /**
+    * \brief Read a frame as navigation datas, one per tool.
+    */
+    std::vector<NavigationData::Pointer> GetFrame(std::uint64_t frameIndex);
+
+    /**
+    * \brief Find the last frame whose time stamp is not greater than the given one.
+    *
+    * The time stamp of a frame is the time stamp of its first tool. A binary search over the
+    * chunk index and the frames of a single chunk is used, which requires ascending time stamps.
+    * \return 0 if the time stamp is before the first frame.
+    */
+    std::uint64_t FindFrame(NavigationData::TimeStampType timeStamp);
+
+    /**
+    * \brief Read the whole stream into a (memory-based) navigation data set.
+    */
+    NavigationDataSet::Pointer ReadNavigationDataSet();
+
+  protected:
+    NavigationDataStreamReader();
+    ~NavigationDataStreamReader() override;
+
+  private:
+    NavigationData::TimeStampType ReadFrameTimeStamp(std::uint64_t frameIndex);
+
+    std::ifstream m_File;
+    NavigationDataStreamHeader m_Header;
+    std::uint64_t m_NumberOfFrames;
+    std::vector<NavigationDataStreamIndexEntry> m_Index;
+  };
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkNavigationDataStreamWriter_h
+#define mitkNavigationDataStreamWriter_h
+
+#include <MitkIGTBaseExports.h>
+#include "mitkNavigationDataRecord.h"
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mitk
+{
+  /**
+  * \brief Appends navigation data frames to a binary stream file from a background thread.
+  *
+  * Append() only converts the navigation datas into fixed-size records (see mitk::NavigationDataRecord)
+  * and queues them, so it can be called from the tracking pipeline without blocking on disk access.
+  * The writer thread appends all queued frames to the stream file and flushes it afterwards. Hence,
+  * everything but the last few frames is on disk if the application crashes.
+  *
+  * For every chunk of GetFramesPerChunk() frames, an entry is added to the index file
+  * (see NavigationDataStream::GetIndexFileName()). It allows mitk::NavigationDataStreamReader to
+  * reopen long recordings and to seek to time stamps without reading the whole file.
+  *
+  * \ingroup IGT
+  */
+  class MITKIGTBASE_EXPORT NavigationDataStreamWriter : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(NavigationDataStreamWriter, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    /**
+    * \brief Number of frames per chunk, i.e. between two index entries. Must be set before Open(). Default is 256.
+    */
+    itkSetMacro(FramesPerChunk, unsigned int);
+    itkGetConstMacro(FramesPerChunk, unsigned int);
+
+    /**
+    * \brief Create (or overwrite) the stream file and its index and start the writer thread.
+    * @throw mitk::IGTIOException if the files cannot be created
+    */
+    void Open(const std::string &fileName, unsigned int numberOfTools);
+
+    /**
+    * \brief Queue one frame, i.e. one navigation data per tool in tool order.
+    * @throw mitk::IGTException if the writer is not open or the number of navigation datas is wrong
+    * @throw mitk::IGTIOException if a previous write failed
+    */
+    void Append(const std::vector<NavigationData::Pointer> &navigationDatas);
+
+    /**
+    * \brief Block until all queued frames are written and flushed. Returns immediately for a stream without tools.
+    */
+    void Flush();
+
+    /**
+    * \brief Write all queued frames, stop the writer thread and close the files.
+    */
+    void Close();
+
+    bool IsOpen() const;
+
+    /**
+    * \brief Number of frames appended since Open(), including frames that are still queued.
+    */
+    std::uint64_t GetNumberOfFrames() const;
+
+    /**
+    * \brief Number of frames that are already written to the stream file.
+    */
+    std::uint64_t GetNumberOfWrittenFrames() const;
+
+  protected:
+    NavigationDataStreamWriter();
+    ~NavigationDataStreamWriter() override;
+
+  private:
+    void Write();
+
+    std::ofstream m_StreamFile;
+    std::ofstream m_IndexFile;
+    std::thread m_Thread;
+
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_QueueCondition;
+    std::condition_variable m_WrittenCondition;
+    std::vector<NavigationDataRecord> m_Queue;
+
+    unsigned int m_FramesPerChunk;
+    unsigned int m_NumberOfTools;
+    std::uint64_t m_NumberOfFrames;
+    std::uint64_t m_NumberOfWrittenFrames;
+    bool m_IsOpen;
+    bool m_StopRequested;
+    bool m_WriteFailed;
+  };
+}
+
+#endif
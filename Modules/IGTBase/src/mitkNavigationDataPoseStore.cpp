@@ -0,0 +1,249 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataPoseStore.h"
+#include "mitkIGTException.h"
+#include "mitkIGTIOException.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+  void Slerp(const double *q0, const double *q1, double t, double *result)
+  {
+    double q1Signed[4] = { q1[0], q1[1], q1[2], q1[3] };
+    double dot = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+
+    // Take the shorter path
+    if (dot < 0.0)
+    {
+      dot = -dot;
+      for (int i = 0; i < 4; ++i)
+        q1Signed[i] = -q1Signed[i];
+    }
+
+    double w0 = 1.0 - t;
+    double w1 = t;
+
+    // Fall back to linear interpolation for (almost) identical orientations
+    if (dot < 0.9995)
+    {
+      const double angle = std::acos(dot);
+      const double sinAngle = std::sin(angle);
+      w0 = std::sin((1.0 - t) * angle) / sinAngle;
+      w1 = std::sin(t * angle) / sinAngle;
+    }
+
+    double norm = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+      result[i] = w0 * q0[i] + w1 * q1Signed[i];
+      norm += result[i] * result[i];
+    }
+
+    norm = std::sqrt(norm);
+    if (norm > 0.0)
+    {
+      for (int i = 0; i < 4; ++i)
+        result[i] /= norm;
+    }
+  }
+}
+
+mitk::NavigationDataPoseStore::NavigationDataPoseStore()
+  : m_Data(nullptr),
+    m_NumberOfTools(0),
+    m_NumberOfFrames(0)
+{
+}
+
+mitk::NavigationDataPoseStore::~NavigationDataPoseStore()
+{
+}
+
+void mitk::NavigationDataPoseStore::SetNavigationDataSet(const NavigationDataSet *navigationDataSet)
+{
+  this->Clear();
+
+  if (nullptr == navigationDataSet)
+    return;
+
+  m_NumberOfTools = navigationDataSet->GetNumberOfTools();
+  m_NumberOfFrames = navigationDataSet->Size();
+  m_Records.reserve(m_NumberOfFrames * m_NumberOfTools);
+
+  for (auto iter = navigationDataSet->Begin(); iter != navigationDataSet->End(); ++iter)
+  {
+    for (unsigned int toolIndex = 0; toolIndex < m_NumberOfTools; ++toolIndex)
+      m_Records.push_back(NavigationDataStream::ToRecord((*iter)[toolIndex], toolIndex));
+  }
+
+  m_Data = m_Records.data();
+  this->Modified();
+}
+
+void mitk::NavigationDataPoseStore::OpenStream(const std::string &fileName)
+{
+  this->Clear();
+
+  try
+  {
+    m_MappedFile.Open(fileName);
+  }
+  catch (const mitk::Exception &e)
+  {
+    mitkThrowException(mitk::IGTIOException) << e.GetDescription();
+  }
+
+  NavigationDataStreamHeader header;
+
+  if (m_MappedFile.GetSize() < sizeof(header))
+  {
+    this->Clear();
+    mitkThrowException(mitk::IGTIOException) << fileName << " is not a supported navigation data stream.";
+  }
+
+  std::memcpy(&header, m_MappedFile.GetData(), sizeof(header));
+
+  if (!NavigationDataStream::IsSupportedStreamHeader(header))
+  {
+    this->Clear();
+    mitkThrowException(mitk::IGTIOException) << fileName << " is not a supported navigation data stream.";
+  }
+
+  const std::size_t frameSize = static_cast<std::size_t>(header.NumberOfTools) * sizeof(NavigationDataRecord);
+
+  m_NumberOfTools = header.NumberOfTools;
+  m_NumberOfFrames = 0 != frameSize
+    ? (m_MappedFile.GetSize() - sizeof(header)) / frameSize
+    : 0;
+
+  // The header size is a multiple of 8 bytes, so the records are properly aligned
+  m_Data = reinterpret_cast<const NavigationDataRecord *>(m_MappedFile.GetData() + sizeof(header));
+  this->Modified();
+}
+
+void mitk::NavigationDataPoseStore::Clear()
+{
+  m_Records.clear();
+  m_Records.shrink_to_fit();
+  m_MappedFile.Close();
+  m_Data = nullptr;
+  m_NumberOfTools = 0;
+  m_NumberOfFrames = 0;
+  this->Modified();
+}
+
+unsigned int mitk::NavigationDataPoseStore::GetNumberOfTools() const
+{
+  return m_NumberOfTools;
+}
+
+std::size_t mitk::NavigationDataPoseStore::GetNumberOfFrames() const
+{
+  return m_NumberOfFrames;
+}
+
+const mitk::NavigationDataRecord *mitk::NavigationDataPoseStore::GetFrame(std::size_t frameIndex) const
+{
+  if (frameIndex >= m_NumberOfFrames)
+    mitkThrowException(mitk::IGTException) << "Frame " << frameIndex << " is not available, the store contains " << m_NumberOfFrames << " frames.";
+
+  return m_Data + frameIndex * m_NumberOfTools;
+}
+
+const mitk::NavigationDataRecord &mitk::NavigationDataPoseStore::GetRecord(std::size_t frameIndex, unsigned int toolIndex) const
+{
+  if (toolIndex >= m_NumberOfTools)
+    mitkThrowException(mitk::IGTException) << "Invalid tool index " << toolIndex << ", the store contains " << m_NumberOfTools << " tools.";
+
+  return this->GetFrame(frameIndex)[toolIndex];
+}
+
+mitk::NavigationDataPoseStore::ToolRecords mitk::NavigationDataPoseStore::GetToolRecords(unsigned int toolIndex) const
+{
+  if (toolIndex >= m_NumberOfTools)
+    mitkThrowException(mitk::IGTException) << "Invalid tool index " << toolIndex << ", the store contains " << m_NumberOfTools << " tools.";
+
+  return ToolRecords(m_Data + toolIndex, m_NumberOfTools, m_NumberOfFrames);
+}
+
+std::size_t mitk::NavigationDataPoseStore::FindFrame(NavigationData::TimeStampType timeStamp, unsigned int toolIndex) const
+{
+  const auto records = this->GetToolRecords(toolIndex);
+
+  // Number of frames at or before the time stamp
+  std::size_t first = 0;
+  std::size_t count = records.size();
+
+  while (count > 0)
+  {
+    const std::size_t step = count / 2;
+
+    if (records[first + step].TimeStamp <= timeStamp)
+    {
+      first += step + 1;
+      count -= step + 1;
+    }
+    else
+    {
+      count = step;
+    }
+  }
+
+  return first > 0 ? first - 1 : 0;
+}
+
+mitk::NavigationDataRecord mitk::NavigationDataPoseStore::Interpolate(unsigned int toolIndex, NavigationData::TimeStampType timeStamp) const
+{
+  const auto records = this->GetToolRecords(toolIndex);
+
+  if (0 == records.size())
+    mitkThrowException(mitk::IGTException) << "Cannot interpolate, the store is empty.";
+
+  const std::size_t frameIndex = this->FindFrame(timeStamp, toolIndex);
+  const auto &before = records[frameIndex];
+
+  if (timeStamp <= before.TimeStamp || frameIndex + 1 == records.size())
+    return before;
+
+  const auto &after = records[frameIndex + 1];
+  const double t = (timeStamp - before.TimeStamp) / (after.TimeStamp - before.TimeStamp);
+
+  NavigationDataRecord result = before;
+  result.TimeStamp = timeStamp;
+
+  for (int i = 0; i < 3; ++i)
+    result.Position[i] = before.Position[i] + t * (after.Position[i] - before.Position[i]);
+
+  Slerp(before.Orientation, after.Orientation, t, result.Orientation);
+
+  result.PositionAccuracy = before.PositionAccuracy + t * (after.PositionAccuracy - before.PositionAccuracy);
+  result.OrientationAccuracy = before.OrientationAccuracy + t * (after.OrientationAccuracy - before.OrientationAccuracy);
+  result.Flags = before.Flags & after.Flags;
+
+  return result;
+}
+
+mitk::NavigationData::Pointer mitk::NavigationDataPoseStore::GetNavigationData(std::size_t frameIndex, unsigned int toolIndex) const
+{
+  return NavigationDataStream::FromRecord(this->GetRecord(frameIndex, toolIndex));
+}
+
+mitk::NavigationData::Pointer mitk::NavigationDataPoseStore::GetInterpolatedNavigationData(unsigned int toolIndex, NavigationData::TimeStampType timeStamp) const
+{
+  return NavigationDataStream::FromRecord(this->Interpolate(toolIndex, timeStamp));
+}
@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataRecord.h"
+
+#include <cmath>
+#include <cstring>
+
+std::string mitk::NavigationDataStream::GetIndexFileName(const std::string &streamFileName)
+{
+  return streamFileName + ".idx";
+}
+
+bool mitk::NavigationDataStream::IsSupportedStreamHeader(const NavigationDataStreamHeader &header)
+{
+  return 0 == std::memcmp(header.Magic, StreamMagic, sizeof(header.Magic)) &&
+         header.Version == Version &&
+         header.RecordSize == sizeof(NavigationDataRecord) &&
+         0 != header.FramesPerChunk;
+}
+
+mitk::NavigationDataRecord mitk::NavigationDataStream::ToRecord(const NavigationData *data, unsigned int toolIndex)
+{
+  NavigationDataRecord record;
+
+  record.TimeStamp = data->GetIGTTimeStamp();
+
+  const auto position = data->GetPosition();
+  for (int i = 0; i < 3; ++i)
+    record.Position[i] = position[i];
+
+  const auto orientation = data->GetOrientation();
+  record.Orientation[0] = orientation.x();
+  record.Orientation[1] = orientation.y();
+  record.Orientation[2] = orientation.z();
+  record.Orientation[3] = orientation.r();
+
+  const auto covariance = data->GetCovErrorMatrix();
+  record.PositionAccuracy = std::sqrt(covariance[0][0]);
+  record.OrientationAccuracy = std::sqrt(covariance[3][3]);
+
+  record.ToolIndex = toolIndex;
+  record.Flags = 0;
+
+  if (data->IsDataValid())
+    record.Flags |= NavigationDataRecord::DataValid;
+  if (data->GetHasPosition())
+    record.Flags |= NavigationDataRecord::HasPosition;
+  if (data->GetHasOrientation())
+    record.Flags |= NavigationDataRecord::HasOrientation;
+
+  return record;
+}
+
+mitk::NavigationData::Pointer mitk::NavigationDataStream::FromRecord(const NavigationDataRecord &record)
+{
+  auto data = NavigationData::New();
+
+  NavigationData::PositionType position;
+  for (int i = 0; i < 3; ++i)
+    position[i] = record.Position[i];
+
+  data->SetPosition(position);
+  data->SetOrientation(NavigationData::OrientationType(record.Orientation[0], record.Orientation[1], record.Orientation[2], record.Orientation[3]));
+  data->SetIGTTimeStamp(record.TimeStamp);
+  data->SetPositionAccuracy(record.PositionAccuracy);
+  data->SetOrientationAccuracy(record.OrientationAccuracy);
+  data->SetDataValid(0 != (record.Flags & NavigationDataRecord::DataValid));
+  data->SetHasPosition(0 != (record.Flags & NavigationDataRecord::HasPosition));
+  data->SetHasOrientation(0 != (record.Flags & NavigationDataRecord::HasOrientation));
+
+  return data;
+}
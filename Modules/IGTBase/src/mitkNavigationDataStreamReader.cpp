@@ -0,0 +1,193 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataStreamReader.h"
+#include "mitkIGTIOException.h"
+
+#include <algorithm>
+#include <cstring>
+
+mitk::NavigationDataStreamReader::NavigationDataStreamReader()
+  : m_Header(),
+    m_NumberOfFrames(0)
+{
+}
+
+mitk::NavigationDataStreamReader::~NavigationDataStreamReader()
+{
+}
+
+void mitk::NavigationDataStreamReader::Open(const std::string &fileName)
+{
+  this->Close();
+
+  m_File.open(fileName, std::ios::binary);
+
+  if (!m_File.is_open())
+    mitkThrowException(mitk::IGTIOException) << "Cannot open navigation data stream " << fileName;
+
+  m_File.read(reinterpret_cast<char *>(&m_Header), sizeof(m_Header));
+
+  if (!m_File || !NavigationDataStream::IsSupportedStreamHeader(m_Header))
+  {
+    this->Close();
+    mitkThrowException(mitk::IGTIOException) << fileName << " is not a supported navigation data stream.";
+  }
+
+  // Only complete frames are used, a partially written last frame is ignored
+  m_File.seekg(0, std::ios::end);
+  const std::uint64_t dataSize = static_cast<std::uint64_t>(m_File.tellg()) - sizeof(m_Header);
+  const std::uint64_t frameSize = static_cast<std::uint64_t>(m_Header.NumberOfTools) * sizeof(NavigationDataRecord);
+  m_NumberOfFrames = 0 != frameSize ? dataSize / frameSize : 0;
+
+  const std::uint64_t numberOfChunks = (m_NumberOfFrames + m_Header.FramesPerChunk - 1) / m_Header.FramesPerChunk;
+
+  std::ifstream indexFile(NavigationDataStream::GetIndexFileName(fileName), std::ios::binary);
+  NavigationDataStreamHeader indexHeader;
+
+  if (indexFile.read(reinterpret_cast<char *>(&indexHeader), sizeof(indexHeader)) &&
+      0 == std::memcmp(indexHeader.Magic, NavigationDataStream::IndexMagic, sizeof(indexHeader.Magic)) &&
+      indexHeader.FramesPerChunk == m_Header.FramesPerChunk)
+  {
+    NavigationDataStreamIndexEntry entry;
+
+    while (m_Index.size() < numberOfChunks && indexFile.read(reinterpret_cast<char *>(&entry), sizeof(entry)))
+    {
+      if (entry.FrameIndex != m_Index.size() * m_Header.FramesPerChunk)
+        break;
+
+      m_Index.push_back(entry);
+    }
+  }
+
+  // Restore missing index entries from the stream
+  while (m_Index.size() < numberOfChunks)
+  {
+    NavigationDataStreamIndexEntry entry;
+    entry.FrameIndex = m_Index.size() * m_Header.FramesPerChunk;
+    entry.TimeStamp = this->ReadFrameTimeStamp(entry.FrameIndex);
+    m_Index.push_back(entry);
+  }
+}
+
+void mitk::NavigationDataStreamReader::Close()
+{
+  m_File.close();
+  m_File.clear();
+  m_Header = NavigationDataStreamHeader();
+  m_NumberOfFrames = 0;
+  m_Index.clear();
+}
+
+unsigned int mitk::NavigationDataStreamReader::GetNumberOfTools() const
+{
+  return m_Header.NumberOfTools;
+}
+
+std::uint64_t mitk::NavigationDataStreamReader::GetNumberOfFrames() const
+{
+  return m_NumberOfFrames;
+}
+
+void mitk::NavigationDataStreamReader::ReadFrame(std::uint64_t frameIndex, std::vector<NavigationDataRecord> &records)
+{
+  if (frameIndex >= m_NumberOfFrames)
+    mitkThrowException(mitk::IGTIOException) << "Frame " << frameIndex << " is not available, the stream contains " << m_NumberOfFrames << " frames.";
+
+  records.resize(m_Header.NumberOfTools);
+
+  const std::uint64_t frameSize = records.size() * sizeof(NavigationDataRecord);
+  m_File.seekg(sizeof(m_Header) + frameIndex * frameSize);
+  m_File.read(reinterpret_cast<char *>(records.data()), frameSize);
+
+  if (!m_File)
+  {
+    m_File.clear();
+    mitkThrowException(mitk::IGTIOException) << "Cannot read frame " << frameIndex << " of navigation data stream.";
+  }
+}
+
+std::vector<mitk::NavigationData::Pointer> mitk::NavigationDataStreamReader::GetFrame(std::uint64_t frameIndex)
+{
+  std::vector<NavigationDataRecord> records;
+  this->ReadFrame(frameIndex, records);
+
+  std::vector<NavigationData::Pointer> navigationDatas;
+  navigationDatas.reserve(records.size());
+
+  for (const auto &record : records)
+    navigationDatas.push_back(NavigationDataStream::FromRecord(record));
+
+  return navigationDatas;
+}
+
+std::uint64_t mitk::NavigationDataStreamReader::FindFrame(NavigationData::TimeStampType timeStamp)
+{
+  if (m_Index.empty())
+    return 0;
+
+  // Last chunk starting at or before the time stamp
+  auto chunk = std::upper_bound(m_Index.begin(), m_Index.end(), timeStamp,
+    [](NavigationData::TimeStampType value, const NavigationDataStreamIndexEntry &entry) { return value < entry.TimeStamp; });
+
+  if (chunk == m_Index.begin())
+    return 0;
+
+  --chunk;
+
+  // Last frame of the chunk at or before the time stamp
+  std::uint64_t first = chunk->FrameIndex;
+  std::uint64_t last = std::min<std::uint64_t>(first + m_Header.FramesPerChunk, m_NumberOfFrames) - 1;
+
+  while (first < last)
+  {
+    const std::uint64_t middle = first + (last - first + 1) / 2;
+
+    if (this->ReadFrameTimeStamp(middle) <= timeStamp)
+    {
+      first = middle;
+    }
+    else
+    {
+      last = middle - 1;
+    }
+  }
+
+  return first;
+}
+
+mitk::NavigationDataSet::Pointer mitk::NavigationDataStreamReader::ReadNavigationDataSet()
+{
+  auto navigationDataSet = NavigationDataSet::New(m_Header.NumberOfTools);
+
+  for (std::uint64_t frameIndex = 0; frameIndex < m_NumberOfFrames; ++frameIndex)
+    navigationDataSet->AddNavigationDatas(this->GetFrame(frameIndex));
+
+  return navigationDataSet;
+}
+
+mitk::NavigationData::TimeStampType mitk::NavigationDataStreamReader::ReadFrameTimeStamp(std::uint64_t frameIndex)
+{
+  NavigationDataRecord record;
+
+  const std::uint64_t frameSize = static_cast<std::uint64_t>(m_Header.NumberOfTools) * sizeof(NavigationDataRecord);
+  m_File.seekg(sizeof(m_Header) + frameIndex * frameSize);
+  m_File.read(reinterpret_cast<char *>(&record), sizeof(record));
+
+  if (!m_File)
+  {
+    m_File.clear();
+    mitkThrowException(mitk::IGTIOException) << "Cannot read frame " << frameIndex << " of navigation data stream.";
+  }
+
+  return record.TimeStamp;
+}
@@ -0,0 +1,226 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkNavigationDataStreamWriter.h"
+#include "mitkIGTException.h"
+#include "mitkIGTIOException.h"
+
+#include <cstring>
+
+namespace
+{
+  mitk::NavigationDataStreamHeader CreateHeader(const char *magic, unsigned int numberOfTools, unsigned int framesPerChunk)
+  {
+    mitk::NavigationDataStreamHeader header;
+    std::memcpy(header.Magic, magic, sizeof(header.Magic));
+    header.Version = mitk::NavigationDataStream::Version;
+    header.NumberOfTools = numberOfTools;
+    header.RecordSize = sizeof(mitk::NavigationDataRecord);
+    header.FramesPerChunk = framesPerChunk;
+    return header;
+  }
+}
+
+mitk::NavigationDataStreamWriter::NavigationDataStreamWriter()
+  : m_FramesPerChunk(256),
+    m_NumberOfTools(0),
+    m_NumberOfFrames(0),
+    m_NumberOfWrittenFrames(0),
+    m_IsOpen(false),
+    m_StopRequested(false),
+    m_WriteFailed(false)
+{
+}
+
+mitk::NavigationDataStreamWriter::~NavigationDataStreamWriter()
+{
+  try
+  {
+    this->Close();
+  }
+  catch (...)
+  {
+    MITK_ERROR << "Error while closing navigation data stream.";
+  }
+}
+
+void mitk::NavigationDataStreamWriter::Open(const std::string &fileName, unsigned int numberOfTools)
+{
+  this->Close();
+
+  if (0 == m_FramesPerChunk)
+    m_FramesPerChunk = 1;
+
+  m_StreamFile.open(fileName, std::ios::binary | std::ios::trunc);
+  m_IndexFile.open(NavigationDataStream::GetIndexFileName(fileName), std::ios::binary | std::ios::trunc);
+
+  if (!m_StreamFile.is_open() || !m_IndexFile.is_open())
+  {
+    m_StreamFile.close();
+    m_IndexFile.close();
+    mitkThrowException(mitk::IGTIOException) << "Cannot create navigation data stream " << fileName;
+  }
+
+  const auto streamHeader = CreateHeader(NavigationDataStream::StreamMagic, numberOfTools, m_FramesPerChunk);
+  const auto indexHeader = CreateHeader(NavigationDataStream::IndexMagic, numberOfTools, m_FramesPerChunk);
+  m_StreamFile.write(reinterpret_cast<const char *>(&streamHeader), sizeof(streamHeader));
+  m_IndexFile.write(reinterpret_cast<const char *>(&indexHeader), sizeof(indexHeader));
+  m_StreamFile.flush();
+  m_IndexFile.flush();
+
+  m_NumberOfTools = numberOfTools;
+  m_NumberOfFrames = 0;
+  m_NumberOfWrittenFrames = 0;
+  m_StopRequested = false;
+  m_WriteFailed = !m_StreamFile || !m_IndexFile;
+  m_IsOpen = true;
+
+  m_Thread = std::thread(&NavigationDataStreamWriter::Write, this);
+}
+
+void mitk::NavigationDataStreamWriter::Append(const std::vector<NavigationData::Pointer> &navigationDatas)
+{
+  if (!this->IsOpen())
+    mitkThrowException(mitk::IGTException) << "Navigation data stream is not open.";
+
+  if (navigationDatas.size() != m_NumberOfTools)
+    mitkThrowException(mitk::IGTException) << "Navigation data stream requires " << m_NumberOfTools << " navigation datas per frame, got " << navigationDatas.size() << ".";
+
+  std::vector<NavigationDataRecord> records;
+  records.reserve(navigationDatas.size());
+
+  for (unsigned int toolIndex = 0; toolIndex < navigationDatas.size(); ++toolIndex)
+    records.push_back(NavigationDataStream::ToRecord(navigationDatas[toolIndex], toolIndex));
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (m_WriteFailed)
+      mitkThrowException(mitk::IGTIOException) << "Writing the navigation data stream failed.";
+
+    m_Queue.insert(m_Queue.end(), records.begin(), records.end());
+    ++m_NumberOfFrames;
+  }
+
+  m_QueueCondition.notify_one();
+}
+
+void mitk::NavigationDataStreamWriter::Flush()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+
+  // Frames without tools have no records, so the writer thread never writes (or counts) them
+  if (0 == m_NumberOfTools)
+    return;
+
+  m_WrittenCondition.wait(lock, [this] { return !m_IsOpen || m_WriteFailed || m_NumberOfWrittenFrames == m_NumberOfFrames; });
+}
+
+void mitk::NavigationDataStreamWriter::Close()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    if (!m_IsOpen)
+      return;
+
+    m_StopRequested = true;
+  }
+
+  m_QueueCondition.notify_one();
+  m_Thread.join();
+
+  m_StreamFile.close();
+  m_IndexFile.close();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_IsOpen = false;
+  m_WrittenCondition.notify_all();
+}
+
+bool mitk::NavigationDataStreamWriter::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_IsOpen;
+}
+
+std::uint64_t mitk::NavigationDataStreamWriter::GetNumberOfFrames() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfFrames;
+}
+
+std::uint64_t mitk::NavigationDataStreamWriter::GetNumberOfWrittenFrames() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfWrittenFrames;
+}
+
+void mitk::NavigationDataStreamWriter::Write()
+{
+  std::vector<NavigationDataRecord> records;
+  std::uint64_t frameIndex = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_QueueCondition.wait(lock, [this] { return m_StopRequested || !m_Queue.empty(); });
+
+      if (m_Queue.empty() && m_StopRequested)
+        break;
+
+      records.clear();
+      records.swap(m_Queue);
+    }
+
+    const std::uint64_t numberOfFrames = 0 != m_NumberOfTools
+      ? records.size() / m_NumberOfTools
+      : 0;
+
+    bool indexChanged = false;
+
+    for (std::uint64_t i = 0; i < numberOfFrames; ++i, ++frameIndex)
+    {
+      if (0 == frameIndex % m_FramesPerChunk)
+      {
+        NavigationDataStreamIndexEntry entry;
+        entry.FrameIndex = frameIndex;
+        entry.TimeStamp = records[i * m_NumberOfTools].TimeStamp;
+        m_IndexFile.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        indexChanged = true;
+      }
+    }
+
+    m_StreamFile.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(NavigationDataRecord));
+    m_StreamFile.flush();
+
+    // The index is flushed after the stream, so it never refers to frames that are not on disk
+    if (indexChanged)
+      m_IndexFile.flush();
+
+    const bool failed = !m_StreamFile || !m_IndexFile;
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      m_NumberOfWrittenFrames += numberOfFrames;
+
+      if (failed && !m_WriteFailed)
+      {
+        m_WriteFailed = true;
+        MITK_ERROR << "Writing the navigation data stream failed.";
+      }
+    }
+
+    m_WrittenCondition.notify_all();
+  }
+}
@@ -5,6 +5,8 @@ set(MODULE_TESTS
   mitkImageStatisticsTextureAnalysisTest.cpp
   mitkImageStatisticsContainerTest.cpp
   mitkImageStatisticsContainerManagerTest.cpp
+  mitkIncrementalImageStatisticsCalculatorTest.cpp
+  mitkMultiLabelMaskGeneratorTest.cpp
 )
 
 set(MODULE_CUSTOM_TESTS
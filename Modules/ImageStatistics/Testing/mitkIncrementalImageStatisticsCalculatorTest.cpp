@@ -0,0 +1,410 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include "mitkIncrementalImageStatisticsCalculator.h"
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkITKImageImport.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkImage.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * \brief Test class for mitkIncrementalImageStatisticsCalculator
+ *
+ * This test covers:
+ * - statistics of the labels of a mask compared to a brute force computation
+ * - incremental updates after modifying the mask in place
+ * - masks covering a sub region of the image
+ * - exact quantiles computed in the background
+ * - images with NaN and infinite values
+ */
+class mitkIncrementalImageStatisticsCalculatorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIncrementalImageStatisticsCalculatorTestSuite);
+  MITK_TEST(TestUninitializedImage);
+  MITK_TEST(TestMultilabelMask);
+  MITK_TEST(TestIncrementalUpdate);
+  MITK_TEST(TestLabelRemoval);
+  MITK_TEST(TestSubRegionMask);
+  MITK_TEST(TestExactQuantiles);
+  MITK_TEST(TestNonFiniteValues);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  typedef itk::Image<short, 3> ImageType;
+  typedef itk::Image<unsigned short, 3> MaskType;
+
+  void setUp() override
+  {
+    ImageType::SizeType size = {{16, 12, 6}};
+    ImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+    ImageType::PointType origin;
+    origin[0] = -3.0;
+    origin[1] = 5.0;
+    origin[2] = 1.0;
+
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->Allocate();
+
+    short* values = image->GetBufferPointer();
+
+    for (unsigned int z = 0; z < size[2]; ++z)
+      for (unsigned int y = 0; y < size[1]; ++y)
+        for (unsigned int x = 0; x < size[0]; ++x)
+          values[x + size[0] * (y + size[1] * z)] = static_cast<short>((x * 7 + y * 13 + z * 29) % 101 - 30);
+
+    m_Values.assign(values, values + image->GetBufferedRegion().GetNumberOfPixels());
+    m_Image = mitk::GrabItkImageMemory(image.GetPointer());
+
+    // label 1 and label 2 side by side
+    m_Labels.assign(m_Values.size(), 0);
+
+    for (unsigned int z = 1; z < 5; ++z)
+      for (unsigned int y = 2; y < 8; ++y)
+        for (unsigned int x = 2; x < 14; ++x)
+          m_Labels[x + 16 * (y + 12 * z)] = x < 10 ? 1 : 2;
+
+    auto mask = MaskType::New();
+    mask->SetRegions(size);
+    mask->SetSpacing(spacing);
+    mask->SetOrigin(origin);
+    mask->Allocate();
+    std::copy(m_Labels.begin(), m_Labels.end(), mask->GetBufferPointer());
+    m_Mask = mitk::GrabItkImageMemory(mask.GetPointer());
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Mask = nullptr;
+    m_Values.clear();
+    m_Labels.clear();
+  }
+
+  void TestUninitializedImage()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    CPPUNIT_ASSERT_THROW(calculator->Update(), mitk::Exception);
+
+    calculator->SetInputImage(mitk::Image::New());
+    CPPUNIT_ASSERT_THROW(calculator->Update(), mitk::Exception);
+  }
+
+  void TestMultilabelMask()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(m_Mask);
+    calculator->SetComputeExactQuantiles(false);
+    calculator->Update();
+
+    CPPUNIT_ASSERT(calculator->GetLastUpdateWasFull());
+    CPPUNIT_ASSERT(std::vector<mitk::IncrementalImageStatisticsCalculator::LabelIndex>({1, 2}) ==
+                   calculator->GetLabels());
+
+    VerifyStatistics(calculator, 1);
+    VerifyStatistics(calculator, 2);
+  }
+
+  void TestIncrementalUpdate()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(m_Mask);
+    calculator->SetComputeExactQuantiles(false);
+    calculator->Update();
+
+    // grow label 1 by a slab, shrink it by a row and move a few voxels of label 2 to label 1
+    unsigned long changes = 0;
+    changes += SetLabel(2, 10, 2, 8, 0, 1, 1);
+    changes += SetLabel(2, 10, 7, 8, 1, 5, 0);
+    changes += SetLabel(10, 12, 2, 3, 2, 3, 1);
+    WriteLabelsToMask();
+
+    calculator->Update();
+
+    CPPUNIT_ASSERT(!calculator->GetLastUpdateWasFull());
+    CPPUNIT_ASSERT_EQUAL(changes, calculator->GetNumberOfChangedVoxels());
+
+    VerifyStatistics(calculator, 1);
+    VerifyStatistics(calculator, 2);
+
+    // nothing changed
+    m_Mask->Modified();
+    calculator->Update();
+    CPPUNIT_ASSERT_EQUAL(0ul, calculator->GetNumberOfChangedVoxels());
+    VerifyStatistics(calculator, 1);
+  }
+
+  void TestLabelRemoval()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(m_Mask);
+    calculator->SetComputeExactQuantiles(false);
+    calculator->Update();
+
+    SetLabel(10, 14, 2, 8, 1, 5, 0);
+    WriteLabelsToMask();
+
+    CPPUNIT_ASSERT_THROW(calculator->GetStatistics(2), mitk::Exception);
+    CPPUNIT_ASSERT(std::vector<mitk::IncrementalImageStatisticsCalculator::LabelIndex>({1}) ==
+                   calculator->GetLabels());
+    VerifyStatistics(calculator, 1);
+  }
+
+  void TestSubRegionMask()
+  {
+    // mask of 4x3x2 voxels starting at voxel (3, 2, 1) of the image
+    MaskType::PointType origin;
+    origin[0] = -3.0 + 3 * 0.5;
+    origin[1] = 5.0 + 2 * 1.0;
+    origin[2] = 1.0 + 1 * 2.0;
+
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(CreateConstantMask(origin, 3));
+    calculator->SetComputeExactQuantiles(false);
+    calculator->Update();
+
+    std::fill(m_Labels.begin(), m_Labels.end(), 0);
+    SetLabel(3, 7, 2, 5, 1, 3, 3);
+    VerifyStatistics(calculator, 3);
+
+    // a mask off the voxel grid of the image is rejected
+    origin[0] += 0.1;
+    calculator->SetMask(CreateConstantMask(origin, 3));
+    CPPUNIT_ASSERT_THROW(calculator->Update(), mitk::Exception);
+  }
+
+  void TestExactQuantiles()
+  {
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(m_Mask);
+    calculator->SetQuantileLevels({0.0, 0.1, 1.0});
+    calculator->Update();
+
+    CPPUNIT_ASSERT(calculator->UpdateExactQuantiles(true));
+
+    for (mitk::IncrementalImageStatisticsCalculator::LabelIndex label = 1; label <= 2; ++label)
+    {
+      auto values = GetValues(label);
+      std::sort(values.begin(), values.end());
+
+      const double position = 0.1 * (values.size() - 1);
+      const auto lower = static_cast<std::size_t>(position);
+      const double expectedQuantile = values[lower] + (position - lower) * (values[lower + 1] - values[lower]);
+      const double expectedMedian = values.size() % 2 == 0
+                                      ? 0.5 * (values[values.size() / 2 - 1] + values[values.size() / 2])
+                                      : values[values.size() / 2];
+
+      auto quantiles = calculator->GetQuantiles(label);
+      CPPUNIT_ASSERT_EQUAL(std::size_t(3), quantiles.size());
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(values.front(), quantiles[0], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedQuantile, quantiles[1], mitk::eps);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(values.back(), quantiles[2], mitk::eps);
+
+      auto statistics = calculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedMedian,
+        statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEDIAN()),
+        mitk::eps);
+    }
+
+    // a new update discards the quantiles of the previous mask
+    SetLabel(2, 10, 2, 8, 0, 1, 1);
+    WriteLabelsToMask();
+    calculator->Update();
+    CPPUNIT_ASSERT(calculator->UpdateExactQuantiles(true));
+
+    auto values = GetValues(1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(*std::max_element(values.begin(), values.end()), calculator->GetQuantiles(1)[2], mitk::eps);
+  }
+
+  void TestNonFiniteValues()
+  {
+    // the image values as float with NaN and infinite values in label 1 and outside of the mask
+    typedef itk::Image<float, 3> FloatImageType;
+
+    FloatImageType::SizeType size = {{16, 12, 6}};
+    FloatImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+    FloatImageType::PointType origin;
+    origin[0] = -3.0;
+    origin[1] = 5.0;
+    origin[2] = 1.0;
+
+    auto image = FloatImageType::New();
+    image->SetRegions(size);
+    image->SetSpacing(spacing);
+    image->SetOrigin(origin);
+    image->Allocate();
+    std::copy(m_Values.begin(), m_Values.end(), image->GetBufferPointer());
+
+    float* values = image->GetBufferPointer();
+    const std::size_t nanOffset = 3 + 16 * (3 + 12 * 2);
+    const std::size_t infOffset = 5 + 16 * (4 + 12 * 3);
+    values[nanOffset] = std::numeric_limits<float>::quiet_NaN();
+    values[infOffset] = std::numeric_limits<float>::infinity();
+    values[0] = -std::numeric_limits<float>::infinity();
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), m_Labels[nanOffset]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), m_Labels[infOffset]);
+
+    auto calculator = mitk::IncrementalImageStatisticsCalculator::New();
+    calculator->SetInputImage(mitk::GrabItkImageMemory(image.GetPointer()));
+    calculator->SetMask(m_Mask);
+    calculator->SetQuantileLevels({1.0});
+    calculator->Update();
+
+    // the non-finite voxels are ignored, the label statistics are the ones of the finite values
+    m_Labels[nanOffset] = 0;
+    m_Labels[infOffset] = 0;
+    VerifyStatistics(calculator, 1);
+    CPPUNIT_ASSERT(calculator->UpdateExactQuantiles(true));
+
+    auto finiteValues = GetValues(1);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(*std::max_element(finiteValues.begin(), finiteValues.end()),
+                                 calculator->GetQuantiles(1).back(), mitk::eps);
+
+    // removing and adding non-finite voxels does not change the statistics
+    m_Labels[nanOffset] = 2;
+    m_Labels[infOffset] = 2;
+    m_Labels[0] = 2;
+    WriteLabelsToMask();
+    calculator->Update();
+
+    CPPUNIT_ASSERT(!calculator->GetLastUpdateWasFull());
+    CPPUNIT_ASSERT_EQUAL(3ul, calculator->GetNumberOfChangedVoxels());
+
+    for (auto offset : { nanOffset, infOffset, std::size_t(0) })
+      m_Labels[offset] = 0;
+
+    VerifyStatistics(calculator, 1);
+    VerifyStatistics(calculator, 2);
+  }
+
+private:
+  mitk::Image::Pointer CreateConstantMask(const MaskType::PointType& origin, unsigned short label) const
+  {
+    MaskType::SizeType size = {{4, 3, 2}};
+    MaskType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+
+    auto mask = MaskType::New();
+    mask->SetRegions(size);
+    mask->SetSpacing(spacing);
+    mask->SetOrigin(origin);
+    mask->Allocate();
+    mask->FillBuffer(label);
+
+    return mitk::GrabItkImageMemory(mask.GetPointer());
+  }
+
+  unsigned long SetLabel(int x0, int x1, int y0, int y1, int z0, int z1, unsigned short label)
+  {
+    unsigned long changes = 0;
+
+    for (int z = z0; z < z1; ++z)
+      for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+        {
+          auto& voxelLabel = m_Labels[x + 16 * (y + 12 * z)];
+
+          if (voxelLabel != label)
+            ++changes;
+
+          voxelLabel = label;
+        }
+
+    return changes;
+  }
+
+  void WriteLabelsToMask()
+  {
+    {
+      mitk::ImageWriteAccessor accessor(m_Mask);
+      std::copy(m_Labels.begin(), m_Labels.end(), static_cast<unsigned short*>(accessor.GetData()));
+    }
+
+    m_Mask->Modified();
+  }
+
+  std::vector<double> GetValues(unsigned short label) const
+  {
+    std::vector<double> values;
+
+    for (std::size_t i = 0; i < m_Values.size(); ++i)
+    {
+      if (m_Labels[i] == label)
+        values.push_back(m_Values[i]);
+    }
+
+    return values;
+  }
+
+  void VerifyStatistics(mitk::IncrementalImageStatisticsCalculator* calculator, unsigned short label) const
+  {
+    const auto values = GetValues(label);
+    const double n = static_cast<double>(values.size());
+
+    double mean = 0.0;
+    for (auto value : values)
+      mean += value;
+    mean /= n;
+
+    double variance = 0.0;
+    for (auto value : values)
+      variance += (value - mean) * (value - mean);
+    variance /= n - 1.0;
+
+    mitk::ImageStatisticsContainer::Pointer container;
+    CPPUNIT_ASSERT_NO_THROW(container = calculator->GetStatistics(label));
+    auto statistics = container->GetStatisticsForTimeStep(0);
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<mitk::ImageStatisticsContainer::VoxelCountType>(values.size()),
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(mitk::ImageStatisticsConstants::NUMBEROFVOXELS()));
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(mean,
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MEAN()), 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(variance,
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::VARIANCE()), 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(*std::min_element(values.begin(), values.end()),
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MINIMUM()), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(*std::max_element(values.begin(), values.end()),
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::MAXIMUM()), mitk::eps);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(n * 0.5 * 1.0 * 2.0,
+      statistics.GetValueConverted<mitk::ImageStatisticsContainer::RealType>(mitk::ImageStatisticsConstants::VOLUME()), 1e-9);
+  }
+
+  mitk::Image::Pointer m_Image;
+  mitk::Image::Pointer m_Mask;
+  std::vector<double> m_Values;
+  std::vector<unsigned short> m_Labels;
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIncrementalImageStatisticsCalculator)
@@ -0,0 +1,163 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+#include <mitkMultiLabelMaskGenerator.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <mitkITKImageImport.h>
+#include <mitkImageStatisticsCalculator.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itkImage.h>
+
+/**
+ * \brief Test class for mitkMultiLabelMaskGenerator
+ *
+ * This test covers:
+ * - masks of all or of selected labels of a LabelSetImage
+ * - statistics of all labels computed with a single mask
+ * - updates of the mask and the statistics after editing the segmentation
+ */
+class mitkMultiLabelMaskGeneratorTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkMultiLabelMaskGeneratorTestSuite);
+  MITK_TEST(TestNoLabelSetImage);
+  MITK_TEST(TestAllLabels);
+  MITK_TEST(TestSelectedLabels);
+  MITK_TEST(TestSegmentationModified);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  typedef itk::Image<short, 3> ImageType;
+
+  void setUp() override
+  {
+    ImageType::SizeType size = {{10, 8, 4}};
+    auto image = ImageType::New();
+    image->SetRegions(size);
+    image->Allocate();
+
+    short* values = image->GetBufferPointer();
+    for (unsigned int i = 0; i < image->GetBufferedRegion().GetNumberOfPixels(); ++i)
+      values[i] = static_cast<short>(i % 17);
+
+    m_Image = mitk::GrabItkImageMemory(image.GetPointer());
+
+    m_Segmentation = mitk::LabelSetImage::New();
+    m_Segmentation->Initialize(m_Image);
+
+    // label 1 in the first two slices, label 2 in the first half of the third slice
+    SetLabel(0, 160, 1);
+    SetLabel(160, 200, 2);
+  }
+
+  void tearDown() override
+  {
+    m_Image = nullptr;
+    m_Segmentation = nullptr;
+  }
+
+  void TestNoLabelSetImage()
+  {
+    auto generator = mitk::MultiLabelMaskGenerator::New();
+    CPPUNIT_ASSERT_THROW(generator->GetMask(), mitk::Exception);
+
+    generator->SetLabelSetImage(m_Segmentation);
+    generator->SetLayer(1);
+    CPPUNIT_ASSERT_THROW(generator->GetMask(), mitk::Exception);
+  }
+
+  void TestAllLabels()
+  {
+    auto generator = mitk::MultiLabelMaskGenerator::New();
+    generator->SetLabelSetImage(m_Segmentation);
+    generator->SetInputImage(m_Image);
+
+    auto mask = generator->GetMask();
+    CPPUNIT_ASSERT(mask.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Mask is not cached", mask == generator->GetMask());
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(generator);
+
+    CPPUNIT_ASSERT_EQUAL(160ul, GetNumberOfVoxels(calculator, 1));
+    CPPUNIT_ASSERT_EQUAL(40ul, GetNumberOfVoxels(calculator, 2));
+  }
+
+  void TestSelectedLabels()
+  {
+    auto generator = mitk::MultiLabelMaskGenerator::New();
+    generator->SetLabelSetImage(m_Segmentation);
+    generator->SetInputImage(m_Image);
+    generator->SetLabels({2});
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(generator);
+
+    CPPUNIT_ASSERT_EQUAL(40ul, GetNumberOfVoxels(calculator, 2));
+    CPPUNIT_ASSERT_THROW(calculator->GetStatistics(1), mitk::Exception);
+
+    // the segmentation itself is not modified
+    generator->SetLabels({});
+    CPPUNIT_ASSERT_EQUAL(160ul, GetNumberOfVoxels(calculator, 1));
+  }
+
+  void TestSegmentationModified()
+  {
+    auto generator = mitk::MultiLabelMaskGenerator::New();
+    generator->SetLabelSetImage(m_Segmentation);
+    generator->SetInputImage(m_Image);
+
+    auto calculator = mitk::ImageStatisticsCalculator::New();
+    calculator->SetInputImage(m_Image);
+    calculator->SetMask(generator);
+
+    CPPUNIT_ASSERT_EQUAL(40ul, GetNumberOfVoxels(calculator, 2));
+    auto mask = generator->GetMask();
+    const auto mTime = generator->GetMTime();
+
+    SetLabel(100, 180, 2);
+
+    // a 3D layer without label selection is not copied, i.e. the mask is the edited segmentation itself
+    CPPUNIT_ASSERT_MESSAGE("Generator is not modified", mTime < generator->GetMTime());
+    CPPUNIT_ASSERT(mask == generator->GetMask());
+    CPPUNIT_ASSERT_EQUAL(100ul, GetNumberOfVoxels(calculator, 1));
+    CPPUNIT_ASSERT_EQUAL(100ul, GetNumberOfVoxels(calculator, 2));
+  }
+
+private:
+  void SetLabel(std::size_t begin, std::size_t end, mitk::LabelSetImage::LabelValueType label)
+  {
+    {
+      mitk::ImageWriteAccessor accessor(m_Segmentation);
+      auto* labels = static_cast<mitk::LabelSetImage::LabelValueType*>(accessor.GetData());
+      std::fill(labels + begin, labels + end, label);
+    }
+
+    m_Segmentation->Modified();
+  }
+
+  static unsigned long GetNumberOfVoxels(mitk::ImageStatisticsCalculator* calculator, unsigned int label)
+  {
+    auto statistics = calculator->GetStatistics(label)->GetStatisticsForTimeStep(0);
+    return statistics.GetValueConverted<mitk::ImageStatisticsContainer::VoxelCountType>(
+      mitk::ImageStatisticsConstants::NUMBEROFVOXELS());
+  }
+
+  mitk::Image::Pointer m_Image;
+  mitk::LabelSetImage::Pointer m_Segmentation;
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkMultiLabelMaskGenerator)
@@ -17,6 +17,7 @@ set(CPP_FILES
   mitkStatisticsToImageRelationRule.cpp
   mitkStatisticsToMaskRelationRule.cpp
   mitkImageStatisticsConstants.cpp
+  mitkIncrementalImageStatisticsCalculator.cpp
 )
 
 set(H_FILES
@@ -43,6 +44,7 @@ set(H_FILES
   mitkStatisticsToImageRelationRule.h
   mitkStatisticsToMaskRelationRule.h
   mitkImageStatisticsConstants.h
+  mitkIncrementalImageStatisticsCalculator.h
 )
 
 set(TPP_FILES
@@ -104,6 +104,10 @@ namespace mitk
 
     if (IsUpdateRequired(label))
     {
+      // statistics of all labels are recomputed in one pass. Existing containers would keep their old statistics
+      // objects and labels that are no longer part of the mask.
+      m_StatisticContainers.clear();
+
       auto timeGeometry = m_Image->GetTimeGeometry();
       // always compute statistics on all timesteps
       for (unsigned int timeStep = 0; timeStep < m_Image->GetTimeSteps(); timeStep++)
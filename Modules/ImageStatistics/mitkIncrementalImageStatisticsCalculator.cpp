@@ -0,0 +1,835 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkIncrementalImageStatisticsCalculator.h"
+#include <mitkHistogramStatisticsCalculator.h>
+#include <mitkImageAccessByItk.h>
+#include <mitkImageCast.h>
+#include <mitkImageStatisticsConstants.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkImageToItk.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+  /** Quantile by linear interpolation between the closest ranks. The values are reordered.*/
+  double ComputeQuantile(std::vector<double>& values, double level)
+  {
+    const double position = level * static_cast<double>(values.size() - 1);
+    const auto lower = static_cast<std::size_t>(std::floor(position));
+    const double fraction = position - static_cast<double>(lower);
+
+    std::nth_element(values.begin(), values.begin() + lower, values.end());
+    double quantile = values[lower];
+
+    if (fraction > 0.0 && lower + 1 < values.size())
+    {
+      // the next larger value is the minimum of the upper partition
+      const double upper = *std::min_element(values.begin() + lower + 1, values.end());
+      quantile += fraction * (upper - quantile);
+    }
+
+    return quantile;
+  }
+}
+
+namespace mitk
+{
+  IncrementalImageStatisticsCalculator::IncrementalImageStatisticsCalculator()
+    : m_TimeStep(0),
+      m_NBinsForHistogramStatistics(100),
+      m_QuantileLevels({0.25, 0.5, 0.75}),
+      m_ComputeExactQuantiles(true),
+      m_UpdatedImage(nullptr),
+      m_UpdatedImageMTime(0),
+      m_UpdatedTimeStep(0),
+      m_UpdatedNBins(0),
+      m_ImageSize({{0, 0, 0}}),
+      m_VoxelVolume(1.0),
+      m_Shift(0.0),
+      m_HistogramLowerBound(0.0),
+      m_HistogramBinSize(1.0),
+      m_CachedLabel(0),
+      m_CachedAccumulator(nullptr),
+      m_NumberOfChangedVoxels(0),
+      m_LastUpdateWasFull(false)
+  {
+  }
+
+  IncrementalImageStatisticsCalculator::~IncrementalImageStatisticsCalculator()
+  {
+    this->CancelQuantileComputation();
+  }
+
+  void IncrementalImageStatisticsCalculator::SetInputImage(const mitk::Image* image)
+  {
+    if (image != m_Image)
+    {
+      m_Image = image;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetMask(const mitk::Image* mask)
+  {
+    if (mask != m_Mask)
+    {
+      m_Mask = mask;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetTimeStep(TimeStepType timeStep)
+  {
+    if (timeStep != m_TimeStep)
+    {
+      m_TimeStep = timeStep;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetNBinsForHistogramStatistics(unsigned int nBins)
+  {
+    nBins = std::max(nBins, 1u);
+
+    if (nBins != m_NBinsForHistogramStatistics)
+    {
+      m_NBinsForHistogramStatistics = nBins;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::SetQuantileLevels(const std::vector<double>& levels)
+  {
+    for (auto level : levels)
+    {
+      if (!(level >= 0.0 && level <= 1.0))
+        mitkThrow() << "Quantile level " << level << " is not between 0 and 1!";
+    }
+
+    if (levels != m_QuantileLevels)
+    {
+      m_QuantileLevels = levels;
+      this->Modified();
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::Update()
+  {
+    if (m_Image.IsNull())
+    {
+      mitkThrow() << "no image";
+    }
+
+    if (!m_Image->IsInitialized())
+    {
+      mitkThrow() << "Image not initialized!";
+    }
+
+    if (m_TimeStep >= m_Image->GetTimeSteps())
+    {
+      mitkThrow() << "Image has no time step " << m_TimeStep << "!";
+    }
+
+    if (!this->IsUpdateRequired())
+      return;
+
+    // the background computation reads the labels and values that are about to change
+    this->CancelQuantileComputation();
+    m_Quantiles.clear();
+
+    const bool fullUpdate = this->IsFullUpdateRequired();
+
+    if (fullUpdate)
+    {
+      ImageTimeSelector::Pointer imgTimeSel = ImageTimeSelector::New();
+      imgTimeSel->SetInput(m_Image);
+      imgTimeSel->SetTimeNr(m_TimeStep);
+      imgTimeSel->UpdateLargestPossibleRegion();
+      m_ImageTimeSlice = imgTimeSel->GetOutput();
+
+      m_UpdatedImage = m_Image;
+      m_UpdatedImageMTime = m_Image->GetMTime();
+      m_UpdatedTimeStep = m_TimeStep;
+      m_UpdatedNBins = m_NBinsForHistogramStatistics;
+    }
+
+    AccessByItk_1(m_ImageTimeSlice, InternalUpdate, fullUpdate)
+
+    m_LastUpdateWasFull = fullUpdate;
+    m_UpdateTime.Modified();
+
+    this->UpdateStatisticContainers();
+  }
+
+  ImageStatisticsContainer* IncrementalImageStatisticsCalculator::GetStatistics(LabelIndex label)
+  {
+    this->Update();
+
+    auto it = m_StatisticContainers.find(label);
+
+    if (it == m_StatisticContainers.end())
+    {
+      mitkThrow() << "unknown label";
+    }
+
+    return it->second.GetPointer();
+  }
+
+  std::vector<IncrementalImageStatisticsCalculator::LabelIndex> IncrementalImageStatisticsCalculator::GetLabels() const
+  {
+    std::vector<LabelIndex> labels;
+    labels.reserve(m_Accumulators.size());
+
+    for (const auto& accumulator : m_Accumulators)
+      labels.push_back(accumulator.first);
+
+    return labels;
+  }
+
+  bool IncrementalImageStatisticsCalculator::UpdateExactQuantiles(bool wait)
+  {
+    if (!m_Quantiles.empty())
+      return true;
+
+    if (!m_QuantileComputation.valid())
+      return false;
+
+    if (!wait && m_QuantileComputation.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      return false;
+
+    m_Quantiles = m_QuantileComputation.get();
+    this->UpdateStatisticContainers();
+
+    return !m_Quantiles.empty();
+  }
+
+  std::vector<double> IncrementalImageStatisticsCalculator::GetQuantiles(LabelIndex label) const
+  {
+    auto it = m_Quantiles.find(static_cast<MaskPixelType>(label));
+
+    // the first quantile is the median
+    return it != m_Quantiles.end() ? std::vector<double>(it->second.begin() + 1, it->second.end()) : std::vector<double>();
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void IncrementalImageStatisticsCalculator::InternalUpdate(const itk::Image<TPixel, VImageDimension>* image,
+                                                            bool fullUpdate)
+  {
+    typedef itk::Image<MaskPixelType, VImageDimension> MaskType;
+
+    if (fullUpdate)
+    {
+      const auto size = image->GetBufferedRegion().GetSize();
+      m_ImageSize = {{1, 1, 1}};
+      m_VoxelVolume = 1.0;
+
+      for (unsigned int i = 0; i < VImageDimension && i < 3; ++i)
+      {
+        m_ImageSize[i] = static_cast<long>(size[i]);
+        m_VoxelVolume *= image->GetSpacing()[i];
+      }
+
+      this->InitializeHistogramBins(image);
+
+      m_Labels.assign(static_cast<std::size_t>(m_ImageSize[0]) * m_ImageSize[1] * m_ImageSize[2], 0);
+      m_MaskBox = Box();
+      m_Accumulators.clear();
+    }
+
+    m_CachedAccumulator = nullptr;
+
+    // the mask in index coordinates of the image, the whole image is label 1 if there is no mask
+    typename MaskType::ConstPointer maskImage;
+    const MaskPixelType* mask = nullptr;
+    Box maskBox;
+
+    if (m_Mask.IsNotNull())
+    {
+      mitk::Image::ConstPointer maskTimeSlice = m_Mask;
+
+      if (m_Mask->GetTimeSteps() > 1)
+      {
+        ImageTimeSelector::Pointer maskTimeSel = ImageTimeSelector::New();
+        maskTimeSel->SetInput(m_Mask);
+        maskTimeSel->SetTimeNr(m_TimeStep);
+        maskTimeSel->UpdateLargestPossibleRegion();
+        maskTimeSlice = maskTimeSel->GetOutput();
+      }
+
+      if (maskTimeSlice->GetDimension() != VImageDimension)
+      {
+        mitkThrow() << "Mask dimension " << maskTimeSlice->GetDimension() << " differs from image dimension "
+                    << VImageDimension << "!";
+      }
+
+      try
+      {
+        // try to access the pixel values directly (no copying or casting)
+        maskImage = ImageToItkImage<MaskPixelType, VImageDimension>(maskTimeSlice);
+      }
+      catch (const itk::ExceptionObject &)
+      {
+        typename MaskType::Pointer noneConstMaskImage;
+        CastToItkImage(maskTimeSlice, noneConstMaskImage);
+        maskImage = noneConstMaskImage;
+      }
+
+      mask = this->GetMaskBuffer<VImageDimension>(maskImage, image, maskBox);
+    }
+    else
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+        maskBox.End[i] = m_ImageSize[i];
+    }
+
+    // visit the voxels of the previous and the current mask and move the voxels with a different label between the
+    // accumulators
+    Box unionBox = maskBox;
+
+    if (m_MaskBox.End[0] > m_MaskBox.Begin[0])
+    {
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        unionBox.Begin[i] = std::min(unionBox.Begin[i], m_MaskBox.Begin[i]);
+        unionBox.End[i] = std::max(unionBox.End[i], m_MaskBox.End[i]);
+      }
+    }
+
+    const TPixel* values = image->GetBufferPointer();
+    const long nx = m_ImageSize[0];
+    const long ny = m_ImageSize[1];
+    const long mx = maskBox.End[0] - maskBox.Begin[0];
+    const long my = maskBox.End[1] - maskBox.Begin[1];
+    const bool sameRows = unionBox.Begin[0] == maskBox.Begin[0] && unionBox.End[0] == maskBox.End[0];
+
+    m_NumberOfChangedVoxels = 0;
+
+    for (long z = unionBox.Begin[2]; z < unionBox.End[2]; ++z)
+    {
+      for (long y = unionBox.Begin[1]; y < unionBox.End[1]; ++y)
+      {
+        const std::size_t rowOffset = static_cast<std::size_t>(nx) * (y + ny * z);
+        MaskPixelType* labelRow = m_Labels.data() + rowOffset;
+
+        const bool rowInMask = y >= maskBox.Begin[1] && y < maskBox.End[1] && z >= maskBox.Begin[2] && z < maskBox.End[2];
+        const MaskPixelType* maskRow =
+          rowInMask && mask != nullptr ? mask + mx * ((y - maskBox.Begin[1]) + my * (z - maskBox.Begin[2])) : nullptr;
+
+        // skip unchanged rows
+        if (maskRow != nullptr && sameRows &&
+            0 == std::memcmp(labelRow + maskBox.Begin[0], maskRow, mx * sizeof(MaskPixelType)))
+          continue;
+
+        for (long x = unionBox.Begin[0]; x < unionBox.End[0]; ++x)
+        {
+          MaskPixelType newLabel = 0;
+
+          if (rowInMask && x >= maskBox.Begin[0] && x < maskBox.End[0])
+            newLabel = maskRow != nullptr ? maskRow[x - maskBox.Begin[0]] : 1;
+
+          const MaskPixelType oldLabel = labelRow[x];
+
+          if (newLabel == oldLabel)
+            continue;
+
+          const double value = static_cast<double>(values[rowOffset + x]);
+
+          if (oldLabel != 0)
+            this->RemoveVoxel(this->GetAccumulator(oldLabel), value);
+
+          if (newLabel != 0)
+            this->AddVoxel(this->GetAccumulator(newLabel), value, rowOffset + x);
+
+          labelRow[x] = newLabel;
+          ++m_NumberOfChangedVoxels;
+        }
+      }
+    }
+
+    m_MaskBox = maskBox;
+    m_CachedAccumulator = nullptr;
+
+    // remove labels that are not part of the mask anymore
+    bool rescanRequired = false;
+
+    for (auto it = m_Accumulators.begin(); it != m_Accumulators.end();)
+    {
+      if (it->second.Count == 0)
+      {
+        it = m_Accumulators.erase(it);
+      }
+      else
+      {
+        if (!it->second.ExtremaValid)
+        {
+          it->second.Minimum = std::numeric_limits<double>::max();
+          it->second.Maximum = std::numeric_limits<double>::lowest();
+          rescanRequired = true;
+        }
+
+        ++it;
+      }
+    }
+
+    // the minimum or maximum of a label was removed, find the new extrema of these labels
+    if (rescanRequired)
+    {
+      for (long z = maskBox.Begin[2]; z < maskBox.End[2]; ++z)
+      {
+        for (long y = maskBox.Begin[1]; y < maskBox.End[1]; ++y)
+        {
+          const std::size_t rowOffset = static_cast<std::size_t>(nx) * (y + ny * z);
+
+          for (long x = maskBox.Begin[0]; x < maskBox.End[0]; ++x)
+          {
+            const MaskPixelType label = m_Labels[rowOffset + x];
+
+            if (label == 0)
+              continue;
+
+            Accumulator& accumulator = this->GetAccumulator(label);
+
+            if (accumulator.ExtremaValid)
+              continue;
+
+            const double value = static_cast<double>(values[rowOffset + x]);
+
+            if (!std::isfinite(value))
+              continue;
+
+            if (value < accumulator.Minimum)
+            {
+              accumulator.Minimum = value;
+              accumulator.MinimumOffset = rowOffset + x;
+            }
+
+            if (value > accumulator.Maximum)
+            {
+              accumulator.Maximum = value;
+              accumulator.MaximumOffset = rowOffset + x;
+            }
+          }
+        }
+      }
+
+      for (auto& accumulator : m_Accumulators)
+        accumulator.second.ExtremaValid = true;
+
+      m_CachedAccumulator = nullptr;
+    }
+
+    if (!m_ComputeExactQuantiles || m_Accumulators.empty())
+      return;
+
+    // exact quantiles in the background, the labels are not modified before the computation is cancelled
+    std::vector<double> levels = {0.5};
+    levels.insert(levels.end(), m_QuantileLevels.begin(), m_QuantileLevels.end());
+
+    std::map<MaskPixelType, unsigned long> counts;
+
+    for (const auto& accumulator : m_Accumulators)
+      counts[accumulator.first] = accumulator.second.Count;
+
+    auto cancel = std::make_shared<std::atomic<bool>>(false);
+    m_CancelQuantileComputation = cancel;
+
+    const MaskPixelType* labels = m_Labels.data();
+    mitk::Image::Pointer imageTimeSlice = m_ImageTimeSlice; // keeps the values alive
+
+    m_QuantileComputation = std::async(std::launch::async,
+      [cancel, levels, counts, labels, values, maskBox, nx, ny, imageTimeSlice]() {
+        std::map<MaskPixelType, std::vector<double>> labelValues;
+
+        for (const auto& count : counts)
+          labelValues[count.first].reserve(count.second);
+
+        MaskPixelType currentLabel = 0;
+        std::vector<double>* currentValues = nullptr;
+
+        for (long z = maskBox.Begin[2]; z < maskBox.End[2]; ++z)
+        {
+          for (long y = maskBox.Begin[1]; y < maskBox.End[1]; ++y)
+          {
+            if (*cancel)
+              return QuantileMap();
+
+            const std::size_t rowOffset = static_cast<std::size_t>(nx) * (y + ny * z);
+
+            for (long x = maskBox.Begin[0]; x < maskBox.End[0]; ++x)
+            {
+              const MaskPixelType label = labels[rowOffset + x];
+
+              if (label == 0)
+                continue;
+
+              const double value = static_cast<double>(values[rowOffset + x]);
+
+              if (!std::isfinite(value))
+                continue;
+
+              if (label != currentLabel || currentValues == nullptr)
+              {
+                currentLabel = label;
+                currentValues = &labelValues[label];
+              }
+
+              currentValues->push_back(value);
+            }
+          }
+        }
+
+        QuantileMap quantiles;
+
+        for (auto& entry : labelValues)
+        {
+          if (*cancel)
+            return QuantileMap();
+
+          if (entry.second.empty())
+            continue;
+
+          auto& labelQuantiles = quantiles[entry.first];
+
+          for (auto level : levels)
+            labelQuantiles.push_back(ComputeQuantile(entry.second, level));
+        }
+
+        return quantiles;
+      });
+  }
+
+  template <typename TPixel, unsigned int VImageDimension>
+  void IncrementalImageStatisticsCalculator::InitializeHistogramBins(const itk::Image<TPixel, VImageDimension>* image)
+  {
+    const TPixel* values = image->GetBufferPointer();
+    const std::size_t numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+
+    double minimum = std::numeric_limits<double>::max();
+    double maximum = std::numeric_limits<double>::lowest();
+
+    for (std::size_t i = 0; i < numberOfPixels; ++i)
+    {
+      const double value = static_cast<double>(values[i]);
+
+      if (!std::isfinite(value))
+        continue;
+
+      if (value < minimum)
+        minimum = value;
+
+      if (value > maximum)
+        maximum = value;
+    }
+
+    if (minimum > maximum)
+    {
+      minimum = 0.0;
+      maximum = 0.0;
+    }
+
+    m_HistogramLowerBound = minimum;
+    m_HistogramBinSize = maximum > minimum ? (maximum - minimum) / m_NBinsForHistogramStatistics
+                                           : 1.0 / m_NBinsForHistogramStatistics;
+    m_Shift = 0.5 * (minimum + maximum);
+  }
+
+  template <unsigned int VImageDimension>
+  const IncrementalImageStatisticsCalculator::MaskPixelType* IncrementalImageStatisticsCalculator::GetMaskBuffer(
+    const itk::Image<MaskPixelType, VImageDimension>* maskImage,
+    const itk::ImageBase<VImageDimension>* image,
+    Box& maskBox) const
+  {
+    const double tolerance = 0.001;
+
+    for (unsigned int i = 0; i < VImageDimension; ++i)
+    {
+      if (std::abs(maskImage->GetSpacing()[i] - image->GetSpacing()[i]) > tolerance * image->GetSpacing()[i])
+        mitkThrow() << "Mask spacing differs from image spacing!";
+
+      for (unsigned int j = 0; j < VImageDimension; ++j)
+      {
+        if (std::abs(maskImage->GetDirection()[i][j] - image->GetDirection()[i][j]) > tolerance)
+          mitkThrow() << "Mask orientation differs from image orientation!";
+      }
+    }
+
+    const auto& maskRegion = maskImage->GetBufferedRegion();
+
+    typename itk::ImageBase<VImageDimension>::PointType firstVoxel;
+    maskImage->TransformIndexToPhysicalPoint(maskRegion.GetIndex(), firstVoxel);
+
+    itk::ContinuousIndex<double, VImageDimension> firstIndex;
+    image->TransformPhysicalPointToContinuousIndex(firstVoxel, firstIndex);
+
+    maskBox = Box();
+
+    for (unsigned int i = 0; i < 3; ++i)
+      maskBox.End[i] = 1;
+
+    for (unsigned int i = 0; i < VImageDimension && i < 3; ++i)
+    {
+      const long index = std::lround(firstIndex[i]);
+
+      if (std::abs(firstIndex[i] - index) > 0.01)
+        mitkThrow() << "Mask is not aligned with the voxel grid of the image!";
+
+      maskBox.Begin[i] = index;
+      maskBox.End[i] = index + static_cast<long>(maskRegion.GetSize(i));
+
+      if (maskBox.Begin[i] < 0 || maskBox.End[i] > m_ImageSize[i])
+        mitkThrow() << "Mask exceeds the image!";
+    }
+
+    return maskImage->GetBufferPointer();
+  }
+
+  IncrementalImageStatisticsCalculator::Accumulator& IncrementalImageStatisticsCalculator::GetAccumulator(
+    MaskPixelType label)
+  {
+    if (m_CachedAccumulator != nullptr && m_CachedLabel == label)
+      return *m_CachedAccumulator;
+
+    auto it = m_Accumulators.find(label);
+
+    if (it == m_Accumulators.end())
+    {
+      it = m_Accumulators.emplace(label, Accumulator()).first;
+      it->second.Histogram.assign(m_NBinsForHistogramStatistics, 0);
+    }
+
+    m_CachedLabel = label;
+    m_CachedAccumulator = &it->second;
+
+    return it->second;
+  }
+
+  void IncrementalImageStatisticsCalculator::AddVoxel(Accumulator& accumulator, double value, std::size_t offset) const
+  {
+    // NaN and infinite values are not part of the statistics
+    if (!std::isfinite(value))
+      return;
+
+    const double shiftedValue = value - m_Shift;
+    const double squaredValue = shiftedValue * shiftedValue;
+
+    ++accumulator.Count;
+    accumulator.PowerSums[0] += shiftedValue;
+    accumulator.PowerSums[1] += squaredValue;
+    accumulator.PowerSums[2] += squaredValue * shiftedValue;
+    accumulator.PowerSums[3] += squaredValue * squaredValue;
+
+    if (value > 0.0)
+    {
+      ++accumulator.CountOfPositivePixels;
+      accumulator.SumOfPositivePixels += value;
+    }
+
+    const auto bin = static_cast<long>(std::floor((value - m_HistogramLowerBound) / m_HistogramBinSize));
+    ++accumulator.Histogram[std::min(std::max(bin, 0L), static_cast<long>(accumulator.Histogram.size()) - 1)];
+
+    if (accumulator.Count == 1)
+    {
+      accumulator.Minimum = value;
+      accumulator.Maximum = value;
+      accumulator.MinimumOffset = offset;
+      accumulator.MaximumOffset = offset;
+      accumulator.ExtremaValid = true;
+    }
+    else if (accumulator.ExtremaValid)
+    {
+      if (value < accumulator.Minimum)
+      {
+        accumulator.Minimum = value;
+        accumulator.MinimumOffset = offset;
+      }
+
+      if (value > accumulator.Maximum)
+      {
+        accumulator.Maximum = value;
+        accumulator.MaximumOffset = offset;
+      }
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::RemoveVoxel(Accumulator& accumulator, double value) const
+  {
+    // non-finite values were never added, see AddVoxel()
+    if (!std::isfinite(value))
+      return;
+
+    const double shiftedValue = value - m_Shift;
+    const double squaredValue = shiftedValue * shiftedValue;
+
+    --accumulator.Count;
+    accumulator.PowerSums[0] -= shiftedValue;
+    accumulator.PowerSums[1] -= squaredValue;
+    accumulator.PowerSums[2] -= squaredValue * shiftedValue;
+    accumulator.PowerSums[3] -= squaredValue * squaredValue;
+
+    if (value > 0.0)
+    {
+      --accumulator.CountOfPositivePixels;
+      accumulator.SumOfPositivePixels -= value;
+    }
+
+    const auto bin = static_cast<long>(std::floor((value - m_HistogramLowerBound) / m_HistogramBinSize));
+    --accumulator.Histogram[std::min(std::max(bin, 0L), static_cast<long>(accumulator.Histogram.size()) - 1)];
+
+    if (accumulator.Count == 0)
+    {
+      // start from exact zeros instead of accumulated rounding errors
+      accumulator.PowerSums.fill(0.0);
+      accumulator.SumOfPositivePixels = 0.0;
+      accumulator.ExtremaValid = false;
+    }
+    else if (value <= accumulator.Minimum || value >= accumulator.Maximum)
+    {
+      accumulator.ExtremaValid = false;
+    }
+  }
+
+  void IncrementalImageStatisticsCalculator::UpdateStatisticContainers()
+  {
+    m_StatisticContainers.clear();
+
+    for (const auto& accumulator : m_Accumulators)
+    {
+      auto quantilesIt = m_Quantiles.find(accumulator.first);
+      const std::vector<double>* quantiles = quantilesIt != m_Quantiles.end() ? &quantilesIt->second : nullptr;
+
+      auto statisticContainer = ImageStatisticsContainer::New();
+      statisticContainer->SetTimeGeometry(const_cast<mitk::TimeGeometry*>(m_Image->GetTimeGeometry()));
+      statisticContainer->SetStatisticsForTimeStep(m_UpdatedTimeStep, this->CreateStatisticsObject(accumulator.second, quantiles));
+
+      m_StatisticContainers.emplace(accumulator.first, statisticContainer);
+    }
+  }
+
+  ImageStatisticsContainer::ImageStatisticsObject IncrementalImageStatisticsCalculator::CreateStatisticsObject(
+    const Accumulator& accumulator, const std::vector<double>* quantiles) const
+  {
+    ImageStatisticsContainer::ImageStatisticsObject statObj;
+
+    const double count = static_cast<double>(accumulator.Count);
+    const auto& sums = accumulator.PowerSums;
+
+    // moments of the shifted values, mean and central moments follow from them
+    const double shiftedMean = sums[0] / count;
+    const double mean = m_Shift + shiftedMean;
+    const double variance = count > 1 ? std::max(0.0, (sums[1] - sums[0] * sums[0] / count) / (count - 1.0)) : 0.0;
+    const double sigma = std::sqrt(variance);
+
+    const double secondMoment = sums[1] / count;
+    const double thirdMoment = sums[2] / count;
+    const double fourthMoment = sums[3] / count;
+    const double centralSecondMoment = secondMoment - std::pow(shiftedMean, 2);
+
+    const double skewness = (thirdMoment - 3 * secondMoment * shiftedMean + 2 * std::pow(shiftedMean, 3)) /
+                            std::pow(centralSecondMoment, 1.5);
+    const double kurtosis = (fourthMoment - 4 * thirdMoment * shiftedMean + 6 * secondMoment * std::pow(shiftedMean, 2) -
+                             3 * std::pow(shiftedMean, 4)) /
+                            std::pow(centralSecondMoment, 2);
+    const double mpp = accumulator.SumOfPositivePixels / static_cast<double>(accumulator.CountOfPositivePixels);
+    const double rms = std::sqrt(std::pow(mean, 2.) + variance);
+
+    // histogram with the shared bins
+    const auto nBins = static_cast<unsigned int>(accumulator.Histogram.size());
+
+    ImageStatisticsContainer::HistogramType::SizeType histogramSize(1);
+    histogramSize[0] = nBins;
+    ImageStatisticsContainer::HistogramType::MeasurementVectorType lowerBound(1);
+    lowerBound[0] = m_HistogramLowerBound;
+    ImageStatisticsContainer::HistogramType::MeasurementVectorType upperBound(1);
+    upperBound[0] = m_HistogramLowerBound + nBins * m_HistogramBinSize;
+
+    auto histogram = ImageStatisticsContainer::HistogramType::New();
+    histogram->SetMeasurementVectorSize(1);
+    histogram->Initialize(histogramSize, lowerBound, upperBound);
+
+    for (unsigned int i = 0; i < nBins; ++i)
+      histogram->SetFrequency(i, accumulator.Histogram[i]);
+
+    HistogramStatisticsCalculator histogramStatisticsCalculator;
+    histogramStatisticsCalculator.SetHistogram(histogram);
+    histogramStatisticsCalculator.CalculateStatistics();
+
+    const double median = quantiles != nullptr ? quantiles->front() : histogramStatisticsCalculator.GetMedian();
+
+    // voxel indices of the extrema
+    auto offsetToIndex = [this](std::size_t offset) {
+      ImageStatisticsContainer::IndexType index(3);
+      index[0] = static_cast<int>(offset % m_ImageSize[0]);
+      index[1] = static_cast<int>((offset / m_ImageSize[0]) % m_ImageSize[1]);
+      index[2] = static_cast<int>(offset / (m_ImageSize[0] * m_ImageSize[1]));
+      return index;
+    };
+
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUMPOSITION(), offsetToIndex(accumulator.MinimumOffset));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUMPOSITION(), offsetToIndex(accumulator.MaximumOffset));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::NUMBEROFVOXELS(),
+                         static_cast<ImageStatisticsContainer::VoxelCountType>(accumulator.Count));
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VOLUME(), count * m_VoxelVolume);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEAN(), mean);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MINIMUM(), accumulator.Minimum);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MAXIMUM(), accumulator.Maximum);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::STANDARDDEVIATION(), sigma);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::VARIANCE(), variance);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::SKEWNESS(), skewness);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::KURTOSIS(), kurtosis);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::RMS(), rms);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MPP(), mpp);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::ENTROPY(), histogramStatisticsCalculator.GetEntropy());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::MEDIAN(), median);
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UNIFORMITY(), histogramStatisticsCalculator.GetUniformity());
+    statObj.AddStatistic(mitk::ImageStatisticsConstants::UPP(), histogramStatisticsCalculator.GetUPP());
+    statObj.m_Histogram = histogram.GetPointer();
+
+    return statObj;
+  }
+
+  void IncrementalImageStatisticsCalculator::CancelQuantileComputation()
+  {
+    if (!m_QuantileComputation.valid())
+      return;
+
+    *m_CancelQuantileComputation = true;
+    m_QuantileComputation.wait();
+    m_QuantileComputation = std::future<QuantileMap>();
+  }
+
+  bool IncrementalImageStatisticsCalculator::IsFullUpdateRequired() const
+  {
+    return m_ImageTimeSlice.IsNull() || m_UpdatedImage != m_Image.GetPointer() ||
+           m_UpdatedImageMTime != m_Image->GetMTime() || m_UpdatedTimeStep != m_TimeStep ||
+           m_UpdatedNBins != m_NBinsForHistogramStatistics;
+  }
+
+  bool IncrementalImageStatisticsCalculator::IsUpdateRequired() const
+  {
+    if (this->IsFullUpdateRequired())
+      return true;
+
+    if (this->GetMTime() > m_UpdateTime.GetMTime()) // inputs have changed
+      return true;
+
+    if (m_Mask.IsNotNull() && m_Mask->GetMTime() > m_UpdateTime.GetMTime()) // mask has changed
+      return true;
+
+    return false;
+  }
+} // namespace mitk
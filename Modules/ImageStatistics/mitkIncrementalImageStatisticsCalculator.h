@@ -0,0 +1,217 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkIncrementalImageStatisticsCalculator_h
+#define mitkIncrementalImageStatisticsCalculator_h
+
+#include <MitkImageStatisticsExports.h>
+#include <mitkImage.h>
+#include <mitkImageStatisticsContainer.h>
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Computes the statistics of the labels of a mask incrementally, e.g. while a ROI is drawn or dragged.
+   *
+   * ImageStatisticsCalculator recomputes the statistics and histograms of the whole masked region whenever the mask
+   * changes. This calculator keeps mergeable accumulators (count, power sums, minimum, maximum and histogram) for each
+   * label of the mask instead. On every update only the voxels whose label differs from the previous mask are
+   * removed from and added to the accumulators. The histogram bins are derived once from the value range of the
+   * image time step, i.e. all labels share the same bins and the bins do not change while the mask is edited.
+   *
+   * The median in the statistics of an update is approximated by the histogram. After every update, exact quantiles
+   * (including the median) are computed in a background thread. Call UpdateExactQuantiles() to replace the
+   * approximated median by the exact one as soon as it is available.
+   *
+   * The mask must have the dimension, spacing and orientation of the image and lie on its voxel grid, but may cover a
+   * sub region of the image (e.g. a segmentation of the image or a mask of a planar figure in a slice image). Label 0
+   * is background and has no statistics. Statistics are computed for a single time step. NaN and infinite voxel
+   * values are ignored, i.e. they neither count as voxels of a label nor contribute to its statistics or histogram.
+   *
+   * The calculator is a standalone engine: ImageStatisticsCalculator and the ImageStatisticsContainerManager based
+   * statistics of segmentations and planar figures do not use it. Tools that edit a mask interactively create it
+   * directly and keep it alive between the edits to benefit from the incremental updates.
+   */
+  class MITKIMAGESTATISTICS_EXPORT IncrementalImageStatisticsCalculator : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(IncrementalImageStatisticsCalculator, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    typedef unsigned short MaskPixelType;
+    using LabelIndex = ImageStatisticsContainer::LabelIndex;
+
+    /**Documentation
+    @brief Set the image for which the statistics are to be computed.*/
+    void SetInputImage(const mitk::Image* image);
+
+    /**Documentation
+    @brief Set the label mask. Setting a modified or a new mask on the same voxel grid results in an incremental
+    update. The previous state of the mask is kept internally, so the mask may be modified in place.*/
+    void SetMask(const mitk::Image* mask);
+
+    /**Documentation
+    @brief Set the time step of the image (and of the mask if it has several time steps). Default is 0.*/
+    void SetTimeStep(TimeStepType timeStep);
+    itkGetConstMacro(TimeStep, TimeStepType);
+
+    /**Documentation
+    @brief Set the number of histogram bins over the value range of the image. Default is 100.*/
+    void SetNBinsForHistogramStatistics(unsigned int nBins);
+    itkGetConstMacro(NBinsForHistogramStatistics, unsigned int);
+
+    /**Documentation
+    @brief Set the levels (between 0 and 1) of the exact quantiles computed in the background. The median is always
+    computed. Default is {0.25, 0.5, 0.75}.*/
+    void SetQuantileLevels(const std::vector<double>& levels);
+    itkGetConstReferenceMacro(QuantileLevels, std::vector<double>);
+
+    /**Documentation
+    @brief Enable or disable the computation of exact quantiles in the background. Default is true.*/
+    itkSetMacro(ComputeExactQuantiles, bool);
+    itkGetConstMacro(ComputeExactQuantiles, bool);
+    itkBooleanMacro(ComputeExactQuantiles);
+
+    /**Documentation
+    @brief Updates the statistics if the image, the mask or the parameters have changed.
+    @throw mitk::Exception if no image is set or the mask is not on the voxel grid of the image.*/
+    void Update();
+
+    /**Documentation
+    @brief Returns the statistics of label @a label after updating them if necessary.
+    @throw mitk::Exception if the label is not part of the mask.*/
+    ImageStatisticsContainer* GetStatistics(LabelIndex label = 1);
+
+    /**Documentation
+    @brief Returns the labels of the mask, i.e. the labels with statistics.*/
+    std::vector<LabelIndex> GetLabels() const;
+
+    /**Documentation
+    @brief Replaces the approximated median in the statistics by the exact median of the background computation.
+    @param wait Wait for the background computation instead of returning false if it is still running.
+    @return True if the statistics of the last update contain the exact median.*/
+    bool UpdateExactQuantiles(bool wait = false);
+
+    /**Documentation
+    @brief Returns the exact quantiles of label @a label in the order of GetQuantileLevels(), or an empty vector
+    if they are not yet available (see UpdateExactQuantiles()).*/
+    std::vector<double> GetQuantiles(LabelIndex label) const;
+
+    /**Documentation
+    @brief Returns the number of voxels whose label changed in the last update.*/
+    itkGetConstMacro(NumberOfChangedVoxels, unsigned long);
+
+    /**Documentation
+    @brief Returns whether the last update recomputed all accumulators, e.g. because the image changed.*/
+    itkGetConstMacro(LastUpdateWasFull, bool);
+
+  protected:
+    IncrementalImageStatisticsCalculator();
+    ~IncrementalImageStatisticsCalculator() override;
+
+  private:
+    /** Mergeable statistics of the voxels of a label. Power sums are shifted by the center of the value range of
+     *  the image to limit the cancellation when voxels are removed.*/
+    struct Accumulator
+    {
+      unsigned long Count = 0;
+      std::array<double, 4> PowerSums = {{ 0.0, 0.0, 0.0, 0.0 }};
+      unsigned long CountOfPositivePixels = 0;
+      double SumOfPositivePixels = 0.0;
+      double Minimum = 0.0;
+      double Maximum = 0.0;
+      std::size_t MinimumOffset = 0;
+      std::size_t MaximumOffset = 0;
+      bool ExtremaValid = false;
+      std::vector<unsigned long> Histogram;
+    };
+
+    /** Voxel box [Begin, End) in index coordinates of the image.*/
+    struct Box
+    {
+      std::array<long, 3> Begin = {{ 0, 0, 0 }};
+      std::array<long, 3> End = {{ 0, 0, 0 }};
+    };
+
+    using QuantileMap = std::map<MaskPixelType, std::vector<double>>;
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void InternalUpdate(const itk::Image<TPixel, VImageDimension>* image, bool fullUpdate);
+
+    template <typename TPixel, unsigned int VImageDimension>
+    void InitializeHistogramBins(const itk::Image<TPixel, VImageDimension>* image);
+
+    template <unsigned int VImageDimension>
+    const MaskPixelType* GetMaskBuffer(const itk::Image<MaskPixelType, VImageDimension>* maskImage,
+                                       const itk::ImageBase<VImageDimension>* image,
+                                       Box& maskBox) const;
+
+    Accumulator& GetAccumulator(MaskPixelType label);
+    void AddVoxel(Accumulator& accumulator, double value, std::size_t offset) const;
+    void RemoveVoxel(Accumulator& accumulator, double value) const;
+
+    void UpdateStatisticContainers();
+    ImageStatisticsContainer::ImageStatisticsObject CreateStatisticsObject(const Accumulator& accumulator,
+                                                                           const std::vector<double>* quantiles) const;
+    void CancelQuantileComputation();
+
+    bool IsUpdateRequired() const;
+    bool IsFullUpdateRequired() const;
+
+    mitk::Image::ConstPointer m_Image;
+    mitk::Image::ConstPointer m_Mask;
+    TimeStepType m_TimeStep;
+    unsigned int m_NBinsForHistogramStatistics;
+    std::vector<double> m_QuantileLevels;
+    bool m_ComputeExactQuantiles;
+
+    // state of the last full update
+    mitk::Image::Pointer m_ImageTimeSlice;
+    const mitk::Image* m_UpdatedImage;
+    itk::ModifiedTimeType m_UpdatedImageMTime;
+    TimeStepType m_UpdatedTimeStep;
+    unsigned int m_UpdatedNBins;
+    itk::TimeStamp m_UpdateTime;
+
+    std::array<long, 3> m_ImageSize;
+    double m_VoxelVolume;
+    double m_Shift;
+    double m_HistogramLowerBound;
+    double m_HistogramBinSize;
+
+    // labels of all voxels of the image after the last update and the box of the last mask
+    std::vector<MaskPixelType> m_Labels;
+    Box m_MaskBox;
+
+    std::map<MaskPixelType, Accumulator> m_Accumulators;
+    MaskPixelType m_CachedLabel;
+    Accumulator* m_CachedAccumulator;
+
+    std::map<LabelIndex, ImageStatisticsContainer::Pointer> m_StatisticContainers;
+
+    std::future<QuantileMap> m_QuantileComputation;
+    std::shared_ptr<std::atomic<bool>> m_CancelQuantileComputation;
+    QuantileMap m_Quantiles;
+
+    unsigned long m_NumberOfChangedVoxels;
+    bool m_LastUpdateWasFull;
+  };
+}
+
+#endif
@@ -11,3 +11,187 @@ found in the LICENSE file.
 ============================================================================*/
 
 #include <mitkMultiLabelMaskGenerator.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageTimeSelector.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <algorithm>
+
+namespace mitk {
+
+MultiLabelMaskGenerator::MultiLabelMaskGenerator():
+    Superclass(),
+    m_Layer(0),
+    m_UpdatedLayerImage(nullptr),
+    m_UpdatedLayerImageMTime(0),
+    m_UpdatedTimeStep(0)
+{
+}
+
+void MultiLabelMaskGenerator::SetLabelSetImage(const LabelSetImage* labelSetImage)
+{
+    if (m_LabelSetImage != labelSetImage)
+    {
+        m_LabelSetImage = labelSetImage;
+        this->Modified();
+    }
+}
+
+void MultiLabelMaskGenerator::SetLayer(unsigned int layer)
+{
+    if (m_Layer != layer)
+    {
+        m_Layer = layer;
+        this->Modified();
+    }
+}
+
+void MultiLabelMaskGenerator::SetLabels(const LabelValueVectorType& labels)
+{
+    if (m_Labels != labels)
+    {
+        m_Labels = labels;
+        this->Modified();
+    }
+}
+
+void MultiLabelMaskGenerator::SetTimeStep(unsigned int timeStep)
+{
+    if (timeStep != m_TimeStep)
+    {
+        m_TimeStep = timeStep;
+        this->Modified();
+    }
+}
+
+itk::ModifiedTimeType MultiLabelMaskGenerator::GetMTime() const
+{
+    auto mTime = Superclass::GetMTime();
+
+    if (m_LabelSetImage.IsNotNull() && m_Layer < m_LabelSetImage->GetNumberOfLayers())
+    {
+        mTime = std::max(mTime, this->GetLayerImage()->GetMTime());
+    }
+
+    return mTime;
+}
+
+const mitk::Image* MultiLabelMaskGenerator::GetLayerImage() const
+{
+    // the pixels of the active layer are kept in the LabelSetImage itself
+    if (m_Layer == m_LabelSetImage->GetActiveLayer())
+    {
+        return m_LabelSetImage;
+    }
+
+    return m_LabelSetImage->GetLayerImage(m_Layer);
+}
+
+mitk::Image::ConstPointer MultiLabelMaskGenerator::GetMask()
+{
+    if (m_LabelSetImage.IsNull())
+    {
+        mitkThrow() << "Cannot generate mask. LabelSetImage is not set.";
+    }
+
+    if (m_Layer >= m_LabelSetImage->GetNumberOfLayers())
+    {
+        mitkThrow() << "Cannot generate mask. LabelSetImage has no layer " << m_Layer << ".";
+    }
+
+    if (IsUpdateRequired())
+    {
+        UpdateInternalMask();
+    }
+
+    return m_InternalMask;
+}
+
+bool MultiLabelMaskGenerator::IsUpdateRequired() const
+{
+    // compare the inputs instead of the modification time of this class, because ImageStatisticsCalculator calls
+    // Modified() for every time step
+    const auto layerImage = this->GetLayerImage();
+
+    return m_InternalMask.IsNull() || m_UpdatedLayerImage != layerImage ||
+           m_UpdatedLayerImageMTime != layerImage->GetMTime() || m_UpdatedTimeStep != m_TimeStep ||
+           m_UpdatedLabels != m_Labels;
+}
+
+void MultiLabelMaskGenerator::UpdateInternalMask()
+{
+    const auto layerImage = this->GetLayerImage();
+
+    mitk::Image::ConstPointer layerTimeSlice;
+
+    if (m_inputImage.IsNotNull())
+    {
+        const auto timeGeo = m_inputImage->GetTimeGeometry();
+        if (!timeGeo->IsValidTimeStep(m_TimeStep))
+        {
+            mitkThrow() << "Cannot update internal mask. Time step selected that is not supported by input image.";
+        }
+
+        layerTimeSlice = SelectImageByTimePoint(layerImage, timeGeo->TimeStepToTimePoint(m_TimeStep));
+    }
+    else
+    {
+        layerTimeSlice = SelectImageByTimeStep(layerImage, m_TimeStep);
+    }
+
+    if (layerTimeSlice.IsNull())
+    {
+        MITK_WARN << "Warning: time step > number of time steps in LabelSetImage, using last time step";
+        layerTimeSlice = SelectImageByTimeStep(layerImage, layerImage->GetTimeSteps() - 1);
+    }
+
+    if (m_Labels.empty())
+    {
+        // all labels: the layer is the mask
+        m_InternalMask = layerTimeSlice;
+    }
+    else
+    {
+        if (layerTimeSlice->GetPixelType() != MakeScalarPixelType<LabelValueType>())
+        {
+            mitkThrow() << "Cannot update internal mask. Unexpected pixel type of LabelSetImage layer.";
+        }
+
+        std::vector<bool> isSelected(*std::max_element(m_Labels.begin(), m_Labels.end()) + 1, false);
+        for (auto label : m_Labels)
+        {
+            isSelected[label] = true;
+        }
+
+        auto mask = mitk::Image::New();
+        mask->Initialize(layerTimeSlice);
+
+        std::size_t numberOfPixels = 1;
+        for (unsigned int i = 0; i < layerTimeSlice->GetDimension(); ++i)
+        {
+            numberOfPixels *= layerTimeSlice->GetDimension(i);
+        }
+
+        {
+            ImageReadAccessor layerAccessor(layerTimeSlice);
+            ImageWriteAccessor maskAccessor(mask);
+            const auto* labels = static_cast<const LabelValueType*>(layerAccessor.GetData());
+            auto* maskLabels = static_cast<LabelValueType*>(maskAccessor.GetData());
+
+            for (std::size_t i = 0; i < numberOfPixels; ++i)
+            {
+                const auto label = labels[i];
+                maskLabels[i] = label < isSelected.size() && isSelected[label] ? label : 0;
+            }
+        }
+
+        m_InternalMask = mask;
+    }
+
+    m_UpdatedLayerImage = layerImage;
+    m_UpdatedLayerImageMTime = layerImage->GetMTime();
+    m_UpdatedTimeStep = m_TimeStep;
+    m_UpdatedLabels = m_Labels;
+}
+
+}
@@ -22,32 +22,83 @@ found in the LICENSE file.
 namespace mitk
 {
 /**
- * @brief The MultiLabelMaskGenerator class NOT IMPLEMENTED YET!
+ * @brief The MultiLabelMaskGenerator class provides a layer of a LabelSetImage as label mask.
+ *
+ * In contrast to a binary mask per label, the mask keeps the label values. ImageStatisticsCalculator computes the
+ * statistics of all labels of such a mask in a single (multi-threaded) pass over the image, so the statistics of
+ * every label are available after one call of ImageStatisticsCalculator::GetStatistics().
+ *
+ * If labels are selected (see SetLabels()), all other labels of the layer are set to 0 in the mask. Otherwise the
+ * layer itself is used as mask without copying it. The mask is only updated if the layer image, the selection or the
+ * time step changed. GetMTime() includes the modification time of the layer image, i.e. editing the segmentation
+ * invalidates the statistics of a calculator using this generator.
+ *
+ * Without a label selection, a 3D layer is never copied: the cached mask returned by GetMask() is the live
+ * segmentation (for the active layer the LabelSetImage itself), so edits of the segmentation are visible through a
+ * previously returned mask. Use GetMTime() instead of comparing mask pointers to detect changes.
  */
 class MITKIMAGESTATISTICS_EXPORT MultiLabelMaskGenerator: public MaskGenerator
 {
 public:
-   /* void setLabelSetImage(mitk::LabelSetImage::Pointer labelSetImage);
-
-    void addLabel(LabelSetImage::PixelType, std::vector<mitk::Image::Pointer>::size_type layer=0);
-    void removeLabel(LabelSetImage::PixelType, std::vector<mitk::Image::Pointer>::size_type layer=0);
-
-    void addLabels(std::pair<std::vector<mitk::Image::Pointer>::size_type, std::vector<unsigned int>> labelsToAdd);
-    void removeLabels(std::pair<std::vector<mitk::Image::Pointer>::size_type, std::vector<unsigned int>> labelsToAdd);
-
-    void addLabels(std::vector<LabelSetImage::PixelType> labels, std::vector<mitk::Image::Pointer>::size_type layer=0);
-    void removeLabels(std::vector<LabelSetImage::PixelType> labels, std::vector<mitk::Image::Pointer>::size_type layer=0);
-
-    void removeLayer(std::vector<mitk::Image::Pointer>::size_type layer);
-
-    mitk::Image::Pointer GetMask();
+    /** Standard Self typedef */
+    typedef MultiLabelMaskGenerator             Self;
+    typedef MaskGenerator                       Superclass;
+    typedef itk::SmartPointer< Self >           Pointer;
+    typedef itk::SmartPointer< const Self >     ConstPointer;
+
+    /** Method for creation through the object factory. */
+    itkNewMacro(Self); /** Runtime information support. */
+    itkTypeMacro(MultiLabelMaskGenerator, MaskGenerator);
+
+    using LabelValueType = LabelSetImage::LabelValueType;
+    using LabelValueVectorType = LabelSetImage::LabelValueVectorType;
+
+    /**
+     * @brief GetMask returns the selected labels of the layer at the current time step.
+     * @throw mitk::Exception if no LabelSetImage is set or the layer does not exist.
+     */
+    mitk::Image::ConstPointer GetMask() override;
+
+    void SetTimeStep(unsigned int timeStep) override;
+
+    /**
+     * @brief GetMTime returns the latest modification time of the generator and of the layer image.
+     */
+    itk::ModifiedTimeType GetMTime() const override;
+
+    void SetLabelSetImage(const mitk::LabelSetImage* labelSetImage);
+    itkGetConstObjectMacro(LabelSetImage, mitk::LabelSetImage);
+
+    /**
+     * @brief SetLayer selects the layer of the LabelSetImage that is used as mask. Default is 0.
+     */
+    void SetLayer(unsigned int layer);
+    itkGetConstMacro(Layer, unsigned int);
+
+    /**
+     * @brief SetLabels selects the labels of the layer that are part of the mask. An empty vector (default) selects
+     * all labels.
+     */
+    void SetLabels(const LabelValueVectorType& labels);
+    itkGetConstReferenceMacro(Labels, LabelValueVectorType);
 
 protected:
+    MultiLabelMaskGenerator();
 
 private:
-    mitk::LabelSetImage::Pointer m_LabelSetImage;
-    std::vector<std::vector<LabelSetImage::PixelType>> m_selectedLabels;*/
-
+    const mitk::Image* GetLayerImage() const;
+    bool IsUpdateRequired() const;
+    void UpdateInternalMask();
+
+    mitk::LabelSetImage::ConstPointer m_LabelSetImage;
+    unsigned int m_Layer;
+    LabelValueVectorType m_Labels;
+
+    mitk::Image::ConstPointer m_InternalMask;
+    const mitk::Image* m_UpdatedLayerImage;
+    itk::ModifiedTimeType m_UpdatedLayerImageMTime;
+    unsigned int m_UpdatedTimeStep;
+    LabelValueVectorType m_UpdatedLabels;
 };
 
 }
@@ -45,6 +45,8 @@ namespace mitk
     itkSetMacro(DerivativeStepLength, double);
     itkSetMacro(Iterations, unsigned int);
     itkSetMacro(Scales, ::itk::LevenbergMarquardtOptimizer::ScalesType);
+    /** If true (default), analytic derivatives are used for models that provide them (see ModelBase::HasAnalyticJacobian()).*/
+    itkSetMacro(UseAnalyticDerivative, bool);
 
     itkGetMacro(Epsilon, double);
     itkGetMacro(GradientTolerance, double);
@@ -52,6 +54,7 @@ namespace mitk
     itkGetMacro(DerivativeStepLength, double);
     itkGetMacro(Iterations, unsigned int);
     itkGetMacro(Scales, ::itk::LevenbergMarquardtOptimizer::ScalesType);
+    itkGetMacro(UseAnalyticDerivative, bool);
 
     itkSetConstObjectMacro(ConstraintChecker, ConstraintCheckerBase);
     itkGetConstObjectMacro(ConstraintChecker, ConstraintCheckerBase);
@@ -88,6 +91,7 @@ namespace mitk
     double m_ValueTolerance;
     unsigned int m_Iterations;
     double m_DerivativeStepLength;
+    bool m_UseAnalyticDerivative;
     ::itk::LevenbergMarquardtOptimizer::ScalesType m_Scales;
 
     /**Constraint checker. If set it will be used by the optimization strategies to add additional constraints to the
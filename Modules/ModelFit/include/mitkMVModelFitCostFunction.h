@@ -26,6 +26,8 @@ namespace mitk
 /** Base class for all model fit cost function that return a multiple cost value
  * It offers also a default implementation for the numerical computation of the
  * derivatives. Normaly you just have to (re)implement CalcMeasure().
+ * If the model computes analytic Jacobians (see ModelBase::HasAnalyticJacobian()) and the
+ * cost function implements CalcMeasureDerivative(), the derivatives are computed analytically.
 */
 class MITKMODELFIT_EXPORT MVModelFitCostFunction : public itk::MultipleValuedCostFunction, public ModelFitCostFunctionInterface
 {
@@ -54,11 +56,25 @@ public:
     itkSetMacro(DerivativeStepLength, double);
     itkGetConstMacro(DerivativeStepLength, double);
 
+    /** If false, the derivatives are always computed numerically. Default is true.*/
+    itkSetMacro(UseAnalyticDerivative, bool);
+    itkGetConstMacro(UseAnalyticDerivative, bool);
+    itkBooleanMacro(UseAnalyticDerivative);
+
 protected:
 
     virtual MeasureType CalcMeasure(const ParametersType &parameters, const SignalType& signal) const = 0;
 
-    MVModelFitCostFunction() : m_DerivativeStepLength(1e-5)
+    /** Indicates if the cost function implements CalcMeasureDerivative().
+     * @remark Default implementation returns false.*/
+    virtual bool HasMeasureDerivative() const;
+
+    /** Computes the derivatives of the measure given the signal of the model and its Jacobian.
+     * @remark Default implementation throws an exception.*/
+    virtual void CalcMeasureDerivative(const ParametersType &parameters, const SignalType& signal,
+                                       const ModelBase::ModelJacobianType& signalJacobian, DerivativeType& derivative) const;
+
+    MVModelFitCostFunction() : m_DerivativeStepLength(1e-5), m_UseAnalyticDerivative(true)
     {
     }
 
@@ -71,6 +87,8 @@ private:
 
     /**value (delta of parameters) used to compute the derivatives numerically*/
     double m_DerivativeStepLength;
+
+    bool m_UseAnalyticDerivative;
 };
 
 }
@@ -60,6 +60,9 @@ namespace mitk
     /** Type defining the time grid used be models.
      * @remark the model time grid has a resolution in sec and not like the time geometry which uses ms.*/
     typedef itk::Array<double> TimeGridType;
+    /** Type of the partial derivatives of the model signal. It has one row per parameter and one column per
+     * time point (compare itk::MultipleValuedCostFunction::DerivativeType).*/
+    typedef itk::Array2D<double> ModelJacobianType;
     typedef ModelTraitsInterface::ParameterNameType ParameterNameType;
     typedef ModelTraitsInterface::ParameterNamesType ParameterNamesType;
     typedef ModelTraitsInterface::ParametersSizeType ParametersSizeType;
@@ -168,10 +171,29 @@ namespace mitk
 
     ModelResultType GetSignal(const ParametersType& parameters) const;
 
+    /** Indicates if the model computes the partial derivatives of its signal analytically
+     * (see GetSignalAndJacobian()). Fit cost functions use numerical derivatives otherwise.
+     * @remark Default implementation returns false.*/
+    virtual bool HasAnalyticJacobian() const;
+
+    /** Computes the signal and its partial derivatives with respect to the parameters in one go.
+     * @param parameters The parameters of the model.
+     * @param [out] signal The signal of the model (see GetSignal()).
+     * @param [out] jacobian The partial derivatives of the signal (see ModelJacobianType).
+     * @pre HasAnalyticJacobian() returns true.*/
+    void GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                              ModelJacobianType& jacobian) const;
+
   protected:
 
     virtual ModelResultType ComputeModelfunction(const ParametersType& parameters) const = 0;
 
+    /** Helper function called by GetSignalAndJacobian(). Implement in derived classes that return true
+     * in HasAnalyticJacobian().
+     * @remark Default implementation throws an exception.*/
+    virtual void ComputeModelfunctionJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                              ModelJacobianType& jacobian) const;
+
     /** Member is called by GetSignal() before ComputeModelfunction(). It indicates if model is in a valid state and
      * ready to compute the signal. The default implementation checks nothing and always returns true.
      * Reimplement to realize special behavior for derived classes.
@@ -31,6 +31,19 @@ mitk::MVModelFitCostFunction::MeasureType mitk::MVModelFitCostFunction::GetValue
 
 void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &parameters, DerivativeType &derivative) const
 {
+  if (m_UseAnalyticDerivative && this->HasMeasureDerivative() && m_Model->HasAnalyticJacobian())
+  {
+    SignalType signal;
+    ModelBase::ModelJacobianType signalJacobian;
+    m_Model->GetSignalAndJacobian(parameters, signal, signalJacobian);
+
+    if(signal.GetSize() != m_Sample.GetSize()) itkExceptionMacro("Signal size does not matche sample size!");
+
+    derivative.SetSize(parameters.Size(), m_Sample.Size());
+    this->CalcMeasureDerivative(parameters, signal, signalJacobian, derivative);
+    return;
+  }
+
   ParametersType::SizeValueType paramCount = parameters.Size();
   MeasureType::SizeValueType measureCount = GetNumberOfValues();
 
@@ -57,6 +70,17 @@ void mitk::MVModelFitCostFunction::GetDerivative (const ParametersType &paramete
 
 };
 
+bool mitk::MVModelFitCostFunction::HasMeasureDerivative() const
+{
+  return false;
+}
+
+void mitk::MVModelFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType& /*signal*/,
+  const ModelBase::ModelJacobianType& /*signalJacobian*/, DerivativeType& /*derivative*/) const
+{
+  itkExceptionMacro("CalcMeasureDerivative() is not implemented by this cost function.");
+}
+
 unsigned int mitk::MVModelFitCostFunction::GetNumberOfParameters() const
 {
   return m_Model->GetNumberOfParameters();
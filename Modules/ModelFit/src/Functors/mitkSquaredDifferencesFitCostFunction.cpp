@@ -24,3 +24,20 @@ mitk::SquaredDifferencesFitCostFunction::MeasureType mitk::SquaredDifferencesFit
 
   return measure;
 }
+
+bool mitk::SquaredDifferencesFitCostFunction::HasMeasureDerivative() const
+{
+  return true;
+}
+
+void mitk::SquaredDifferencesFitCostFunction::CalcMeasureDerivative(const ParametersType &/*parameters*/, const SignalType &signal,
+  const ModelBase::ModelJacobianType& signalJacobian, DerivativeType& derivative) const
+{
+  for(unsigned int i=0; i<signalJacobian.rows(); ++i)
+  {
+    for(SignalType::size_type j=0; j<signal.GetSize(); ++j)
+    {
+      derivative[i][j] = -2 * (m_Sample[j] - signal[j]) * signalJacobian[i][j];
+    }
+  }
+}
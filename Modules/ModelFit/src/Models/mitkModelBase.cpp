@@ -146,6 +146,42 @@ mitk::ModelBase::ModelResultType mitk::ModelBase::GetSignal(const ParametersType
   return signal;
 }
 
+bool mitk::ModelBase::HasAnalyticJacobian() const
+{
+  return false;
+}
+
+void mitk::ModelBase::GetSignalAndJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                           ModelJacobianType& jacobian) const
+{
+  if (!this->HasAnalyticJacobian())
+  {
+    itkExceptionMacro("Model does not compute analytic Jacobians. Use GetSignal() and numerical derivatives instead.");
+  }
+
+  if (parameters.size() != this->GetNumberOfParameters())
+  {
+    itkExceptionMacro("Passed parameter set has wrong size for model. Cannot evaluate model. Required size: "
+                      << this->GetNumberOfParameters() << "; passed parameters: " << parameters);
+  }
+
+  std::string error;
+
+  if (!ValidateModel(error))
+  {
+    itkExceptionMacro("Cannot evaluate model and return signal. Model is in an invalid state. Validation error: "
+                      << error);
+  }
+
+  ComputeModelfunctionJacobian(parameters, signal, jacobian);
+}
+
+void mitk::ModelBase::ComputeModelfunctionJacobian(const ParametersType& /*parameters*/, ModelResultType& /*signal*/,
+                                                   ModelJacobianType& /*jacobian*/) const
+{
+  itkExceptionMacro("ComputeModelfunctionJacobian() is not implemented by this model.");
+}
+
 bool mitk::ModelBase::ValidateModel(std::string& /*error*/) const
 {
   return true;
@@ -46,6 +46,7 @@ namespace mitk
     : AbstractFileIO(LabelSetImage::GetStaticNameOfClass(), IOMimeTypes::NRRD_MIMETYPE(), "MITK Multilabel Segmentation")
   {
     this->InitializeDefaultMetaDataKeys();
+    this->SetDefaultWriterOptions(ItkImageIO::GetDefaultCompressionOptions());
     AbstractFileWriter::SetRanking(10);
     AbstractFileReader::SetRanking(10);
     this->RegisterService();
@@ -112,11 +113,8 @@ namespace mitk
       itk::EncapsulateMetaData<std::string>(nrrdImageIo->GetMetaDataDictionary(), PROPERTY_KEY_UID, input->GetUID());
 
       // use compression if available
-      nrrdImageIo->UseCompressionOn();
-      nrrdImageIo->SetFileName(path);
-
       ImageReadAccessor imageAccess(inputVector);
-      nrrdImageIo->Write(imageAccess.GetData());
+      ItkImageIO::WriteImageIO(nrrdImageIo, path, imageAccess.GetData(), this->GetWriterOptions());
     }
     catch (const std::exception &e)
     {
@@ -0,0 +1,178 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkTestingMacros.h>
+#include <mitkTestFixture.h>
+
+#include <mitkIGTLMessageQueue.h>
+
+#include <igtlStringMessage.h>
+#include <igtlTransformMessage.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+class mitkIGTLMessageQueueTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkIGTLMessageQueueTestSuite);
+  MITK_TEST(Test_InfiniteBuffering_KeepsOrder);
+  MITK_TEST(Test_NoBuffering_KeepsLatestMessage);
+  MITK_TEST(Test_LatestMessageOnly_AffectsSingleQueue);
+  MITK_TEST(Test_ResetQueueStatistics);
+  MITK_TEST(Test_ConcurrentPush_KeepsOrderPerProducer);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::IGTLMessageQueue::Pointer m_Queue;
+
+  igtl::StringMessage::Pointer CreateStringMessage(const std::string& text)
+  {
+    igtl::StringMessage::Pointer message = igtl::StringMessage::New();
+    message->SetString(text);
+    return message;
+  }
+
+public:
+  void setUp() override
+  {
+    m_Queue = mitk::IGTLMessageQueue::New();
+  }
+
+  void tearDown() override
+  {
+    m_Queue = nullptr;
+  }
+
+  void Test_InfiniteBuffering_KeepsOrder()
+  {
+    m_Queue->EnableNoBufferingMode(false);
+
+    m_Queue->PushMessage(this->CreateStringMessage("first").GetPointer());
+    m_Queue->PushMessage(this->CreateStringMessage("second").GetPointer());
+    m_Queue->PushMessage(igtl::TransformMessage::New().GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(3, m_Queue->GetSize());
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), std::string(m_Queue->PullStringMessage()->GetString()));
+    CPPUNIT_ASSERT_EQUAL(std::string("second"), std::string(m_Queue->PullStringMessage()->GetString()));
+    CPPUNIT_ASSERT(m_Queue->PullStringMessage().IsNull());
+    CPPUNIT_ASSERT(m_Queue->PullTransformMessage().IsNotNull());
+    CPPUNIT_ASSERT_EQUAL(0, m_Queue->GetSize());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL(2ul, statistics.NumberOfPushedMessages);
+    CPPUNIT_ASSERT_EQUAL(0ul, statistics.NumberOfDroppedMessages);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(0), statistics.Depth);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(2), statistics.MaximumDepth);
+  }
+
+  void Test_NoBuffering_KeepsLatestMessage()
+  {
+    m_Queue->EnableNoBufferingMode(true);
+
+    m_Queue->PushMessage(this->CreateStringMessage("first").GetPointer());
+    m_Queue->PushMessage(this->CreateStringMessage("second").GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(1, m_Queue->GetSize());
+    CPPUNIT_ASSERT_EQUAL(std::string("second"), std::string(m_Queue->PullStringMessage()->GetString()));
+    CPPUNIT_ASSERT(m_Queue->PullStringMessage().IsNull());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL(2ul, statistics.NumberOfPushedMessages);
+    CPPUNIT_ASSERT_EQUAL(1ul, statistics.NumberOfDroppedMessages);
+  }
+
+  void Test_LatestMessageOnly_AffectsSingleQueue()
+  {
+    m_Queue->EnableNoBufferingMode(false);
+    m_Queue->SetLatestMessageOnly(mitk::IGTLMessageQueue::TransformQueue, true);
+    CPPUNIT_ASSERT(m_Queue->GetLatestMessageOnly(mitk::IGTLMessageQueue::TransformQueue));
+    CPPUNIT_ASSERT(!m_Queue->GetLatestMessageOnly(mitk::IGTLMessageQueue::StringQueue));
+
+    igtl::TransformMessage::Pointer latestTransform = igtl::TransformMessage::New();
+    m_Queue->PushMessage(igtl::TransformMessage::New().GetPointer());
+    m_Queue->PushMessage(latestTransform.GetPointer());
+    m_Queue->PushMessage(this->CreateStringMessage("first").GetPointer());
+    m_Queue->PushMessage(this->CreateStringMessage("second").GetPointer());
+
+    CPPUNIT_ASSERT_EQUAL(3, m_Queue->GetSize());
+    CPPUNIT_ASSERT(latestTransform == m_Queue->PullTransformMessage());
+    CPPUNIT_ASSERT(m_Queue->PullTransformMessage().IsNull());
+    CPPUNIT_ASSERT_EQUAL(1ul, m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::TransformQueue).NumberOfDroppedMessages);
+    CPPUNIT_ASSERT_EQUAL(0ul, m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue).NumberOfDroppedMessages);
+  }
+
+  void Test_ResetQueueStatistics()
+  {
+    m_Queue->EnableNoBufferingMode(false);
+
+    m_Queue->PushCommandMessage(this->CreateStringMessage("command").GetPointer());
+    m_Queue->ResetQueueStatistics();
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::CommandQueue);
+    CPPUNIT_ASSERT_EQUAL(0ul, statistics.NumberOfPushedMessages);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.Depth);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(1), statistics.MaximumDepth);
+    CPPUNIT_ASSERT(m_Queue->PullCommandMessage().IsNotNull());
+  }
+
+  void Test_ConcurrentPush_KeepsOrderPerProducer()
+  {
+    m_Queue->EnableNoBufferingMode(false);
+
+    const int numberOfProducers = 4;
+    const int numberOfMessages = 1000;
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < numberOfProducers; ++producer)
+    {
+      producers.emplace_back([this, producer, numberOfMessages]() {
+        for (int i = 0; i < numberOfMessages; ++i)
+          m_Queue->PushMessage(this->CreateStringMessage(std::to_string(producer) + " " + std::to_string(i)).GetPointer());
+      });
+    }
+
+    // Pull while the producers are running, so the inbox is flushed several times
+    std::vector<int> nextMessage(numberOfProducers, 0);
+    int numberOfPulledMessages = 0;
+    bool isInOrder = true;
+    while (numberOfPulledMessages < numberOfProducers * numberOfMessages)
+    {
+      auto message = m_Queue->PullStringMessage();
+      if (message.IsNull())
+        continue;
+
+      const std::string text = message->GetString();
+      const int producer = std::stoi(text.substr(0, text.find(' ')));
+      const int i = std::stoi(text.substr(text.find(' ') + 1));
+
+      isInOrder = isInOrder && nextMessage[producer] == i;
+      nextMessage[producer] = i + 1;
+      ++numberOfPulledMessages;
+    }
+
+    for (auto& producer : producers)
+      producer.join();
+
+    CPPUNIT_ASSERT_MESSAGE("Messages of a producer were pulled out of order.", isInOrder);
+
+    CPPUNIT_ASSERT(m_Queue->PullStringMessage().IsNull());
+    CPPUNIT_ASSERT_EQUAL(0, m_Queue->GetSize());
+
+    auto statistics = m_Queue->GetQueueStatistics(mitk::IGTLMessageQueue::StringQueue);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long>(numberOfProducers * numberOfMessages), statistics.NumberOfPushedMessages);
+    CPPUNIT_ASSERT_EQUAL(0ul, statistics.NumberOfDroppedMessages);
+    CPPUNIT_ASSERT(m_Queue->GetLatestMsgDeviceType() == "STRING");
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkIGTLMessageQueue)
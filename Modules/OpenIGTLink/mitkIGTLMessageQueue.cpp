@@ -16,292 +16,255 @@ found in the LICENSE file.
 
 void mitk::IGTLMessageQueue::PushSendMessage(mitk::IGTLMessage::Pointer message)
 {
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_SendQueue.clear();
-
-  m_SendQueue.push_back(message);
-  this->m_Mutex.unlock();
+  m_SendQueue.Push(message.GetPointer(), this->m_BufferingType == IGTLMessageQueue::NoBuffering);
 }
 
 void mitk::IGTLMessageQueue::PushCommandMessage(igtl::MessageBase::Pointer message)
 {
-  this->m_Mutex.lock();
-  if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-    m_CommandQueue.clear();
-
-  m_CommandQueue.push_back(message);
-  this->m_Mutex.unlock();
+  m_CommandQueue.Push(message.GetPointer(), this->m_BufferingType == IGTLMessageQueue::NoBuffering);
 }
 
 void mitk::IGTLMessageQueue::PushMessage(igtl::MessageBase::Pointer msg)
 {
-  this->m_Mutex.lock();
-
-  std::stringstream infolog;
-
-  infolog << "Received message of type ";
+  const bool noBuffering = this->m_BufferingType == IGTLMessageQueue::NoBuffering;
 
-  if (dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()) != nullptr)
+  if (auto trackingDataMsg = dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()))
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TrackingDataQueue.clear();
-
-    this->m_TrackingDataQueue.push_back(dynamic_cast<igtl::TrackingDataMessage*>(msg.GetPointer()));
-
-    infolog << "TDATA";
+    this->m_TrackingDataQueue.Push(trackingDataMsg, noBuffering);
   }
-  else if (dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()) != nullptr)
+  else if (auto transformMsg = dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()))
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_TransformQueue.clear();
-
-    this->m_TransformQueue.push_back(dynamic_cast<igtl::TransformMessage*>(msg.GetPointer()));
-
-    infolog << "TRANSFORM";
+    this->m_TransformQueue.Push(transformMsg, noBuffering);
   }
-  else if (dynamic_cast<igtl::StringMessage*>(msg.GetPointer()) != nullptr)
+  else if (auto stringMsg = dynamic_cast<igtl::StringMessage*>(msg.GetPointer()))
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_StringQueue.clear();
-
-    this->m_StringQueue.push_back(dynamic_cast<igtl::StringMessage*>(msg.GetPointer()));
-
-    infolog << "STRING";
+    this->m_StringQueue.Push(stringMsg, noBuffering);
   }
-  else if (dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()) != nullptr)
+  else if (auto imageMsg = dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()))
   {
-    igtl::ImageMessage::Pointer imageMsg = dynamic_cast<igtl::ImageMessage*>(msg.GetPointer());
-    int* dim = new int[3];
+    int dim[3];
     imageMsg->GetDimensions(dim);
     if (dim[2] > 1)
     {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image3dQueue.clear();
-
-      this->m_Image3dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
-
-      infolog << "IMAGE3D";
+      this->m_Image3dQueue.Push(imageMsg, noBuffering);
     }
     else
     {
-      if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-        m_Image2dQueue.clear();
-
-      this->m_Image2dQueue.push_back(dynamic_cast<igtl::ImageMessage*>(msg.GetPointer()));
-
-      infolog << "IMAGE2D";
+      this->m_Image2dQueue.Push(imageMsg, noBuffering);
     }
   }
   else
   {
-    if (this->m_BufferingType == IGTLMessageQueue::NoBuffering)
-      m_MiscQueue.clear();
+    this->m_MiscQueue.Push(msg.GetPointer(), noBuffering);
+  }
 
-    this->m_MiscQueue.push_back(msg);
+  msg->Register(); // reference of the slot
+  igtl::MessageBase* previousMessage = m_LatestMessage.exchange(msg.GetPointer());
+  if (nullptr != previousMessage)
+    previousMessage->UnRegister();
+}
 
-    infolog << "OTHER";
-  }
+igtl::MessageBase::Pointer mitk::IGTLMessageQueue::GetLatestMessage()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // Take the message out of the slot, so a concurrent push cannot release it while it is read
+  igtl::MessageBase* message = m_LatestMessage.exchange(nullptr);
+  if (nullptr == message)
+    return nullptr;
 
-  m_Latest_Message = msg;
+  igtl::MessageBase::Pointer latestMessage = message;
 
-  //MITK_INFO << infolog.str();
+  // Put it back unless a newer message has been pushed in the meantime
+  igtl::MessageBase* expected = nullptr;
+  if (!m_LatestMessage.compare_exchange_strong(expected, message))
+    message->UnRegister(); // reference of the slot
 
-  this->m_Mutex.unlock();
+  return latestMessage;
 }
 
 mitk::IGTLMessage::Pointer mitk::IGTLMessageQueue::PullSendMessage()
 {
-  mitk::IGTLMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_SendQueue.size() > 0)
-  {
-    ret = this->m_SendQueue.front();
-    this->m_SendQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_SendQueue.Pull();
 }
 
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullMiscMessage()
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_MiscQueue.size() > 0)
-  {
-    ret = this->m_MiscQueue.front();
-    this->m_MiscQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_MiscQueue.Pull();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage2dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image2dQueue.size() > 0)
-  {
-    ret = this->m_Image2dQueue.front();
-    this->m_Image2dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image2dQueue.Pull();
 }
 
 igtl::ImageMessage::Pointer mitk::IGTLMessageQueue::PullImage3dMessage()
 {
-  igtl::ImageMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_Image3dQueue.size() > 0)
-  {
-    ret = this->m_Image3dQueue.front();
-    this->m_Image3dQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_Image3dQueue.Pull();
 }
 
 igtl::TrackingDataMessage::Pointer mitk::IGTLMessageQueue::PullTrackingMessage()
 {
-  igtl::TrackingDataMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TrackingDataQueue.size() > 0)
-  {
-    ret = this->m_TrackingDataQueue.front();
-    this->m_TrackingDataQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TrackingDataQueue.Pull();
 }
 
 igtl::MessageBase::Pointer mitk::IGTLMessageQueue::PullCommandMessage()
 {
-  igtl::MessageBase::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_CommandQueue.size() > 0)
-  {
-    ret = this->m_CommandQueue.front();
-    this->m_CommandQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_CommandQueue.Pull();
 }
 
 igtl::StringMessage::Pointer mitk::IGTLMessageQueue::PullStringMessage()
 {
-  igtl::StringMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_StringQueue.size() > 0)
-  {
-    ret = this->m_StringQueue.front();
-    this->m_StringQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_StringQueue.Pull();
 }
 
 igtl::TransformMessage::Pointer mitk::IGTLMessageQueue::PullTransformMessage()
 {
-  igtl::TransformMessage::Pointer ret = nullptr;
-  this->m_Mutex.lock();
-  if (this->m_TransformQueue.size() > 0)
-  {
-    ret = this->m_TransformQueue.front();
-    this->m_TransformQueue.pop_front();
-  }
-  this->m_Mutex.unlock();
-  return ret;
+  return this->m_TransformQueue.Pull();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgInformationString()
 {
-  this->m_Mutex.lock();
+  igtl::MessageBase::Pointer latestMessage = this->GetLatestMessage();
   std::stringstream s;
-  if (this->m_Latest_Message != nullptr)
+  if (latestMessage != nullptr)
   {
-    s << "Device Type: " << this->m_Latest_Message->GetDeviceType() << std::endl;
-    s << "Device Name: " << this->m_Latest_Message->GetDeviceName() << std::endl;
+    s << "Device Type: " << latestMessage->GetDeviceType() << std::endl;
+    s << "Device Name: " << latestMessage->GetDeviceName() << std::endl;
   }
   else
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetNextMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  igtl::MessageBase::Pointer latestMessage = this->GetLatestMessage();
   std::stringstream s;
-  if (m_Latest_Message != nullptr)
+  if (latestMessage != nullptr)
   {
-    s << this->m_Latest_Message->GetDeviceType();
+    s << latestMessage->GetDeviceType();
   }
   else
   {
     s << "";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgInformationString()
 {
-  this->m_Mutex.lock();
+  igtl::MessageBase::Pointer latestMessage = this->GetLatestMessage();
   std::stringstream s;
-  if (m_Latest_Message != nullptr)
+  if (latestMessage != nullptr)
   {
-    s << "Device Type: " << this->m_Latest_Message->GetDeviceType() << std::endl;
-    s << "Device Name: " << this->m_Latest_Message->GetDeviceName() << std::endl;
+    s << "Device Type: " << latestMessage->GetDeviceType() << std::endl;
+    s << "Device Name: " << latestMessage->GetDeviceName() << std::endl;
   }
   else
   {
     s << "No Msg";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 std::string mitk::IGTLMessageQueue::GetLatestMsgDeviceType()
 {
-  this->m_Mutex.lock();
+  igtl::MessageBase::Pointer latestMessage = this->GetLatestMessage();
   std::stringstream s;
-  if (m_Latest_Message != nullptr)
+  if (latestMessage != nullptr)
   {
-    s << this->m_Latest_Message->GetDeviceType();
+    s << latestMessage->GetDeviceType();
   }
   else
   {
     s << "";
   }
-  this->m_Mutex.unlock();
   return s.str();
 }
 
 int mitk::IGTLMessageQueue::GetSize()
 {
-  return (this->m_CommandQueue.size() + this->m_Image2dQueue.size() + this->m_Image3dQueue.size() + this->m_MiscQueue.size()
-    + this->m_StringQueue.size() + this->m_TrackingDataQueue.size() + this->m_TransformQueue.size());
+  return (this->m_CommandQueue.GetDepth() + this->m_Image2dQueue.GetDepth() + this->m_Image3dQueue.GetDepth() + this->m_MiscQueue.GetDepth()
+    + this->m_StringQueue.GetDepth() + this->m_TrackingDataQueue.GetDepth() + this->m_TransformQueue.GetDepth());
 }
 
 void mitk::IGTLMessageQueue::EnableNoBufferingMode(bool enable)
 {
-  this->m_Mutex.lock();
   if (enable)
     this->m_BufferingType = IGTLMessageQueue::BufferingType::NoBuffering;
   else
     this->m_BufferingType = IGTLMessageQueue::BufferingType::Infinit;
-  this->m_Mutex.unlock();
+}
+
+template <typename TFunction>
+void mitk::IGTLMessageQueue::InvokeOnQueue(MessageQueueType queue, TFunction function)
+{
+  switch (queue)
+  {
+  case CommandQueue:
+    function(m_CommandQueue);
+    break;
+  case Image2dQueue:
+    function(m_Image2dQueue);
+    break;
+  case Image3dQueue:
+    function(m_Image3dQueue);
+    break;
+  case TransformQueue:
+    function(m_TransformQueue);
+    break;
+  case TrackingDataQueue:
+    function(m_TrackingDataQueue);
+    break;
+  case StringQueue:
+    function(m_StringQueue);
+    break;
+  case MiscQueue:
+    function(m_MiscQueue);
+    break;
+  case SendQueue:
+    function(m_SendQueue);
+    break;
+  }
+}
+
+void mitk::IGTLMessageQueue::SetLatestMessageOnly(MessageQueueType queue, bool latestOnly)
+{
+  this->InvokeOnQueue(queue, [latestOnly](auto& channel) { channel.SetLatestOnly(latestOnly); });
+}
+
+bool mitk::IGTLMessageQueue::GetLatestMessageOnly(MessageQueueType queue)
+{
+  bool latestOnly = false;
+  this->InvokeOnQueue(queue, [&latestOnly](auto& channel) { latestOnly = channel.GetLatestOnly(); });
+  return latestOnly;
+}
+
+mitk::IGTLMessageQueue::QueueStatistics mitk::IGTLMessageQueue::GetQueueStatistics(MessageQueueType queue)
+{
+  QueueStatistics statistics = {};
+  this->InvokeOnQueue(queue, [&statistics](auto& channel) { statistics = channel.GetStatistics(); });
+  return statistics;
+}
+
+void mitk::IGTLMessageQueue::ResetQueueStatistics()
+{
+  for (auto queue : { CommandQueue, Image2dQueue, Image3dQueue, TransformQueue, TrackingDataQueue, StringQueue, MiscQueue, SendQueue })
+    this->InvokeOnQueue(queue, [](auto& channel) { channel.ResetStatistics(); });
 }
 
 mitk::IGTLMessageQueue::IGTLMessageQueue()
+  : m_LatestMessage(nullptr)
 {
   this->m_BufferingType = IGTLMessageQueue::NoBuffering;
 }
 
 mitk::IGTLMessageQueue::~IGTLMessageQueue()
 {
-  this->m_Mutex.unlock();
+  igtl::MessageBase* latestMessage = m_LatestMessage.exchange(nullptr);
+  if (nullptr != latestMessage)
+    latestMessage->UnRegister(); // reference of the slot
 }
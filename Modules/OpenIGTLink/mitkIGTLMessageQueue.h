@@ -18,6 +18,7 @@ found in the LICENSE file.
 #include "itkObject.h"
 #include "mitkCommon.h"
 
+#include <atomic>
 #include <deque>
 #include <mutex>
 #include <mitkIGTLMessage.h>
@@ -34,6 +35,12 @@ namespace mitk {
   * \class IGTLMessageQueue
   * \brief Thread safe message queue to store OpenIGTLink messages.
   *
+  * Messages are stored in a separate queue per message type. Pushing a message never takes a lock: it is
+  * added to a lock-free inbox of its queue, which is moved to the queue in one batch under the lock of the
+  * queue by the next pull. Queues can be switched to a "latest message only" mode (see
+  * SetLatestMessageOnly()) in which a new message replaces an unread one instead of being queued. Replacing
+  * is lock-free as well. The NoBuffering mode enables this for all queues.
+  *
   * \ingroup OpenIGTLink
   */
   class MITKOPENIGTLINK_EXPORT IGTLMessageQueue : public itk::Object
@@ -50,6 +57,22 @@ namespace mitk {
        */
     enum BufferingType { Infinit, NoBuffering };
 
+    /**
+     * \brief The queues messages are sorted into
+     */
+    enum MessageQueueType { CommandQueue, Image2dQueue, Image3dQueue, TransformQueue, TrackingDataQueue, StringQueue, MiscQueue, SendQueue };
+
+    /**
+     * \brief Statistics of a single queue
+     */
+    struct QueueStatistics
+    {
+      unsigned long NumberOfPushedMessages; ///< Messages added since the last reset
+      unsigned long NumberOfDroppedMessages; ///< Messages replaced by a newer one before they were pulled
+      std::size_t Depth; ///< Messages currently waiting in the queue
+      std::size_t MaximumDepth; ///< Highest depth since the last reset
+    };
+
     void PushSendMessage(mitk::IGTLMessage::Pointer message);
 
     /**
@@ -101,38 +124,259 @@ namespace mitk {
     std::string GetLatestMsgDeviceType();
 
     /**
+     * \brief Stores only the latest message in all queues if enabled
      */
     void EnableNoBufferingMode(bool enable);
 
+    /**
+     * \brief Stores only the latest message of the given queue if enabled.
+     * Useful for tracking and transform messages, of which only the most recent one is of interest.
+     * Has no effect while the NoBuffering mode is enabled, which keeps only the latest message in all queues.
+     */
+    void SetLatestMessageOnly(MessageQueueType queue, bool latestOnly);
+    bool GetLatestMessageOnly(MessageQueueType queue);
+
+    QueueStatistics GetQueueStatistics(MessageQueueType queue);
+    void ResetQueueStatistics();
+
   protected:
     IGTLMessageQueue();
     ~IGTLMessageQueue() override;
 
+    /**
+    * \brief Queue of a single message type.
+    *
+    * Producers push onto a lock-free singly linked inbox. Consumers detach the whole inbox at once and move it
+    * to the FIFO queue while holding the lock of the channel, so nodes are never shared after detaching and
+    * need no further reclamation scheme.
+    *
+    * In latest-only mode, the message is held in a slot which owns a reference to the message.
+    * Pushing and pulling exchange the slot atomically, so the slot is lock-free.
+    */
+    template <typename TMessage>
+    class MessageChannel
+    {
+    public:
+      using MessagePointer = typename TMessage::Pointer;
+
+      MessageChannel()
+        : m_Inbox(nullptr), m_Slot(nullptr), m_LatestOnly(false), m_QueueDepth(0), m_MaximumDepth(0), m_NumberOfPushedMessages(0), m_NumberOfDroppedMessages(0)
+      {
+      }
+
+      ~MessageChannel()
+      {
+        this->Clear();
+      }
+
+      void Push(TMessage* message, bool latestOnly)
+      {
+        ++m_NumberOfPushedMessages;
+
+        if (latestOnly || m_LatestOnly)
+        {
+          message->Register(); // reference of the slot
+          TMessage* previousMessage = m_Slot.exchange(message);
+
+          if (nullptr != previousMessage)
+          {
+            ++m_NumberOfDroppedMessages;
+            previousMessage->UnRegister();
+          }
+
+          this->UpdateMaximumDepth(1);
+
+          // messages queued before the mode was switched are outdated now
+          if (m_QueueDepth > 0)
+            m_NumberOfDroppedMessages += this->ClearQueue();
+        }
+        else
+        {
+          // counted before it is visible, so pulling it can never make the depth negative
+          this->UpdateMaximumDepth(++m_QueueDepth);
+
+          auto node = new InboxNode{ message, m_Inbox.load() };
+          while (!m_Inbox.compare_exchange_weak(node->Next, node))
+          {
+          }
+        }
+      }
+
+      MessagePointer Pull()
+      {
+        if (m_QueueDepth > 0)
+        {
+          std::lock_guard<std::mutex> lock(m_Mutex);
+          this->FlushInbox();
+
+          if (!m_Queue.empty())
+          {
+            MessagePointer message = m_Queue.front();
+            m_Queue.pop_front();
+            --m_QueueDepth;
+            return message;
+          }
+        }
+
+        MessagePointer message;
+        TMessage* slotMessage = m_Slot.exchange(nullptr);
+
+        if (nullptr != slotMessage)
+        {
+          message = slotMessage;
+          slotMessage->UnRegister(); // reference of the slot
+        }
+
+        return message;
+      }
+
+      void Clear()
+      {
+        TMessage* slotMessage = m_Slot.exchange(nullptr);
+        if (nullptr != slotMessage)
+          slotMessage->UnRegister();
+
+        this->ClearQueue();
+      }
+
+      std::size_t GetDepth() const
+      {
+        return m_QueueDepth + (nullptr != m_Slot.load() ? 1 : 0);
+      }
+
+      void SetLatestOnly(bool latestOnly)
+      {
+        m_LatestOnly = latestOnly;
+      }
+
+      bool GetLatestOnly() const
+      {
+        return m_LatestOnly;
+      }
+
+      QueueStatistics GetStatistics() const
+      {
+        QueueStatistics statistics;
+        statistics.NumberOfPushedMessages = m_NumberOfPushedMessages;
+        statistics.NumberOfDroppedMessages = m_NumberOfDroppedMessages;
+        statistics.Depth = this->GetDepth();
+        statistics.MaximumDepth = m_MaximumDepth;
+        return statistics;
+      }
+
+      void ResetStatistics()
+      {
+        m_NumberOfPushedMessages = 0;
+        m_NumberOfDroppedMessages = 0;
+        m_MaximumDepth = this->GetDepth();
+      }
+
+    private:
+      struct InboxNode
+      {
+        MessagePointer Message;
+        InboxNode* Next;
+      };
+
+      /**
+      * \brief Moves the inbox to the end of the FIFO queue. The caller has to hold m_Mutex.
+      */
+      void FlushInbox()
+      {
+        InboxNode* node = m_Inbox.exchange(nullptr);
+
+        // the inbox is a stack, i.e. it starts with the newest message
+        InboxNode* oldestNode = nullptr;
+        while (nullptr != node)
+        {
+          InboxNode* next = node->Next;
+          node->Next = oldestNode;
+          oldestNode = node;
+          node = next;
+        }
+
+        while (nullptr != oldestNode)
+        {
+          InboxNode* next = oldestNode->Next;
+          m_Queue.push_back(oldestNode->Message);
+          delete oldestNode;
+          oldestNode = next;
+        }
+      }
+
+      /**
+      * \brief Removes all messages of the inbox and the FIFO queue and returns their number.
+      */
+      std::size_t ClearQueue()
+      {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        this->FlushInbox();
+
+        const std::size_t numberOfMessages = m_Queue.size();
+        m_Queue.clear();
+        m_QueueDepth -= numberOfMessages;
+
+        return numberOfMessages;
+      }
+
+      void UpdateMaximumDepth(std::size_t depth)
+      {
+        std::size_t maximumDepth = m_MaximumDepth;
+        while (maximumDepth < depth && !m_MaximumDepth.compare_exchange_weak(maximumDepth, depth))
+        {
+        }
+      }
+
+      std::mutex m_Mutex; ///< guards the FIFO queue only, taken by consumers
+      std::deque<MessagePointer> m_Queue;
+      std::atomic<InboxNode*> m_Inbox; ///< messages pushed since the last flush, newest first
+      std::atomic<TMessage*> m_Slot;
+      std::atomic<bool> m_LatestOnly;
+      std::atomic<std::size_t> m_QueueDepth; ///< messages in the inbox and the FIFO queue
+      std::atomic<std::size_t> m_MaximumDepth;
+      std::atomic<unsigned long> m_NumberOfPushedMessages;
+      std::atomic<unsigned long> m_NumberOfDroppedMessages;
+    };
+
+    /**
+    * \brief Calls the function with the channel of the given queue type
+    */
+    template <typename TFunction>
+    void InvokeOnQueue(MessageQueueType queue, TFunction function);
+
   protected:
     /**
-    * \brief Mutex to take car of the queue
+    * \brief Returns the latest pushed message without removing it
+    */
+    igtl::MessageBase::Pointer GetLatestMessage();
+
+    /**
+    * \brief Serializes the readers of the latest message. Pushing never takes it.
     */
     std::mutex m_Mutex;
 
     /**
-    * \brief the queue that stores pointer to the inserted messages
+    * \brief the queues that store pointers to the inserted messages
     */
-    std::deque< igtl::MessageBase::Pointer > m_CommandQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image2dQueue;
-    std::deque< igtl::ImageMessage::Pointer > m_Image3dQueue;
-    std::deque< igtl::TransformMessage::Pointer > m_TransformQueue;
-    std::deque< igtl::TrackingDataMessage::Pointer > m_TrackingDataQueue;
-    std::deque< igtl::StringMessage::Pointer > m_StringQueue;
-    std::deque< igtl::MessageBase::Pointer > m_MiscQueue;
+    MessageChannel< igtl::MessageBase > m_CommandQueue;
+    MessageChannel< igtl::ImageMessage > m_Image2dQueue;
+    MessageChannel< igtl::ImageMessage > m_Image3dQueue;
+    MessageChannel< igtl::TransformMessage > m_TransformQueue;
+    MessageChannel< igtl::TrackingDataMessage > m_TrackingDataQueue;
+    MessageChannel< igtl::StringMessage > m_StringQueue;
+    MessageChannel< igtl::MessageBase > m_MiscQueue;
 
-    std::deque< mitk::IGTLMessage::Pointer > m_SendQueue;
+    MessageChannel< mitk::IGTLMessage > m_SendQueue;
 
-    igtl::MessageBase::Pointer m_Latest_Message;
+    /**
+    * \brief The latest pushed message. The slot owns a reference, pushing exchanges it atomically.
+    */
+    std::atomic<igtl::MessageBase*> m_LatestMessage;
 
     /**
     * \brief defines the kind of buffering
     */
-    BufferingType m_BufferingType;
+    std::atomic<BufferingType> m_BufferingType;
   };
 }
 
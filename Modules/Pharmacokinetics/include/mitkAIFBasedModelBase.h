@@ -54,8 +54,11 @@ namespace mitk
     itkGetConstReferenceMacro(AterialInputFunctionValues, AterialInputFunctionType);
     itkGetConstReferenceMacro(AterialInputFunctionTimeGrid, TimeGridType);
 
-    itkSetMacro(AterialInputFunctionValues, AterialInputFunctionType);
-    itkSetMacro(AterialInputFunctionTimeGrid, TimeGridType);
+    virtual void SetAterialInputFunctionValues(const AterialInputFunctionType& values);
+    virtual void SetAterialInputFunctionTimeGrid(const TimeGridType& grid);
+
+    /** Reimplementation that also resamples the AIF to the new time grid.*/
+    void SetTimeGrid(const TimeGridType& grid) override;
 
     std::string GetXAxisName() const override;
 
@@ -74,6 +77,13 @@ namespace mitk
      * if currentTimeGrid.Size() = 0 , the Original AIF will be returned*/
     const AterialInputFunctionType GetAterialInputFunction(TimeGridType currentTimeGrid) const;
 
+    /** Returns the Aterial Input function interpolated to the time grid of the model.
+     * In contrast to GetAterialInputFunction(), the values are not interpolated on every call
+     * but once whenever the AIF, the AIF time grid or the model time grid change. Models should
+     * use it in ComputeModelfunction().
+     * The result is empty if the AIF cannot be interpolated (see ValidateModel()).*/
+    const AterialInputFunctionType& GetResampledAterialInputFunction() const;
+
     ParameterNamesType GetStaticParameterNames() const override;
     ParametersSizeType GetNumberOfStaticParameters() const override;
     ParamterUnitMapType GetStaticParameterUnits() const override;
@@ -97,8 +107,12 @@ namespace mitk
     StaticParameterValuesType GetStaticParameterValue(const ParameterNameType& name) const
     override;
 
+    /** Updates m_ResampledAterialInputFunction. Must be called whenever the AIF or one of the time grids changes.*/
+    void UpdateResampledAterialInputFunction();
+
     TimeGridType m_AterialInputFunctionTimeGrid;
     AterialInputFunctionType m_AterialInputFunctionValues;
+    AterialInputFunctionType m_ResampledAterialInputFunction;
 
 
   private:
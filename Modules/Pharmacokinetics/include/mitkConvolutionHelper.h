@@ -105,47 +105,90 @@ inline    itk::Array<double> wrap1d(itk::Array<double> kernel)
 
     }
 
-  inline itk::Array<double> convoluteAIFWithExponential(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double lambda)
+  /** @brief Iterative formula to convolve aif(t) with an exponential residue function R(t) = exp(-lambda*t).
+   * Allocation-free variant that writes into caller-provided buffers, e.g. during voxel-wise fitting.
+   * @param timeGrid Time grid of aif
+   * @param aif Aterial input function
+   * @param lambda Decay constant of the residue function
+   * @param [out] convolution Buffer for the convolution; must hold timeGrid.GetSize() values.
+   * @param [out] derivative Optional buffer for the derivative of the convolution with respect to lambda;
+   * must hold timeGrid.GetSize() values if not nullptr.*/
+  inline void convoluteAIFWithExponential(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda,
+                                          double* convolution, double* derivative = nullptr)
   {
-      /** @brief Iterative Formula to Convolve aif(t) with an exponential Residuefunction R(t) = exp(lambda*t)
-       **/
-      typedef itk::Array<double> ConvolutionResultType;
-      ConvolutionResultType convolution(timeGrid.GetSize());
-      convolution.fill(0.0);
-
-      convolution(0) = 0;
-      for(unsigned int i = 0; i< (timeGrid.GetSize()-1); ++i)
+      const unsigned int size = timeGrid.GetSize();
+
+      if (size == 0)
+      {
+          return;
+      }
+
+      convolution[0] = 0;
+
+      if (derivative)
+      {
+          derivative[0] = 0;
+      }
+
+      for(unsigned int i = 0; i< (size-1); ++i)
       {
           double dt = timeGrid(i+1) - timeGrid(i);
           double m = (aif(i+1) - aif(i))/dt;
           double edt = exp(-lambda *dt);
 
-          convolution(i+1) =edt * convolution(i)
+          convolution[i+1] =edt * convolution[i]
                            + (aif(i) - m*timeGrid(i))/lambda * (1 - edt )
                            + m/(lambda * lambda) * ((lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1));
 
+          if (derivative)
+          {
+              // Derivative of the recursion above, so that it matches the discretized convolution exactly
+              double dedt = -dt * edt;
+              double g = (lambda * timeGrid(i+1) - 1) - edt*(lambda*timeGrid(i) -1);
+              double dg = timeGrid(i+1) - dedt*(lambda*timeGrid(i) -1) - edt*timeGrid(i);
+
+              derivative[i+1] = dedt * convolution[i] + edt * derivative[i]
+                              + (aif(i) - m*timeGrid(i)) * (-dedt * lambda - (1 - edt)) / (lambda * lambda)
+                              + m * (dg / (lambda * lambda) - 2 * g / (lambda * lambda * lambda));
+          }
       }
-      return convolution;
   }
 
+  inline itk::Array<double> convoluteAIFWithExponential(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double lambda)
+  {
+      itk::Array<double> convolution(timeGrid.GetSize());
+      convoluteAIFWithExponential(timeGrid, aif, lambda, convolution.data_block());
+      return convolution;
+  }
 
-  inline itk::Array<double> convoluteAIFWithConstant(mitk::ModelBase::TimeGridType timeGrid, mitk::AIFBasedModelBase::AterialInputFunctionType aif, double constant)
+  /** @brief Iterative formula to convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points.
+   * Allocation-free variant that writes into a caller-provided buffer.
+   * @param [out] convolution Buffer for the convolution; must hold timeGrid.GetSize() values.*/
+  inline void convoluteAIFWithConstant(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double constant,
+                                       double* convolution)
   {
-      /** @brief Iterative Formula to Convolve aif(t) with a constant value by linear interpolation of the Aif between sampling points
-       **/
-      typedef itk::Array<double> ConvolutionResultType;
-      ConvolutionResultType convolution(timeGrid.GetSize());
-      convolution.fill(0.0);
-
-      convolution(0) = 0;
-      for(unsigned int i = 0; i< (timeGrid.GetSize()-1); ++i)
+      const unsigned int size = timeGrid.GetSize();
+
+      if (size == 0)
+      {
+          return;
+      }
+
+      convolution[0] = 0;
+      for(unsigned int i = 0; i< (size-1); ++i)
       {
           double dt = timeGrid(i+1) - timeGrid(i);
           double m = (aif(i+1) - aif(i))/dt;
 
-          convolution(i+1) = convolution(i) + constant * (aif(i)*dt + m*timeGrid(i)*dt + m/2*(timeGrid(i+1)*timeGrid(i+1) - timeGrid(i)*timeGrid(i)));
+          convolution[i+1] = convolution[i] + constant * (aif(i)*dt + m*timeGrid(i)*dt + m/2*(timeGrid(i+1)*timeGrid(i+1) - timeGrid(i)*timeGrid(i)));
 
       }
+  }
+
+  inline itk::Array<double> convoluteAIFWithConstant(const mitk::ModelBase::TimeGridType& timeGrid, const mitk::AIFBasedModelBase::AterialInputFunctionType& aif, double constant)
+  {
+      itk::Array<double> convolution(timeGrid.GetSize());
+      convoluteAIFWithConstant(timeGrid, aif, constant, convolution.data_block());
       return convolution;
   }
 
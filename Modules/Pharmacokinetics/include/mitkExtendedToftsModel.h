@@ -71,6 +71,8 @@ namespace mitk
     ParametersSizeType  GetNumberOfDerivedParameters() const override;
     ParamterUnitMapType GetDerivedParameterUnits() const override;
 
+    bool HasAnalyticJacobian() const override;
+
 
   protected:
     ExtendedToftsModel();
@@ -84,6 +86,9 @@ namespace mitk
 
     ModelResultType ComputeModelfunction(const ParametersType& parameters) const override;
 
+    void ComputeModelfunctionJacobian(const ParametersType& parameters, ModelResultType& signal,
+                                      ModelJacobianType& jacobian) const override;
+
     DerivedParameterMapType ComputeDerivedParameters(const mitk::ModelBase::ParametersType&
         parameters) const override;
 
@@ -0,0 +1,83 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkLinearTwoCompartmentSystemSolver_h
+#define mitkLinearTwoCompartmentSystemSolver_h
+
+#include "itkArray.h"
+
+#include "MitkPharmacokineticsExports.h"
+
+namespace mitk
+{
+  /** @class LinearTwoCompartmentSystemSolver
+   * @brief Solver for the mass balance equations of linear two compartment models driven by an input function (e.g. the AIF).
+   *
+   * Solves the initial value problem
+   *
+   * dx(t)/dt = A * x(t) + b * Ca(t),  x(0) = 0
+   *
+   * with the state x = (x0, x1), the constant 2x2 matrix A and the constant vector b. As in the numeric integration
+   * formerly used by the numeric compartment models, Ca(t) is linearly interpolated between the points of the time grid
+   * and held at Ca(t_0) before the first point. For such a piecewise linear input the solution can be propagated exactly
+   * from one grid point to the next:
+   *
+   * x(t+h) = E(h) * x(t) + G0(h) * Ca(t) + G1(h) * (Ca(t+h) - Ca(t)) / h
+   *
+   * The propagators E, G0 and G1 are the upper rows of the matrix exponential of the system augmented by the input and its
+   * slope. They only depend on the step length h and are reused as long as the grid is equidistant. Thus no step size has
+   * to be chosen and each time step costs a few multiply-adds.*/
+  class MITKPHARMACOKINETICS_EXPORT LinearTwoCompartmentSystemSolver
+  {
+  public:
+    typedef itk::Array<double> TimeGridType;
+    typedef itk::Array<double> InputFunctionType;
+
+    struct SystemType
+    {
+      double A00;
+      double A01;
+      double A10;
+      double A11;
+      double B0;
+      double B1;
+    };
+
+    /** Computes the solution of one system at the points of the time grid.
+     * @param system Coefficients of the system.
+     * @param timeGrid Time grid of the input function and the solution. Must be sorted ascending.
+     * @param input Values of the input function on the time grid.
+     * @param [out] x0 Buffer for the first compartment. Must hold timeGrid.GetSize() values.
+     * @param [out] x1 Buffer for the second compartment. Must hold timeGrid.GetSize() values.
+     * @remark If a coefficient is not finite the solution is NaN.*/
+    static void Solve(const SystemType& system, const TimeGridType& timeGrid, const InputFunctionType& input,
+                      double* x0, double* x1);
+
+    /** Propagators of a system for a given step length (see class description).*/
+    struct PropagatorType
+    {
+      double E00;
+      double E01;
+      double E10;
+      double E11;
+      double G00;
+      double G10;
+      double G01;
+      double G11;
+    };
+
+    /** Computes the propagators of a system for the step length h via scaling and squaring of the augmented matrix.*/
+    static PropagatorType ComputePropagator(const SystemType& system, double h);
+  };
+}
+
+#endif
@@ -27,8 +27,8 @@ namespace mitk
    * ve * dCi(t)/dt = PS * (Cp(t) - Ci(t))
    *
    * with concentration curve Cp(t) of the Blood Plasma p and Ce(t) of the Extracellular Extravascular Space(EES)(interstitial volume). CA(t) is the aterial concentration, i.e. the AIF
-   * Cp(t) and Ce(t) are found numerical via Runge-Kutta methode, implemented in Boosts numeric library ODEINT. Here we use a runge_kutta_cash_karp54 stepper with
-   * adaptive step size and error controll.
+   * Cp(t) and Ce(t) are found by LinearTwoCompartmentSystemSolver, which propagates the solution exactly from one time point to the next
+   * for the linearly interpolated AIF. Thus the solution does not depend on a step size anymore.
    * From the resulting curves Cp(t) and Ce(t) the measured concentration Ctotal(t) is found vial
    *
    * Ctotal(t) = vp * Cp(t) + ve * Ce(t)
@@ -80,6 +80,8 @@ namespace mitk
 
     std::string GetModelType() const override;
 
+    /** Step size formerly used for the numeric integration with ODEINT. It is kept as static parameter for compatibility
+     * with existing fits, but does not influence the signal anymore.*/
     itkGetConstReferenceMacro(ODEINTStepSize, double);
     itkSetMacro(ODEINTStepSize, double);
 
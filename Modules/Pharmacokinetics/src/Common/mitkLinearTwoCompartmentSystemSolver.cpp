@@ -0,0 +1,182 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkLinearTwoCompartmentSystemSolver.h"
+
+#include <itkMacro.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  typedef double Matrix4Type[4][4];
+
+  /** Order of the Taylor series of the matrix exponential. Together with the scaling to a norm of at most 0.5
+   * the truncation error is below 1e-16.*/
+  const unsigned int TAYLOR_ORDER = 14;
+
+  void Multiply(const Matrix4Type a, const Matrix4Type b, Matrix4Type result)
+  {
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        result[row][col] = a[row][0] * b[0][col] + a[row][1] * b[1][col] + a[row][2] * b[2][col] + a[row][3] * b[3][col];
+      }
+    }
+  }
+
+  void Copy(const Matrix4Type source, Matrix4Type destination)
+  {
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        destination[row][col] = source[row][col];
+      }
+    }
+  }
+
+  /** Propagators only depend on the step length. Steps of (nearly) equidistant grids that just differ by rounding
+   * reuse the propagators of the previous step.*/
+  bool IsSameStep(double h, double lastH)
+  {
+    return std::abs(h - lastH) <= 1e-9 * lastH;
+  }
+
+  void CheckInput(const mitk::LinearTwoCompartmentSystemSolver::TimeGridType& timeGrid,
+                  const mitk::LinearTwoCompartmentSystemSolver::InputFunctionType& input)
+  {
+    if (timeGrid.GetSize() != input.GetSize())
+    {
+      itkGenericExceptionMacro("Size of the input function (" << input.GetSize() << ") does not match the size of the time grid ("
+                               << timeGrid.GetSize() << ").");
+    }
+  }
+}
+
+mitk::LinearTwoCompartmentSystemSolver::PropagatorType
+mitk::LinearTwoCompartmentSystemSolver::ComputePropagator(const SystemType& system, double h)
+{
+  // Augmented system for the state (x0, x1, Ca, dCa/dt) with a constant slope of the input
+  Matrix4Type m = { { system.A00 * h, system.A01 * h, system.B0 * h, 0.0 },
+                    { system.A10 * h, system.A11 * h, system.B1 * h, 0.0 },
+                    { 0.0, 0.0, 0.0, h },
+                    { 0.0, 0.0, 0.0, 0.0 } };
+
+  double norm = 0.0;
+  for (unsigned int row = 0; row < 4; ++row)
+  {
+    norm = std::max(norm, std::abs(m[row][0]) + std::abs(m[row][1]) + std::abs(m[row][2]) + std::abs(m[row][3]));
+  }
+
+  if (!std::isfinite(norm))
+  {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    return { nan, nan, nan, nan, nan, nan, nan, nan };
+  }
+
+  int squarings = 0;
+  if (norm > 0.5)
+  {
+    squarings = static_cast<int>(std::ceil(std::log2(norm / 0.5)));
+  }
+
+  const double scale = std::ldexp(1.0, -squarings);
+  for (unsigned int row = 0; row < 4; ++row)
+  {
+    for (unsigned int col = 0; col < 4; ++col)
+    {
+      m[row][col] *= scale;
+    }
+  }
+
+  Matrix4Type result = { { 1.0, 0.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0, 0.0 }, { 0.0, 0.0, 0.0, 1.0 } };
+  Matrix4Type term;
+  Matrix4Type temp;
+  Copy(result, term);
+
+  for (unsigned int k = 1; k <= TAYLOR_ORDER; ++k)
+  {
+    Multiply(term, m, temp);
+    for (unsigned int row = 0; row < 4; ++row)
+    {
+      for (unsigned int col = 0; col < 4; ++col)
+      {
+        term[row][col] = temp[row][col] / k;
+        result[row][col] += term[row][col];
+      }
+    }
+  }
+
+  for (int i = 0; i < squarings; ++i)
+  {
+    Multiply(result, result, temp);
+    Copy(temp, result);
+  }
+
+  return { result[0][0], result[0][1], result[1][0], result[1][1], result[0][2], result[1][2], result[0][3], result[1][3] };
+}
+
+void mitk::LinearTwoCompartmentSystemSolver::Solve(const SystemType& system, const TimeGridType& timeGrid,
+                                                   const InputFunctionType& input, double* x0, double* x1)
+{
+  CheckInput(timeGrid, input);
+
+  const unsigned int timeSteps = timeGrid.GetSize();
+  if (timeSteps == 0)
+  {
+    return;
+  }
+
+  double y0 = 0.0;
+  double y1 = 0.0;
+
+  if (timeGrid[0] > 0.0)
+  {
+    // constant input before the first time point
+    const PropagatorType start = ComputePropagator(system, timeGrid[0]);
+    y0 = start.G00 * input[0];
+    y1 = start.G10 * input[0];
+  }
+
+  x0[0] = y0;
+  x1[0] = y1;
+
+  PropagatorType propagator = {};
+  double lastH = -1.0;
+
+  for (unsigned int i = 1; i < timeSteps; ++i)
+  {
+    const double h = timeGrid[i] - timeGrid[i - 1];
+
+    if (h > 0.0)
+    {
+      if (!IsSameStep(h, lastH))
+      {
+        propagator = ComputePropagator(system, h);
+        lastH = h;
+      }
+
+      const double slope = (input[i] - input[i - 1]) / h;
+      const double next0 = propagator.E00 * y0 + propagator.E01 * y1 + propagator.G00 * input[i - 1] + propagator.G01 * slope;
+      const double next1 = propagator.E10 * y0 + propagator.E11 * y1 + propagator.G10 * input[i - 1] + propagator.G11 * slope;
+      y0 = next0;
+      y1 = next1;
+    }
+
+    x0[i] = y0;
+    x1[i] = y1;
+  }
+}
@@ -81,6 +81,58 @@ mitk::AIFBasedModelBase::GetAterialInputFunction(TimeGridType CurrentTimeGrid) c
   }
 }
 
+const mitk::AIFBasedModelBase::AterialInputFunctionType&
+mitk::AIFBasedModelBase::GetResampledAterialInputFunction() const
+{
+  return m_ResampledAterialInputFunction;
+}
+
+void mitk::AIFBasedModelBase::SetAterialInputFunctionValues(const AterialInputFunctionType& values)
+{
+  itkDebugMacro("setting AterialInputFunctionValues to " << values);
+
+  if (this->m_AterialInputFunctionValues != values)
+  {
+    this->m_AterialInputFunctionValues = values;
+    this->UpdateResampledAterialInputFunction();
+    this->Modified();
+  }
+}
+
+void mitk::AIFBasedModelBase::SetAterialInputFunctionTimeGrid(const TimeGridType& grid)
+{
+  itkDebugMacro("setting AterialInputFunctionTimeGrid to " << grid);
+
+  if (this->m_AterialInputFunctionTimeGrid != grid)
+  {
+    this->m_AterialInputFunctionTimeGrid = grid;
+    this->UpdateResampledAterialInputFunction();
+    this->Modified();
+  }
+}
+
+void mitk::AIFBasedModelBase::SetTimeGrid(const TimeGridType& grid)
+{
+  Superclass::SetTimeGrid(grid);
+  this->UpdateResampledAterialInputFunction();
+}
+
+void mitk::AIFBasedModelBase::UpdateResampledAterialInputFunction()
+{
+  const auto& aifTimeGrid = this->GetCurrentAterialInputFunctionTimeGrid();
+
+  // The AIF and the time grids may be set in any order, so intermediate states are allowed
+  // to be invalid. They are reported by ValidateModel().
+  if (this->m_TimeGrid.GetSize() == 0 || aifTimeGrid.GetSize() != m_AterialInputFunctionValues.GetSize())
+  {
+    m_ResampledAterialInputFunction.SetSize(0);
+    return;
+  }
+
+  m_ResampledAterialInputFunction = mitk::InterpolateSignalToNewTimeGrid(m_AterialInputFunctionValues,
+                                    aifTimeGrid, this->m_TimeGrid);
+}
+
 mitk::AIFBasedModelBase::ParameterNamesType mitk::AIFBasedModelBase::GetStaticParameterNames() const
 {
   ParameterNamesType result;
@@ -113,10 +113,7 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
-
-
+  const AterialInputFunctionType& aterialInputFunction = this->GetResampledAterialInputFunction();
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
 
@@ -133,25 +130,66 @@ mitk::ExtendedToftsModel::ModelResultType mitk::ExtendedToftsModel::ComputeModel
 
   double lambda =  ktrans / ve;
 
-  mitk::ModelBase::ModelResultType convolution = mitk::convoluteAIFWithExponential(this->m_TimeGrid,
-      aterialInputFunction, lambda);
-
-  //Signal that will be returned by ComputeModelFunction
+  //Signal that will be returned by ComputeModelFunction. The convolution is computed in place.
   mitk::ModelBase::ModelResultType signal(timeSteps);
-  signal.fill(0.0);
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction, lambda, signal.data_block());
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = aterialInputFunction[i] * vp + ktrans * signal[i];
+  }
+
+  return signal;
 
-  mitk::ModelBase::ModelResultType::iterator signalPos = signal.begin();
-  mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
+}
 
+bool mitk::ExtendedToftsModel::HasAnalyticJacobian() const
+{
+  return true;
+}
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
-       Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
+void mitk::ExtendedToftsModel::ComputeModelfunctionJacobian(const ParametersType& parameters,
+  ModelResultType& signal, ModelJacobianType& jacobian) const
+{
+  if (this->m_TimeGrid.GetSize() == 0)
   {
-    *signalPos = (*Cp) * vp + ktrans * (*res);
+    itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  return signal;
+  const AterialInputFunctionType& aterialInputFunction = this->GetResampledAterialInputFunction();
+
+  unsigned int timeSteps = this->m_TimeGrid.GetSize();
+
+  double ktrans = parameters[POSITION_PARAMETER_Ktrans] / 6000.0;
+  double     ve = parameters[POSITION_PARAMETER_ve];
+  double     vp = parameters[POSITION_PARAMETER_vp];
+
+  if (ve == 0.0)
+  {
+    itkExceptionMacro("ve is 0! Cannot calculate signal");
+  }
+
+  double lambda = ktrans / ve;
+
+  signal.SetSize(timeSteps);
+  jacobian.SetSize(NUMBER_OF_PARAMETERS, timeSteps);
 
+  // The rows of ktrans and ve hold the convolution and its derivative with respect to lambda until they are
+  // replaced by the partial derivatives.
+  double* convolution = jacobian[POSITION_PARAMETER_Ktrans];
+  double* convolutionDerivative = jacobian[POSITION_PARAMETER_ve];
+  mitk::convoluteAIFWithExponential(this->m_TimeGrid, aterialInputFunction, lambda, convolution, convolutionDerivative);
+
+  for (unsigned int i = 0; i < timeSteps; ++i)
+  {
+    signal[i] = aterialInputFunction[i] * vp + ktrans * convolution[i];
+
+    // signal = Cp * vp + ktrans * conv(Cp, exp(-ktrans/ve * t)), ktrans is passed in ml/min/100ml
+    const double dSignal_dLambda = ktrans * convolutionDerivative[i];
+    jacobian[POSITION_PARAMETER_Ktrans][i] = (convolution[i] + dSignal_dLambda / ve) / 6000.0;
+    jacobian[POSITION_PARAMETER_ve][i] = -dSignal_dLambda * lambda / ve;
+    jacobian[POSITION_PARAMETER_vp][i] = aterialInputFunction[i];
+  }
 }
 
 
@@ -84,8 +84,7 @@ mitk::OneTissueCompartmentModel::ModelResultType mitk::OneTissueCompartmentModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = this->GetResampledAterialInputFunction();
 
 
 
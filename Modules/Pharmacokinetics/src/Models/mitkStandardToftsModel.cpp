@@ -105,8 +105,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = this->GetResampledAterialInputFunction();
 
 
 
@@ -130,7 +129,7 @@ mitk::StandardToftsModel::ModelResultType mitk::StandardToftsModel::ComputeModel
   mitk::ModelBase::ModelResultType::const_iterator res = convolution.begin();
 
 
-  for (AterialInputFunctionType::iterator Cp = aterialInputFunction.begin();
+  for (AterialInputFunctionType::const_iterator Cp = aterialInputFunction.begin();
        Cp != aterialInputFunction.end(); ++res, ++signalPos, ++Cp)
   {
     *signalPos = ktrans * (*res);
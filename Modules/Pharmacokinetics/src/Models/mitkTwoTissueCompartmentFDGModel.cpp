@@ -92,8 +92,7 @@ mitk::TwoTissueCompartmentFDGModel::ComputeModelfunction(const ParametersType& p
     itkExceptionMacro("No Time Grid Set! Cannot Calculate Signal");
   }
 
-  AterialInputFunctionType aterialInputFunction;
-  aterialInputFunction = GetAterialInputFunction(this->m_TimeGrid);
+  const AterialInputFunctionType& aterialInputFunction = this->GetResampledAterialInputFunction();
 
 
   unsigned int timeSteps = this->m_TimeGrid.GetSize();
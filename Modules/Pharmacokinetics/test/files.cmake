@@ -4,4 +4,6 @@ SET(MODULE_TESTS
   #ConvertToConcentrationTest.cpp
   mitkTwoCompartmentExchangeModelTest.cpp
   mitkExtendedToftsModelTest.cpp
+  mitkLinearTwoCompartmentSystemSolverTest.cpp
+  mitkNumericCompartmentModelsTest.cpp
 )
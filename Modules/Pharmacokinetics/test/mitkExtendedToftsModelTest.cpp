@@ -19,6 +19,10 @@ found in the LICENSE file.
 #include "mitkVector.h"
 #include "mitkExtendedToftsModel.h"
 #include "mitkAIFBasedModelBase.h"
+#include "mitkLevenbergMarquardtModelFitFunctor.h"
+
+#include <chrono>
+#include <sstream>
 
 class mitkExtendedToftsModelTestSuite : public mitk::TestFixture
 {
@@ -33,10 +37,15 @@ class mitkExtendedToftsModelTestSuite : public mitk::TestFixture
   MITK_TEST(GetDerivedParameterUnitsTest);
   MITK_TEST(ComputeModelfunctionTest);
   MITK_TEST(ComputeDerivedParametersTest);
+  MITK_TEST(ComputeModelfunctionJacobianTest);
+  MITK_TEST(FitWithAnalyticJacobianTest);
+  MITK_TEST(FitDurationPerVoxelBenchmark);
   CPPUNIT_TEST_SUITE_END();
 
 private:
   mitk::ExtendedToftsModel::Pointer m_testmodel;
+  mitk::ExtendedToftsModel::Pointer m_fitmodel;
+  mitk::ModelBase::ParametersType m_testparameters;
   mitk::ModelBase::ModelResultType m_output;
   mitk::ModelBase::DerivedParameterMapType m_derivedParameters;
 
@@ -44,7 +53,7 @@ public:
   void setUp() override
   {
     mitk::ModelBase::TimeGridType m_grid(60);
-    mitk::ModelBase::ParametersType m_testparameters(3);
+    m_testparameters.SetSize(3);
     mitk::AIFBasedModelBase::AterialInputFunctionType m_arterialInputFunction (60);
 
     m_testparameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 35.0;
@@ -76,11 +85,26 @@ public:
     //ComputeModelfunction is called within GetSignal(), therefore no explicit testing of ComputeModelFunction()
     m_output = m_testmodel->GetSignal(m_testparameters);
     m_derivedParameters = m_testmodel->GetDerivedParameters(m_testparameters);
+
+    // model with a completely defined time grid for the derivative and fit tests
+    mitk::ModelBase::TimeGridType fitGrid(22);
+    mitk::AIFBasedModelBase::AterialInputFunctionType fitAIF(22);
+    for (unsigned int i = 0; i < fitGrid.GetSize(); ++i)
+    {
+      fitGrid[i] = m_grid[i];
+      fitAIF[i] = m_arterialInputFunction[i];
+    }
+
+    m_fitmodel = mitk::ExtendedToftsModel::New();
+    m_fitmodel->SetTimeGrid(fitGrid);
+    m_fitmodel->SetAterialInputFunctionValues(fitAIF);
+    m_fitmodel->SetAterialInputFunctionTimeGrid(fitGrid);
   }
 
   void tearDown() override
   {
     m_testmodel = nullptr;
+    m_fitmodel = nullptr;
     m_output.clear();
     m_derivedParameters.clear();
   }
@@ -159,6 +183,138 @@ public:
     CPPUNIT_ASSERT_MESSAGE("Checking kep.", mitk::Equal(70.00, m_derivedParameters["kep"], 1e-6, true) == true);
   }
 
+  void ComputeModelfunctionJacobianTest()
+  {
+    CPPUNIT_ASSERT_MESSAGE("Checking analytic Jacobian support.", m_fitmodel->HasAnalyticJacobian());
+
+    mitk::ModelBase::ModelResultType signal;
+    mitk::ModelBase::ModelJacobianType jacobian;
+    m_fitmodel->GetSignalAndJacobian(m_testparameters, signal, jacobian);
+
+    mitk::ModelBase::ModelResultType referenceSignal = m_fitmodel->GetSignal(m_testparameters);
+    CPPUNIT_ASSERT_EQUAL(referenceSignal.GetSize(), signal.GetSize());
+    CPPUNIT_ASSERT_EQUAL(m_testparameters.GetSize(), jacobian.rows());
+    CPPUNIT_ASSERT_EQUAL(signal.GetSize(), jacobian.cols());
+
+    for (unsigned int i = 0; i < signal.GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT_MESSAGE("Checking signal of GetSignalAndJacobian().", mitk::Equal(referenceSignal[i], signal[i], 1e-10, true));
+    }
+
+    // compare with central differences
+    for (unsigned int p = 0; p < m_testparameters.GetSize(); ++p)
+    {
+      const double step = 1e-6 * m_testparameters[p];
+      mitk::ModelBase::ParametersType upper = m_testparameters;
+      mitk::ModelBase::ParametersType lower = m_testparameters;
+      upper[p] += step;
+      lower[p] -= step;
+
+      mitk::ModelBase::ModelResultType upperSignal = m_fitmodel->GetSignal(upper);
+      mitk::ModelBase::ModelResultType lowerSignal = m_fitmodel->GetSignal(lower);
+
+      for (unsigned int i = 0; i < signal.GetSize(); ++i)
+      {
+        const double numeric = (upperSignal[i] - lowerSignal[i]) / (2 * step);
+        std::stringstream message;
+        message << "Checking derivative of parameter " << p << " at time frame " << i << ".";
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str(), numeric, jacobian[p][i], 1e-4 * std::max(1.0, std::abs(numeric)));
+      }
+    }
+  }
+
+  void FitWithAnalyticJacobianTest()
+  {
+    // Fits a few synthetic voxels with analytic and numeric derivatives, both fits have to yield the same parameters.
+    mitk::ModelBase::ParametersType initialParameters(3);
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 15.0;
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.3;
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.02;
+
+    auto numericFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    numericFunctor->SetUseAnalyticDerivative(false);
+    auto analyticFunctor = mitk::LevenbergMarquardtModelFitFunctor::New();
+    analyticFunctor->SetUseAnalyticDerivative(true);
+
+    const unsigned int numberOfVoxels = 5;
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      mitk::ModelBase::ParametersType parameters(3);
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 5.0 + 6.0 * v;
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.1 + 0.08 * v;
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.01 + 0.01 * v;
+
+      mitk::ModelBase::ModelResultType signal = m_fitmodel->GetSignal(parameters);
+      const mitk::LevenbergMarquardtModelFitFunctor::InputPixelArrayType sample(signal.begin(), signal.end());
+
+      const auto numericResult = numericFunctor->Compute(sample, m_fitmodel, initialParameters);
+      const auto analyticResult = analyticFunctor->Compute(sample, m_fitmodel, initialParameters);
+
+      for (unsigned int p = 0; p < parameters.GetSize(); ++p)
+      {
+        std::stringstream message;
+        message << "Checking parameter " << p << " of voxel " << v << ".";
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str() + " Analytic and numeric fit differ.", numericResult[p], analyticResult[p], 1e-4 * parameters[p]);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(message.str() + " Fit does not recover the parameter.", parameters[p], analyticResult[p], 1e-3 * parameters[p]);
+      }
+    }
+  }
+
+  void FitDurationPerVoxelBenchmark()
+  {
+    // Fits a set of synthetic voxels with analytic and numeric derivatives and reports the time per voxel.
+    const unsigned int numberOfVoxels = 200;
+
+    std::vector<mitk::LevenbergMarquardtModelFitFunctor::InputPixelArrayType> samples;
+    std::vector<mitk::ModelBase::ParametersType> references;
+    for (unsigned int v = 0; v < numberOfVoxels; ++v)
+    {
+      mitk::ModelBase::ParametersType parameters(3);
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 5.0 + 30.0 * v / numberOfVoxels;
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.1 + 0.4 * (v % 10) / 10.0;
+      parameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.01 + 0.01 * (v % 5);
+
+      mitk::ModelBase::ModelResultType signal = m_fitmodel->GetSignal(parameters);
+      samples.emplace_back(signal.begin(), signal.end());
+      references.push_back(parameters);
+    }
+
+    mitk::ModelBase::ParametersType initialParameters(3);
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans] = 15.0;
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_ve] = 0.3;
+    initialParameters[mitk::ExtendedToftsModel::POSITION_PARAMETER_vp] = 0.02;
+
+    double durationPerVoxel[2] = { 0.0, 0.0 };
+
+    for (const bool useAnalyticDerivative : { false, true })
+    {
+      auto functor = mitk::LevenbergMarquardtModelFitFunctor::New();
+      functor->SetUseAnalyticDerivative(useAnalyticDerivative);
+
+      unsigned int convergedVoxels = 0;
+      const auto start = std::chrono::steady_clock::now();
+      for (unsigned int v = 0; v < numberOfVoxels; ++v)
+      {
+        auto result = functor->Compute(samples[v], m_fitmodel, initialParameters);
+        if (mitk::Equal(references[v][mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans], result[mitk::ExtendedToftsModel::POSITION_PARAMETER_Ktrans], 1e-2, false))
+        {
+          ++convergedVoxels;
+        }
+      }
+      const std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+      durationPerVoxel[useAnalyticDerivative] = duration.count() / numberOfVoxels;
+
+      MITK_INFO << "Extended Tofts fit (" << (useAnalyticDerivative ? "analytic" : "numeric") << " derivative): "
+                << durationPerVoxel[useAnalyticDerivative] << " us per voxel, " << convergedVoxels << " of "
+                << numberOfVoxels << " voxels recovered Ktrans.";
+
+      CPPUNIT_ASSERT_MESSAGE("Checking that the fit recovers the model parameters.", convergedVoxels >= numberOfVoxels * 9 / 10);
+    }
+
+    // Timings depend on the machine and its load, so the speedup is only reported.
+    MITK_INFO << "Extended Tofts fit: analytic derivative speedup " << durationPerVoxel[0] / durationPerVoxel[1];
+  }
+
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkExtendedToftsModel)
@@ -0,0 +1,144 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkLinearTwoCompartmentSystemSolver.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+class mitkLinearTwoCompartmentSystemSolverTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkLinearTwoCompartmentSystemSolverTestSuite);
+  MITK_TEST(ConstantInputTest);
+  MITK_TEST(LinearInputTest);
+  MITK_TEST(NonEquidistantGridTest);
+  MITK_TEST(InvalidSystemTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  typedef mitk::LinearTwoCompartmentSystemSolver SolverType;
+
+  SolverType::TimeGridType m_grid;
+
+public:
+  void setUp() override
+  {
+    m_grid.SetSize(22);
+    for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+    {
+      m_grid[i] = 14.0 * i;
+    }
+  }
+
+  void tearDown() override
+  {
+    m_grid.SetSize(0);
+  }
+
+  void ConstantInputTest()
+  {
+    // x0' = k*(c - x0), x1' = k*x0; the second compartment has an eigenvalue of 0
+    const double k = 0.05;
+    const double c = 2.0;
+    const SolverType::SystemType system = { -k, 0.0, k, 0.0, k, 0.0 };
+
+    SolverType::InputFunctionType input(m_grid.GetSize());
+    input.Fill(c);
+
+    std::vector<double> x0(m_grid.GetSize());
+    std::vector<double> x1(m_grid.GetSize());
+    SolverType::Solve(system, m_grid, input, x0.data(), x1.data());
+
+    for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+    {
+      const double t = m_grid[i];
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(c * (1 - std::exp(-k * t)), x0[i], 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(c * (k * t - 1 + std::exp(-k * t)), x1[i], 1e-10);
+    }
+  }
+
+  void LinearInputTest()
+  {
+    // x0' = k*(t - x0)
+    const double k = 0.2;
+    const SolverType::SystemType system = { -k, 0.0, 0.0, 0.0, k, 0.0 };
+
+    SolverType::InputFunctionType input(m_grid.GetSize());
+    for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+    {
+      input[i] = m_grid[i];
+    }
+
+    std::vector<double> x0(m_grid.GetSize());
+    std::vector<double> x1(m_grid.GetSize());
+    SolverType::Solve(system, m_grid, input, x0.data(), x1.data());
+
+    for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+    {
+      const double t = m_grid[i];
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(t - (1 - std::exp(-k * t)) / k, x0[i], 1e-10);
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, x1[i], 1e-10);
+    }
+  }
+
+  void NonEquidistantGridTest()
+  {
+    // The input is held constant before the first time point
+    const double k = 0.05;
+    const double c = 1.5;
+    const SolverType::SystemType system = { -k, 0.0, 0.0, 0.0, k, 0.0 };
+
+    SolverType::TimeGridType grid(5);
+    grid[0] = 3.0;
+    grid[1] = 4.0;
+    grid[2] = 10.0;
+    grid[3] = 10.0;
+    grid[4] = 30.5;
+
+    SolverType::InputFunctionType input(grid.GetSize());
+    input.Fill(c);
+
+    std::vector<double> x0(grid.GetSize());
+    std::vector<double> x1(grid.GetSize());
+    SolverType::Solve(system, grid, input, x0.data(), x1.data());
+
+    for (unsigned int i = 0; i < grid.GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(c * (1 - std::exp(-k * grid[i])), x0[i], 1e-10);
+    }
+  }
+
+  void InvalidSystemTest()
+  {
+    const SolverType::SystemType system = { -std::numeric_limits<double>::infinity(), 0.0, 0.0, 0.0, 1.0, 0.0 };
+
+    SolverType::InputFunctionType input(m_grid.GetSize());
+    input.Fill(1.0);
+
+    std::vector<double> x0(m_grid.GetSize());
+    std::vector<double> x1(m_grid.GetSize());
+    SolverType::Solve(system, m_grid, input, x0.data(), x1.data());
+
+    CPPUNIT_ASSERT(std::isnan(x0.back()));
+
+    SolverType::InputFunctionType wrongInput(m_grid.GetSize() - 1);
+    CPPUNIT_ASSERT_THROW(SolverType::Solve(system, m_grid, wrongInput, x0.data(), x1.data()), itk::ExceptionObject);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkLinearTwoCompartmentSystemSolver)
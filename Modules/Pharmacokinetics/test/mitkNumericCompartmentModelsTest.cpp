@@ -0,0 +1,127 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+// Testing
+#include "mitkTestingMacros.h"
+#include "mitkTestFixture.h"
+
+//MITK includes
+#include "mitkNumericTwoCompartmentExchangeModel.h"
+#include "mitkNumericTwoTissueCompartmentModel.h"
+#include "mitkTwoCompartmentExchangeModel.h"
+#include "mitkTwoTissueCompartmentModel.h"
+
+#include <cmath>
+
+/**
+ * Compares the numeric compartment models with their analytic counterparts. Both solve the mass balance equations
+ * exactly for the linearly interpolated AIF, so the signals have to agree up to rounding errors.
+ */
+class mitkNumericCompartmentModelsTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkNumericCompartmentModelsTestSuite);
+  MITK_TEST(TwoCompartmentExchangeModelTest);
+  MITK_TEST(TwoCompartmentExchangeModelWithoutExchangeTest);
+  MITK_TEST(TwoTissueCompartmentModelTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  mitk::ModelBase::TimeGridType m_grid;
+  mitk::AIFBasedModelBase::AterialInputFunctionType m_arterialInputFunction;
+
+public:
+  void setUp() override
+  {
+    m_grid.SetSize(22);
+    m_arterialInputFunction.SetSize(22);
+
+    // AIF from Weinmann et al. (1984), see mitkTwoCompartmentExchangeModelTest
+    for (unsigned int i = 0; i < m_grid.GetSize(); ++i)
+    {
+      // time grid in seconds, 14s between frames
+      m_grid[i] = 14.0 * i;
+
+      if (i < 5)
+        m_arterialInputFunction[i] = 0;
+      else
+        m_arterialInputFunction[i] = 3.99 * std::exp(-0.144 * m_grid[i]) + 4.78 * std::exp(-0.0111 * m_grid[i]);
+    }
+  }
+
+  void tearDown() override
+  {
+    m_grid.SetSize(0);
+    m_arterialInputFunction.SetSize(0);
+  }
+
+  void TwoCompartmentExchangeModelTest()
+  {
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 35.0;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 5.0;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.5;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.05;
+
+    CheckSignals(mitk::TwoCompartmentExchangeModel::New().GetPointer(),
+                 mitk::NumericTwoCompartmentExchangeModel::New().GetPointer(), parameters);
+  }
+
+  void TwoCompartmentExchangeModelWithoutExchangeTest()
+  {
+    mitk::ModelBase::ParametersType parameters(4);
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_F] = 60.0;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_PS] = 0.0;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_ve] = 0.3;
+    parameters[mitk::TwoCompartmentExchangeModel::POSITION_PARAMETER_vp] = 0.1;
+
+    CheckSignals(mitk::TwoCompartmentExchangeModel::New().GetPointer(),
+                 mitk::NumericTwoCompartmentExchangeModel::New().GetPointer(), parameters);
+  }
+
+  void TwoTissueCompartmentModelTest()
+  {
+    mitk::ModelBase::ParametersType parameters(5);
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_K1] = 0.8;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k2] = 1.2;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k3] = 0.3;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_k4] = 0.05;
+    parameters[mitk::TwoTissueCompartmentModel::POSITION_PARAMETER_VB] = 0.04;
+
+    CheckSignals(mitk::TwoTissueCompartmentModel::New().GetPointer(),
+                 mitk::NumericTwoTissueCompartmentModel::New().GetPointer(), parameters);
+  }
+
+private:
+  void CheckSignals(mitk::AIFBasedModelBase* analyticModel, mitk::AIFBasedModelBase* numericModel,
+                    const mitk::ModelBase::ParametersType& parameters)
+  {
+    for (auto model : { analyticModel, numericModel })
+    {
+      model->SetTimeGrid(m_grid);
+      model->SetAterialInputFunctionValues(m_arterialInputFunction);
+      model->SetAterialInputFunctionTimeGrid(m_grid);
+    }
+
+    const mitk::ModelBase::ModelResultType analyticSignal = analyticModel->GetSignal(parameters);
+    const mitk::ModelBase::ModelResultType numericSignal = numericModel->GetSignal(parameters);
+
+    CPPUNIT_ASSERT_EQUAL(analyticSignal.GetSize(), numericSignal.GetSize());
+    CPPUNIT_ASSERT_MESSAGE("Checking that the signal is not trivial.", analyticSignal.max_value() > 0.01);
+
+    for (unsigned int i = 0; i < analyticSignal.GetSize(); ++i)
+    {
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(analyticSignal[i], numericSignal[i], 1e-9);
+    }
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkNumericCompartmentModels)
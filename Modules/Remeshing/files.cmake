@@ -3,5 +3,6 @@ set(H_FILES
 )
 
 set(CPP_FILES
+  mitkParallelClustering.cpp
   mitkRemeshing.cpp
 )
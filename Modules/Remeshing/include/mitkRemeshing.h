@@ -18,8 +18,47 @@ found in the LICENSE file.
 #include <mitkTimeGeometry.h>
 #include <MitkRemeshingExports.h>
 
+#include <vtkType.h>
+
+#include <functional>
+#include <iosfwd>
+
+class vtkPolyData;
+
 namespace mitk
 {
+  /** \brief Receives the progress of mitk::Remesh() between 0 and 1. Return false to cancel the remeshing.
+   *
+   * The callback is always called from the thread that called mitk::Remesh(). The parallel remeshing calls it between
+   * its iterations. The serial %ACVD remeshing cannot be interrupted, i.e. the callback is only called before and after
+   * the %ACVD clustering (at 0.05 and 0.8) and a cancellation takes effect when the clustering has finished.
+   */
+  using RemeshingProgressCallback = std::function<bool(double)>;
+
+  /** \brief Quality measures of a triangle mesh, e.g. to compare the serial and the parallel remeshing.
+   */
+  struct RemeshingQuality
+  {
+    vtkIdType NumberOfVertices = 0;
+    vtkIdType NumberOfTriangles = 0;
+    double Area = 0.0;
+    double MinimumAngle = 0.0;             ///< Smallest triangle angle in degrees
+    double MeanMinimumAngle = 0.0;         ///< Mean of the smallest angle of each triangle in degrees
+    double MinimumRadiusRatio = 0.0;       ///< Twice the inradius divided by the circumradius of the worst triangle (1 is equilateral)
+    double MeanRadiusRatio = 0.0;
+    double MeanEdgeLength = 0.0;
+    double EdgeLengthDeviation = 0.0;      ///< Standard deviation of the edge lengths divided by their mean
+    vtkIdType NumberOfBoundaryEdges = 0;
+    vtkIdType NumberOfNonManifoldEdges = 0;
+    double Seconds = 0.0;                  ///< Duration of the remeshing, only set by mitk::Remesh()
+  };
+
+  /** \brief Compute the quality measures of the triangles of a mesh. Other cells are ignored.
+   */
+  MITKREMESHING_EXPORT RemeshingQuality ComputeRemeshingQuality(vtkPolyData* polyData);
+
+  MITKREMESHING_EXPORT std::ostream& operator<<(std::ostream& os, const RemeshingQuality& quality);
+
   /** \brief Remesh a surface and store the result in a new surface.
    *
    * The %ACVD library is used for remeshing which is based on the paper "Approximated Centroidal Voronoi Diagrams for
@@ -50,7 +89,15 @@ namespace mitk
    * \param[in] optimizationLevel Minimize distance between input surface and remeshed surface.
    * \param[in] forceManifold
    * \param[in] boundaryFixing Keep original surface boundaries by adding additional polygons.
-   * \return Returns the remeshed surface or nullptr if input surface is invalid.
+   * \param[in] numberOfThreads 1 runs the serial %ACVD remeshing. Any other value uses the parallel clustering
+   * with that many threads (0 for the global default number of threads of itk::MultiThreaderBase): The mesh is split into spatial regions that are
+   * clustered concurrently and the borders between the regions are reconciled afterwards. Results are of similar
+   * quality but not identical to the serial remeshing. Curvature adaptive remeshing (gradation) approximates the
+   * %ACVD metric. forceManifold and boundaryFixing are only supported by the serial remeshing.
+   * \param[in] progressCallback Optional callback that receives the progress and can cancel the remeshing.
+   * \param[out] quality Optional, receives the quality measures of the remeshed surface.
+   * \return Returns the remeshed surface or nullptr if the remeshing was cancelled.
+   * \throws mitk::Exception if the input surface is invalid.
    */
   MITKREMESHING_EXPORT Surface::Pointer Remesh(const Surface* surface,
                                                TimeStepType t,
@@ -60,9 +107,15 @@ namespace mitk
                                                double edgeSplitting = 0.0,
                                                int optimizationLevel = 1,
                                                bool forceManifold = false,
-                                               bool boundaryFixing = false);
+                                               bool boundaryFixing = false,
+                                               unsigned int numberOfThreads = 1,
+                                               const RemeshingProgressCallback& progressCallback = nullptr,
+                                               RemeshingQuality* quality = nullptr);
 
   /** \brief Encapsulates mitk::Remesh function as filter.
+   *
+   * The filter reports its progress and can be aborted by SetAbortGenerateData(true), which results in an
+   * itk::ProcessAborted exception. See RemeshingProgressCallback for when the abort takes effect. The quality of the last output is available by GetQuality().
    */
   class MITKREMESHING_EXPORT RemeshFilter : public mitk::SurfaceToSurfaceFilter
   {
@@ -78,6 +131,9 @@ namespace mitk
     itkSetMacro(OptimizationLevel, int);
     itkSetMacro(ForceManifold, bool);
     itkSetMacro(BoundaryFixing, bool);
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+    itkGetConstReferenceMacro(Quality, RemeshingQuality);
 
   protected:
     void GenerateData() override;
@@ -94,6 +150,8 @@ namespace mitk
     int m_OptimizationLevel;
     bool m_ForceManifold;
     bool m_BoundaryFixing;
+    unsigned int m_NumberOfThreads;
+    RemeshingQuality m_Quality;
   };
 }
 
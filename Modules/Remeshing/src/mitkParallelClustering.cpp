@@ -0,0 +1,948 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkParallelClustering.h"
+
+#include <mitkExceptionMacro.h>
+
+#include <itkMultiThreaderBase.h>
+
+#include <vnl/algo/vnl_symmetric_eigensystem.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+  using PointType = mitk::ParallelClustering::PointType;
+  using TriangleType = mitk::ParallelClustering::TriangleType;
+
+  // Sweeps over the points of a thread before the borders between threads are reconciled
+  constexpr unsigned int MaximumNumberOfSweeps = 20;
+
+  // Moves must improve the energy of the involved clusters by more than this fraction
+  constexpr double RelativeGainThreshold = 1e-12;
+
+  /** Calls function for the indices 0, ..., count - 1 with one work unit per index.*/
+  void ParallelizeArray(unsigned int count, const std::function<void(itk::SizeValueType)>& function)
+  {
+    if (0 == count)
+      return;
+
+    auto multiThreader = itk::MultiThreaderBase::New();
+    multiThreader->SetMaximumNumberOfThreads(count);
+    multiThreader->SetNumberOfWorkUnits(count);
+    multiThreader->ParallelizeArray(0, count, function, nullptr);
+  }
+
+  double SquaredNorm(const PointType& v)
+  {
+    return v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+  }
+
+  PointType Cross(const PointType& u, const PointType& v)
+  {
+    return { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+  }
+
+  PointType Subtract(const PointType& u, const PointType& v)
+  {
+    return { u[0] - v[0], u[1] - v[1], u[2] - v[2] };
+  }
+
+  /** Energy term of a cluster with the given weighted sum of points (the larger, the more compact).*/
+  double ClusterTerm(const PointType& sum, double weight)
+  {
+    return SquaredNorm(sum) / weight;
+  }
+
+  /** Spreads the lower 21 bits of x to every third bit (Morton order).*/
+  std::uint64_t SpreadBits(std::uint64_t x)
+  {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffff;
+    x = (x | x << 16) & 0x1f0000ff0000ff;
+    x = (x | x << 8) & 0x100f00f00f00f00f;
+    x = (x | x << 4) & 0x10c30c30c30c30c3;
+    x = (x | x << 2) & 0x1249249249249249;
+    return x;
+  }
+}
+
+mitk::ParallelClustering::ParallelClustering(const std::vector<PointType>& points,
+                                             const std::vector<TriangleType>& triangles,
+                                             const std::vector<double>& densities)
+  : m_NumberOfThreads(0),
+    m_MaximumNumberOfIterations(100),
+    m_Center({ 0.0, 0.0, 0.0 }),
+    m_Points(points),
+    m_Triangles(triangles),
+    m_Clustering(points.size())
+{
+  const auto numPoints = static_cast<vtkIdType>(m_Points.size());
+
+  if (!densities.empty() && densities.size() != m_Points.size())
+    mitkThrow() << "Number of densities (" << densities.size() << ") does not match number of points (" << numPoints << ")!";
+
+  for (const auto& triangle : m_Triangles)
+  {
+    for (auto id : triangle)
+    {
+      if (id < 0 || id >= numPoints)
+        mitkThrow() << "Triangle refers to invalid point " << id << "!";
+    }
+  }
+
+  if (numPoints != 0)
+  {
+    PointType minimum = m_Points[0];
+    PointType maximum = m_Points[0];
+
+    for (const auto& point : m_Points)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        minimum[i] = std::min(minimum[i], point[i]);
+        maximum[i] = std::max(maximum[i], point[i]);
+      }
+    }
+
+    for (int i = 0; i < 3; ++i)
+      m_Center[i] = 0.5 * (minimum[i] + maximum[i]);
+
+    for (auto& point : m_Points)
+      point = Subtract(point, m_Center);
+  }
+
+  // Each point represents a third of the area of its triangles
+  m_Weights.assign(numPoints, 0.0);
+  m_AdjacencyOffsets.assign(numPoints + 1, 0);
+
+  for (const auto& triangle : m_Triangles)
+  {
+    const auto normal = Cross(Subtract(m_Points[triangle[1]], m_Points[triangle[0]]), Subtract(m_Points[triangle[2]], m_Points[triangle[0]]));
+    const double area = 0.5 * std::sqrt(SquaredNorm(normal));
+
+    for (auto id : triangle)
+    {
+      m_Weights[id] += area / 3.0;
+      m_AdjacencyOffsets[id + 1] += 2;
+    }
+  }
+
+  std::partial_sum(m_AdjacencyOffsets.begin(), m_AdjacencyOffsets.end(), m_AdjacencyOffsets.begin());
+  m_Adjacency.resize(m_AdjacencyOffsets.back());
+
+  std::vector<vtkIdType> positions(m_AdjacencyOffsets.begin(), m_AdjacencyOffsets.end() - 1);
+
+  for (const auto& triangle : m_Triangles)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto id = triangle[i];
+      m_Adjacency[positions[id]++] = triangle[(i + 1) % 3];
+      m_Adjacency[positions[id]++] = triangle[(i + 2) % 3];
+    }
+  }
+
+  // Sort the neighbors and remove duplicates in place
+  vtkIdType begin = 0;
+  vtkIdType size = 0;
+
+  for (vtkIdType id = 0; id < numPoints; ++id)
+  {
+    const auto end = m_AdjacencyOffsets[id + 1];
+    auto first = m_Adjacency.begin() + begin;
+    auto last = m_Adjacency.begin() + end;
+
+    std::sort(first, last);
+    last = std::unique(first, last);
+    last = std::remove(first, last, id);
+
+    m_AdjacencyOffsets[id] = size;
+
+    for (auto iter = first; iter != last; ++iter)
+      m_Adjacency[size++] = *iter;
+
+    begin = end;
+  }
+
+  m_AdjacencyOffsets[numPoints] = size;
+  m_Adjacency.resize(size);
+  m_Adjacency.shrink_to_fit();
+
+  if (!densities.empty())
+  {
+    for (vtkIdType id = 0; id < numPoints; ++id)
+      m_Weights[id] *= std::max(densities[id], 0.0);
+  }
+
+  // Points of degenerated triangles get a tiny weight to keep the cluster energies defined
+  double totalWeight = std::accumulate(m_Weights.begin(), m_Weights.end(), 0.0);
+  const double minimumWeight = totalWeight > 0.0 ? 1e-9 * totalWeight / std::max<vtkIdType>(numPoints, 1) : 1.0;
+
+  for (auto& weight : m_Weights)
+    weight = std::max(weight, minimumWeight);
+}
+
+void mitk::ParallelClustering::SetNumberOfThreads(unsigned int numberOfThreads)
+{
+  m_NumberOfThreads = numberOfThreads;
+}
+
+unsigned int mitk::ParallelClustering::GetNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+void mitk::ParallelClustering::SetMaximumNumberOfIterations(unsigned int maximumNumberOfIterations)
+{
+  m_MaximumNumberOfIterations = std::max(maximumNumberOfIterations, 1u);
+}
+
+unsigned int mitk::ParallelClustering::GetMaximumNumberOfIterations() const
+{
+  return m_MaximumNumberOfIterations;
+}
+
+std::vector<int> mitk::ParallelClustering::GetClustering() const
+{
+  std::vector<int> clustering(m_Clustering.size());
+
+  for (std::size_t i = 0; i < clustering.size(); ++i)
+    clustering[i] = m_Clustering[i].load(std::memory_order_relaxed);
+
+  return clustering;
+}
+
+int mitk::ParallelClustering::GetNumberOfClusters() const
+{
+  return static_cast<int>(m_ClusterOwners.size());
+}
+
+bool mitk::ParallelClustering::AreAdjacent(vtkIdType point1, vtkIdType point2) const
+{
+  return std::binary_search(m_Adjacency.begin() + m_AdjacencyOffsets[point1], m_Adjacency.begin() + m_AdjacencyOffsets[point1 + 1], point2);
+}
+
+void mitk::ParallelClustering::Partition(std::vector<vtkIdType>& ids, std::size_t begin, std::size_t end, int firstPart, int numParts)
+{
+  if (1 == numParts)
+  {
+    m_PartPoints[firstPart].assign(ids.begin() + begin, ids.begin() + end);
+    return;
+  }
+
+  // Split at the weighted median of the longest extent
+  PointType minimum = m_Points[ids[begin]];
+  PointType maximum = minimum;
+  double weight = 0.0;
+
+  for (auto i = begin; i < end; ++i)
+  {
+    const auto& point = m_Points[ids[i]];
+
+    for (int j = 0; j < 3; ++j)
+    {
+      minimum[j] = std::min(minimum[j], point[j]);
+      maximum[j] = std::max(maximum[j], point[j]);
+    }
+
+    weight += m_Weights[ids[i]];
+  }
+
+  int axis = 0;
+
+  for (int j = 1; j < 3; ++j)
+  {
+    if (maximum[j] - minimum[j] > maximum[axis] - minimum[axis])
+      axis = j;
+  }
+
+  std::sort(ids.begin() + begin, ids.begin() + end, [this, axis](vtkIdType a, vtkIdType b) {
+    return m_Points[a][axis] < m_Points[b][axis];
+  });
+
+  const int numLeftParts = numParts / 2;
+  const double leftWeight = weight * numLeftParts / numParts;
+
+  auto split = begin;
+
+  for (double sum = 0.0; split < end && sum < leftWeight; ++split)
+    sum += m_Weights[ids[split]];
+
+  // Every part needs at least one point
+  split = std::max(split, begin + numLeftParts);
+  split = std::min(split, end - (numParts - numLeftParts));
+
+  this->Partition(ids, begin, split, firstPart, numLeftParts);
+  this->Partition(ids, split, end, firstPart + numLeftParts, numParts - numLeftParts);
+}
+
+void mitk::ParallelClustering::Initialize(int numberOfClusters, int numParts)
+{
+  const auto numPoints = static_cast<vtkIdType>(m_Points.size());
+
+  // Share clusters among the parts in proportion to their weight (largest remainder method)
+  std::vector<double> partWeights(numParts, 0.0);
+  std::vector<vtkIdType> partSizes(numParts);
+
+  for (int k = 0; k < numParts; ++k)
+  {
+    partSizes[k] = static_cast<vtkIdType>(m_PartPoints[k].size());
+
+    for (auto id : m_PartPoints[k])
+      partWeights[k] += m_Weights[id];
+  }
+
+  const double totalWeight = std::accumulate(partWeights.begin(), partWeights.end(), 0.0);
+
+  std::vector<int> counts(numParts);
+  std::vector<std::pair<double, int>> remainders(numParts);
+  int numAssigned = 0;
+
+  for (int k = 0; k < numParts; ++k)
+  {
+    const double exact = numberOfClusters * partWeights[k] / totalWeight;
+    counts[k] = static_cast<int>(std::clamp<vtkIdType>(static_cast<vtkIdType>(exact), 1, partSizes[k]));
+    remainders[k] = { exact - std::floor(exact), k };
+    numAssigned += counts[k];
+  }
+
+  std::sort(remainders.begin(), remainders.end(), std::greater<std::pair<double, int>>());
+
+  while (numAssigned < numberOfClusters)
+  {
+    for (const auto& remainder : remainders)
+    {
+      const int k = remainder.second;
+
+      if (numAssigned < numberOfClusters && counts[k] < partSizes[k])
+      {
+        ++counts[k];
+        ++numAssigned;
+      }
+    }
+  }
+
+  while (numAssigned > numberOfClusters)
+  {
+    for (auto iter = remainders.rbegin(); iter != remainders.rend(); ++iter)
+    {
+      const int k = iter->second;
+
+      if (numAssigned > numberOfClusters && counts[k] > 1)
+      {
+        --counts[k];
+        --numAssigned;
+      }
+    }
+  }
+
+  std::vector<int> firstClusters(numParts, 0);
+  m_ClusterOwners.clear();
+
+  for (int k = 0; k < numParts; ++k)
+  {
+    firstClusters[k] = static_cast<int>(m_ClusterOwners.size());
+    m_ClusterOwners.insert(m_ClusterOwners.end(), counts[k], k);
+  }
+
+  std::vector<int> pointParts(numPoints, -1);
+
+  for (int k = 0; k < numParts; ++k)
+  {
+    for (auto id : m_PartPoints[k])
+      pointParts[id] = k;
+  }
+
+  for (auto& cluster : m_Clustering)
+    cluster.store(-1, std::memory_order_relaxed);
+
+  // Seeds are evenly distributed along the Morton order of the points of a part and grown by a breadth-first
+  // search within the part.
+  ParallelizeArray(numParts, [&](unsigned int k) {
+    const auto& partPoints = m_PartPoints[k];
+
+    PointType minimum = m_Points[partPoints[0]];
+    PointType maximum = minimum;
+
+    for (auto id : partPoints)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        minimum[j] = std::min(minimum[j], m_Points[id][j]);
+        maximum[j] = std::max(maximum[j], m_Points[id][j]);
+      }
+    }
+
+    PointType scale;
+
+    for (int j = 0; j < 3; ++j)
+      scale[j] = maximum[j] > minimum[j] ? 2097151.0 / (maximum[j] - minimum[j]) : 0.0;
+
+    std::vector<std::pair<std::uint64_t, vtkIdType>> codes;
+    codes.reserve(partPoints.size());
+
+    for (auto id : partPoints)
+    {
+      std::uint64_t code = 0;
+
+      for (int j = 0; j < 3; ++j)
+        code |= SpreadBits(static_cast<std::uint64_t>((m_Points[id][j] - minimum[j]) * scale[j])) << j;
+
+      codes.emplace_back(code, id);
+    }
+
+    std::sort(codes.begin(), codes.end());
+
+    std::vector<vtkIdType> queue;
+    queue.reserve(partPoints.size());
+
+    const auto numSeeds = static_cast<std::size_t>(counts[k]);
+
+    for (std::size_t seed = 0; seed < numSeeds; ++seed)
+    {
+      const auto id = codes[(2 * seed + 1) * codes.size() / (2 * numSeeds)].second;
+      m_Clustering[id].store(firstClusters[k] + static_cast<int>(seed), std::memory_order_relaxed);
+      queue.push_back(id);
+    }
+
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+      const auto id = queue[head];
+      const auto cluster = m_Clustering[id].load(std::memory_order_relaxed);
+
+      for (auto i = m_AdjacencyOffsets[id]; i < m_AdjacencyOffsets[id + 1]; ++i)
+      {
+        const auto neighbor = m_Adjacency[i];
+
+        if (pointParts[neighbor] == static_cast<int>(k) && m_Clustering[neighbor].load(std::memory_order_relaxed) < 0)
+        {
+          m_Clustering[neighbor].store(cluster, std::memory_order_relaxed);
+          queue.push_back(neighbor);
+        }
+      }
+    }
+  });
+
+  // Points that could not be reached within their part (e.g. a part consisting of several pieces) join the clusters
+  // of neighboring parts. Connected components without any seed get a cluster of their own.
+  std::vector<vtkIdType> queue;
+  queue.reserve(numPoints);
+
+  for (vtkIdType id = 0; id < numPoints; ++id)
+  {
+    if (m_Clustering[id].load(std::memory_order_relaxed) >= 0)
+      queue.push_back(id);
+  }
+
+  std::size_t head = 0;
+
+  auto grow = [&]() {
+    for (; head < queue.size(); ++head)
+    {
+      const auto id = queue[head];
+      const auto cluster = m_Clustering[id].load(std::memory_order_relaxed);
+
+      for (auto i = m_AdjacencyOffsets[id]; i < m_AdjacencyOffsets[id + 1]; ++i)
+      {
+        const auto neighbor = m_Adjacency[i];
+
+        if (m_Clustering[neighbor].load(std::memory_order_relaxed) < 0)
+        {
+          m_Clustering[neighbor].store(cluster, std::memory_order_relaxed);
+          queue.push_back(neighbor);
+        }
+      }
+    }
+  };
+
+  grow();
+
+  for (int k = 0; k < numParts; ++k)
+  {
+    for (auto id : m_PartPoints[k])
+    {
+      if (m_Clustering[id].load(std::memory_order_relaxed) < 0)
+      {
+        m_Clustering[id].store(static_cast<int>(m_ClusterOwners.size()), std::memory_order_relaxed);
+        m_ClusterOwners.push_back(k);
+        queue.push_back(id);
+        grow();
+      }
+    }
+  }
+
+  const auto numClusters = m_ClusterOwners.size();
+  m_ClusterWeights.assign(numClusters, 0.0);
+  m_ClusterSums.assign(numClusters, { 0.0, 0.0, 0.0 });
+  m_ClusterSizes.assign(numClusters, 0);
+
+  for (vtkIdType id = 0; id < numPoints; ++id)
+  {
+    const auto cluster = m_Clustering[id].load(std::memory_order_relaxed);
+
+    if (cluster < 0)
+      continue;
+
+    m_ClusterWeights[cluster] += m_Weights[id];
+    ++m_ClusterSizes[cluster];
+
+    for (int j = 0; j < 3; ++j)
+      m_ClusterSums[cluster][j] += m_Weights[id] * m_Points[id][j];
+  }
+}
+
+void mitk::ParallelClustering::UpdatePartsFromOwners()
+{
+  for (auto& partPoints : m_PartPoints)
+    partPoints.clear();
+
+  const auto numPoints = static_cast<vtkIdType>(m_Points.size());
+
+  for (vtkIdType id = 0; id < numPoints; ++id)
+  {
+    const auto cluster = m_Clustering[id].load(std::memory_order_relaxed);
+
+    if (cluster >= 0)
+      m_PartPoints[m_ClusterOwners[cluster]].push_back(id);
+  }
+}
+
+bool mitk::ParallelClustering::IsRemovable(vtkIdType point, int cluster) const
+{
+  // The remaining neighbors in the cluster must be connected among each other to keep the cluster connected
+  thread_local std::vector<vtkIdType> neighbors;
+  thread_local std::vector<vtkIdType> queue;
+
+  neighbors.clear();
+
+  for (auto i = m_AdjacencyOffsets[point]; i < m_AdjacencyOffsets[point + 1]; ++i)
+  {
+    if (m_Clustering[m_Adjacency[i]].load(std::memory_order_relaxed) == cluster)
+      neighbors.push_back(m_Adjacency[i]);
+  }
+
+  if (neighbors.size() <= 1)
+    return true;
+
+  queue.assign(1, neighbors.back());
+  neighbors.pop_back();
+
+  for (std::size_t head = 0; head < queue.size() && !neighbors.empty(); ++head)
+  {
+    for (std::size_t i = 0; i < neighbors.size();)
+    {
+      if (this->AreAdjacent(queue[head], neighbors[i]))
+      {
+        queue.push_back(neighbors[i]);
+        neighbors[i] = neighbors.back();
+        neighbors.pop_back();
+      }
+      else
+      {
+        ++i;
+      }
+    }
+  }
+
+  return neighbors.empty();
+}
+
+bool mitk::ParallelClustering::Move(vtkIdType point, int owner)
+{
+  const auto cluster = m_Clustering[point].load(std::memory_order_relaxed);
+
+  if (cluster < 0 || (owner >= 0 && m_ClusterOwners[cluster] != owner) || m_ClusterSizes[cluster] <= 1)
+    return false;
+
+  const double weight = m_Weights[point];
+  const auto& position = m_Points[point];
+  const PointType weightedPosition = { weight * position[0], weight * position[1], weight * position[2] };
+
+  const double clusterWeight = m_ClusterWeights[cluster];
+
+  if (clusterWeight - weight <= 0.0)
+    return false;
+
+  const double term = ClusterTerm(m_ClusterSums[cluster], clusterWeight);
+  const double termWithout = ClusterTerm(Subtract(m_ClusterSums[cluster], weightedPosition), clusterWeight - weight);
+
+  int bestCluster = -1;
+  double bestGain = 0.0;
+  double bestThreshold = 0.0;
+
+  for (auto i = m_AdjacencyOffsets[point]; i < m_AdjacencyOffsets[point + 1]; ++i)
+  {
+    const auto neighborCluster = m_Clustering[m_Adjacency[i]].load(std::memory_order_relaxed);
+
+    if (neighborCluster == cluster || neighborCluster == bestCluster || neighborCluster < 0 ||
+        (owner >= 0 && m_ClusterOwners[neighborCluster] != owner))
+      continue;
+
+    const auto& sum = m_ClusterSums[neighborCluster];
+    const double neighborWeight = m_ClusterWeights[neighborCluster];
+    const double neighborTerm = ClusterTerm(sum, neighborWeight);
+    const PointType sumWith = { sum[0] + weightedPosition[0], sum[1] + weightedPosition[1], sum[2] + weightedPosition[2] };
+
+    const double gain = termWithout + ClusterTerm(sumWith, neighborWeight + weight) - term - neighborTerm;
+
+    if (gain > bestGain)
+    {
+      bestCluster = neighborCluster;
+      bestGain = gain;
+      bestThreshold = RelativeGainThreshold * (term + neighborTerm);
+    }
+  }
+
+  if (bestCluster < 0 || bestGain <= bestThreshold || !this->IsRemovable(point, cluster))
+    return false;
+
+  m_ClusterWeights[cluster] -= weight;
+  m_ClusterWeights[bestCluster] += weight;
+  --m_ClusterSizes[cluster];
+  ++m_ClusterSizes[bestCluster];
+
+  for (int j = 0; j < 3; ++j)
+  {
+    m_ClusterSums[cluster][j] -= weightedPosition[j];
+    m_ClusterSums[bestCluster][j] += weightedPosition[j];
+  }
+
+  m_Clustering[point].store(bestCluster, std::memory_order_relaxed);
+
+  // Revisit the neighborhood
+  m_Active[point] = 1;
+
+  for (auto i = m_AdjacencyOffsets[point]; i < m_AdjacencyOffsets[point + 1]; ++i)
+  {
+    const auto neighbor = m_Adjacency[i];
+
+    if (owner < 0 || m_ClusterOwners[m_Clustering[neighbor].load(std::memory_order_relaxed)] == owner)
+      m_Active[neighbor] = 1;
+  }
+
+  return true;
+}
+
+vtkIdType mitk::ParallelClustering::Sweep(const std::vector<vtkIdType>& ids, int owner, bool activeOnly)
+{
+  vtkIdType numMoves = 0;
+
+  for (auto id : ids)
+  {
+    if (activeOnly && !m_Active[id])
+      continue;
+
+    m_Active[id] = 0;
+
+    if (this->Move(id, owner))
+      ++numMoves;
+  }
+
+  return numMoves;
+}
+
+bool mitk::ParallelClustering::Cluster(int numberOfClusters, const ProgressCallback& progressCallback)
+{
+  std::vector<vtkIdType> ids;
+  ids.reserve(m_Points.size());
+
+  for (vtkIdType id = 0; id < static_cast<vtkIdType>(m_Points.size()); ++id)
+  {
+    if (m_AdjacencyOffsets[id + 1] > m_AdjacencyOffsets[id])
+      ids.push_back(id);
+  }
+
+  if (ids.empty())
+    mitkThrow() << "Cannot cluster a mesh without triangles!";
+
+  numberOfClusters = static_cast<int>(std::min<std::size_t>(std::max(numberOfClusters, 1), ids.size()));
+
+  const auto numThreads = m_NumberOfThreads != 0 ? m_NumberOfThreads : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const auto numParts = static_cast<int>(std::min<std::size_t>(numThreads, static_cast<std::size_t>(numberOfClusters)));
+
+  m_PartPoints.assign(numParts, std::vector<vtkIdType>());
+  this->Partition(ids, 0, ids.size(), 0, numParts);
+  this->Initialize(numberOfClusters, numParts);
+
+  m_Active.assign(m_Points.size(), 1);
+
+  std::vector<std::vector<vtkIdType>> borders(numParts);
+  std::vector<vtkIdType> numMoves(numParts);
+
+  for (unsigned int iteration = 0; iteration < m_MaximumNumberOfIterations; ++iteration)
+  {
+    this->UpdatePartsFromOwners();
+
+    // Every thread only moves points between its own clusters
+    ParallelizeArray(numParts, [&](unsigned int k) {
+      numMoves[k] = 0;
+
+      for (unsigned int sweep = 0; sweep < MaximumNumberOfSweeps; ++sweep)
+      {
+        const auto numSweepMoves = this->Sweep(m_PartPoints[k], static_cast<int>(k), iteration != 0);
+        numMoves[k] += numSweepMoves;
+
+        if (0 == numSweepMoves)
+          break;
+      }
+
+      // Collect the points at the borders to clusters of other threads
+      borders[k].clear();
+
+      for (auto id : m_PartPoints[k])
+      {
+        for (auto i = m_AdjacencyOffsets[id]; i < m_AdjacencyOffsets[id + 1]; ++i)
+        {
+          if (m_ClusterOwners[m_Clustering[m_Adjacency[i]].load(std::memory_order_relaxed)] != static_cast<int>(k))
+          {
+            borders[k].push_back(id);
+            break;
+          }
+        }
+      }
+    });
+
+    // Reconciliation of the borders between threads
+    auto numIterationMoves = std::accumulate(numMoves.begin(), numMoves.end(), vtkIdType(0));
+
+    for (const auto& border : borders)
+      numIterationMoves += this->Sweep(border, -1, false);
+
+    if (progressCallback && !progressCallback(static_cast<double>(iteration + 1) / m_MaximumNumberOfIterations))
+      return false;
+
+    if (0 == numIterationMoves)
+      break;
+  }
+
+  if (progressCallback)
+    progressCallback(1.0);
+
+  return true;
+}
+
+void mitk::ParallelClustering::BuildMesh(int optimizationLevel, std::vector<PointType>& points, std::vector<TriangleType>& triangles) const
+{
+  const auto clustering = this->GetClustering();
+  const auto numClusters = static_cast<std::size_t>(this->GetNumberOfClusters());
+  const auto numThreads = m_NumberOfThreads != 0 ? m_NumberOfThreads : itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const auto numTriangles = m_Triangles.size();
+
+  // Triangles whose vertices belong to three different clusters
+  std::vector<std::vector<TriangleType>> threadTriangles(numThreads);
+
+  ParallelizeArray(numThreads, [&](unsigned int thread) {
+    const auto begin = numTriangles * thread / numThreads;
+    const auto end = numTriangles * (thread + 1) / numThreads;
+
+    for (auto i = begin; i < end; ++i)
+    {
+      const auto& triangle = m_Triangles[i];
+      const TriangleType clusters = { clustering[triangle[0]], clustering[triangle[1]], clustering[triangle[2]] };
+
+      if (clusters[0] >= 0 && clusters[0] != clusters[1] && clusters[1] != clusters[2] && clusters[2] != clusters[0])
+        threadTriangles[thread].push_back(clusters);
+    }
+  });
+
+  std::vector<TriangleType> candidates;
+
+  for (const auto& candidatesOfThread : threadTriangles)
+    candidates.insert(candidates.end(), candidatesOfThread.begin(), candidatesOfThread.end());
+
+  // Keep the first triangle of each cluster triple
+  std::vector<TriangleType> keys(candidates);
+
+  for (auto& key : keys)
+    std::sort(key.begin(), key.end());
+
+  std::vector<std::size_t> order(candidates.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&keys](std::size_t a, std::size_t b) { return keys[a] < keys[b]; });
+
+  std::vector<std::size_t> unique;
+  unique.reserve(order.size());
+
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    if (0 == i || keys[order[i]] != keys[order[i - 1]])
+      unique.push_back(order[i]);
+  }
+
+  std::sort(unique.begin(), unique.end());
+
+  // Number the used clusters in the order of their first appearance
+  std::vector<vtkIdType> pointIds(numClusters, -1);
+  std::vector<int> clusters;
+  clusters.reserve(numClusters);
+
+  triangles.resize(unique.size());
+
+  for (std::size_t i = 0; i < unique.size(); ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      const auto cluster = candidates[unique[i]][j];
+
+      if (pointIds[cluster] < 0)
+      {
+        pointIds[cluster] = static_cast<vtkIdType>(clusters.size());
+        clusters.push_back(static_cast<int>(cluster));
+      }
+
+      triangles[i][j] = pointIds[cluster];
+    }
+  }
+
+  const auto numPoints = clusters.size();
+  points.resize(numPoints);
+
+  for (std::size_t i = 0; i < numPoints; ++i)
+  {
+    const auto& sum = m_ClusterSums[clusters[i]];
+    const double weight = m_ClusterWeights[clusters[i]];
+
+    for (int j = 0; j < 3; ++j)
+      points[i][j] = sum[j] / weight;
+  }
+
+  if (optimizationLevel > 0)
+  {
+    // Planes of the input triangles (unit normal, offset)
+    std::vector<std::array<double, 4>> planes(numTriangles);
+
+    ParallelizeArray(numThreads, [&](unsigned int thread) {
+      const auto begin = numTriangles * thread / numThreads;
+      const auto end = numTriangles * (thread + 1) / numThreads;
+
+      for (auto i = begin; i < end; ++i)
+      {
+        const auto& triangle = m_Triangles[i];
+        const auto& p0 = m_Points[triangle[0]];
+        auto normal = Cross(Subtract(m_Points[triangle[1]], p0), Subtract(m_Points[triangle[2]], p0));
+        const double length = std::sqrt(SquaredNorm(normal));
+
+        if (length > 0.0)
+        {
+          for (auto& coordinate : normal)
+            coordinate /= length;
+        }
+
+        planes[i] = { normal[0], normal[1], normal[2], normal[0] * p0[0] + normal[1] * p0[1] + normal[2] * p0[2] };
+      }
+    });
+
+    // Triangles of each point and points of each cluster in compressed row storage
+    std::vector<vtkIdType> triangleOffsets(m_Points.size() + 1, 0);
+
+    for (const auto& triangle : m_Triangles)
+    {
+      for (auto id : triangle)
+        ++triangleOffsets[id + 1];
+    }
+
+    std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+    std::vector<vtkIdType> pointTriangles(triangleOffsets.back());
+    std::vector<vtkIdType> positions(triangleOffsets.begin(), triangleOffsets.end() - 1);
+
+    for (std::size_t i = 0; i < numTriangles; ++i)
+    {
+      for (auto id : m_Triangles[i])
+        pointTriangles[positions[id]++] = static_cast<vtkIdType>(i);
+    }
+
+    std::vector<vtkIdType> clusterOffsets(numClusters + 1, 0);
+
+    for (auto cluster : clustering)
+    {
+      if (cluster >= 0)
+        ++clusterOffsets[cluster + 1];
+    }
+
+    std::partial_sum(clusterOffsets.begin(), clusterOffsets.end(), clusterOffsets.begin());
+    std::vector<vtkIdType> clusterPoints(clusterOffsets.back());
+    positions.assign(clusterOffsets.begin(), clusterOffsets.end() - 1);
+
+    for (std::size_t id = 0; id < clustering.size(); ++id)
+    {
+      if (clustering[id] >= 0)
+        clusterPoints[positions[clustering[id]]++] = static_cast<vtkIdType>(id);
+    }
+
+    // Minimize the quadric error along the principal directions with the largest eigenvalues, starting at the
+    // centroid. Like in ACVD, the triangles of a point contribute to its cluster once per point.
+    const auto maximumNumberOfDirections = static_cast<unsigned int>(std::min(optimizationLevel, 3));
+
+    ParallelizeArray(numThreads, [&](unsigned int thread) {
+      vnl_matrix<double> quadric(3, 3);
+      vnl_vector<double> offset(3);
+
+      for (auto i = thread; i < numPoints; i += numThreads)
+      {
+        const auto cluster = clusters[i];
+
+        quadric.fill(0.0);
+        offset.fill(0.0);
+
+        for (auto j = clusterOffsets[cluster]; j < clusterOffsets[cluster + 1]; ++j)
+        {
+          const auto id = clusterPoints[j];
+
+          for (auto k = triangleOffsets[id]; k < triangleOffsets[id + 1]; ++k)
+          {
+            const auto& plane = planes[pointTriangles[k]];
+
+            for (unsigned int r = 0; r < 3; ++r)
+            {
+              for (unsigned int c = 0; c < 3; ++c)
+                quadric(r, c) += plane[r] * plane[c];
+
+              offset[r] += plane[3] * plane[r];
+            }
+          }
+        }
+
+        vnl_vector<double> centroid(points[i].data(), 3);
+        const vnl_vector<double> residual = offset - quadric * centroid;
+        const vnl_symmetric_eigensystem<double> eigensystem(quadric);
+        const double largestEigenvalue = eigensystem.get_eigenvalue(2);
+
+        for (unsigned int direction = 0; direction < maximumNumberOfDirections; ++direction)
+        {
+          const double eigenvalue = eigensystem.get_eigenvalue(2 - direction);
+
+          if (eigenvalue <= 1e-6 * largestEigenvalue || eigenvalue <= 0.0)
+            break;
+
+          const auto eigenvector = eigensystem.get_eigenvector(2 - direction);
+          centroid += (dot_product(eigenvector, residual) / eigenvalue) * eigenvector;
+        }
+
+        for (int j = 0; j < 3; ++j)
+          points[i][j] = centroid[j];
+      }
+    });
+  }
+
+  for (auto& point : points)
+  {
+    for (int j = 0; j < 3; ++j)
+      point[j] += m_Center[j];
+  }
+}
@@ -0,0 +1,121 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkParallelClustering_h
+#define mitkParallelClustering_h
+
+#include <vtkType.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace mitk
+{
+  /** \brief Approximated centroidal Voronoi clustering of the vertices of a triangle mesh using multiple threads.
+   *
+   * Implements the greedy energy minimization of Valette and Chassery that %ACVD is based on: Vertices at cluster
+   * borders are moved to neighboring clusters as long as this decreases the clustering energy and the clusters
+   * remain connected.
+   *
+   * To run without locks, the mesh is split into one spatially compact region per thread by recursive bisection
+   * and every region gets a share of the clusters that is proportional to its area. Each cluster is owned by a
+   * single thread, which is the only one that moves vertices between its clusters. Moves between clusters of
+   * different threads are applied afterwards in a serial reconciliation pass. Both steps are repeated until the
+   * clustering converges.
+   *
+   * Internal helper of mitk::Remesh().
+   */
+  class ParallelClustering
+  {
+  public:
+    using PointType = std::array<double, 3>;
+    using TriangleType = std::array<vtkIdType, 3>;
+
+    /** Receives the progress between 0 and 1. Returning false cancels the clustering.*/
+    using ProgressCallback = std::function<bool(double)>;
+
+    /** \param densities Optional relative density per point, empty for uniform clustering. Points are weighted
+     *  by their area times their density, i.e. clusters are smaller in regions of higher density.*/
+    ParallelClustering(const std::vector<PointType> &points,
+                       const std::vector<TriangleType> &triangles,
+                       const std::vector<double> &densities);
+
+    ParallelClustering(const ParallelClustering &) = delete;
+    ParallelClustering &operator=(const ParallelClustering &) = delete;
+
+    /** Number of threads and spatial regions. 0 (default) uses the global default number of threads of itk::MultiThreaderBase.*/
+    void SetNumberOfThreads(unsigned int numberOfThreads);
+    unsigned int GetNumberOfThreads() const;
+
+    /** Maximum number of parallel optimizations followed by a reconciliation. Default is 100.*/
+    void SetMaximumNumberOfIterations(unsigned int maximumNumberOfIterations);
+    unsigned int GetMaximumNumberOfIterations() const;
+
+    /** \return False if cancelled by the progress callback.*/
+    bool Cluster(int numberOfClusters, const ProgressCallback &progressCallback = nullptr);
+
+    /** Cluster of each point, -1 for points that are not part of any triangle.*/
+    std::vector<int> GetClustering() const;
+
+    /** Number of clusters. May exceed the requested number by one per connected mesh component without seed.*/
+    int GetNumberOfClusters() const;
+
+    /** \brief Creates the remeshed surface.
+     *
+     * Every cluster becomes a vertex and every input triangle with vertices in three different clusters becomes
+     * a triangle (once per cluster triple, with the orientation of the input). Unused clusters are dropped.
+     *
+     * \param optimizationLevel 0 places the vertices at the cluster centroids. Otherwise, the vertices are moved
+     * towards the input surface by minimizing the quadric error of the triangles of the cluster along the given
+     * number of principal directions (see vtkQuadricTools::ComputeRepresentativePoint()).
+     */
+    void BuildMesh(int optimizationLevel, std::vector<PointType> &points, std::vector<TriangleType> &triangles) const;
+
+  private:
+    void Partition(std::vector<vtkIdType> &ids, std::size_t begin, std::size_t end, int firstPart, int numParts);
+    void Initialize(int numberOfClusters, int numParts);
+    void UpdatePartsFromOwners();
+    vtkIdType Sweep(const std::vector<vtkIdType> &ids, int owner, bool activeOnly);
+    bool Move(vtkIdType point, int owner);
+    bool IsRemovable(vtkIdType point, int cluster) const;
+    bool AreAdjacent(vtkIdType point1, vtkIdType point2) const;
+
+    unsigned int m_NumberOfThreads;
+    unsigned int m_MaximumNumberOfIterations;
+
+    PointType m_Center;
+    std::vector<PointType> m_Points; // Relative to m_Center for numerical accuracy
+    std::vector<TriangleType> m_Triangles;
+    std::vector<double> m_Weights;
+
+    // Sorted neighbors of each point in compressed row storage
+    std::vector<vtkIdType> m_AdjacencyOffsets;
+    std::vector<vtkIdType> m_Adjacency;
+
+    std::vector<std::atomic<int>> m_Clustering;
+
+    // Points whose neighborhood changed since they were visited last. During the parallel optimization, threads only
+    // write the flags of points in their own clusters.
+    std::vector<char> m_Active;
+
+    std::vector<std::vector<vtkIdType>> m_PartPoints;
+
+    std::vector<int> m_ClusterOwners;
+    std::vector<double> m_ClusterWeights;
+    std::vector<PointType> m_ClusterSums;
+    std::vector<vtkIdType> m_ClusterSizes;
+  };
+}
+
+#endif
@@ -12,17 +12,29 @@ found in the LICENSE file.
 
 #include <mitkRemeshing.h>
 #include <mitkExceptionMacro.h>
+#include "mitkParallelClustering.h"
 
-#include <vtkIdList.h>
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkFloatArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkIntArray.h>
 #include <vtkIsotropicDiscreteRemeshing.h>
+#include <vtkLinearSubdivisionFilter.h>
 #include <vtkMultiThreader.h>
+#include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPolyData.h>
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 #include <vtkSurface.h>
+#include <vtkTriangleFilter.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cmath>
+#include <ostream>
 #include <vector>
 
 namespace
@@ -62,6 +74,405 @@ namespace
     if (polyData->GetNumberOfPolys() == 0)
       mitkThrow() << "Input surface has no polygons at time step " << t << "!";
   }
+
+  bool ReportProgress(const mitk::RemeshingProgressCallback& progressCallback, double progress)
+  {
+    return !progressCallback || progressCallback(progress);
+  }
+
+  using PointType = mitk::ParallelClustering::PointType;
+  using TriangleType = mitk::ParallelClustering::TriangleType;
+
+  void ExtractTriangles(vtkPolyData* polyData, std::vector<PointType>& points, std::vector<TriangleType>& triangles)
+  {
+    const auto numPoints = polyData->GetNumberOfPoints();
+    points.resize(numPoints);
+
+    for (vtkIdType i = 0; i < numPoints; ++i)
+      polyData->GetPoint(i, points[i].data());
+
+    triangles.clear();
+    triangles.reserve(polyData->GetNumberOfPolys());
+
+    auto* polys = polyData->GetPolys();
+    vtkIdType numCellPoints;
+    const vtkIdType* cellPoints;
+
+    for (polys->InitTraversal(); polys->GetNextCell(numCellPoints, cellPoints);)
+    {
+      if (numCellPoints == 3)
+        triangles.push_back({ cellPoints[0], cellPoints[1], cellPoints[2] });
+    }
+  }
+
+  /** \brief Estimates the absolute curvature of each point.
+   *
+   * Averages the normal curvatures 2 |n * e| / |e|^2 along the edges e of a point with the area weighted point
+   * normal n.
+   */
+  std::vector<double> ComputeCurvatures(const std::vector<PointType>& points, const std::vector<TriangleType>& triangles)
+  {
+    std::vector<PointType> normals(points.size(), PointType{ 0.0, 0.0, 0.0 });
+
+    for (const auto& triangle : triangles)
+    {
+      const auto& p0 = points[triangle[0]];
+      const auto& p1 = points[triangle[1]];
+      const auto& p2 = points[triangle[2]];
+
+      const PointType u = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+      const PointType v = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+      const PointType normal = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+
+      for (auto id : triangle)
+      {
+        for (int i = 0; i < 3; ++i)
+          normals[id][i] += normal[i];
+      }
+    }
+
+    for (auto& normal : normals)
+    {
+      const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+      if (length > 0.0)
+      {
+        for (auto& coordinate : normal)
+          coordinate /= length;
+      }
+    }
+
+    std::vector<double> curvatures(points.size(), 0.0);
+    std::vector<int> counts(points.size(), 0);
+
+    for (const auto& triangle : triangles)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        const auto a = triangle[i];
+        const auto b = triangle[(i + 1) % 3];
+        const PointType edge = { points[b][0] - points[a][0], points[b][1] - points[a][1], points[b][2] - points[a][2] };
+        const double squaredLength = edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2];
+
+        if (squaredLength <= 0.0)
+          continue;
+
+        curvatures[a] += 2.0 * std::abs(normals[a][0] * edge[0] + normals[a][1] * edge[1] + normals[a][2] * edge[2]) / squaredLength;
+        curvatures[b] += 2.0 * std::abs(normals[b][0] * edge[0] + normals[b][1] * edge[1] + normals[b][2] * edge[2]) / squaredLength;
+        ++counts[a];
+        ++counts[b];
+      }
+    }
+
+    for (std::size_t i = 0; i < curvatures.size(); ++i)
+    {
+      if (counts[i] != 0)
+        curvatures[i] /= counts[i];
+    }
+
+    return curvatures;
+  }
+
+  /** \brief Converts curvatures into clustering densities (curvature relative to the mean curvature to the power of
+   * gradation), i.e. clusters become smaller in curved regions.
+   */
+  void ConvertCurvaturesToDensities(std::vector<double>& curvatures, double gradation)
+  {
+    double meanCurvature = 0.0;
+
+    for (auto curvature : curvatures)
+      meanCurvature += curvature;
+
+    meanCurvature /= std::max<std::size_t>(curvatures.size(), 1);
+
+    for (auto& curvature : curvatures)
+    {
+      const double relativeCurvature = meanCurvature > 0.0 ? curvature / meanCurvature : 1.0;
+      curvature = std::pow(std::clamp(relativeCurvature, 0.1, 10.0), gradation);
+    }
+  }
+
+  /** \brief Creates a poly data from triangles without any per cell loops of VTK.
+   *
+   * Point normals are accumulated from the triangles, as their orientation is consistent by construction.
+   */
+  vtkSmartPointer<vtkPolyData> CreatePolyData(const std::vector<PointType>& points, const std::vector<TriangleType>& triangles)
+  {
+    const auto numPoints = static_cast<vtkIdType>(points.size());
+    const auto numTriangles = static_cast<vtkIdType>(triangles.size());
+
+    auto coordinates = vtkSmartPointer<vtkDoubleArray>::New();
+    coordinates->SetNumberOfComponents(3);
+    coordinates->SetNumberOfTuples(numPoints);
+    auto* coordinatesPointer = coordinates->GetPointer(0);
+
+    for (vtkIdType i = 0; i < numPoints; ++i)
+      std::copy(points[i].begin(), points[i].end(), coordinatesPointer + 3 * i);
+
+    auto connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivity->SetNumberOfValues(3 * numTriangles);
+    auto* connectivityPointer = connectivity->GetPointer(0);
+
+    std::vector<PointType> normals(points.size(), PointType{ 0.0, 0.0, 0.0 });
+
+    for (vtkIdType i = 0; i < numTriangles; ++i)
+    {
+      const auto& triangle = triangles[i];
+      std::copy(triangle.begin(), triangle.end(), connectivityPointer + 3 * i);
+
+      const auto& p0 = points[triangle[0]];
+      const auto& p1 = points[triangle[1]];
+      const auto& p2 = points[triangle[2]];
+
+      const PointType u = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+      const PointType v = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+      const PointType normal = { u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0] };
+
+      for (auto id : triangle)
+      {
+        for (int j = 0; j < 3; ++j)
+          normals[id][j] += normal[j];
+      }
+    }
+
+    auto normalArray = vtkSmartPointer<vtkFloatArray>::New();
+    normalArray->SetName("Normals");
+    normalArray->SetNumberOfComponents(3);
+    normalArray->SetNumberOfTuples(numPoints);
+    auto* normalPointer = normalArray->GetPointer(0);
+
+    for (vtkIdType i = 0; i < numPoints; ++i)
+    {
+      const auto& normal = normals[i];
+      const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+      for (int j = 0; j < 3; ++j)
+        normalPointer[3 * i + j] = length > 0.0 ? static_cast<float>(normal[j] / length) : 0.0f;
+    }
+
+    auto vtkpoints = vtkSmartPointer<vtkPoints>::New();
+    vtkpoints->SetData(coordinates);
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetData(3, connectivity);
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(vtkpoints);
+    polyData->SetPolys(polys);
+    polyData->GetPointData()->SetNormals(normalArray);
+
+    return polyData;
+  }
+
+  /** \brief The %ACVD remeshing, see mitk::Remesh().
+   *
+   * %ACVD does not report the progress of its clustering and cannot be interrupted. The callback is polled after it.
+   */
+  vtkSmartPointer<vtkPolyData> RemeshSerially(vtkSurface* mesh,
+                                              int numVertices,
+                                              double gradation,
+                                              int subsampling,
+                                              int optimizationLevel,
+                                              bool forceManifold,
+                                              bool boundaryFixing,
+                                              const mitk::RemeshingProgressCallback& progressCallback)
+  {
+    auto remesher = vtkSmartPointer<vtkIsotropicDiscreteRemeshing>::New();
+
+    remesher->GetMetric()->SetGradation(gradation);
+    remesher->SetBoundaryFixing(boundaryFixing);
+    remesher->SetConsoleOutput(1);
+    remesher->SetForceManifold(forceManifold);
+    remesher->SetInput(mesh);
+    remesher->SetNumberOfClusters(numVertices);
+    remesher->SetSubsamplingThreshold(subsampling);
+
+    remesher->Remesh();
+
+    if (!ReportProgress(progressCallback, 0.8))
+      return nullptr;
+
+    // Optimization: Minimize distance between input surface and remeshed surface
+    if (optimizationLevel != 0)
+    {
+      ClustersQuadrics clustersQuadrics(numVertices);
+
+      vtkSmartPointer<vtkIntArray> clustering = remesher->GetClustering();
+      vtkSmartPointer<vtkSurface> remesherInput = remesher->GetInput();
+      int clusteringType = remesher->GetClusteringType();
+      int numItems = remesher->GetNumberOfItems();
+      int numMisclassifiedItems = 0;
+
+      for (int i = 0; i < numItems; ++i)
+      {
+        int cluster = clustering->GetValue(i);
+
+        if (cluster < 0 || cluster >= numVertices)
+        {
+          ++numMisclassifiedItems;
+        }
+        else if (clusteringType == 0)
+        {
+          vtkQuadricTools::AddTriangleQuadric(clustersQuadrics.Elements[cluster].data(), remesherInput, i, false);
+        }
+      }
+
+      // Vertex clustering: The quadric of each face is added to the clusters of its vertices. Computing it once per
+      // face is equivalent to adding the quadrics of the neighbor faces of every vertex.
+      if (clusteringType != 0)
+      {
+        const vtkIdType numFaces = remesherInput->GetNumberOfCells();
+        std::array<double, 9> faceQuadric;
+
+        for (vtkIdType face = 0; face < numFaces; ++face)
+        {
+          std::array<vtkIdType, 3> vertices;
+          remesherInput->GetFaceVertices(face, vertices[0], vertices[1], vertices[2]);
+
+          faceQuadric.fill(0.0);
+          vtkQuadricTools::AddTriangleQuadric(faceQuadric.data(), remesherInput, face, false);
+
+          for (auto vertex : vertices)
+          {
+            int cluster = clustering->GetValue(vertex);
+
+            if (cluster < 0 || cluster >= numVertices)
+              continue;
+
+            auto& clusterQuadric = clustersQuadrics.Elements[cluster];
+
+            for (std::size_t j = 0; j < faceQuadric.size(); ++j)
+              clusterQuadric[j] += faceQuadric[j];
+          }
+        }
+      }
+
+      if (numMisclassifiedItems != 0)
+        MITK_INFO << numMisclassifiedItems << " items with wrong cluster association" << std::endl;
+
+      vtkSmartPointer<vtkSurface> remesherOutput = remesher->GetOutput();
+      double point[3];
+
+      for (int i = 0; i < numVertices; ++i)
+      {
+        remesherOutput->GetPoint(i, point);
+        vtkQuadricTools::ComputeRepresentativePoint(clustersQuadrics.Elements[i].data(), point, optimizationLevel);
+        remesherOutput->SetPointCoordinates(i, point);
+      }
+
+      MITK_INFO << "After quadrics post-processing:" << std::endl;
+      remesherOutput->DisplayMeshProperties();
+    }
+
+    if (!ReportProgress(progressCallback, 0.9))
+      return nullptr;
+
+    auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+
+    normals->SetInputData(remesher->GetOutput());
+    normals->AutoOrientNormalsOn();
+    normals->ComputeCellNormalsOff();
+    normals->ComputePointNormalsOn();
+    normals->ConsistencyOff();
+    normals->FlipNormalsOff();
+    normals->NonManifoldTraversalOff();
+    normals->SplittingOff();
+
+    normals->Update();
+
+    return normals->GetOutput();
+  }
+
+  /** \brief Remeshing by mitk::ParallelClustering, see mitk::Remesh().
+   */
+  vtkSmartPointer<vtkPolyData> RemeshInParallel(vtkSurface* mesh,
+                                                int numVertices,
+                                                double gradation,
+                                                int subsampling,
+                                                int optimizationLevel,
+                                                unsigned int numberOfThreads,
+                                                const mitk::RemeshingProgressCallback& progressCallback)
+  {
+    auto triangleFilter = vtkSmartPointer<vtkTriangleFilter>::New();
+    triangleFilter->SetInputData(mesh);
+    triangleFilter->PassVertsOff();
+    triangleFilter->PassLinesOff();
+    triangleFilter->Update();
+
+    vtkSmartPointer<vtkPolyData> polyData = triangleFilter->GetOutput();
+    polyData->GetPointData()->Initialize();
+
+    std::vector<PointType> points;
+    std::vector<TriangleType> triangles;
+
+    // Curvatures are estimated before the subsampling, which interpolates them linearly
+    if (gradation != 0.0)
+    {
+      ExtractTriangles(polyData, points, triangles);
+      const auto curvatures = ComputeCurvatures(points, triangles);
+
+      auto curvatureArray = vtkSmartPointer<vtkDoubleArray>::New();
+      curvatureArray->SetName("Curvature");
+      curvatureArray->SetNumberOfValues(static_cast<vtkIdType>(curvatures.size()));
+      std::copy(curvatures.begin(), curvatures.end(), curvatureArray->GetPointer(0));
+
+      polyData->GetPointData()->AddArray(curvatureArray);
+    }
+
+    const auto minimumNumberOfPoints = static_cast<vtkIdType>(subsampling) * numVertices;
+
+    while (polyData->GetNumberOfPoints() < minimumNumberOfPoints)
+    {
+      auto subdivision = vtkSmartPointer<vtkLinearSubdivisionFilter>::New();
+      subdivision->SetInputData(polyData);
+      subdivision->SetNumberOfSubdivisions(1);
+      subdivision->Update();
+
+      if (subdivision->GetOutput()->GetNumberOfPoints() <= polyData->GetNumberOfPoints())
+        break;
+
+      polyData = subdivision->GetOutput();
+    }
+
+    MITK_INFO << "Clustering " << polyData->GetNumberOfPoints() << " points into " << numVertices << " clusters...";
+
+    if (!ReportProgress(progressCallback, 0.2))
+      return nullptr;
+
+    ExtractTriangles(polyData, points, triangles);
+
+    std::vector<double> densities;
+
+    if (gradation != 0.0)
+    {
+      auto* curvatureArray = vtkDoubleArray::SafeDownCast(polyData->GetPointData()->GetArray("Curvature"));
+
+      if (curvatureArray != nullptr)
+      {
+        densities.assign(curvatureArray->GetPointer(0), curvatureArray->GetPointer(0) + curvatureArray->GetNumberOfValues());
+        ConvertCurvaturesToDensities(densities, gradation);
+      }
+    }
+
+    mitk::ParallelClustering clustering(points, triangles, densities);
+    clustering.SetNumberOfThreads(numberOfThreads);
+
+    mitk::ParallelClustering::ProgressCallback clusteringProgressCallback;
+
+    if (progressCallback)
+    {
+      clusteringProgressCallback = [&progressCallback](double progress) {
+        return progressCallback(0.2 + 0.7 * progress);
+      };
+    }
+
+    if (!clustering.Cluster(numVertices, clusteringProgressCallback))
+      return nullptr;
+
+    clustering.BuildMesh(optimizationLevel, points, triangles);
+
+    return CreatePolyData(points, triangles);
+  }
 }
 
 mitk::Surface::Pointer mitk::Remesh(const Surface* surface,
@@ -72,12 +483,20 @@ mitk::Surface::Pointer mitk::Remesh(const Surface* surface,
                                     double edgeSplitting,
                                     int optimizationLevel,
                                     bool forceManifold,
-                                    bool boundaryFixing)
+                                    bool boundaryFixing,
+                                    unsigned int numberOfThreads,
+                                    const RemeshingProgressCallback& progressCallback,
+                                    RemeshingQuality* quality)
 {
   ValidateSurface(surface, t);
 
   MITK_INFO << "Start remeshing...";
 
+  const auto start = std::chrono::steady_clock::now();
+
+  if (!ReportProgress(progressCallback, 0.0))
+    return nullptr;
+
   auto surfacePolyData = vtkSmartPointer<vtkPolyData>::New();
   surfacePolyData->DeepCopy(const_cast<Surface *>(surface)->GetVtkPolyData(t));
 
@@ -95,91 +514,177 @@ mitk::Surface::Pointer mitk::Remesh(const Surface* surface,
   if (edgeSplitting != 0.0)
     mesh->SplitLongEdges(edgeSplitting);
 
-  auto remesher = vtkSmartPointer<vtkIsotropicDiscreteRemeshing>::New();
+  if (!ReportProgress(progressCallback, 0.05))
+    return nullptr;
 
-  remesher->GetMetric()->SetGradation(gradation);
-  remesher->SetBoundaryFixing(boundaryFixing);
-  remesher->SetConsoleOutput(1);
-  remesher->SetForceManifold(forceManifold);
-  remesher->SetInput(mesh);
-  remesher->SetNumberOfClusters(numVertices);
-  remesher->SetSubsamplingThreshold(subsampling);
+  vtkSmartPointer<vtkPolyData> remeshedPolyData;
 
-  remesher->Remesh();
+  if (numberOfThreads != 1 && !forceManifold && !boundaryFixing)
+  {
+    remeshedPolyData = RemeshInParallel(mesh, numVertices, gradation, subsampling, optimizationLevel, numberOfThreads, progressCallback);
+  }
+  else
+  {
+    if (numberOfThreads != 1)
+      MITK_INFO << "Forcing manifolds and boundary fixing require serial remeshing.";
 
-  // Optimization: Minimize distance between input surface and remeshed surface
-  if (optimizationLevel != 0)
+    remeshedPolyData = RemeshSerially(mesh, numVertices, gradation, subsampling, optimizationLevel, forceManifold, boundaryFixing, progressCallback);
+  }
+
+  if (remeshedPolyData == nullptr)
   {
-    ClustersQuadrics clustersQuadrics(numVertices);
+    MITK_INFO << "Remeshing was cancelled";
+    return nullptr;
+  }
 
-    auto faceList = vtkSmartPointer<vtkIdList>::New();
-    vtkSmartPointer<vtkIntArray> clustering = remesher->GetClustering();
-    vtkSmartPointer<vtkSurface> remesherInput = remesher->GetInput();
-    int clusteringType = remesher->GetClusteringType();
-    int numItems = remesher->GetNumberOfItems();
-    int numMisclassifiedItems = 0;
+  auto remeshedSurface = Surface::New();
+  remeshedSurface->SetVtkPolyData(remeshedPolyData);
 
-    for (int i = 0; i < numItems; ++i)
-    {
-      int cluster = clustering->GetValue(i);
+  auto remeshingQuality = ComputeRemeshingQuality(remeshedPolyData);
+  remeshingQuality.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 
-      if (cluster >= 0 && cluster < numVertices)
-      {
-        if (clusteringType != 0)
-        {
-          remesherInput->GetVertexNeighbourFaces(i, faceList);
-          int numIds = static_cast<int>(faceList->GetNumberOfIds());
+  MITK_INFO << "Finished remeshing: " << remeshingQuality;
 
-          for (int j = 0; j < numIds; ++j)
-            vtkQuadricTools::AddTriangleQuadric(clustersQuadrics.Elements[cluster].data(), remesherInput, faceList->GetId(j), false);
-        }
-        else
-        {
-          vtkQuadricTools::AddTriangleQuadric(clustersQuadrics.Elements[cluster].data(), remesherInput, i, false);
-        }
-      }
-      else
-      {
-        ++numMisclassifiedItems;
-      }
+  if (quality != nullptr)
+    *quality = remeshingQuality;
+
+  ReportProgress(progressCallback, 1.0);
+
+  return remeshedSurface;
+}
+
+mitk::RemeshingQuality mitk::ComputeRemeshingQuality(vtkPolyData* polyData)
+{
+  RemeshingQuality quality;
+
+  if (polyData == nullptr)
+    return quality;
+
+  quality.NumberOfVertices = polyData->GetNumberOfPoints();
+  quality.MinimumAngle = 180.0;
+  quality.MinimumRadiusRatio = 1.0;
+
+  const double radiansToDegrees = 45.0 / std::atan(1.0);
+  std::vector<std::pair<vtkIdType, vtkIdType>> edges;
+  edges.reserve(3 * polyData->GetNumberOfPolys());
+
+  auto* polys = polyData->GetPolys();
+  vtkIdType numCellPoints;
+  const vtkIdType* cellPoints;
+
+  for (polys->InitTraversal(); polys->GetNextCell(numCellPoints, cellPoints);)
+  {
+    if (numCellPoints != 3)
+      continue;
+
+    std::array<std::array<double, 3>, 3> points;
+    std::array<double, 3> lengths;
+
+    for (int i = 0; i < 3; ++i)
+      polyData->GetPoint(cellPoints[i], points[i].data());
+
+    // Length of the edge opposite to each point
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto& p1 = points[(i + 1) % 3];
+      const auto& p2 = points[(i + 2) % 3];
+      lengths[i] = std::sqrt((p2[0] - p1[0]) * (p2[0] - p1[0]) + (p2[1] - p1[1]) * (p2[1] - p1[1]) + (p2[2] - p1[2]) * (p2[2] - p1[2]));
+
+      edges.emplace_back(std::min(cellPoints[(i + 1) % 3], cellPoints[(i + 2) % 3]), std::max(cellPoints[(i + 1) % 3], cellPoints[(i + 2) % 3]));
     }
 
-    if (numMisclassifiedItems != 0)
-      MITK_INFO << numMisclassifiedItems << " items with wrong cluster association" << std::endl;
+    const double a = lengths[0];
+    const double b = lengths[1];
+    const double c = lengths[2];
+    const double product = a * b * c;
 
-    vtkSmartPointer<vtkSurface> remesherOutput = remesher->GetOutput();
-    double point[3];
+    double minimumAngle = 0.0;
+    double radiusRatio = 0.0;
 
-    for (int i = 0; i < numVertices; ++i)
+    if (product > 0.0)
     {
-      remesherOutput->GetPoint(i, point);
-      vtkQuadricTools::ComputeRepresentativePoint(clustersQuadrics.Elements[i].data(), point, optimizationLevel);
-      remesherOutput->SetPointCoordinates(i, point);
+      // Law of cosines, the smallest angle is opposite to the shortest edge
+      const double shortest = std::min({ a, b, c });
+      const double cosine = (a * a + b * b + c * c - 2.0 * shortest * shortest) / (2.0 * product / shortest);
+      minimumAngle = std::acos(std::clamp(cosine, -1.0, 1.0)) * radiansToDegrees;
+      radiusRatio = std::max(0.0, (b + c - a) * (c + a - b) * (a + b - c) / product);
+
+      const double s = 0.5 * (a + b + c);
+      quality.Area += std::sqrt(std::max(0.0, s * (s - a) * (s - b) * (s - c)));
     }
 
-    MITK_INFO << "After quadrics post-processing:" << std::endl;
-    remesherOutput->DisplayMeshProperties();
+    quality.MinimumAngle = std::min(quality.MinimumAngle, minimumAngle);
+    quality.MeanMinimumAngle += minimumAngle;
+    quality.MinimumRadiusRatio = std::min(quality.MinimumRadiusRatio, radiusRatio);
+    quality.MeanRadiusRatio += radiusRatio;
+    ++quality.NumberOfTriangles;
+  }
+
+  if (quality.NumberOfTriangles == 0)
+  {
+    quality.MinimumAngle = 0.0;
+    quality.MinimumRadiusRatio = 0.0;
+    return quality;
   }
 
-  auto normals = vtkSmartPointer<vtkPolyDataNormals>::New();
+  quality.MeanMinimumAngle /= quality.NumberOfTriangles;
+  quality.MeanRadiusRatio /= quality.NumberOfTriangles;
 
-  normals->SetInputData(remesher->GetOutput());
-  normals->AutoOrientNormalsOn();
-  normals->ComputeCellNormalsOff();
-  normals->ComputePointNormalsOn();
-  normals->ConsistencyOff();
-  normals->FlipNormalsOff();
-  normals->NonManifoldTraversalOff();
-  normals->SplittingOff();
+  // Edges of one triangle are boundary edges, edges of more than two triangles are non-manifold
+  std::sort(edges.begin(), edges.end());
 
-  normals->Update();
+  double sum = 0.0;
+  double squaredSum = 0.0;
+  vtkIdType numEdges = 0;
 
-  auto remeshedSurface = Surface::New();
-  remeshedSurface->SetVtkPolyData(normals->GetOutput());
+  for (std::size_t i = 0; i < edges.size();)
+  {
+    auto j = i + 1;
 
-  MITK_INFO << "Finished remeshing";
+    while (j < edges.size() && edges[j] == edges[i])
+      ++j;
 
-  return remeshedSurface;
+    if (j - i == 1)
+    {
+      ++quality.NumberOfBoundaryEdges;
+    }
+    else if (j - i > 2)
+    {
+      ++quality.NumberOfNonManifoldEdges;
+    }
+
+    std::array<double, 3> p1, p2;
+    polyData->GetPoint(edges[i].first, p1.data());
+    polyData->GetPoint(edges[i].second, p2.data());
+
+    const double length = std::sqrt((p2[0] - p1[0]) * (p2[0] - p1[0]) + (p2[1] - p1[1]) * (p2[1] - p1[1]) + (p2[2] - p1[2]) * (p2[2] - p1[2]));
+    sum += length;
+    squaredSum += length * length;
+    ++numEdges;
+
+    i = j;
+  }
+
+  quality.MeanEdgeLength = sum / numEdges;
+
+  if (quality.MeanEdgeLength > 0.0)
+  {
+    const double variance = std::max(0.0, squaredSum / numEdges - quality.MeanEdgeLength * quality.MeanEdgeLength);
+    quality.EdgeLengthDeviation = std::sqrt(variance) / quality.MeanEdgeLength;
+  }
+
+  return quality;
+}
+
+std::ostream& mitk::operator<<(std::ostream& os, const RemeshingQuality& quality)
+{
+  os << quality.NumberOfVertices << " vertices, " << quality.NumberOfTriangles << " triangles, area " << quality.Area
+     << ", minimum angle " << quality.MinimumAngle << " (mean " << quality.MeanMinimumAngle << "), radius ratio "
+     << quality.MinimumRadiusRatio << " (mean " << quality.MeanRadiusRatio << "), edge length " << quality.MeanEdgeLength
+     << " (relative deviation " << quality.EdgeLengthDeviation << "), " << quality.NumberOfBoundaryEdges
+     << " boundary edges, " << quality.NumberOfNonManifoldEdges << " non-manifold edges, " << quality.Seconds << " s";
+
+  return os;
 }
 
 mitk::RemeshFilter::RemeshFilter()
@@ -190,7 +695,8 @@ mitk::RemeshFilter::RemeshFilter()
     m_EdgeSplitting(0.0),
     m_OptimizationLevel(1),
     m_ForceManifold(false),
-    m_BoundaryFixing(false)
+    m_BoundaryFixing(false),
+    m_NumberOfThreads(1)
 {
   Surface::Pointer output = Surface::New();
   this->SetNthOutput(0, output);
@@ -202,6 +708,11 @@ mitk::RemeshFilter::~RemeshFilter()
 
 void mitk::RemeshFilter::GenerateData()
 {
+  auto progressCallback = [this](double progress) {
+    this->UpdateProgress(static_cast<float>(progress));
+    return !this->GetAbortGenerateData();
+  };
+
   auto output = Remesh(this->GetInput(),
                        m_TimeStep,
                        m_NumVertices,
@@ -210,7 +721,17 @@ void mitk::RemeshFilter::GenerateData()
                        m_EdgeSplitting,
                        m_OptimizationLevel,
                        m_ForceManifold,
-                       m_BoundaryFixing);
+                       m_BoundaryFixing,
+                       m_NumberOfThreads,
+                       progressCallback,
+                       &m_Quality);
+
+  if (output.IsNull())
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("Remeshing was aborted");
+    throw e;
+  }
 
   this->SetNthOutput(0, output);
 }
@@ -0,0 +1,247 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkRemeshing.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <vtkCellArray.h>
+#include <vtkPoints.h>
+#include <vtkPolyData.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/**
+ * Tests mitk::Remesh() and mitk::ComputeRemeshingQuality():
+ * - the serial and the parallel remeshing of a sphere result in meshes of similar quality
+ * - a progress callback can cancel the remeshing
+ * - the quality measures of known meshes
+ */
+class mitkRemeshingTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkRemeshingTestSuite);
+  MITK_TEST(SerialAndParallelRemeshingTest);
+  MITK_TEST(CancelParallelRemeshingTest);
+  MITK_TEST(CancelSerialRemeshingTest);
+  MITK_TEST(QualityOfSquareTest);
+  MITK_TEST(QualityOfTetrahedronTest);
+  MITK_TEST(InvalidSurfaceTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  static constexpr double Radius = 10.0;
+  static constexpr int NumberOfVertices = 500;
+
+  mitk::Surface::Pointer m_Sphere;
+
+  static vtkSmartPointer<vtkPolyData> CreatePolyData(const std::vector<std::array<double, 3>> &points,
+                                                     const std::vector<std::array<vtkIdType, 3>> &triangles)
+  {
+    auto vtkpoints = vtkSmartPointer<vtkPoints>::New();
+
+    for (const auto &point : points)
+      vtkpoints->InsertNextPoint(point.data());
+
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+
+    for (const auto &triangle : triangles)
+      polys->InsertNextCell(3, triangle.data());
+
+    auto polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(vtkpoints);
+    polyData->SetPolys(polys);
+
+    return polyData;
+  }
+
+  /** Collects the reported progress and cancels the remeshing as soon as it exceeds the given value.*/
+  struct ProgressRecorder
+  {
+    double CancelAfter = 2.0;
+    std::vector<double> Progress;
+    bool CalledFromOtherThread = false;
+    std::thread::id ThreadId = std::this_thread::get_id();
+
+    mitk::RemeshingProgressCallback GetCallback()
+    {
+      return [this](double progress) {
+        Progress.push_back(progress);
+        CalledFromOtherThread = CalledFromOtherThread || std::this_thread::get_id() != ThreadId;
+        return progress <= CancelAfter;
+      };
+    }
+  };
+
+public:
+  void setUp() override
+  {
+    auto sphereSource = vtkSmartPointer<vtkSphereSource>::New();
+    sphereSource->SetRadius(Radius);
+    sphereSource->SetThetaResolution(60);
+    sphereSource->SetPhiResolution(60);
+    sphereSource->Update();
+
+    m_Sphere = mitk::Surface::New();
+    m_Sphere->SetVtkPolyData(sphereSource->GetOutput());
+  }
+
+  void tearDown() override
+  {
+    m_Sphere = nullptr;
+  }
+
+  void SerialAndParallelRemeshingTest()
+  {
+    const double sphereArea = 16.0 * std::atan(1.0) * Radius * Radius;
+
+    mitk::RemeshingQuality serialQuality;
+    auto serialSurface = mitk::Remesh(m_Sphere, 0, NumberOfVertices, 0.0, 10, 0.0, 1, false, false, 1, nullptr, &serialQuality);
+
+    mitk::RemeshingQuality parallelQuality;
+    auto parallelSurface = mitk::Remesh(m_Sphere, 0, NumberOfVertices, 0.0, 10, 0.0, 1, false, false, 4, nullptr, &parallelQuality);
+
+    CPPUNIT_ASSERT(serialSurface.IsNotNull());
+    CPPUNIT_ASSERT(parallelSurface.IsNotNull());
+
+    MITK_INFO << "Serial remeshing: " << serialQuality;
+    MITK_INFO << "Parallel remeshing: " << parallelQuality;
+
+    // The quality is the one of the returned surfaces
+    const auto serialCheck = mitk::ComputeRemeshingQuality(serialSurface->GetVtkPolyData());
+    CPPUNIT_ASSERT_EQUAL(serialCheck.NumberOfVertices, serialQuality.NumberOfVertices);
+    CPPUNIT_ASSERT_EQUAL(serialCheck.NumberOfTriangles, serialQuality.NumberOfTriangles);
+    CPPUNIT_ASSERT(serialQuality.Seconds > 0.0);
+
+    // Empty clusters are dropped, so the number of vertices may slightly fall short of the requested one
+    CPPUNIT_ASSERT(std::abs(serialQuality.NumberOfVertices - NumberOfVertices) <= NumberOfVertices / 20);
+    CPPUNIT_ASSERT(std::abs(parallelQuality.NumberOfVertices - NumberOfVertices) <= NumberOfVertices / 20);
+
+    // Both approximate the sphere and consist of well-shaped triangles of similar size
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(sphereArea, serialQuality.Area, 0.03 * sphereArea);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(sphereArea, parallelQuality.Area, 0.03 * sphereArea);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(serialQuality.MeanEdgeLength, parallelQuality.MeanEdgeLength, 0.1 * serialQuality.MeanEdgeLength);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(serialQuality.MeanMinimumAngle, parallelQuality.MeanMinimumAngle, 5.0);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(serialQuality.MeanRadiusRatio, parallelQuality.MeanRadiusRatio, 0.1);
+    CPPUNIT_ASSERT(parallelQuality.EdgeLengthDeviation < serialQuality.EdgeLengthDeviation + 0.1);
+  }
+
+  void CancelParallelRemeshingTest()
+  {
+    ProgressRecorder recorder;
+    recorder.CancelAfter = 0.1;
+
+    auto surface = mitk::Remesh(m_Sphere, 0, NumberOfVertices, 0.0, 10, 0.0, 1, false, false, 4, recorder.GetCallback());
+
+    CPPUNIT_ASSERT(surface.IsNull());
+    CPPUNIT_ASSERT(!recorder.CalledFromOtherThread);
+
+    // The callback is not called after it cancelled the remeshing
+    CPPUNIT_ASSERT(recorder.Progress.back() > recorder.CancelAfter);
+    CPPUNIT_ASSERT(recorder.Progress.back() < 1.0);
+
+    for (std::size_t i = 0; i + 1 < recorder.Progress.size(); ++i)
+      CPPUNIT_ASSERT(recorder.Progress[i] <= recorder.CancelAfter);
+
+    // Without cancellation, the progress increases up to 1
+    ProgressRecorder completeRecorder;
+    surface = mitk::Remesh(m_Sphere, 0, NumberOfVertices, 0.0, 10, 0.0, 1, false, false, 4, completeRecorder.GetCallback());
+
+    CPPUNIT_ASSERT(surface.IsNotNull());
+    CPPUNIT_ASSERT(!completeRecorder.CalledFromOtherThread);
+    CPPUNIT_ASSERT_EQUAL(1.0, completeRecorder.Progress.back());
+
+    for (std::size_t i = 0; i + 1 < completeRecorder.Progress.size(); ++i)
+      CPPUNIT_ASSERT(completeRecorder.Progress[i] <= completeRecorder.Progress[i + 1]);
+  }
+
+  void CancelSerialRemeshingTest()
+  {
+    // The serial remeshing cannot be interrupted during the ACVD clustering, but is cancelled afterwards
+    ProgressRecorder recorder;
+    recorder.CancelAfter = 0.1;
+
+    auto surface = mitk::Remesh(m_Sphere, 0, NumberOfVertices, 0.0, 10, 0.0, 1, false, false, 1, recorder.GetCallback());
+
+    CPPUNIT_ASSERT(surface.IsNull());
+    CPPUNIT_ASSERT(!recorder.CalledFromOtherThread);
+    CPPUNIT_ASSERT_EQUAL(0.8, recorder.Progress.back());
+  }
+
+  void QualityOfSquareTest()
+  {
+    // Unit square split into two right isosceles triangles
+    auto polyData = CreatePolyData({ { 0, 0, 0 }, { 1, 0, 0 }, { 1, 1, 0 }, { 0, 1, 0 } }, { { 0, 1, 2 }, { 0, 2, 3 } });
+    const auto quality = mitk::ComputeRemeshingQuality(polyData);
+
+    const double sqrt2 = std::sqrt(2.0);
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(4), quality.NumberOfVertices);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(2), quality.NumberOfTriangles);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, quality.Area, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(45.0, quality.MinimumAngle, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(45.0, quality.MeanMinimumAngle, 1e-9);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * sqrt2 - 2.0, quality.MinimumRadiusRatio, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * sqrt2 - 2.0, quality.MeanRadiusRatio, 1e-12);
+
+    // Four sides and the diagonal
+    const double meanEdgeLength = (4.0 + sqrt2) / 5.0;
+    const double variance = (4.0 + 2.0) / 5.0 - meanEdgeLength * meanEdgeLength;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(meanEdgeLength, quality.MeanEdgeLength, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(variance) / meanEdgeLength, quality.EdgeLengthDeviation, 1e-9);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(4), quality.NumberOfBoundaryEdges);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), quality.NumberOfNonManifoldEdges);
+  }
+
+  void QualityOfTetrahedronTest()
+  {
+    // Regular tetrahedron with edge length 2 * sqrt(2)
+    auto polyData = CreatePolyData({ { 1, 1, 1 }, { 1, -1, -1 }, { -1, 1, -1 }, { -1, -1, 1 } },
+                                   { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } });
+    const auto quality = mitk::ComputeRemeshingQuality(polyData);
+
+    const double edgeLength = 2.0 * std::sqrt(2.0);
+
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(4), quality.NumberOfTriangles);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(std::sqrt(3.0) * edgeLength * edgeLength, quality.Area, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(60.0, quality.MinimumAngle, 1e-6);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, quality.MinimumRadiusRatio, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(edgeLength, quality.MeanEdgeLength, 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, quality.EdgeLengthDeviation, 1e-6);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), quality.NumberOfBoundaryEdges);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), quality.NumberOfNonManifoldEdges);
+
+    // An edge shared by three triangles is non-manifold
+    polyData = CreatePolyData({ { 1, 1, 1 }, { 1, -1, -1 }, { -1, 1, -1 }, { -1, -1, 1 }, { 2, 2, -2 } },
+                              { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 }, { 0, 1, 4 } });
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(1), mitk::ComputeRemeshingQuality(polyData).NumberOfNonManifoldEdges);
+  }
+
+  void InvalidSurfaceTest()
+  {
+    CPPUNIT_ASSERT_THROW(mitk::Remesh(nullptr, 0, NumberOfVertices, 0.0), mitk::Exception);
+
+    auto emptySurface = mitk::Surface::New();
+    emptySurface->SetVtkPolyData(vtkSmartPointer<vtkPolyData>::New());
+    CPPUNIT_ASSERT_THROW(mitk::Remesh(emptySurface, 0, NumberOfVertices, 0.0), mitk::Exception);
+
+    const auto quality = mitk::ComputeRemeshingQuality(nullptr);
+    CPPUNIT_ASSERT_EQUAL(vtkIdType(0), quality.NumberOfTriangles);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkRemeshing)
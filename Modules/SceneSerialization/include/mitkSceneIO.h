@@ -30,6 +30,7 @@ namespace mitk
 {
   class BaseData;
   class PropertyList;
+  class SceneArchive;
 
   class MITKSCENESERIALIZATION_EXPORT SceneIO : public itk::Object
   {
@@ -48,6 +49,10 @@ namespace mitk
      * Attempts to read the provided file and create objects with
      * parent/child relations into a DataStorage.
      *
+     * Only the index and property lists are extracted into a temporary directory upfront.
+     * Data files are extracted one by one right before they are read and are removed afterwards.
+     * Independent data files are read concurrently (see SetNumberOfLoadingThreads()).
+     *
      * \param filename full filename of the scene file
      * \param storage If given, this DataStorage is used instead of a newly created one
      * \param clearStorageFirst If set, the provided DataStorage will be cleared before populating it with the loaded
@@ -115,12 +120,30 @@ namespace mitk
      */
     const PropertyList *GetFailedProperties();
 
+    /**
+     * \brief Maximum number of data files that are read concurrently when loading a scene.
+     *
+     * 0 (default) uses the number of hardware threads, 1 reads all data files sequentially.
+     */
+    itkSetMacro(NumberOfLoadingThreads, unsigned int);
+    itkGetConstMacro(NumberOfLoadingThreads, unsigned int);
+
   protected:
     SceneIO();
     ~SceneIO() override;
 
     std::string CreateEmptyTempDirectory();
 
+    /**
+     * \brief Extracts index.xml and all entries that are not data files into the working directory.
+     */
+    bool ExtractSceneIndex(SceneArchive &archive);
+
+    DataStorage::Pointer LoadSceneIndex(const std::string &indexfilename,
+                                        DataStorage *storage,
+                                        bool clearStorageFirst,
+                                        const SceneArchive *archive);
+
     tinyxml2::XMLElement *SaveBaseData(tinyxml2::XMLDocument &doc, BaseData *data, const std::string &filenamehint, bool &error);
     tinyxml2::XMLElement *SavePropertyList(tinyxml2::XMLDocument &doc, PropertyList *propertyList, const std::string &filenamehint);
 
@@ -132,6 +155,7 @@ namespace mitk
 
     std::string m_WorkingDirectory;
     unsigned int m_UnzipErrors;
+    unsigned int m_NumberOfLoadingThreads;
   };
 }
 
@@ -26,6 +26,8 @@ namespace tinyxml2
 
 namespace mitk
 {
+  class SceneArchive;
+
   class MITKSCENESERIALIZATION_EXPORT SceneReader : public itk::Object
   {
   public:
@@ -34,6 +36,28 @@ namespace mitk
     itkCloneMacro(Self);
 
     virtual bool LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage);
+
+    /**
+      \brief If set, data files are extracted from this archive into the working directory right before
+      they are read and removed afterwards.
+    */
+    void SetArchive(const SceneArchive *archive);
+    const SceneArchive *GetArchive() const;
+
+    /**
+      \brief Maximum number of data files that are read concurrently.
+
+      0 (default) uses the number of hardware threads, 1 reads all data files sequentially.
+    */
+    itkSetMacro(NumberOfThreads, unsigned int);
+    itkGetConstMacro(NumberOfThreads, unsigned int);
+
+  protected:
+    SceneReader();
+    ~SceneReader() override;
+
+    const SceneArchive *m_Archive;
+    unsigned int m_NumberOfThreads;
   };
 }
 
@@ -0,0 +1,170 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkSceneArchive.h"
+
+#include <mitkLogMacros.h>
+
+#include <Poco/File.h>
+#include <Poco/FileStream.h>
+#include <Poco/Path.h>
+#include <Poco/StreamCopier.h>
+#include <Poco/Zip/ZipArchive.h>
+#include <Poco/Zip/ZipStream.h>
+
+namespace
+{
+  std::string GetStem(const std::string &entryName)
+  {
+    const auto dot = entryName.find_last_of('.');
+    const auto slash = entryName.find_last_of('/');
+
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+      return entryName;
+
+    return entryName.substr(0, dot);
+  }
+
+  bool IsSafeEntryName(const std::string &entryName)
+  {
+    Poco::Path path(entryName, Poco::Path::PATH_UNIX);
+
+    if (path.isAbsolute())
+      return false;
+
+    for (int i = 0; i < path.depth(); ++i)
+    {
+      if (path[i] == "..")
+        return false;
+    }
+
+    return true;
+  }
+}
+
+mitk::SceneArchive::SceneArchive(const std::string &filename)
+  : m_Filename(filename)
+{
+  Poco::FileInputStream file(filename, std::ios::binary);
+  Poco::Zip::ZipArchive archive(file);
+
+  for (auto iter = archive.headerBegin(); iter != archive.headerEnd(); ++iter)
+  {
+    if (!iter->second.isDirectory())
+      m_Headers.emplace(iter->first, iter->second);
+  }
+}
+
+std::vector<std::string> mitk::SceneArchive::GetEntryNames() const
+{
+  std::vector<std::string> entryNames;
+  entryNames.reserve(m_Headers.size());
+
+  for (const auto &header : m_Headers)
+    entryNames.push_back(header.first);
+
+  return entryNames;
+}
+
+bool mitk::SceneArchive::HasEntry(const std::string &entryName) const
+{
+  return m_Headers.find(entryName) != m_Headers.end();
+}
+
+std::string mitk::SceneArchive::Extract(const std::string &entryName, const std::string &targetDirectory) const
+{
+  auto iter = m_Headers.find(entryName);
+
+  if (iter == m_Headers.end())
+  {
+    MITK_ERROR << "Scene file does not contain '" << entryName << "'";
+    return "";
+  }
+
+  if (!IsSafeEntryName(entryName))
+  {
+    MITK_ERROR << "Refusing to extract '" << entryName << "' outside of the working directory";
+    return "";
+  }
+
+  try
+  {
+    Poco::Path path(targetDirectory);
+    path.makeDirectory();
+    path.resolve(Poco::Path(entryName, Poco::Path::PATH_UNIX));
+
+    Poco::File(path.parent()).createDirectories();
+
+    Poco::FileInputStream file(m_Filename, std::ios::binary);
+    Poco::Zip::ZipInputStream zipStream(file, iter->second);
+
+    Poco::FileOutputStream output(path.toString(), std::ios::binary | std::ios::trunc);
+    Poco::StreamCopier::copyStream(zipStream, output);
+    output.close();
+
+    return path.toString();
+  }
+  catch (const Poco::Exception &e)
+  {
+    MITK_ERROR << "Error while extracting '" << entryName << "': " << e.displayText();
+  }
+  catch (const std::exception &e)
+  {
+    MITK_ERROR << "Error while extracting '" << entryName << "': " << e.what();
+  }
+
+  return "";
+}
+
+void mitk::SceneArchive::SetDataFiles(const std::vector<std::string> &dataFiles,
+                                      const std::set<std::string> &excludedEntries)
+{
+  m_DataEntries.clear();
+  m_AllDataEntries.clear();
+
+  for (const auto &dataFile : dataFiles)
+  {
+    if (!this->HasEntry(dataFile))
+      continue;
+
+    const auto stem = GetStem(dataFile);
+    std::vector<std::string> entries = { dataFile };
+
+    for (auto iter = m_Headers.lower_bound(stem); iter != m_Headers.end(); ++iter)
+    {
+      const auto &entryName = iter->first;
+
+      if (0 != entryName.compare(0, stem.size(), stem))
+        break;
+
+      if (entryName != dataFile && GetStem(entryName) == stem && excludedEntries.count(entryName) == 0)
+        entries.push_back(entryName);
+    }
+
+    m_AllDataEntries.insert(entries.begin(), entries.end());
+    m_DataEntries[dataFile] = entries;
+  }
+}
+
+std::vector<std::string> mitk::SceneArchive::GetDataEntries(const std::string &dataFile) const
+{
+  auto iter = m_DataEntries.find(dataFile);
+
+  return iter != m_DataEntries.end()
+    ? iter->second
+    : std::vector<std::string>();
+}
+
+bool mitk::SceneArchive::IsDataEntry(const std::string &entryName) const
+{
+  return m_AllDataEntries.count(entryName) != 0;
+}
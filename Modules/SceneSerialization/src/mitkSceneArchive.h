@@ -0,0 +1,82 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkSceneArchive_h
+#define mitkSceneArchive_h
+
+#include <Poco/Zip/ZipLocalFileHeader.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace mitk
+{
+  /**
+    \brief Random access to the entries of a zipped scene file.
+
+    In contrast to Poco::Zip::Decompress, entries are extracted individually and on demand.
+    Each extraction opens its own stream on the scene file, so entries can be extracted
+    concurrently.
+
+    Data files are registered with SetDataFiles(). Their entries, including companion entries
+    that share the same base name (like the raw file of a header/raw pair), are meant to be
+    extracted right before reading and removed afterwards, so that a scene never has to be
+    extracted as a whole.
+  */
+  class SceneArchive
+  {
+  public:
+    /**
+      \brief Reads the central directory of the scene file.
+      \throw Poco::Exception if the file cannot be opened or is not a valid zip archive.
+    */
+    explicit SceneArchive(const std::string &filename);
+
+    std::vector<std::string> GetEntryNames() const;
+
+    bool HasEntry(const std::string &entryName) const;
+
+    /**
+      \brief Extracts a single entry into the target directory.
+      \return Full path of the extracted file or empty string on error.
+    */
+    std::string Extract(const std::string &entryName, const std::string &targetDirectory) const;
+
+    /**
+      \brief Registers data files and determines their companion entries.
+
+      Entries listed in excludedEntries (e.g. property lists) are never considered companions.
+    */
+    void SetDataFiles(const std::vector<std::string> &dataFiles, const std::set<std::string> &excludedEntries);
+
+    /**
+      \brief Entries that must be extracted to read the given data file.
+      \return Empty list if the data file was not registered via SetDataFiles().
+    */
+    std::vector<std::string> GetDataEntries(const std::string &dataFile) const;
+
+    /**
+      \brief Checks if an entry belongs to any registered data file.
+    */
+    bool IsDataEntry(const std::string &entryName) const;
+
+  private:
+    std::string m_Filename;
+    std::map<std::string, Poco::Zip::ZipLocalFileHeader> m_Headers;
+    std::map<std::string, std::vector<std::string>> m_DataEntries;
+    std::set<std::string> m_AllDataEntries;
+  };
+}
+
+#endif
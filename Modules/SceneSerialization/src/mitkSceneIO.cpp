@@ -18,6 +18,7 @@ found in the LICENSE file.
 
 #include "mitkBaseDataSerializer.h"
 #include "mitkPropertyListSerializer.h"
+#include "mitkSceneArchive.h"
 #include "mitkSceneIO.h"
 #include "mitkSceneReader.h"
 
@@ -31,14 +32,16 @@ found in the LICENSE file.
 #include <itkObjectFactoryBase.h>
 
 #include <fstream>
+#include <memory>
 #include <mitkIOUtil.h>
+#include <set>
 #include <sstream>
 
 #include "itksys/SystemTools.hxx"
 
 #include <tinyxml2.h>
 
-mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0)
+mitk::SceneIO::SceneIO() : m_WorkingDirectory(""), m_UnzipErrors(0), m_NumberOfLoadingThreads(0)
 {
 }
 
@@ -117,18 +120,38 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
     return storage;
   }
 
-  // unzip all filenames contents to temp dir
-  m_UnzipErrors = 0;
-  Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
-  unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
-  unzipper.decompressAllFiles();
-  unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
-    this, &SceneIO::OnUnzipError);
-  unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
-    this, &SceneIO::OnUnzipOk);
+  // extract index and property lists only, data files are extracted on demand while reading
+  std::unique_ptr<SceneArchive> archive;
+
+  try
+  {
+    archive = std::make_unique<SceneArchive>(filename);
+  }
+  catch (const Poco::Exception &e)
+  {
+    MITK_WARN << "Cannot read central directory of '" << filename << "' (" << e.displayText()
+              << "). Falling back to sequential decompression.";
+  }
+
+  if (archive != nullptr)
+  {
+    m_UnzipErrors = this->ExtractSceneIndex(*archive) ? 0 : 1;
+  }
+  else
+  {
+    // unzip all filenames contents to temp dir
+    m_UnzipErrors = 0;
+    Poco::Zip::Decompress unzipper(file, Poco::Path(m_WorkingDirectory));
+    unzipper.EError += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
+      this, &SceneIO::OnUnzipError);
+    unzipper.EOk += Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
+      this, &SceneIO::OnUnzipOk);
+    unzipper.decompressAllFiles();
+    unzipper.EError -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const std::string>>(
+      this, &SceneIO::OnUnzipError);
+    unzipper.EOk -= Poco::Delegate<SceneIO, std::pair<const Poco::Zip::ZipLocalFileHeader, const Poco::Path>>(
+      this, &SceneIO::OnUnzipOk);
+  }
 
   if (m_UnzipErrors)
   {
@@ -140,7 +163,7 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
   m_WorkingDirectory = Poco::Path::transcode (m_WorkingDirectory);
 
   auto indexFile = m_WorkingDirectory + mitk::IOUtil::GetDirectorySeparator() + "index.xml";
-  storage = LoadSceneUnzipped(indexFile, storage, clearStorageFirst);
+  storage = this->LoadSceneIndex(indexFile, storage, clearStorageFirst, archive.get());
 
   // delete temp directory
   try
@@ -157,9 +180,77 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadScene(const std::string &filename,
   return storage;
 }
 
+bool mitk::SceneIO::ExtractSceneIndex(SceneArchive &archive)
+{
+  const std::string indexEntry = "index.xml";
+
+  if (archive.Extract(indexEntry, m_WorkingDirectory).empty())
+    return false;
+
+  tinyxml2::XMLDocument document;
+  if (tinyxml2::XML_SUCCESS != document.LoadFile((m_WorkingDirectory + Poco::Path::separator() + indexEntry).c_str()))
+    return false;
+
+  // data files are referenced by <data file="..."> elements, property lists by <properties file="..."> elements
+  std::vector<std::string> dataFiles;
+  std::set<std::string> nonDataEntries = { indexEntry };
+
+  for (auto *nodeElement = document.FirstChildElement("node"); nodeElement != nullptr;
+       nodeElement = nodeElement->NextSiblingElement("node"))
+  {
+    auto *dataElement = nodeElement->FirstChildElement("data");
+
+    if (dataElement != nullptr)
+    {
+      const auto *dataFile = dataElement->Attribute("file");
+
+      if (dataFile != nullptr)
+        dataFiles.emplace_back(dataFile);
+
+      for (auto *propertiesElement = dataElement->FirstChildElement("properties"); propertiesElement != nullptr;
+           propertiesElement = propertiesElement->NextSiblingElement("properties"))
+      {
+        const auto *propertiesFile = propertiesElement->Attribute("file");
+
+        if (propertiesFile != nullptr)
+          nonDataEntries.insert(propertiesFile);
+      }
+    }
+
+    for (auto *propertiesElement = nodeElement->FirstChildElement("properties"); propertiesElement != nullptr;
+         propertiesElement = propertiesElement->NextSiblingElement("properties"))
+    {
+      const auto *propertiesFile = propertiesElement->Attribute("file");
+
+      if (propertiesFile != nullptr)
+        nonDataEntries.insert(propertiesFile);
+    }
+  }
+
+  archive.SetDataFiles(dataFiles, nonDataEntries);
+
+  bool success = true;
+
+  for (const auto &entry : archive.GetEntryNames())
+  {
+    if (entry != indexEntry && !archive.IsDataEntry(entry))
+      success &= !archive.Extract(entry, m_WorkingDirectory).empty();
+  }
+
+  return success;
+}
+
 mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &indexfilename,
   DataStorage *pStorage,
   bool clearStorageFirst)
+{
+  return this->LoadSceneIndex(indexfilename, pStorage, clearStorageFirst, nullptr);
+}
+
+mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneIndex(const std::string &indexfilename,
+  DataStorage *pStorage,
+  bool clearStorageFirst,
+  const SceneArchive *archive)
 {
   mitk::LocaleSwitch localeSwitch("C");
 
@@ -205,6 +296,9 @@ mitk::DataStorage::Pointer mitk::SceneIO::LoadSceneUnzipped(const std::string &i
   }
 
   SceneReader::Pointer reader = SceneReader::New();
+  reader->SetArchive(archive);
+  reader->SetNumberOfThreads(m_NumberOfLoadingThreads);
+
   if (!reader->LoadScene(document, workingDir, storage))
   {
     MITK_ERROR << "There were errors while loading scene file " << indexfilename << ". Your data may be corrupted";
@@ -13,6 +13,26 @@ found in the LICENSE file.
 #include "mitkSceneReader.h"
 #include <tinyxml2.h>
 
+mitk::SceneReader::SceneReader()
+  : m_Archive(nullptr),
+    m_NumberOfThreads(0)
+{
+}
+
+mitk::SceneReader::~SceneReader()
+{
+}
+
+void mitk::SceneReader::SetArchive(const SceneArchive *archive)
+{
+  m_Archive = archive;
+}
+
+const mitk::SceneArchive *mitk::SceneReader::GetArchive() const
+{
+  return m_Archive;
+}
+
 bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::string &workingDirectory, DataStorage *storage)
 {
   // find version node --> note version in some variable
@@ -46,6 +66,9 @@ bool mitk::SceneReader::LoadScene(tinyxml2::XMLDocument &document, const std::st
   {
     if (auto *reader = dynamic_cast<SceneReader *>(iter->GetPointer()))
     {
+      reader->SetArchive(m_Archive);
+      reader->SetNumberOfThreads(m_NumberOfThreads);
+
       if (!reader->LoadScene(document, workingDirectory, storage))
       {
         MITK_ERROR << "There were errors while loading scene file "
@@ -12,6 +12,7 @@ found in the LICENSE file.
 
 #include "mitkSceneReaderV1.h"
 #include "Poco/Path.h"
+#include "mitkSceneArchive.h"
 #include "mitkBaseRenderer.h"
 #include "mitkIOUtil.h"
 #include "mitkProgressBar.h"
@@ -21,8 +22,12 @@ found in the LICENSE file.
 #include <mitkRenderingModeProperty.h>
 #include <tinyxml2.h>
 
+#include <algorithm>
+#include <deque>
 #include <filesystem>
+#include <future>
 #include <map>
+#include <thread>
 
 MITK_REGISTER_SERIALIZER(SceneReaderV1)
 
@@ -147,6 +152,9 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
     }
   }
 
+  // Collect data elements and their base data properties in document order
+  std::vector<std::pair<const tinyxml2::XMLElement *, PropertyList *>> dataElements;
+
   for (auto *element = document.FirstChildElement("node"); element != nullptr;
        element = element->NextSiblingElement("node"))
   {
@@ -161,12 +169,39 @@ bool mitk::SceneReaderV1::LoadScene(tinyxml2::XMLDocument &document, const std::
         properties = iter->second;
     }
 
-    const auto *dataElement = element->FirstChildElement("data");
-    auto dataNode = this->LoadBaseDataFromDataTag(dataElement, properties, workingDirectory, error);
+    dataElements.emplace_back(element->FirstChildElement("data"), properties);
+  }
+
+  // Read data files concurrently. Nodes are still finished in document order on this
+  // thread, as neither the progress bar nor the data storage are thread-safe.
+  const auto numDataElements = dataElements.size();
+  const auto numThreads = std::max(m_NumberOfThreads != 0 ? m_NumberOfThreads : std::thread::hardware_concurrency(), 1u);
+  const auto launchPolicy = numThreads > 1 ? std::launch::async : std::launch::deferred;
+
+  auto loadData = [this, &dataElements, &workingDirectory](std::size_t index) {
+    bool dataError = false;
+    auto node = this->LoadBaseDataFromDataTag(dataElements[index].first, dataElements[index].second, workingDirectory, dataError);
+    return std::make_pair(node, dataError);
+  };
+
+  std::deque<std::future<std::pair<DataNode::Pointer, bool>>> pendingData;
+  std::size_t nextDataElement = 0;
+
+  for (std::size_t i = 0; i < numDataElements; ++i)
+  {
+    while (nextDataElement < numDataElements && pendingData.size() < numThreads)
+      pendingData.push_back(std::async(launchPolicy, loadData, nextDataElement++));
+
+    auto result = pendingData.front().get();
+    pendingData.pop_front();
+
+    error |= result.second;
+    auto dataNode = result.first;
 
     if (dataNode.IsNull())
       continue;
 
+    auto* properties = dataElements[i].second;
     auto* baseData = dataNode->GetData();
 
     if (baseData != nullptr && properties != nullptr)
@@ -332,6 +367,19 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
     const char *filename = dataElement->Attribute("file");
     if (filename && strlen(filename) != 0)
     {
+      std::vector<std::string> extractedFiles;
+
+      if (m_Archive != nullptr)
+      {
+        for (const auto &entry : m_Archive->GetDataEntries(filename))
+        {
+          auto extractedFile = m_Archive->Extract(entry, workingDirectory);
+
+          if (!extractedFile.empty())
+            extractedFiles.push_back(extractedFile);
+        }
+      }
+
       try
       {
         auto baseData = IOUtil::Load(workingDirectory + Poco::Path::separator() + filename, properties);
@@ -345,6 +393,13 @@ mitk::DataNode::Pointer mitk::SceneReaderV1::LoadBaseDataFromDataTag(const tinyx
         error = true;
       }
 
+      // Data files extracted on demand are not needed anymore
+      for (const auto &extractedFile : extractedFiles)
+      {
+        std::error_code errorCode;
+        std::filesystem::remove(extractedFile, errorCode);
+      }
+
       if (node.IsNull())
       {
         MITK_ERROR << "Error during attempt to read '" << filename << "'. Factory returned nullptr object.";
@@ -36,6 +36,8 @@ namespace mitk
   protected:
     /**
       \brief tries to create one DataNode from a given XML \<node\> element
+
+      Called concurrently for different elements, so it must not modify any member.
     */
     DataNode::Pointer LoadBaseDataFromDataTag(const tinyxml2::XMLElement *dataElement,
                                               const PropertyList *properties,
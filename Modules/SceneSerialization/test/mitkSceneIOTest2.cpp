@@ -19,6 +19,13 @@ found in the LICENSE file.
 #include "mitkSceneIO.h"
 #include "mitkSceneIOTestScenarioProvider.h"
 
+#include <Poco/Path.h>
+#include <Poco/Zip/Compress.h>
+#include <Poco/Zip/Decompress.h>
+
+#include <filesystem>
+#include <fstream>
+
 /**
   \brief Test cases for SceneIO.
 
@@ -78,6 +85,8 @@ class mitkSceneIOTest2Suite : public mitk::TestFixture
   CPPUNIT_TEST_SUITE(mitkSceneIOTest2Suite);
   MITK_TEST(Test_SceneIOInterfaces);
   MITK_TEST(Test_ReconstructionOfScenes);
+  MITK_TEST(Test_ConcurrentLoading);
+  MITK_TEST(Test_ConcurrentLoadingWithFailingNode);
   CPPUNIT_TEST_SUITE_END();
 
   mitk::SceneIOTestScenarioProvider m_TestCaseProvider;
@@ -125,6 +134,132 @@ public:
     }
   }
 
+  void Test_ConcurrentLoading()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    mitk::DataStorage::Pointer originalStorage = BuildMultiNodeStorage();
+    mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+    CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+    mitk::DataStorage::Pointer sequentialStorage = LoadScene(archiveFilename, 1);
+    mitk::DataStorage::Pointer concurrentStorage = LoadScene(archiveFilename, 4);
+
+    CPPUNIT_ASSERT_EQUAL(originalStorage->GetAll()->Size(), concurrentStorage->GetAll()->Size());
+    CPPUNIT_ASSERT_MESSAGE("Comparing concurrently loaded scene with the original scene",
+                           mitk::DataStorageCompare(originalStorage, concurrentStorage, CompareFlags(), mitk::eps)
+                             .CompareVerbose());
+    CPPUNIT_ASSERT_MESSAGE("Comparing concurrently loaded scene with the sequentially loaded scene",
+                           mitk::DataStorageCompare(sequentialStorage, concurrentStorage, CompareFlags(), mitk::eps)
+                             .CompareVerbose());
+
+    std::filesystem::remove_all(tempDir);
+  }
+
+  void Test_ConcurrentLoadingWithFailingNode()
+  {
+    std::string tempDir = mitk::IOUtil::CreateTemporaryDirectory("SceneIOTest_XXXXXX");
+    std::string archiveFilename = mitk::IOUtil::CreateTemporaryFile("scene_XXXXXX.mitk", tempDir);
+
+    mitk::DataStorage::Pointer originalStorage = BuildMultiNodeStorage();
+    mitk::SceneIO::Pointer writer = mitk::SceneIO::New();
+    CPPUNIT_ASSERT(writer->SaveScene(originalStorage->GetAll(), originalStorage, archiveFilename));
+
+    // replace the surface file by garbage and repack the scene
+    std::string unpackedDir = tempDir + "/unpacked";
+    std::filesystem::create_directory(unpackedDir);
+    {
+      std::ifstream archive(archiveFilename, std::ios::binary);
+      Poco::Zip::Decompress unzipper(archive, Poco::Path(unpackedDir));
+      unzipper.decompressAllFiles();
+    }
+
+    unsigned int corruptedFiles = 0;
+    for (const auto &entry : std::filesystem::directory_iterator(unpackedDir))
+    {
+      if (entry.path().extension() == ".vtp")
+      {
+        std::ofstream file(entry.path(), std::ios::binary | std::ios::trunc);
+        file << "this is not a surface";
+        ++corruptedFiles;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(1u, corruptedFiles);
+
+    std::string brokenArchiveFilename = tempDir + "/broken.mitk";
+    {
+      std::ofstream archive(brokenArchiveFilename, std::ios::binary);
+      Poco::Zip::Compress zipper(archive, true);
+      zipper.addRecursive(Poco::Path(unpackedDir + "/"));
+      zipper.close();
+    }
+
+    mitk::DataStorage::Pointer sequentialStorage = LoadScene(brokenArchiveFilename, 1);
+    mitk::DataStorage::Pointer concurrentStorage = LoadScene(brokenArchiveFilename, 4);
+
+    // the node of the broken file is restored without data, all other nodes are complete
+    CPPUNIT_ASSERT_EQUAL(originalStorage->GetAll()->Size(), concurrentStorage->GetAll()->Size());
+    mitk::DataNode::Pointer brokenNode = concurrentStorage->GetNamedNode("Surface");
+    CPPUNIT_ASSERT(brokenNode.IsNotNull());
+    CPPUNIT_ASSERT(brokenNode->GetData() == nullptr);
+
+    for (const auto &name : { "Image-Int", "Image-Double", "PointSet" })
+    {
+      mitk::DataNode::Pointer node = concurrentStorage->GetNamedNode(name);
+      CPPUNIT_ASSERT_MESSAGE(name, node.IsNotNull() && node->GetData() != nullptr);
+    }
+
+    CPPUNIT_ASSERT_MESSAGE("Comparing concurrently loaded scene with the sequentially loaded scene",
+                           mitk::DataStorageCompare(sequentialStorage, concurrentStorage, CompareFlags(), mitk::eps)
+                             .CompareVerbose());
+
+    std::filesystem::remove_all(tempDir);
+  }
+
+private:
+  static mitk::DataStorageCompare::Tests CompareFlags()
+  {
+    return mitk::DataStorageCompare::CMP_Hierarchy | mitk::DataStorageCompare::CMP_Data |
+           mitk::DataStorageCompare::CMP_Properties;
+  }
+
+  /** Images, a surface and a point set, the point set is a child of the surface. */
+  mitk::DataStorage::Pointer BuildMultiNodeStorage() const
+  {
+    mitk::DataStorage::Pointer storage = BuildScenario("Image");
+
+    mitk::DataNode::Pointer surfaceNode = BuildScenario("Surface")->GetNamedNode("Surface");
+    storage->Add(surfaceNode);
+
+    mitk::DataNode::Pointer pointSetNode = BuildScenario("PointSet")->GetNamedNode("PointSet");
+    storage->Add(pointSetNode, surfaceNode);
+
+    return storage;
+  }
+
+  mitk::DataStorage::Pointer BuildScenario(const std::string &key) const
+  {
+    for (const auto &scenario : m_TestCaseProvider.GetAllScenarios())
+    {
+      if (scenario.key == key)
+        return scenario.BuildDataStorage();
+    }
+
+    CPPUNIT_FAIL("Unknown test scenario " + key);
+    return nullptr;
+  }
+
+  static mitk::DataStorage::Pointer LoadScene(const std::string &filename, unsigned int numberOfThreads)
+  {
+    mitk::SceneIO::Pointer reader = mitk::SceneIO::New();
+    reader->SetNumberOfLoadingThreads(numberOfThreads);
+
+    mitk::DataStorage::Pointer storage;
+    CPPUNIT_ASSERT_NO_THROW(storage = reader->LoadScene(filename));
+    CPPUNIT_ASSERT(storage.IsNotNull());
+    return storage;
+  }
 }; // class
 
 int mitkSceneIOTest2(int /*argc*/, char * /*argv*/ [])
@@ -16,7 +16,9 @@ found in the LICENSE file.
 
 #include <itkCommand.h>
 
-mitk::DiffSliceOperation::DiffSliceOperation() : Operation(1)
+mitk::DiffSliceOperation::DiffSliceOperation()
+  : Operation(1),
+    m_CompressedImageContainer(std::make_shared<CompressedImageContainer>())
 {
   m_TimeStep = 0;
   m_Image = nullptr;
@@ -30,8 +32,10 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
                                              const Image *slice,
                                              const SlicedGeometry3D *sliceGeometry,
                                              TimeStepType timestep,
-                                             const BaseGeometry *currentWorldGeometry)
-  : Operation(1)
+                                             const BaseGeometry *currentWorldGeometry,
+                                             const DiffSliceOperation *referenceOperation)
+  : Operation(1),
+    m_CompressedImageContainer(std::make_shared<CompressedImageContainer>())
 
 {
   m_WorldGeometry = currentWorldGeometry->Clone();
@@ -47,7 +51,19 @@ mitk::DiffSliceOperation::DiffSliceOperation(Image *imageVolume,
 
   m_TimeStep = timestep;
 
-  m_CompressedImageContainer.CompressImage(slice);
+  // Delta chains are not supported, i.e. the reference operation must hold its complete slice
+  if (nullptr != referenceOperation && nullptr == referenceOperation->m_ReferenceImageContainer)
+  {
+    auto referenceSlice = referenceOperation->GetSlice();
+    m_CompressedImageContainer->CompressImage(slice, referenceSlice);
+
+    if (m_CompressedImageContainer->IsDelta())
+      m_ReferenceImageContainer = referenceOperation->m_CompressedImageContainer;
+  }
+  else
+  {
+    m_CompressedImageContainer->CompressImage(slice);
+  }
 
   m_Image = imageVolume;
   m_DeleteObserverTag = 0;
@@ -79,9 +95,20 @@ mitk::DiffSliceOperation::~DiffSliceOperation()
   m_Image = nullptr;
 }
 
-mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice()
+mitk::Image::Pointer mitk::DiffSliceOperation::GetSlice() const
+{
+  if (nullptr != m_ReferenceImageContainer)
+  {
+    auto referenceSlice = m_ReferenceImageContainer->DecompressImage();
+    return m_CompressedImageContainer->DecompressImage(referenceSlice);
+  }
+
+  return m_CompressedImageContainer->DecompressImage();
+}
+
+std::size_t mitk::DiffSliceOperation::GetCompressedSize() const
 {
-  return m_CompressedImageContainer.DecompressImage();
+  return m_CompressedImageContainer->GetCompressedSize();
 }
 
 bool mitk::DiffSliceOperation::IsValid()
@@ -19,6 +19,8 @@ found in the LICENSE file.
 
 #include <vtkSmartPointer.h>
 
+#include <memory>
+
 namespace mitk
 {
   class Image;
@@ -32,6 +34,11 @@ namespace mitk
      slice                  the slice to be applied.
      timestep               the timestep in an 4D image.
      currentWorldGeometry   specifies the axis where the slice has to be applied in the volume.
+     referenceOperation     optional operation whose slice is used as reference for delta compression.
+
+    If a reference operation is passed that is not delta-compressed itself, only the difference between both slices is kept (see
+    CompressedImageContainer). The compressed reference slice is shared with the reference operation,
+    so it stays valid even if the reference operation is deleted first.
 
     This Operation can be used to realize undo-redo functionality for e.g. segmentation purposes.
   */
@@ -55,7 +62,8 @@ namespace mitk
                        const mitk::Image *slice,
                        const SlicedGeometry3D *sliceGeometry,
                        const TimeStepType timestep,
-                       const BaseGeometry *currentWorldGeometry);
+                       const BaseGeometry *currentWorldGeometry,
+                       const DiffSliceOperation *referenceOperation = nullptr);
 
     /** \brief Check if it is a valid operation.*/
     bool IsValid();
@@ -65,7 +73,10 @@ namespace mitk
     const mitk::Image* GetImage() const { return this->m_Image; }
 
     /** \brief Get the slice that is applied in the operation.*/
-    Image::Pointer GetSlice();
+    Image::Pointer GetSlice() const;
+
+    /** \brief Get the number of bytes occupied by the compressed slice.*/
+    std::size_t GetCompressedSize() const;
 
     /** \brief Set timeStep*/
     TimeStepType GetTimeStep() const { return this->m_TimeStep; }
@@ -79,7 +90,9 @@ namespace mitk
     /** \brief Callback for image observer.*/
     void OnImageDeleted();
 
-    CompressedImageContainer m_CompressedImageContainer;
+    std::shared_ptr<CompressedImageContainer> m_CompressedImageContainer;
+
+    std::shared_ptr<const CompressedImageContainer> m_ReferenceImageContainer;
 
     mitk::Image *m_Image;
 
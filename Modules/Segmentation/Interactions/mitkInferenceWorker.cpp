@@ -0,0 +1,570 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include "mitkInferenceWorker.h"
+
+#include <mitkIOUtil.h>
+#include <mitkImageReadAccessor.h>
+#include <mitkImageWriteAccessor.h>
+
+#include <itksys/SystemTools.hxx>
+
+#include <usGetModuleContext.h>
+#include <usModule.h>
+#include <usModuleContext.h>
+#include <usModuleResource.h>
+#include <usModuleResourceStream.h>
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+  const int PROTOCOL_VERSION = 1;
+
+  /** Time the worker gets to shut down before it is killed.*/
+  const double SHUTDOWN_TIMEOUT = 5.0;
+
+  using Clock = std::chrono::steady_clock;
+
+  double SecondsSince(Clock::time_point start)
+  {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  std::string GetDataType(const mitk::PixelType &pixelType)
+  {
+    if (pixelType.GetNumberOfComponents() != 1)
+      mitkThrow() << "Inference worker only supports scalar images.";
+
+    switch (pixelType.GetComponentType())
+    {
+      case itk::IOComponentEnum::CHAR:
+        return "int8";
+      case itk::IOComponentEnum::UCHAR:
+        return "uint8";
+      case itk::IOComponentEnum::SHORT:
+        return "int16";
+      case itk::IOComponentEnum::USHORT:
+        return "uint16";
+      case itk::IOComponentEnum::INT:
+        return "int32";
+      case itk::IOComponentEnum::UINT:
+        return "uint32";
+      case itk::IOComponentEnum::FLOAT:
+        return "float32";
+      case itk::IOComponentEnum::DOUBLE:
+        return "float64";
+      default:
+        mitkThrow() << "Inference worker does not support the pixel type " << pixelType.GetComponentTypeAsString() << ".";
+    }
+  }
+
+  mitk::PixelType MakePixelType(const std::string &dataType)
+  {
+    if (dataType == "int8")
+      return mitk::MakeScalarPixelType<char>();
+    if (dataType == "uint8")
+      return mitk::MakeScalarPixelType<unsigned char>();
+    if (dataType == "int16")
+      return mitk::MakeScalarPixelType<short>();
+    if (dataType == "uint16")
+      return mitk::MakeScalarPixelType<unsigned short>();
+    if (dataType == "int32")
+      return mitk::MakeScalarPixelType<int>();
+    if (dataType == "uint32")
+      return mitk::MakeScalarPixelType<unsigned int>();
+    if (dataType == "float32")
+      return mitk::MakeScalarPixelType<float>();
+    if (dataType == "float64")
+      return mitk::MakeScalarPixelType<double>();
+
+    mitkThrow() << "Inference worker returned the unsupported data type \"" << dataType << "\".";
+  }
+
+  /** Writes to a temporary file first, so the worker never reads a partially written request.*/
+  void WriteJson(const std::string &path, const nlohmann::json &content)
+  {
+    const auto tempPath = path + ".tmp";
+
+    {
+      std::ofstream stream(tempPath);
+      stream << content.dump();
+
+      if (!stream.good())
+        mitkThrow() << "Cannot write " << tempPath << ".";
+    }
+
+    std::filesystem::rename(tempPath, path);
+  }
+
+  nlohmann::json ReadJson(const std::string &path)
+  {
+    std::ifstream stream(path);
+
+    try
+    {
+      return nlohmann::json::parse(stream);
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+      mitkThrow() << "Cannot parse " << path << ": " << e.what();
+    }
+  }
+
+  void RemoveFile(const std::string &path)
+  {
+    std::error_code error;
+    std::filesystem::remove(path, error);
+  }
+}
+
+mitk::InferenceWorker::InferenceWorker()
+  : m_Process(nullptr),
+    m_OwnsExchangeDirectory(false),
+    m_NextRequestId(0),
+    m_Timeout(3600.0),
+    m_StartupTime(0.0)
+{
+}
+
+mitk::InferenceWorker::~InferenceWorker()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->StopWorker();
+}
+
+std::string mitk::InferenceWorker::GetDefaultExchangeBaseDirectory()
+{
+#ifndef _WIN32
+  std::error_code error;
+
+  if (std::filesystem::is_directory("/dev/shm", error))
+    return "/dev/shm";
+#endif
+
+  return IOUtil::GetTempPath();
+}
+
+std::string mitk::InferenceWorker::WriteWorkerScript(const std::string &directory)
+{
+  auto resource = us::GetModuleContext()->GetModule()->GetResource("InferenceWorker.py");
+
+  if (!resource.IsValid())
+    mitkThrow() << "Resource InferenceWorker.py not found.";
+
+  us::ModuleResourceStream resourceStream(resource, std::ios_base::binary);
+
+  const auto path = directory + IOUtil::GetDirectorySeparator() + "InferenceWorker.py";
+  std::ofstream stream(path, std::ios_base::binary);
+  stream << resourceStream.rdbuf();
+
+  if (!stream.good())
+    mitkThrow() << "Cannot write " << path << ".";
+
+  return path;
+}
+
+void mitk::InferenceWorker::Start(const std::string &executionPath,
+                                  const ArgumentListType &argumentList,
+                                  const std::string &exchangeDirectory)
+{
+  std::exception_ptr error;
+  OutputListType output;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    try
+    {
+      this->StartWorker(executionPath, argumentList, exchangeDirectory);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    output.swap(m_Output);
+  }
+
+  this->InvokeOutputEvents(output);
+
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void mitk::InferenceWorker::StartWorker(const std::string &executionPath,
+                                        const ArgumentListType &argumentList,
+                                        const std::string &exchangeDirectory)
+{
+  this->StopWorker();
+
+  if (argumentList.empty())
+    mitkThrow() << "No command line given for the inference worker.";
+
+  m_OwnsExchangeDirectory = exchangeDirectory.empty();
+  m_ExchangeDirectory = m_OwnsExchangeDirectory
+    ? IOUtil::CreateTemporaryDirectory("mitk-inference-XXXXXX", GetDefaultExchangeBaseDirectory())
+    : exchangeDirectory;
+
+  ArgumentListType arguments = argumentList;
+  arguments.push_back("--exchange");
+  arguments.push_back(m_ExchangeDirectory);
+
+  std::vector<const char *> command;
+
+  for (const auto &argument : arguments)
+    command.push_back(argument.c_str());
+
+  command.push_back(nullptr);
+
+  const auto start = Clock::now();
+
+  m_Process = itksysProcess_New();
+  itksysProcess_SetCommand(m_Process, command.data());
+  itksysProcess_SetOption(m_Process, itksysProcess_Option_CreateProcessGroup, 1);
+  itksysProcess_SetWorkingDirectory(m_Process, executionPath.c_str());
+  itksysProcess_Execute(m_Process);
+
+  if (itksysProcess_GetState(m_Process) != itksysProcess_State_Executing)
+  {
+    const std::string error = itksysProcess_GetErrorString(m_Process);
+    this->StopWorker();
+    mitkThrow() << "Cannot start inference worker " << argumentList.front() << ": " << error;
+  }
+
+  m_Arguments = argumentList;
+  m_NextRequestId = 0;
+
+  const auto readyPath = m_ExchangeDirectory + IOUtil::GetDirectorySeparator() + "ready.json";
+  this->WaitForFile(readyPath);
+  auto ready = ReadJson(readyPath);
+  RemoveFile(readyPath);
+
+  if (ready.value("protocol", 0) != PROTOCOL_VERSION)
+  {
+    this->StopWorker();
+    mitkThrow() << "Inference worker uses an unsupported protocol version.";
+  }
+
+  m_StartupTime = SecondsSince(start);
+
+  MITK_INFO << "Inference worker ready after " << m_StartupTime << " s (initialization of the worker: "
+            << ready["timings"].value("startup", 0.0) << " s).";
+}
+
+void mitk::InferenceWorker::Stop()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  this->StopWorker();
+}
+
+void mitk::InferenceWorker::StopWorker()
+{
+  if (nullptr != m_Process)
+  {
+    if (itksysProcess_GetState(m_Process) == itksysProcess_State_Executing)
+    {
+      try
+      {
+        WriteJson(m_ExchangeDirectory + IOUtil::GetDirectorySeparator() + "request-" + std::to_string(m_NextRequestId) + ".json",
+                  { { "id", m_NextRequestId }, { "command", "shutdown" } });
+      }
+      catch (...)
+      {
+        // The worker is killed below
+      }
+
+      double timeout = SHUTDOWN_TIMEOUT;
+
+      if (0 == itksysProcess_WaitForExit(m_Process, &timeout))
+      {
+        itksysProcess_Kill(m_Process);
+        itksysProcess_WaitForExit(m_Process, nullptr);
+      }
+    }
+
+    itksysProcess_Delete(m_Process);
+    m_Process = nullptr;
+  }
+
+  if (m_OwnsExchangeDirectory && !m_ExchangeDirectory.empty())
+  {
+    std::error_code error;
+    std::filesystem::remove_all(m_ExchangeDirectory, error);
+  }
+
+  m_ExchangeDirectory.clear();
+  m_Arguments.clear();
+}
+
+bool mitk::InferenceWorker::IsRunning() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return nullptr != m_Process && itksysProcess_GetState(m_Process) == itksysProcess_State_Executing;
+}
+
+mitk::InferenceWorker::ArgumentListType mitk::InferenceWorker::GetArguments() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Arguments;
+}
+
+mitk::InferenceWorker::Timings mitk::InferenceWorker::GetLastTimings() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_LastTimings;
+}
+
+double mitk::InferenceWorker::GetStartupTime() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_StartupTime;
+}
+
+void mitk::InferenceWorker::WaitForFile(const std::string &path)
+{
+  const auto start = Clock::now();
+
+  while (!itksys::SystemTools::FileExists(path, true))
+  {
+    char *data = nullptr;
+    int length = 0;
+    double timeout = 0.005;
+
+    const int pipe = itksysProcess_WaitForData(m_Process, &data, &length, &timeout);
+
+    this->CollectOutput(pipe, data, length);
+
+    if (pipe == itksysProcess_Pipe_None && !itksys::SystemTools::FileExists(path, true))
+    {
+      // All pipes are closed, i.e. the worker has terminated
+      itksysProcess_WaitForExit(m_Process, nullptr);
+      const auto exitValue = itksysProcess_GetExitValue(m_Process);
+      this->StopWorker();
+      mitkThrow() << "Inference worker terminated unexpectedly (exit value " << exitValue << ").";
+    }
+
+    if (SecondsSince(start) > m_Timeout)
+    {
+      this->StopWorker();
+      mitkThrow() << "Inference worker did not respond within " << m_Timeout << " s.";
+    }
+  }
+}
+
+void mitk::InferenceWorker::DrainOutput()
+{
+  if (nullptr == m_Process)
+    return;
+
+  while (true)
+  {
+    char *data = nullptr;
+    int length = 0;
+    double timeout = 0.0;
+
+    const int pipe = itksysProcess_WaitForData(m_Process, &data, &length, &timeout);
+
+    if (pipe != itksysProcess_Pipe_STDOUT && pipe != itksysProcess_Pipe_STDERR)
+      break;
+
+    this->CollectOutput(pipe, data, length);
+  }
+}
+
+void mitk::InferenceWorker::CollectOutput(int pipe, const char *data, int length)
+{
+  if (pipe == itksysProcess_Pipe_STDOUT || pipe == itksysProcess_Pipe_STDERR)
+    m_Output.emplace_back(pipe == itksysProcess_Pipe_STDERR, std::string(data, length));
+}
+
+void mitk::InferenceWorker::InvokeOutputEvents(const OutputListType &output)
+{
+  for (const auto &entry : output)
+  {
+    if (entry.first)
+    {
+      this->InvokeEvent(ExternalProcessStdErrEvent(entry.second));
+    }
+    else
+    {
+      this->InvokeEvent(ExternalProcessStdOutEvent(entry.second));
+    }
+  }
+}
+
+mitk::Image::Pointer mitk::InferenceWorker::Process(const Image *input, const ParameterMapType &parameters)
+{
+  std::exception_ptr error;
+  OutputListType output;
+  Image::Pointer result;
+
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
+    try
+    {
+      result = this->ProcessRequest(input, parameters);
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+
+    output.swap(m_Output);
+  }
+
+  this->InvokeOutputEvents(output);
+
+  if (error)
+    std::rethrow_exception(error);
+
+  return result;
+}
+
+mitk::Image::Pointer mitk::InferenceWorker::ProcessRequest(const Image *input, const ParameterMapType &parameters)
+{
+  if (nullptr == m_Process || itksysProcess_GetState(m_Process) != itksysProcess_State_Executing)
+    mitkThrow() << "Inference worker is not running.";
+
+  if (nullptr == input)
+    mitkThrow() << "No input image given.";
+
+  if (input->GetDimension() < 2 || input->GetDimension() > 3)
+    mitkThrow() << "Inference worker only supports 2D and 3D images.";
+
+  // Output the worker has written between requests (e.g. by background threads of the backend)
+  this->DrainOutput();
+
+  Timings timings;
+  const auto id = std::to_string(m_NextRequestId);
+  const auto prefix = m_ExchangeDirectory + IOUtil::GetDirectorySeparator();
+  const auto inputPath = prefix + "request-" + id + ".raw";
+  const auto outputPath = prefix + "response-" + id + ".raw";
+  const auto responsePath = prefix + "response-" + id + ".json";
+
+  // Request
+  auto start = Clock::now();
+
+  const std::array<unsigned int, 3> dimensions = { input->GetDimension(0), input->GetDimension(1), input->GetDimension() == 3 ? input->GetDimension(2) : 1 };
+  const std::size_t numberOfVoxels = static_cast<std::size_t>(dimensions[0]) * dimensions[1] * dimensions[2];
+
+  {
+    ImageReadAccessor accessor(input);
+    std::ofstream stream(inputPath, std::ios_base::binary);
+    stream.write(static_cast<const char *>(accessor.GetData()), numberOfVoxels * input->GetPixelType().GetSize());
+
+    if (!stream.good())
+      mitkThrow() << "Cannot write " << inputPath << ".";
+  }
+
+  const auto geometry = input->GetGeometry();
+  const auto spacing = geometry->GetSpacing();
+  const auto origin = geometry->GetOrigin();
+  const auto matrix = geometry->GetIndexToWorldTransform()->GetMatrix();
+
+  auto direction = nlohmann::json::array();
+
+  for (unsigned int row = 0; row < 3; ++row)
+  {
+    for (unsigned int col = 0; col < 3; ++col)
+      direction.push_back(matrix[row][col] / spacing[col]);
+  }
+
+  nlohmann::json request = {
+    { "id", m_NextRequestId },
+    { "input", "request-" + id + ".raw" },
+    { "output", "response-" + id + ".raw" },
+    { "dtype", GetDataType(input->GetPixelType()) },
+    { "shape", dimensions },
+    { "spacing", { spacing[0], spacing[1], spacing[2] } },
+    { "origin", { origin[0], origin[1], origin[2] } },
+    { "direction", direction },
+    { "parameters", parameters }
+  };
+
+  WriteJson(prefix + "request-" + id + ".json", request);
+  ++m_NextRequestId;
+
+  timings.WriteInput = SecondsSince(start);
+
+  // Response
+  start = Clock::now();
+
+  try
+  {
+    this->WaitForFile(responsePath);
+  }
+  catch (...)
+  {
+    RemoveFile(inputPath);
+    throw;
+  }
+
+  timings.Roundtrip = SecondsSince(start);
+
+  // The worker flushes its output before it writes the response
+  this->DrainOutput();
+
+  start = Clock::now();
+
+  auto response = ReadJson(responsePath);
+  RemoveFile(responsePath);
+  RemoveFile(inputPath);
+
+  if (response.value("status", "") != "ok")
+  {
+    RemoveFile(outputPath);
+    mitkThrow() << "Inference worker failed: " << response.value("message", "unknown error");
+  }
+
+  auto output = Image::New();
+  output->Initialize(MakePixelType(response.value("dtype", "")), input->GetDimension(), input->GetDimensions());
+  output->SetGeometry(static_cast<BaseGeometry *>(geometry->Clone().GetPointer()));
+
+  {
+    const auto size = numberOfVoxels * output->GetPixelType().GetSize();
+    ImageWriteAccessor accessor(output);
+    std::ifstream stream(outputPath, std::ios_base::binary);
+    stream.read(static_cast<char *>(accessor.GetData()), size);
+
+    const bool complete = stream.gcount() == static_cast<std::streamsize>(size);
+    stream.close();
+    RemoveFile(outputPath);
+
+    if (!complete)
+      mitkThrow() << "Result of the inference worker is incomplete.";
+  }
+
+  timings.ReadOutput = SecondsSince(start);
+
+  for (const auto &phase : response["timings"].items())
+    timings.WorkerPhases[phase.key()] = phase.value().get<double>();
+
+  m_LastTimings = timings;
+
+  std::ostringstream phases;
+
+  for (const auto &phase : timings.WorkerPhases)
+    phases << ", " << phase.first << ": " << phase.second << " s";
+
+  MITK_INFO << "Inference worker request " << id << ": write input: " << timings.WriteInput << " s, roundtrip: "
+            << timings.Roundtrip << " s (worker" << phases.str() << "), read output: " << timings.ReadOutput << " s";
+
+  return output;
+}
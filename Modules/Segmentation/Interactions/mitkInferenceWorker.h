@@ -0,0 +1,143 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#ifndef mitkInferenceWorker_h
+#define mitkInferenceWorker_h
+
+#include <MitkSegmentationExports.h>
+#include <mitkImage.h>
+#include <mitkProcessExecutor.h>
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mitk
+{
+  /**
+   * @brief Long-lived external process that segments images on request (e.g. a Python process that keeps a
+   * network loaded).
+   *
+   * In contrast to ProcessExecutor, the process is started once and serves multiple requests. Requests and
+   * results are exchanged through files in an exchange directory (see InferenceWorker.py in the module
+   * resources for the protocol). Images are exchanged as uncompressed raw voxel data. By default the exchange
+   * directory is placed in shared memory (/dev/shm) if available.
+   *
+   * Output of the process is passed by invoking ExternalProcessStdOutEvents and ExternalProcessStdErrEvents
+   * when Start() or Process() return. All methods are thread-safe. Events are invoked after the internal lock
+   * has been released, so observers may call methods of the worker.
+   */
+  class MITKSEGMENTATION_EXPORT InferenceWorker : public itk::Object
+  {
+  public:
+    mitkClassMacroItkParent(InferenceWorker, itk::Object);
+    itkFactorylessNewMacro(Self);
+
+    using ArgumentListType = ProcessExecutor::ArgumentListType;
+    using ParameterMapType = std::map<std::string, std::string>;
+
+    /** Durations in seconds of the phases of the last request.*/
+    struct Timings
+    {
+      double WriteInput = 0.0;   ///< Writing the input voxels and the request
+      double Roundtrip = 0.0;    ///< Waiting for the response of the worker
+      double ReadOutput = 0.0;   ///< Reading the result voxels
+      std::map<std::string, double> WorkerPhases; ///< Phases reported by the worker (e.g. "inference")
+    };
+
+    /** Maximum time in seconds to wait for the worker to become ready or to answer a request (default: 3600).*/
+    itkSetMacro(Timeout, double);
+    itkGetConstMacro(Timeout, double);
+
+    /**
+     * @brief Starts the worker process and waits until it is ready. A running worker is stopped first.
+     * @param executionPath Working directory of the process.
+     * @param argumentList Command line of the worker. The first entry is the executable (e.g. the Python
+     * interpreter). "--exchange <directory>" is appended.
+     * @param exchangeDirectory Directory for the exchange of requests and results. If empty, a temporary
+     * directory is created in GetDefaultExchangeBaseDirectory(). It is removed when the worker is stopped.
+     * @throw mitk::Exception if the worker cannot be started or does not become ready.
+     */
+    void Start(const std::string &executionPath, const ArgumentListType &argumentList, const std::string &exchangeDirectory = "");
+
+    /** Stops the worker process. Does nothing if the worker is not running.*/
+    void Stop();
+
+    bool IsRunning() const;
+
+    /** Command line the running worker was started with (without the exchange directory arguments).
+     * Empty if the worker is not running. Can be used to decide if a worker has to be restarted.*/
+    ArgumentListType GetArguments() const;
+
+    /**
+     * @brief Segments a single 3D image with scalar pixel type.
+     * @param input Image to segment.
+     * @param parameters Request parameters passed to the worker backend.
+     * @return Label image with the geometry of the input.
+     * @throw mitk::Exception if the worker is not running, reports an error or does not answer in time.
+     */
+    Image::Pointer Process(const Image *input, const ParameterMapType &parameters = ParameterMapType());
+
+    /** Durations of the last successful call of Process().*/
+    Timings GetLastTimings() const;
+
+    /** Time in seconds from starting the worker until it was ready.*/
+    double GetStartupTime() const;
+
+    /** /dev/shm if it exists, the temporary directory of the system otherwise.*/
+    static std::string GetDefaultExchangeBaseDirectory();
+
+    /** Writes InferenceWorker.py of the module resources into the given directory.
+     * @return Path of the written script.
+     * @throw mitk::Exception if the script cannot be written.*/
+    static std::string WriteWorkerScript(const std::string &directory);
+
+  protected:
+    InferenceWorker();
+    ~InferenceWorker() override;
+
+  private:
+    /** Output of the worker. The flag is true for stderr.*/
+    using OutputListType = std::vector<std::pair<bool, std::string>>;
+
+    void StartWorker(const std::string &executionPath, const ArgumentListType &argumentList, const std::string &exchangeDirectory);
+    Image::Pointer ProcessRequest(const Image *input, const ParameterMapType &parameters);
+
+    /** Waits until the file exists while collecting the output of the worker. The lock must be held.*/
+    void WaitForFile(const std::string &path);
+
+    /** Collects the output the worker has written so far without waiting. The lock must be held.*/
+    void DrainOutput();
+
+    /** Appends data of the given pipe to m_Output.*/
+    void CollectOutput(int pipe, const char *data, int length);
+
+    /** Invokes the output events. The lock must not be held.*/
+    void InvokeOutputEvents(const OutputListType &output);
+
+    void StopWorker();
+
+    mutable std::mutex m_Mutex;
+    itksysProcess *m_Process;
+    std::string m_ExchangeDirectory;
+    bool m_OwnsExchangeDirectory;
+    ArgumentListType m_Arguments;
+    unsigned int m_NextRequestId;
+    double m_Timeout;
+    double m_StartupTime;
+    Timings m_LastTimings;
+    OutputListType m_Output;
+  };
+}
+
+#endif
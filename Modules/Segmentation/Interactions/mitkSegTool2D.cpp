@@ -589,19 +589,13 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
     mitkThrow() << "Cannot write slice to working node. Working node does not contain an image.";
   }
 
-  DiffSliceOperation* undoOperation = nullptr;
+  mitk::Image::Pointer originalSlice;
 
   if (allowUndo)
   {
     /*============= BEGIN undo/redo feature block ========================*/
-    // Create undo operation by caching the not yet modified slices
-    mitk::Image::Pointer originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
-    undoOperation =
-      new DiffSliceOperation(workingImage,
-        originalSlice,
-        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
-        sliceInfo.timestep,
-        sliceInfo.plane);
+    // Cache the not yet modified slice for the undo operation
+    originalSlice = GetAffectedImageSliceAs2DImage(sliceInfo.plane, workingImage, sliceInfo.timestep);
     /*============= END undo/redo feature block ========================*/
   }
 
@@ -646,6 +640,15 @@ void mitk::SegTool2D::WriteSliceToVolume(Image* workingImage, const SliceInforma
         sliceInfo.timestep,
         sliceInfo.plane);
 
+    // specify the undo operation with the original slice, stored as difference to the edited slice
+    auto* undoOperation =
+      new DiffSliceOperation(workingImage,
+        originalSlice,
+        dynamic_cast<SlicedGeometry3D*>(originalSlice->GetGeometry()),
+        sliceInfo.timestep,
+        sliceInfo.plane,
+        doOperation);
+
     // create an operation event for the undo stack
     OperationEvent* undoStackItem =
       new OperationEvent(DiffSliceOperationApplier::GetInstance(), doOperation, undoOperation, "Segmentation");
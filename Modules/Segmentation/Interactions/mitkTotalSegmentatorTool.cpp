@@ -34,6 +34,10 @@ namespace mitk
 
 mitk::TotalSegmentatorTool::~TotalSegmentatorTool()
 {
+  if (m_InferenceWorker.IsNotNull())
+  {
+    m_InferenceWorker->Stop();
+  }
   std::filesystem::remove_all(this->GetMitkTempDir());
 }
 
@@ -96,6 +100,27 @@ void mitk::TotalSegmentatorTool::DoUpdatePreview(const Image *inputAtTimeStep,
   {
     this->SetMitkTempDir(IOUtil::CreateTemporaryDirectory("mitk-XXXXXX"));
   }
+  const bool isSubTask = (this->GetSubTask() != DEFAULT_TOTAL_TASK);
+
+  if (this->GetUseInferenceWorker() && !isSubTask)
+  {
+    try
+    {
+      Image::Pointer outputImage = this->RunInferenceWorker(inputAtTimeStep);
+      auto outputBuffer = mitk::LabelSetImage::New();
+      outputBuffer->InitializeByLabeledImage(outputImage);
+      outputBuffer->SetGeometry(inputAtTimeStep->GetGeometry());
+      mitk::ImageReadAccessor newMitkImgAcc(outputBuffer.GetPointer());
+      this->MapLabelsToSegmentation(outputBuffer, previewImage, m_LabelMapTotal);
+      previewImage->SetVolume(newMitkImgAcc.GetData(), timeStep);
+    }
+    catch (const mitk::Exception &e)
+    {
+      MITK_ERROR << e.GetDescription();
+    }
+    return;
+  }
+
   ProcessExecutor::Pointer spExec = ProcessExecutor::New();
   itk::CStyleCommand::Pointer spCommand = itk::CStyleCommand::New();
   spCommand->SetCallback(&onPythonProcessEvent);
@@ -114,8 +139,7 @@ void mitk::TotalSegmentatorTool::DoUpdatePreview(const Image *inputAtTimeStep,
 
   IOUtil::Save(inputAtTimeStep, inputImagePath);
 
-  outputImagePath = outDir + IOUtil::GetDirectorySeparator() + token + "_000.nii.gz";
-  const bool isSubTask = (this->GetSubTask() != DEFAULT_TOTAL_TASK);
+  outputImagePath = outDir + IOUtil::GetDirectorySeparator() + token + "_000.nii";
   if (isSubTask)
   {
     outputImagePath = outDir;
@@ -292,6 +316,39 @@ void mitk::TotalSegmentatorTool::run_totalsegmentator(ProcessExecutor* spExec,
   }
 }
 
+mitk::Image::Pointer mitk::TotalSegmentatorTool::RunInferenceWorker(const Image *inputAtTimeStep)
+{
+  InferenceWorker::ArgumentListType args;
+  args.push_back(ProcessExecutor::GetOSDependendExecutableName("python"));
+  args.push_back(this->GetMitkTempDir() + IOUtil::GetDirectorySeparator() + "InferenceWorker.py");
+  args.push_back("--backend");
+  args.push_back("totalsegmentator");
+
+  if (this->GetFast())
+  {
+    args.push_back("--fast");
+  }
+
+  args.push_back("--gpu");
+  args.push_back(std::to_string(this->GetGpuId()));
+
+  if (m_InferenceWorker.IsNull())
+  {
+    m_InferenceWorker = InferenceWorker::New();
+    itk::CStyleCommand::Pointer spCommand = itk::CStyleCommand::New();
+    spCommand->SetCallback(&onPythonProcessEvent);
+    m_InferenceWorker->AddObserver(ExternalProcessOutputEvent(), spCommand);
+  }
+
+  if (!m_InferenceWorker->IsRunning() || m_InferenceWorker->GetArguments() != args)
+  {
+    InferenceWorker::WriteWorkerScript(this->GetMitkTempDir());
+    m_InferenceWorker->Start(this->GetPythonPath(), args);
+  }
+
+  return m_InferenceWorker->Process(inputAtTimeStep, {{"task", DEFAULT_TOTAL_TASK}});
+}
+
 void mitk::TotalSegmentatorTool::ParseLabelMapTotalDefault()
 {
   if (!this->GetLabelMapPath().empty())
@@ -15,6 +15,7 @@ found in the LICENSE file.
 #include "mitkSegWithPreviewTool.h"
 #include <MitkSegmentationExports.h>
 #include "mitkProcessExecutor.h"
+#include "mitkInferenceWorker.h"
 
 
 namespace us
@@ -61,6 +62,13 @@ namespace mitk
     itkGetConstMacro(Fast, bool);
     itkBooleanMacro(Fast);
 
+    /** If enabled, the default task is segmented by a persistent InferenceWorker that keeps the Python
+     * interpreter and TotalSegmentator loaded between previews. Images are exchanged uncompressed.
+     * Sub tasks always start a separate TotalSegmentator process.*/
+    itkSetMacro(UseInferenceWorker, bool);
+    itkGetConstMacro(UseInferenceWorker, bool);
+    itkBooleanMacro(UseInferenceWorker);
+
     /**
      * @brief Static function to print out everything from itk::EventObject.
      * Used as callback in mitk::ProcessExecutor object.
@@ -97,6 +105,13 @@ namespace mitk
      */
     void run_totalsegmentator(ProcessExecutor*, const std::string&, const std::string&, bool, bool, unsigned int, const std::string&);
 
+    /**
+     * @brief Segments the input with the default task using the inference worker. The worker is
+     * (re)started if it is not running or was started with other settings.
+     *
+     */
+    Image::Pointer RunInferenceWorker(const Image*);
+
     /**
      * @brief Applies the m_LabelMapTotal lookup table on the output segmentation LabelSetImage.
      * 
@@ -134,7 +149,9 @@ namespace mitk
     unsigned int m_GpuId = 0;
     std::map<mitk::Label::PixelType, std::string> m_LabelMapTotal;
     bool m_Fast = true;
-    const std::string TEMPLATE_FILENAME = "XXXXXX_000_0000.nii.gz";
+    bool m_UseInferenceWorker = false;
+    InferenceWorker::Pointer m_InferenceWorker;
+    const std::string TEMPLATE_FILENAME = "XXXXXX_000_0000.nii";
     const std::string DEFAULT_TOTAL_TASK = "total";
     const std::unordered_map<std::string, std::vector<std::string>> SUBTASKS_MAP =
     {
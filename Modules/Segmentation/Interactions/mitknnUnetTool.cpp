@@ -28,6 +28,10 @@ namespace mitk
 
 mitk::nnUNetTool::~nnUNetTool()
 {
+  if (m_InferenceWorker.IsNotNull())
+  {
+    m_InferenceWorker->Stop();
+  }
   std::filesystem::remove_all(this->GetMitkTempDir());
 }
 
@@ -137,6 +141,27 @@ void mitk::nnUNetTool::DoUpdatePreview(const Image* inputAtTimeStep, const Image
   {
     this->SetMitkTempDir(IOUtil::CreateTemporaryDirectory("mitk-nnunet-XXXXXX"));
   }
+
+  if (this->GetUseInferenceWorker() && !this->GetMultiModal() && !this->GetEnsemble() && m_ParamQ.size() == 1 &&
+      m_ParamQ.front().model.find("cascade") == std::string::npos)
+  {
+    try
+    {
+      Image::Pointer outputImage = this->RunInferenceWorker(inputAtTimeStep, m_ParamQ.front());
+      previewImage->InitializeByLabeledImage(outputImage);
+      previewImage->SetGeometry(inputAtTimeStep->GetGeometry());
+      m_InputBuffer = inputAtTimeStep;
+      m_OutputBuffer = mitk::LabelSetImage::New();
+      m_OutputBuffer->InitializeByLabeledImage(outputImage);
+      m_OutputBuffer->SetGeometry(inputAtTimeStep->GetGeometry());
+    }
+    catch (const mitk::Exception &e)
+    {
+      MITK_ERROR << e.GetDescription();
+    }
+    return;
+  }
+
   std::string inDir, outDir, inputImagePath, outputImagePath, scriptPath;
 
   ProcessExecutor::Pointer spExec = ProcessExecutor::New();
@@ -321,3 +346,69 @@ void mitk::nnUNetTool::DoUpdatePreview(const Image* inputAtTimeStep, const Image
     return;
   }
 }
+
+mitk::Image::Pointer mitk::nnUNetTool::RunInferenceWorker(const Image *inputAtTimeStep, const ModelParams &modelparam)
+{
+  const auto separator = IOUtil::GetDirectorySeparator();
+
+  InferenceWorker::ArgumentListType args;
+#ifdef _WIN32
+  args.push_back(ProcessExecutor::GetOSDependendExecutableName("python"));
+#else
+  args.push_back(ProcessExecutor::GetOSDependendExecutableName("python3"));
+#endif
+  args.push_back(this->GetMitkTempDir() + separator + "InferenceWorker.py");
+  args.push_back("--backend");
+  args.push_back("nnunet");
+
+  args.push_back("--model-folder");
+  args.push_back(this->GetModelDirectory() + separator + "nnUNet" + separator + modelparam.model + separator +
+                 modelparam.task + separator + modelparam.trainer + "__" + modelparam.planId);
+
+  if (!modelparam.folds.empty())
+  {
+    args.push_back("--folds");
+    for (const auto &fold : modelparam.folds)
+    {
+      args.push_back(fold);
+    }
+  }
+
+  if (this->GetMixedPrecision())
+  {
+    args.push_back("--mixed-precision");
+  }
+
+  if (this->GetMirror())
+  {
+    args.push_back("--mirror");
+  }
+
+  args.push_back("--gpu");
+  args.push_back(std::to_string(this->GetGpuId()));
+
+  if (this->GetNoPip())
+  {
+    args.push_back("--sys-path");
+    args.push_back(this->GetnnUNetDirectory());
+  }
+
+  if (m_InferenceWorker.IsNull())
+  {
+    m_InferenceWorker = InferenceWorker::New();
+    itk::CStyleCommand::Pointer spCommand = itk::CStyleCommand::New();
+    spCommand->SetCallback(&onPythonProcessEvent);
+    m_InferenceWorker->AddObserver(ExternalProcessOutputEvent(), spCommand);
+  }
+
+  if (!m_InferenceWorker->IsRunning() || m_InferenceWorker->GetArguments() != args)
+  {
+    std::string resultsFolderEnv = "RESULTS_FOLDER=" + this->GetModelDirectory();
+    itksys::SystemTools::PutEnv(resultsFolderEnv.c_str());
+
+    InferenceWorker::WriteWorkerScript(this->GetMitkTempDir());
+    m_InferenceWorker->Start(this->GetPythonPath(), args);
+  }
+
+  return m_InferenceWorker->Process(inputAtTimeStep);
+}
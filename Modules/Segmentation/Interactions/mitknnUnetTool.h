@@ -16,6 +16,7 @@ found in the LICENSE file.
 #include "mitkSegWithPreviewTool.h"
 #include "mitkCommon.h"
 #include "mitkToolManager.h"
+#include "mitkInferenceWorker.h"
 #include <MitkSegmentationExports.h>
 #include <mitkStandardFileLocations.h>
 #include <numeric>
@@ -120,6 +121,15 @@ namespace mitk
     itkSetMacro(GpuId, unsigned int);
     itkGetConstMacro(GpuId, unsigned int);
 
+    /**
+     * @brief If enabled, single (non-cascade) models are run by a persistent InferenceWorker that keeps the
+     * network loaded between previews. Images are exchanged uncompressed. Ensembles and multi-modal inputs
+     * always start nnUNet_predict.
+     */
+    itkSetMacro(UseInferenceWorker, bool);
+    itkGetConstMacro(UseInferenceWorker, bool);
+    itkBooleanMacro(UseInferenceWorker);
+
     /**
      * @brief vector of ModelParams.
      * Size > 1 only for ensemble prediction.
@@ -194,6 +204,12 @@ namespace mitk
     void UpdatePrepare() override;
 
   private:
+    /**
+     * @brief Segments the input with the given model using the inference worker. The worker is (re)started
+     * if it is not running or was started for another model.
+     */
+    Image::Pointer RunInferenceWorker(const Image *inputAtTimeStep, const ModelParams &modelparam);
+
     std::string m_MitkTempDir;
     std::string m_nnUNetDirectory;
     std::string m_ModelDirectory;
@@ -209,6 +225,8 @@ namespace mitk
     bool m_Predict;
     LabelSetImage::Pointer m_OutputBuffer;
     unsigned int m_GpuId;
+    bool m_UseInferenceWorker = false;
+    InferenceWorker::Pointer m_InferenceWorker;
     const std::string m_TEMPLATE_FILENAME = "XXXXXX_000_0000.nii.gz";
   };
 } // namespace mitk
@@ -0,0 +1,244 @@
+"""Persistent inference worker for mitk::InferenceWorker.
+
+The worker is started once and keeps the selected backend (e.g. a loaded
+network) in memory between requests. Requests and responses are exchanged
+through an exchange directory:
+
+- After initialization the worker writes ready.json.
+- The client writes request-<id>.raw (uncompressed voxel data, x fastest)
+  followed by request-<id>.json.
+- The worker writes response-<id>.raw followed by response-<id>.json.
+- A request with "command": "shutdown" ends the worker.
+
+JSON files are written to a temporary name first and renamed afterwards, so
+readers never see partial files. All timings are reported in seconds.
+"""
+
+import argparse
+import array
+import json
+import os
+import sys
+import time
+import traceback
+
+PROTOCOL_VERSION = 1
+POLL_INTERVAL = 0.005
+
+ARRAY_TYPECODES = {
+    "int8": "b", "uint8": "B", "int16": "h", "uint16": "H",
+    "int32": "i", "uint32": "I", "float32": "f", "float64": "d",
+}
+
+
+def write_json(path, content):
+    temp_path = path + ".tmp"
+    with open(temp_path, "w") as stream:
+        json.dump(content, stream)
+    os.replace(temp_path, path)
+
+
+def read_raw_array(path, dtype):
+    values = array.array(ARRAY_TYPECODES[dtype])
+    with open(path, "rb") as stream:
+        values.frombytes(stream.read())
+    return values
+
+
+class ThresholdBackend:
+    """Stand-in backend without third party dependencies. Labels all voxels
+    above the parameter "threshold" with 1."""
+
+    def __init__(self, args):
+        pass
+
+    def predict(self, request, exchange_dir, timings):
+        start = time.perf_counter()
+        values = read_raw_array(os.path.join(exchange_dir, request["input"]), request["dtype"])
+        timings["read"] = time.perf_counter() - start
+
+        start = time.perf_counter()
+        threshold = float(request.get("parameters", {}).get("threshold", 0))
+        labels = array.array("B", (1 if value > threshold else 0 for value in values))
+        timings["inference"] = time.perf_counter() - start
+
+        start = time.perf_counter()
+        with open(os.path.join(exchange_dir, request["output"]), "wb") as stream:
+            labels.tofile(stream)
+        timings["write"] = time.perf_counter() - start
+        return "uint8"
+
+
+class NiftiBackend:
+    """Base for backends that need the input as NIfTI file. Files are written
+    uncompressed into the exchange directory."""
+
+    def __init__(self, args):
+        import numpy
+        import SimpleITK
+        self.numpy = numpy
+        self.sitk = SimpleITK
+
+    def read_input(self, request, exchange_dir, path):
+        data = self.numpy.fromfile(os.path.join(exchange_dir, request["input"]), dtype=request["dtype"])
+        image = self.sitk.GetImageFromArray(data.reshape(list(reversed(request["shape"]))))
+        image.SetSpacing(request["spacing"])
+        image.SetOrigin(request["origin"])
+        image.SetDirection(request["direction"])
+        self.sitk.WriteImage(image, path, False)
+
+    def write_output(self, request, exchange_dir, path):
+        labels = self.sitk.GetArrayFromImage(self.sitk.ReadImage(path))
+        if labels.max(initial=0) < 256:
+            labels = labels.astype(self.numpy.uint8)
+        else:
+            labels = labels.astype(self.numpy.uint16)
+        labels.tofile(os.path.join(exchange_dir, request["output"]))
+        return str(labels.dtype)
+
+    def predict(self, request, exchange_dir, timings):
+        input_path = os.path.join(exchange_dir, "request-%d_0000.nii" % request["id"])
+        output_path = os.path.join(exchange_dir, "request-%d.nii" % request["id"])
+        try:
+            start = time.perf_counter()
+            self.read_input(request, exchange_dir, input_path)
+            timings["read"] = time.perf_counter() - start
+
+            start = time.perf_counter()
+            self.infer(input_path, output_path, request.get("parameters", {}))
+            timings["inference"] = time.perf_counter() - start
+
+            start = time.perf_counter()
+            dtype = self.write_output(request, exchange_dir, output_path)
+            timings["write"] = time.perf_counter() - start
+            return dtype
+        finally:
+            for path in (input_path, output_path):
+                if os.path.exists(path):
+                    os.remove(path)
+
+
+class NnUNetBackend(NiftiBackend):
+    """nnU-Net (v1) backend. Trainer and checkpoints are loaded once."""
+
+    def __init__(self, args):
+        super().__init__(args)
+        from nnunet.training.model_restore import load_model_and_checkpoint_files
+
+        folds = [fold if fold == "all" else int(fold) for fold in args.folds] if args.folds else None
+        self.trainer, self.params = load_model_and_checkpoint_files(
+            args.model_folder, folds, mixed_precision=args.mixed_precision, checkpoint_name="model_final_checkpoint")
+        self.mixed_precision = args.mixed_precision
+        self.mirror = args.mirror
+
+    def infer(self, input_path, output_path, parameters):
+        from nnunet.inference.segmentation_export import save_segmentation_nifti_from_softmax
+
+        trainer = self.trainer
+        data, _, properties = trainer.preprocess_patient([input_path])
+
+        softmax = []
+        for params in self.params:
+            trainer.load_checkpoint_ram(params, False)
+            softmax.append(trainer.predict_preprocessed_data_return_seg_and_softmax(
+                data, do_mirroring=self.mirror, mirror_axes=trainer.data_aug_params["mirror_axes"],
+                use_sliding_window=True, step_size=0.5, use_gaussian=True, all_in_gpu=False,
+                mixed_precision=self.mixed_precision)[1][None])
+        softmax = self.numpy.vstack(softmax).mean(0)
+
+        transpose_forward = trainer.plans.get("transpose_forward")
+        if transpose_forward is not None:
+            transpose_backward = trainer.plans.get("transpose_backward")
+            softmax = softmax.transpose([0] + [i + 1 for i in transpose_backward])
+
+        export_params = trainer.plans.get("segmentation_export_params", {})
+        save_segmentation_nifti_from_softmax(
+            softmax, output_path, properties, export_params.get("interpolation_order", 1),
+            getattr(trainer, "regions_class_order", None), None, None, None, None,
+            export_params.get("force_separate_z"), export_params.get("interpolation_order_z", 0))
+
+
+class TotalSegmentatorBackend(NiftiBackend):
+    """TotalSegmentator backend. Keeps the interpreter and the imported
+    libraries alive between requests."""
+
+    def __init__(self, args):
+        super().__init__(args)
+        from totalsegmentator.python_api import totalsegmentator
+        self.totalsegmentator = totalsegmentator
+        self.fast = args.fast
+
+    def infer(self, input_path, output_path, parameters):
+        self.totalsegmentator(input_path, output_path, ml=True, fast=self.fast,
+                              task=parameters.get("task", "total"), quiet=True)
+
+
+BACKENDS = {
+    "threshold": ThresholdBackend,
+    "nnunet": NnUNetBackend,
+    "totalsegmentator": TotalSegmentatorBackend,
+}
+
+
+def serve(backend, exchange_dir):
+    next_id = 0
+    parent_id = os.getppid()
+    while True:
+        request_path = os.path.join(exchange_dir, "request-%d.json" % next_id)
+        if not os.path.exists(request_path):
+            if os.getppid() != parent_id or not os.path.isdir(exchange_dir):
+                return  # client is gone
+            time.sleep(POLL_INTERVAL)
+            continue
+
+        with open(request_path) as stream:
+            request = json.load(stream)
+        os.remove(request_path)
+
+        if request.get("command") == "shutdown":
+            return
+
+        timings = {}
+        response = {"id": request["id"]}
+        try:
+            response["dtype"] = backend.predict(request, exchange_dir, timings)
+            response["status"] = "ok"
+        except Exception as error:
+            traceback.print_exc()
+            response["status"] = "error"
+            response["message"] = str(error)
+        response["timings"] = timings
+
+        sys.stdout.flush()
+        sys.stderr.flush()
+        write_json(os.path.join(exchange_dir, "response-%d.json" % request["id"]), response)
+        next_id += 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--exchange", required=True, help="exchange directory")
+    parser.add_argument("--backend", choices=sorted(BACKENDS), required=True)
+    parser.add_argument("--model-folder", help="nnunet: trained model folder (<trainer>__<plans>)")
+    parser.add_argument("--folds", nargs="*", default=[], help="nnunet: folds to use")
+    parser.add_argument("--mixed-precision", action="store_true", help="nnunet: use mixed precision")
+    parser.add_argument("--mirror", action="store_true", help="nnunet: use test time mirroring")
+    parser.add_argument("--fast", action="store_true", help="totalsegmentator: use the fast model")
+    parser.add_argument("--gpu", help="value of CUDA_VISIBLE_DEVICES")
+    parser.add_argument("--sys-path", action="append", default=[], help="additional module search path")
+    args = parser.parse_args()
+
+    # Has to be done before the backend imports its libraries
+    if args.gpu is not None:
+        os.environ["CUDA_VISIBLE_DEVICES"] = args.gpu
+    sys.path[:0] = args.sys_path
+
+    start = time.perf_counter()
+    backend = BACKENDS[args.backend](args)
+    write_json(os.path.join(args.exchange, "ready.json"),
+               {"protocol": PROTOCOL_VERSION, "timings": {"startup": time.perf_counter() - start}})
+    serve(backend, args.exchange)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+/*============================================================================
+
+The Medical Imaging Interaction Toolkit (MITK)
+
+Copyright (c) German Cancer Research Center (DKFZ)
+All rights reserved.
+
+Use of this source code is governed by a 3-clause BSD license that can be
+found in the LICENSE file.
+
+============================================================================*/
+
+#include <mitkInferenceWorker.h>
+
+#include <mitkIOUtil.h>
+#include <mitkImageCast.h>
+#include <mitkImagePixelReadAccessor.h>
+#include <mitkTestFixture.h>
+#include <mitkTestingMacros.h>
+
+#include <itkCommand.h>
+#include <itkImage.h>
+#include <itksys/SystemTools.hxx>
+
+#include <filesystem>
+
+class mitkInferenceWorkerTestSuite : public mitk::TestFixture
+{
+  CPPUNIT_TEST_SUITE(mitkInferenceWorkerTestSuite);
+  MITK_TEST(ProcessTest);
+  MITK_TEST(BackendErrorTest);
+  MITK_TEST(NotRunningTest);
+  CPPUNIT_TEST_SUITE_END();
+
+private:
+  std::string m_Python;
+  std::string m_TempDir;
+  mitk::InferenceWorker::ArgumentListType m_Arguments;
+  mitk::Image::Pointer m_Image;
+  std::string m_StdErr;
+  bool m_RunningDuringOutput = false;
+
+  /** Observers may call methods of the worker while output events are invoked.*/
+  void OnStdErr(itk::Object *caller, const itk::EventObject &event)
+  {
+    m_RunningDuringOutput = static_cast<mitk::InferenceWorker *>(caller)->IsRunning();
+    m_StdErr += dynamic_cast<const mitk::ExternalProcessStdErrEvent &>(event).GetOutput();
+  }
+
+public:
+  void setUp() override
+  {
+    m_Python = itksys::SystemTools::FindProgram("python3");
+
+    if (m_Python.empty())
+      m_Python = itksys::SystemTools::FindProgram("python");
+
+    m_StdErr.clear();
+    m_RunningDuringOutput = false;
+
+    m_TempDir = mitk::IOUtil::CreateTemporaryDirectory("mitk-inference-test-XXXXXX");
+    const auto scriptPath = mitk::InferenceWorker::WriteWorkerScript(m_TempDir);
+    m_Arguments = { m_Python, scriptPath, "--backend", "threshold" };
+
+    using ImageType = itk::Image<short, 3>;
+    auto itkImage = ImageType::New();
+    ImageType::SizeType size = { { 4, 3, 2 } };
+    itkImage->SetRegions(size);
+    itkImage->Allocate();
+
+    short value = 0;
+    for (auto *pixel = itkImage->GetBufferPointer(); pixel != itkImage->GetBufferPointer() + 24; ++pixel)
+    {
+      *pixel = value;
+      value += 10;
+    }
+
+    ImageType::SpacingType spacing;
+    spacing[0] = 0.5;
+    spacing[1] = 1.0;
+    spacing[2] = 2.0;
+    itkImage->SetSpacing(spacing);
+
+    mitk::CastToMitkImage(itkImage, m_Image);
+  }
+
+  void tearDown() override
+  {
+    std::filesystem::remove_all(m_TempDir);
+    m_Image = nullptr;
+  }
+
+  void ProcessTest()
+  {
+    if (m_Python.empty())
+    {
+      MITK_WARN << "No Python interpreter found. Skipping test.";
+      return;
+    }
+
+    auto worker = mitk::InferenceWorker::New();
+    worker->SetTimeout(60.0);
+    worker->Start(m_TempDir, m_Arguments);
+    CPPUNIT_ASSERT(worker->IsRunning());
+    CPPUNIT_ASSERT(worker->GetArguments() == m_Arguments);
+
+    // The worker serves multiple requests
+    for (int request = 0; request < 2; ++request)
+    {
+      auto output = worker->Process(m_Image, { { "threshold", "100" } });
+
+      CPPUNIT_ASSERT(output.IsNotNull());
+      CPPUNIT_ASSERT(output->GetPixelType() == mitk::MakeScalarPixelType<unsigned char>());
+      CPPUNIT_ASSERT(mitk::Equal(*(m_Image->GetGeometry()), *(output->GetGeometry()), mitk::eps, true));
+
+      mitk::ImagePixelReadAccessor<unsigned char, 3> accessor(output);
+      const auto *labels = accessor.GetData();
+
+      for (int i = 0; i < 24; ++i)
+        CPPUNIT_ASSERT_EQUAL(i * 10 > 100 ? 1 : 0, static_cast<int>(labels[i]));
+    }
+
+    const auto timings = worker->GetLastTimings();
+    CPPUNIT_ASSERT(timings.WorkerPhases.find("inference") != timings.WorkerPhases.end());
+    CPPUNIT_ASSERT(timings.Roundtrip >= timings.WorkerPhases.at("inference"));
+
+    worker->Stop();
+    CPPUNIT_ASSERT(!worker->IsRunning());
+    CPPUNIT_ASSERT(worker->GetArguments().empty());
+  }
+
+  void BackendErrorTest()
+  {
+    if (m_Python.empty())
+    {
+      MITK_WARN << "No Python interpreter found. Skipping test.";
+      return;
+    }
+
+    auto worker = mitk::InferenceWorker::New();
+    worker->SetTimeout(60.0);
+    worker->Start(m_TempDir, m_Arguments);
+
+    auto command = itk::MemberCommand<mitkInferenceWorkerTestSuite>::New();
+    command->SetCallbackFunction(this, &mitkInferenceWorkerTestSuite::OnStdErr);
+    worker->AddObserver(mitk::ExternalProcessStdErrEvent(), command);
+
+    CPPUNIT_ASSERT_THROW(worker->Process(m_Image, { { "threshold", "abc" } }), mitk::Exception);
+
+    // The traceback of the worker is passed as event
+    CPPUNIT_ASSERT(m_StdErr.find("Traceback") != std::string::npos);
+    CPPUNIT_ASSERT(m_RunningDuringOutput);
+
+    // Errors of single requests do not end the worker
+    CPPUNIT_ASSERT(worker->IsRunning());
+    CPPUNIT_ASSERT(worker->Process(m_Image, { { "threshold", "100" } }).IsNotNull());
+  }
+
+  void NotRunningTest()
+  {
+    auto worker = mitk::InferenceWorker::New();
+
+    CPPUNIT_ASSERT(!worker->IsRunning());
+    CPPUNIT_ASSERT_THROW(worker->Process(m_Image), mitk::Exception);
+    CPPUNIT_ASSERT_THROW(worker->Start(m_TempDir, mitk::InferenceWorker::ArgumentListType()), mitk::Exception);
+  }
+};
+
+MITK_TEST_SUITE_REGISTRATION(mitkInferenceWorker)
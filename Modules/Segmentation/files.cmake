@@ -59,6 +59,7 @@ set(CPP_FILES
   Interactions/mitkPickingTool.cpp
   Interactions/mitknnUnetTool.cpp
   Interactions/mitkProcessExecutor.cpp
+  Interactions/mitkInferenceWorker.cpp
   Interactions/mitkTotalSegmentatorTool.cpp
   Rendering/mitkContourMapper2D.cpp
   Rendering/mitkContourSetMapper2D.cpp
@@ -118,4 +119,6 @@ set(RESOURCE_FILES
 
   Interactions/ContourModelModificationConfig.xml
   Interactions/ContourModelModificationInteractor.xml
+
+  InferenceWorker.py
 )
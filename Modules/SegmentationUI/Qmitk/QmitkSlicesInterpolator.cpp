@@ -370,6 +370,12 @@ QmitkSlicesInterpolator::QmitkSlicesInterpolator(QWidget *parent, const char * /
   connect(&m_Watcher, SIGNAL(finished()), this, SLOT(StopUpdateInterpolationTimer()));
   m_Timer = new QTimer(this);
   connect(m_Timer, SIGNAL(timeout()), this, SLOT(ChangeSurfaceColor()));
+
+  // Coalesce rapid contour edits into a single 3D interpolation
+  m_InterpolationDebounceTimer = new QTimer(this);
+  m_InterpolationDebounceTimer->setSingleShot(true);
+  m_InterpolationDebounceTimer->setInterval(250);
+  connect(m_InterpolationDebounceTimer, SIGNAL(timeout()), this, SLOT(OnInterpolationDebounceTimeout()));
 }
 
 void QmitkSlicesInterpolator::SetDataStorage(mitk::DataStorage::Pointer storage)
@@ -529,6 +535,7 @@ QmitkSlicesInterpolator::~QmitkSlicesInterpolator()
   m_SurfaceInterpolator->UnsetSelectedImage();
 
   delete m_Timer;
+  delete m_InterpolationDebounceTimer;
 }
 
 /**
@@ -1490,6 +1497,7 @@ void QmitkSlicesInterpolator::PrepareInputsFor3DInterpolation()
       if (ret == QMessageBox::Yes)
       {
         //  Maybe set the segmentation node here
+        m_SurfaceInterpolator->PrepareInterpolation();
         m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
         m_Watcher.setFuture(m_Future);
       }
@@ -1564,13 +1572,24 @@ void QmitkSlicesInterpolator::OnInterpolationAborted(const itk::EventObject& /*e
 
 void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::EventObject & /*e*/)
 {
+  // The running interpolation is outdated. Instead of blocking until it is finished, cancel it and
+  // restart the interpolation once the contours did not change for a short while. The previous
+  // result stays visible in the meantime.
+  if (m_Watcher.isRunning())
+    m_SurfaceInterpolator->CancelInterpolation();
+
+  if (m_3DInterpolationEnabled)
+    m_InterpolationDebounceTimer->start();
+}
+
+void QmitkSlicesInterpolator::OnInterpolationDebounceTimeout()
+{
+  // Returns quickly as a running interpolation has been canceled already
   if (m_Watcher.isRunning())
     m_Watcher.waitForFinished();
 
   if (m_3DInterpolationEnabled)
   {
-    m_3DContourNode->SetData(nullptr);
-    m_InterpolatedSurfaceNode->SetData(nullptr);
     auto* workingNode = m_ToolManager->GetWorkingData(0);
 
     if (workingNode == nullptr)
@@ -1583,6 +1602,7 @@ void QmitkSlicesInterpolator::OnSurfaceInterpolationInfoChanged(const itk::Event
       return;
 
     m_SurfaceInterpolator->AddActiveLabelContoursForInterpolation(label->GetValue());
+    m_SurfaceInterpolator->PrepareInterpolation();
     m_Future = QtConcurrent::run(this, &QmitkSlicesInterpolator::Run3DInterpolation);
     m_Watcher.setFuture(m_Future);
   }
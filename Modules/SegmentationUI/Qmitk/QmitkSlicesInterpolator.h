@@ -299,6 +299,12 @@ protected slots:
 
   void StartUpdateInterpolationTimer();
 
+  /**
+   * @brief Starts the 3D interpolation after contour edits settled.
+   *
+   */
+  void OnInterpolationDebounceTimeout();
+
   void StopUpdateInterpolationTimer();
 
   void ChangeSurfaceColor();
@@ -411,6 +417,7 @@ private:
   QFutureWatcher<void> m_ModifyWatcher;
 
   QTimer *m_Timer;
+  QTimer *m_InterpolationDebounceTimer;
 
   QFuture<void> m_PlaneFuture;
   QFutureWatcher<void> m_PlaneWatcher;
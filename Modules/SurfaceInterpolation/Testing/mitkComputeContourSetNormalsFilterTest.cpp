@@ -31,6 +31,7 @@ class mitkComputeContourSetNormalsFilterTestSuite : public mitk::TestFixture
 
   MITK_TEST(TestComputeNormals);
   MITK_TEST(TestComputeNormalsWithHole);
+  MITK_TEST(TestReuseNormalsOfUnchangedContour);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -94,6 +95,33 @@ public:
                            contourWithNormals->GetVtkPolyData()->GetCellData()->GetNormals()->GetNumberOfTuples() ==
                              contourReference->GetVtkPolyData()->GetNumberOfPoints());
   }
+
+  void TestReuseNormalsOfUnchangedContour()
+  {
+    mitk::Surface::Pointer contour =
+      mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath("SurfaceInterpolation/Reference/SingleContour.vtk"));
+    m_ContourNormalsFilter->SetInput(contour);
+    m_ContourNormalsFilter->Update();
+    auto *normals = m_ContourNormalsFilter->GetOutput()->GetVtkPolyData()->GetCellData()->GetNormals();
+
+    // A reset pipeline with an identical copy of the contour must not recompute the normals
+    m_ContourNormalsFilter->Reset();
+    m_ContourNormalsFilter->SetInput(contour->Clone());
+    m_ContourNormalsFilter->Update();
+    auto *reusedNormals = m_ContourNormalsFilter->GetOutput()->GetVtkPolyData()->GetCellData()->GetNormals();
+
+    CPPUNIT_ASSERT_MESSAGE("Normals of unchanged contour were recomputed", normals == reusedNormals);
+
+    m_ContourNormalsFilter->Reset();
+    m_ContourNormalsFilter->ClearNormalsCache();
+    m_ContourNormalsFilter->SetInput(contour->Clone());
+    m_ContourNormalsFilter->Update();
+    auto *recomputedNormals = m_ContourNormalsFilter->GetOutput()->GetVtkPolyData()->GetCellData()->GetNormals();
+
+    CPPUNIT_ASSERT_MESSAGE("Normals were not recomputed after clearing the cache", normals != recomputedNormals);
+    CPPUNIT_ASSERT_MESSAGE("Recomputed normals differ",
+                           normals->GetNumberOfTuples() == recomputedNormals->GetNumberOfTuples());
+  }
 };
 
 MITK_TEST_SUITE_REGISTRATION(mitkComputeContourSetNormalsFilter)
@@ -14,11 +14,16 @@ found in the LICENSE file.
 #include <mitkCreateDistanceImageFromSurfaceFilter.h>
 #include <mitkIOUtil.h>
 #include <mitkImageAccessByItk.h>
+#include <mitkImageReadAccessor.h>
 #include <mitkTestFixture.h>
 #include <mitkTestingMacros.h>
 
 #include <vtkDebugLeaks.h>
 
+#include <cmath>
+
+#include <omp.h>
+
 class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixture
 {
   CPPUNIT_TEST_SUITE(mitkCreateDistanceImageFromSurfaceFilterTestSuite);
@@ -26,6 +31,8 @@ class mitkCreateDistanceImageFromSurfaceFilterTestSuite : public mitk::TestFixtu
   // Basically tests the same as the other test below
   // MITK_TEST(TestCreateDistanceImageForLiver);
   MITK_TEST(TestCreateDistanceImageForTube);
+  MITK_TEST(TestParallelEqualsSerialDistanceImage);
+  MITK_TEST(TestPartitionOfUnityMatchesDenseSolver);
   CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -84,6 +91,111 @@ public:
                            mitk::Equal(*(liverDistanceImageReference), *(liverDistanceImage), 0.0001, true));
   }
 
+  mitk::Image::Pointer CreateTubeDistanceImage(
+    int numberOfThreads,
+    mitk::CreateDistanceImageFromSurfaceFilter::SolverType solver = mitk::CreateDistanceImageFromSurfaceFilter::DenseSolver,
+    double *spacing = nullptr)
+  {
+    const int previousNumberOfThreads = omp_get_max_threads();
+    omp_set_num_threads(numberOfThreads);
+
+    mitk::Image::Pointer segmentationImage =
+      mitk::IOUtil::Load<mitk::Image>(GetTestDataFilePath("SurfaceInterpolation/Reference/SegmentationWithHoles.nrrd"));
+
+    mitk::ComputeContourSetNormalsFilter::Pointer normalsFilter = mitk::ComputeContourSetNormalsFilter::New();
+    mitk::CreateDistanceImageFromSurfaceFilter::Pointer interpolateSurfaceFilter =
+      mitk::CreateDistanceImageFromSurfaceFilter::New();
+
+    normalsFilter->SetSegmentationBinaryImage(segmentationImage);
+    itk::ImageBase<3>::Pointer itkImage = itk::ImageBase<3>::New();
+    AccessFixedDimensionByItk_1(segmentationImage, GetImageBase, 3, itkImage);
+    interpolateSurfaceFilter->SetReferenceImage(itkImage.GetPointer());
+    interpolateSurfaceFilter->SetSolver(solver);
+
+    // Small patches, so the contour set is split into several of them
+    interpolateSurfaceFilter->SetMaximumNumberOfCentersPerPatch(100);
+
+    // A small contour set: the first three contours of the tube
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      std::stringstream s;
+      s << "SurfaceInterpolation/InterpolateWithHoles/ContourWithHoles_" << i << ".vtk";
+      normalsFilter->SetInput(i, mitk::IOUtil::Load<mitk::Surface>(GetTestDataFilePath(s.str())));
+      interpolateSurfaceFilter->SetInput(i, normalsFilter->GetOutput(i));
+    }
+
+    interpolateSurfaceFilter->Update();
+    mitk::Image::Pointer distanceImage = interpolateSurfaceFilter->GetOutput();
+    distanceImage->DisconnectPipeline();
+
+    if (nullptr != spacing)
+      *spacing = interpolateSurfaceFilter->GetDistanceImageSpacing();
+
+    omp_set_num_threads(previousNumberOfThreads);
+
+    return distanceImage;
+  }
+
+  void TestParallelEqualsSerialDistanceImage()
+  {
+    mitk::Image::Pointer serialDistanceImage = CreateTubeDistanceImage(1);
+    mitk::Image::Pointer parallelDistanceImage = CreateTubeDistanceImage(4);
+
+    CPPUNIT_ASSERT(serialDistanceImage.IsNotNull());
+    CPPUNIT_ASSERT(parallelDistanceImage.IsNotNull());
+    CPPUNIT_ASSERT_MESSAGE("Parallel and serial distance images are not equal!",
+                           mitk::Equal(*serialDistanceImage, *parallelDistanceImage, 1e-9, true));
+  }
+
+  void TestPartitionOfUnityMatchesDenseSolver()
+  {
+    double spacing = 0.0;
+    mitk::Image::Pointer denseDistanceImage =
+      CreateTubeDistanceImage(4, mitk::CreateDistanceImageFromSurfaceFilter::DenseSolver, &spacing);
+    mitk::Image::Pointer partitionOfUnityDistanceImage =
+      CreateTubeDistanceImage(4, mitk::CreateDistanceImageFromSurfaceFilter::PartitionOfUnitySolver);
+
+    CPPUNIT_ASSERT(denseDistanceImage.IsNotNull());
+    CPPUNIT_ASSERT(partitionOfUnityDistanceImage.IsNotNull());
+    CPPUNIT_ASSERT(spacing > 0.0);
+    CPPUNIT_ASSERT_MESSAGE("Distance images of both solvers differ in geometry!",
+                           mitk::Equal(*denseDistanceImage->GetGeometry(),
+                                       *partitionOfUnityDistanceImage->GetGeometry(),
+                                       mitk::eps,
+                                       true));
+
+    mitk::ImageReadAccessor denseAccessor(denseDistanceImage);
+    mitk::ImageReadAccessor partitionOfUnityAccessor(partitionOfUnityDistanceImage);
+    auto denseValues = static_cast<const double *>(denseAccessor.GetData());
+    auto partitionOfUnityValues = static_cast<const double *>(partitionOfUnityAccessor.GetData());
+
+    const auto numberOfVoxels = denseDistanceImage->GetDimension(0) * denseDistanceImage->GetDimension(1) *
+                                denseDistanceImage->GetDimension(2);
+
+    unsigned int numberOfSignDifferences = 0;
+    unsigned int numberOfNarrowBandVoxels = 0;
+    double sumOfNarrowBandErrors = 0.0;
+
+    for (unsigned int i = 0; i < numberOfVoxels; ++i)
+    {
+      if ((denseValues[i] < 0.0) != (partitionOfUnityValues[i] < 0.0))
+        ++numberOfSignDifferences;
+
+      // The segmentation is extracted from the zero level set, so the accuracy matters close to it
+      if (std::abs(denseValues[i]) < 2 * spacing && std::abs(partitionOfUnityValues[i]) < 2 * spacing)
+      {
+        ++numberOfNarrowBandVoxels;
+        sumOfNarrowBandErrors += std::abs(denseValues[i] - partitionOfUnityValues[i]);
+      }
+    }
+
+    CPPUNIT_ASSERT(numberOfNarrowBandVoxels > 0);
+    CPPUNIT_ASSERT_MESSAGE("Partition of unity changes the inside of more than 1% of the voxels!",
+                           numberOfSignDifferences <= numberOfVoxels / 100);
+    CPPUNIT_ASSERT_MESSAGE("Partition of unity deviates by more than 10% of the spacing in the narrow band!",
+                           sumOfNarrowBandErrors / numberOfNarrowBandVoxels < 0.1 * spacing);
+  }
+
   void TestCreateDistanceImageForTube()
   {
     // That's the number of available contours with holes in MITK-Data
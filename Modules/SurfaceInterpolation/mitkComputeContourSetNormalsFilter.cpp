@@ -15,6 +15,52 @@ found in the LICENSE file.
 #include "mitkIOUtil.h"
 #include "mitkImagePixelReadAccessor.h"
 
+namespace
+{
+  // FNV-1a hash over raw bytes
+  void HashBytes(std::uint64_t &hash, const void *data, std::size_t size)
+  {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  // Identifies a contour by its geometry, as reduced contours are recreated for each interpolation
+  std::uint64_t HashContour(vtkPolyData *polyData, double maxSpacing)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    HashBytes(hash, &maxSpacing, sizeof(maxSpacing));
+
+    auto *points = polyData->GetPoints();
+    const auto numberOfPoints = points != nullptr ? points->GetNumberOfPoints() : 0;
+    HashBytes(hash, &numberOfPoints, sizeof(numberOfPoints));
+
+    double p[3];
+
+    for (vtkIdType i = 0; i < numberOfPoints; ++i)
+    {
+      points->GetPoint(i, p);
+      HashBytes(hash, p, sizeof(p));
+    }
+
+    const vtkIdType *cell(nullptr);
+    vtkIdType cellSize(0);
+    auto *polys = polyData->GetPolys();
+
+    for (polys->InitTraversal(); polys->GetNextCell(cellSize, cell);)
+    {
+      HashBytes(hash, &cellSize, sizeof(cellSize));
+      HashBytes(hash, cell, sizeof(vtkIdType) * cellSize);
+    }
+
+    return hash;
+  }
+}
+
 mitk::ComputeContourSetNormalsFilter::ComputeContourSetNormalsFilter()
   : m_SegmentationBinaryImage(nullptr),
     m_MaxSpacing(5),
@@ -35,6 +81,9 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
 {
   unsigned int numberOfInputs = this->GetNumberOfIndexedInputs();
 
+  // Only normals of contours that are still part of the contour set are kept in the cache
+  NormalsCacheType usedNormals;
+
   // Iterating over each input
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
@@ -42,6 +91,16 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
     auto *currentSurface = this->GetInput(i);
     vtkPolyData *polyData = currentSurface->GetVtkPolyData();
 
+    const auto contourHash = HashContour(polyData, m_MaxSpacing);
+    auto cachedNormals = m_NormalsCache.find(contourHash);
+
+    if (cachedNormals != m_NormalsCache.end())
+    {
+      this->GetOutput(i)->GetVtkPolyData()->GetCellData()->SetNormals(cachedNormals->second);
+      usedNormals.insert(*cachedNormals);
+      continue;
+    }
+
     vtkSmartPointer<vtkCellArray> existingPolys = polyData->GetPolys();
 
     vtkSmartPointer<vtkPoints> existingPoints = polyData->GetPoints();
@@ -238,8 +297,12 @@ void mitk::ComputeContourSetNormalsFilter::GenerateData()
 
     Surface::Pointer surface = this->GetOutput(i);
     surface->GetVtkPolyData()->GetCellData()->SetNormals(normals);
+
+    usedNormals[contourHash] = normals;
   } // end for all inputs
 
+  m_NormalsCache.swap(usedNormals);
+
   // Setting progressbar
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(this->m_ProgressStepSize);
@@ -332,6 +395,11 @@ void mitk::ComputeContourSetNormalsFilter::Reset()
   this->SetNthOutput(0, output.GetPointer());
 }
 
+void mitk::ComputeContourSetNormalsFilter::ClearNormalsCache()
+{
+  m_NormalsCache.clear();
+}
+
 void mitk::ComputeContourSetNormalsFilter::SetUseProgressBar(bool status)
 {
   this->m_UseProgressBar = status;
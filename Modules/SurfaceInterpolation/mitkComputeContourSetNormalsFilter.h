@@ -28,6 +28,9 @@ found in the LICENSE file.
 
 #include "mitkImage.h"
 
+#include <cstdint>
+#include <map>
+
 namespace mitk
 {
   /**
@@ -45,6 +48,9 @@ namespace mitk
    Note: If a segmentation binary image is provided this filter assures that the computed normals
          do not point into the segmentation image
 
+   Normals of contours with unchanged geometry are reused from the previous update. The cache is
+   not cleared by Reset() but only by ClearNormalsCache().
+
    $Author: fetzer$
 */
   class MITKSURFACEINTERPOLATION_EXPORT ComputeContourSetNormalsFilter : public SurfaceToSurfaceFilter
@@ -62,6 +68,9 @@ namespace mitk
     // Resets the filter, i.e. removes all inputs and outputs
     void Reset();
 
+    // Discards the normals that were computed for the contours of the previous update
+    void ClearNormalsCache();
+
     void SetMaxSpacing(double);
 
     /**
@@ -96,6 +105,9 @@ namespace mitk
     bool m_UseProgressBar;
     unsigned int m_ProgressStepSize;
 
+    typedef std::map<std::uint64_t, vtkSmartPointer<vtkDoubleArray>> NormalsCacheType;
+    NormalsCacheType m_NormalsCache;
+
   }; // class
 
 } // namespace
@@ -20,9 +20,27 @@ found in the LICENSE file.
 #include "vtkSmartPointer.h"
 
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodIterator.h"
 
-#include <queue>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <numeric>
+#include <set>
+
+namespace
+{
+  // Relative enlargement of the boxes of the partition of unity, so neighboring patches overlap
+  constexpr double PatchOverlap = 0.5;
+
+  // Absolute enlargement of the boxes in units of the distance image spacing. It covers the narrow band, which
+  // extends beyond the outermost centers.
+  constexpr double PatchMargin = 3.0;
+
+  double GetMillisecondsSince(const std::chrono::steady_clock::time_point &start)
+  {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+}
 
 void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 {
@@ -105,7 +123,10 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateEmptyDistanceImage()
 }
 
 mitk::CreateDistanceImageFromSurfaceFilter::CreateDistanceImageFromSurfaceFilter()
-  : m_DistanceImageSpacing(0.0), m_DistanceImageDefaultBufferValue(0.0)
+  : m_Solver(DenseSolver),
+    m_MaximumNumberOfCentersPerPatch(300),
+    m_DistanceImageSpacing(0.0),
+    m_DistanceImageDefaultBufferValue(0.0)
 {
   m_DistanceImageVolume = 50000;
   this->m_UseProgressBar = false;
@@ -121,28 +142,54 @@ mitk::CreateDistanceImageFromSurfaceFilter::~CreateDistanceImageFromSurfaceFilte
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateData()
 {
+  m_Timings = Timings();
+  auto start = std::chrono::steady_clock::now();
+
   this->PreprocessContourPoints();
   this->CreateEmptyDistanceImage();
 
+  m_Timings.Preprocessing = GetMillisecondsSince(start);
+  start = std::chrono::steady_clock::now();
+
   // First of all we have to build the equation-system from the existing contour-edge-points
   this->CreateSolutionMatrixAndFunctionValues();
 
+  m_Timings.MatrixAssembly = GetMillisecondsSince(start);
+
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(1);
 
-  m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+  this->ThrowIfAborted();
+
+  start = std::chrono::steady_clock::now();
+
+  this->SolveEquationSystem();
+
+  m_Timings.Solve = GetMillisecondsSince(start);
 
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
+  this->ThrowIfAborted();
+
+  start = std::chrono::steady_clock::now();
+
   // The last step is to create the distance map with the interpolated distance function
   this->FillDistanceImage();
 
+  m_Timings.Evaluation = GetMillisecondsSince(start);
+
+  MITK_DEBUG << "Distance image from " << m_Centers.size() << " centers: preprocessing " << m_Timings.Preprocessing
+             << " ms, matrix assembly " << m_Timings.MatrixAssembly << " ms, solve " << m_Timings.Solve
+             << " ms, evaluation " << m_Timings.Evaluation << " ms";
+
   if (this->m_UseProgressBar)
     mitk::ProgressBar::GetInstance()->Progress(2);
 
   m_Centers.clear();
   m_Normals.clear();
+  m_CenterCoordinates.resize(0, 3);
+  m_Patches.clear();
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
@@ -168,6 +215,9 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
   PointType currentPoint;
   PointType normal;
 
+  // Points already added as centers, used to eliminate duplicates
+  std::set<std::array<double, 3>> uniquePoints;
+
   for (unsigned int i = 0; i < numberOfInputs; i++)
   {
     auto currentSurface = this->GetInput(i);
@@ -199,9 +249,7 @@ void mitk::CreateDistanceImageFromSurfaceFilter::PreprocessContourPoints()
 
         currentPoint.copy_in(p);
 
-        int count = std::count(m_Centers.begin(), m_Centers.end(), currentPoint);
-
-        if (count == 0)
+        if (uniquePoints.insert({ p[0], p[1], p[2] }).second)
         {
           double currentNormal[3];
           currentCellNormals->GetTuple(cell[j], currentNormal);
@@ -264,26 +312,138 @@ void mitk::CreateDistanceImageFromSurfaceFilter::CreateSolutionMatrixAndFunction
   // Now we have created all centers and all function values. Next step is to create the solution matrix
   numberOfCenters = m_Centers.size();
 
+  // Keep the coordinates in contiguous columns for vectorized distance computations
+  m_CenterCoordinates.resize(numberOfCenters, 3);
+
+  for (unsigned int i = 0; i < numberOfCenters; i++)
+  {
+    m_CenterCoordinates(i, 0) = m_Centers[i][0];
+    m_CenterCoordinates(i, 1) = m_Centers[i][1];
+    m_CenterCoordinates(i, 2) = m_Centers[i][2];
+  }
+
+  if (PartitionOfUnitySolver == m_Solver)
+  {
+    // The local equation systems are assembled and solved by SolveEquationSystem()
+    m_SolutionMatrix.resize(0, 0);
+    m_Patches.clear();
+
+    std::vector<unsigned int> indices(numberOfCenters);
+    std::iota(indices.begin(), indices.end(), 0);
+
+    const Eigen::Vector3d lowerBound = m_CenterCoordinates.colwise().minCoeff().transpose();
+    const Eigen::Vector3d upperBound = m_CenterCoordinates.colwise().maxCoeff().transpose();
+    this->CreatePatches(indices, 0, indices.size(), lowerBound, upperBound);
+
+    return;
+  }
+
   m_SolutionMatrix.resize(numberOfCenters, numberOfCenters);
 
   m_Weights.resize(numberOfCenters);
 
-  PointType p1;
-  PointType p2;
-  double norm;
+  // Calculate the RBF values. Currently using Phi(r) = r with r is the euclidian distance between two points.
+  // The matrix is symmetric, so each column equals the distances of one center to all centers.
+  const auto n = static_cast<int>(numberOfCenters);
 
-  for (unsigned int i = 0; i < numberOfCenters; i++)
+#pragma omp parallel for
+  for (int i = 0; i < n; i++)
+  {
+    m_SolutionMatrix.col(i) = ((m_CenterCoordinates.col(0).array() - m_CenterCoordinates(i, 0)).square() +
+                               (m_CenterCoordinates.col(1).array() - m_CenterCoordinates(i, 1)).square() +
+                               (m_CenterCoordinates.col(2).array() - m_CenterCoordinates(i, 2)).square()).sqrt();
+  }
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::CreatePatches(std::vector<unsigned int> &indices,
+                                                               std::size_t begin,
+                                                               std::size_t end,
+                                                               const Eigen::Vector3d &lowerBound,
+                                                               const Eigen::Vector3d &upperBound)
+{
+  if (end - begin > std::max(m_MaximumNumberOfCentersPerPatch, 1u))
   {
-    for (unsigned int j = 0; j < numberOfCenters; j++)
+    Eigen::Index axis;
+    (upperBound - lowerBound).maxCoeff(&axis);
+
+    const auto median = begin + (end - begin) / 2;
+    std::nth_element(indices.begin() + begin, indices.begin() + median, indices.begin() + end,
+                     [this, axis](unsigned int i, unsigned int j) {
+                       return m_CenterCoordinates(i, axis) < m_CenterCoordinates(j, axis);
+                     });
+
+    const double split = m_CenterCoordinates(indices[median], axis);
+
+    // The boxes of both halves tile the box, so each point of the box lies in one of the enlarged patches
+    Eigen::Vector3d lowerHalfUpperBound = upperBound;
+    lowerHalfUpperBound[axis] = split;
+    Eigen::Vector3d upperHalfLowerBound = lowerBound;
+    upperHalfLowerBound[axis] = split;
+
+    this->CreatePatches(indices, begin, median, lowerBound, lowerHalfUpperBound);
+    this->CreatePatches(indices, median, end, upperHalfLowerBound, upperBound);
+    return;
+  }
+
+  Patch patch;
+  patch.Center = 0.5 * (lowerBound + upperBound);
+  patch.HalfSize = 0.5 * (upperBound - lowerBound) * (1.0 + PatchOverlap) +
+                   Eigen::Vector3d::Constant(PatchMargin * m_DistanceImageSpacing);
+
+  // The patch contains all centers of the enlarged box, not only the ones of its own box
+  std::vector<unsigned int> patchIndices;
+  const auto numberOfCenters = static_cast<unsigned int>(m_CenterCoordinates.rows());
+
+  for (unsigned int i = 0; i < numberOfCenters; ++i)
+  {
+    if (((m_CenterCoordinates.row(i).transpose() - patch.Center).cwiseAbs().array() < patch.HalfSize.array()).all())
+      patchIndices.push_back(i);
+  }
+
+  patch.CenterCoordinates.resize(patchIndices.size(), 3);
+  patch.FunctionValues.resize(patchIndices.size());
+
+  for (std::size_t i = 0; i < patchIndices.size(); ++i)
+  {
+    patch.CenterCoordinates.row(i) = m_CenterCoordinates.row(patchIndices[i]);
+    patch.FunctionValues[i] = m_FunctionValues[patchIndices[i]];
+  }
+
+  m_Patches.push_back(patch);
+}
+
+void mitk::CreateDistanceImageFromSurfaceFilter::SolveEquationSystem()
+{
+  if (PartitionOfUnitySolver != m_Solver)
+  {
+    m_Weights = m_SolutionMatrix.partialPivLu().solve(m_FunctionValues);
+    return;
+  }
+
+  // Each patch is a small, independent equation system with the same basis function as the dense solver
+  const auto numberOfPatches = static_cast<int>(m_Patches.size());
+
+#pragma omp parallel for schedule(dynamic)
+  for (int p = 0; p < numberOfPatches; ++p)
+  {
+    auto &patch = m_Patches[p];
+    const auto &coordinates = patch.CenterCoordinates;
+    const auto n = coordinates.rows();
+
+    Eigen::MatrixXd solutionMatrix(n, n);
+
+    for (Eigen::Index i = 0; i < n; ++i)
     {
-      // Calculate the RBF value. Currently using Phi(r) = r with r is the euclidian distance between two points
-      p1 = m_Centers.at(i);
-      p2 = m_Centers.at(j);
-      p1 = p1 - p2;
-      norm = p1.two_norm();
-      m_SolutionMatrix(i, j) = norm;
+      solutionMatrix.col(i) = ((coordinates.col(0).array() - coordinates(i, 0)).square() +
+                               (coordinates.col(1).array() - coordinates(i, 1)).square() +
+                               (coordinates.col(2).array() - coordinates(i, 2)).square()).sqrt();
     }
+
+    patch.Weights = solutionMatrix.partialPivLu().solve(patch.FunctionValues);
   }
+
+  MITK_DEBUG << "Partition of unity with " << m_Patches.size() << " patches for " << m_CenterCoordinates.rows()
+             << " centers";
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
@@ -292,17 +452,15 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   * Now we must calculate the distance for each pixel. But instead of calculating the distance value
   * for all of the image's pixels we proceed similar to the region growing algorithm:
   *
-  * 1. Take the first pixel from the narrowband_point_list and calculate the distance for each neighbor (6er)
-  * 2. If the current index's distance value is below a certain threshold push it into the list
-  * 3. Next iteration take the next index from the list and originAsIndex with 1. again
+  * 1. Calculate the distance for each unvisited neighbor (6er) of the pixels in the narrowband_point_list
+  * 2. Every neighbor whose distance value is below a certain threshold forms the next narrowband_point_list
+  * 3. Next iteration start with 1. again
   *
   * This is done until the narrowband_point_list is empty.
   */
 
   typedef itk::ImageRegionIteratorWithIndex<DistanceImageType> ImageIterator;
-  typedef itk::NeighborhoodIterator<DistanceImageType> NeighborhoodImageIterator;
 
-  std::queue<DistanceImageType::IndexType> narrowbandPoints;
   PointType currentPoint = m_Centers.at(0);
   double distance = this->CalculateDistanceValue(currentPoint);
 
@@ -316,49 +474,78 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   DistanceImageType::IndexType currentIndex;
   m_DistanceImageITK->TransformPhysicalPointToIndex(currentPointAsPoint, currentIndex);
 
-  assert(
-    m_DistanceImageITK->GetLargestPossibleRegion().IsInside(currentIndex)); // we are quite certain this should hold
+  const auto region = m_DistanceImageITK->GetLargestPossibleRegion();
+
+  assert(region.IsInside(currentIndex)); // we are quite certain this should hold
 
-  narrowbandPoints.push(currentIndex);
   m_DistanceImageITK->SetPixel(currentIndex, distance);
 
-  NeighborhoodImageIterator::RadiusType radius;
-  radius.Fill(1);
-  NeighborhoodImageIterator nIt(radius, m_DistanceImageITK, m_DistanceImageITK->GetLargestPossibleRegion());
-  unsigned int relativeNbIdx[] = {4, 10, 12, 14, 16, 22};
+  // Each pixel is evaluated at most once
+  std::vector<char> visited(region.GetNumberOfPixels(), 0);
+  visited[m_DistanceImageITK->ComputeOffset(currentIndex)] = 1;
+
+  // The narrow band grows one layer of 6-neighbors at a time. All pixels of a layer are
+  // independent of each other and are evaluated in parallel.
+  std::vector<DistanceImageType::IndexType> narrowbandPoints = { currentIndex };
+  std::vector<DistanceImageType::IndexType> candidates;
+  std::vector<double> candidateDistances;
 
-  bool isInBounds = false;
   while (!narrowbandPoints.empty())
   {
-    nIt.SetLocation(narrowbandPoints.front());
-    narrowbandPoints.pop();
+    this->ThrowIfAborted();
+
+    candidates.clear();
 
-    unsigned int *relativeNb = &relativeNbIdx[0];
-    for (int i = 0; i < 6; i++)
+    for (const auto &index : narrowbandPoints)
     {
-      nIt.GetPixel(*relativeNb, isInBounds);
-      if (isInBounds && nIt.GetPixel(*relativeNb) == m_DistanceImageDefaultBufferValue)
+      for (unsigned int dim = 0; dim < 3; ++dim)
       {
-        currentIndex = nIt.GetIndex(*relativeNb);
+        for (int step = -1; step <= 1; step += 2)
+        {
+          auto neighbor = index;
+          neighbor[dim] += step;
 
-        // Transform the currently checked point from index-coordinates to
-        // world-coordinates
-        m_DistanceImageITK->TransformIndexToPhysicalPoint(currentIndex, currentPointAsPoint);
+          if (!region.IsInside(neighbor))
+            continue;
 
-        // create a vnl_vector
-        currentPoint[0] = currentPointAsPoint[0];
-        currentPoint[1] = currentPointAsPoint[1];
-        currentPoint[2] = currentPointAsPoint[2];
+          auto &isVisited = visited[m_DistanceImageITK->ComputeOffset(neighbor)];
 
-        // and check the distance
-        distance = this->CalculateDistanceValue(currentPoint);
-        if (std::fabs(distance) <= m_DistanceImageSpacing * 2)
-        {
-          nIt.SetPixel(*relativeNb, distance);
-          narrowbandPoints.push(currentIndex);
+          if (0 == isVisited)
+          {
+            isVisited = 1;
+            candidates.push_back(neighbor);
+          }
         }
       }
-      relativeNb++;
+    }
+
+    const auto numberOfCandidates = static_cast<int>(candidates.size());
+    candidateDistances.resize(candidates.size());
+
+#pragma omp parallel for
+    for (int i = 0; i < numberOfCandidates; ++i)
+    {
+      // Transform the currently checked point from index-coordinates to world-coordinates
+      DistanceImageType::PointType candidatePoint;
+      m_DistanceImageITK->TransformIndexToPhysicalPoint(candidates[i], candidatePoint);
+
+      PointType p;
+      p[0] = candidatePoint[0];
+      p[1] = candidatePoint[1];
+      p[2] = candidatePoint[2];
+
+      candidateDistances[i] = this->CalculateDistanceValue(p);
+    }
+
+    narrowbandPoints.clear();
+
+    for (int i = 0; i < numberOfCandidates; ++i)
+    {
+      if (std::fabs(candidateDistances[i]) <= m_DistanceImageSpacing * 2)
+      {
+        m_DistanceImageITK->SetPixel(candidates[i], candidateDistances[i]);
+        narrowbandPoints.push_back(candidates[i]);
+      }
     }
   }
 
@@ -419,25 +606,59 @@ void mitk::CreateDistanceImageFromSurfaceFilter::FillDistanceImage()
   CastToMitkImage(m_DistanceImageITK, resultImage);
 }
 
-double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p)
+void mitk::CreateDistanceImageFromSurfaceFilter::ThrowIfAborted()
+{
+  if (this->GetAbortGenerateData())
+  {
+    m_Centers.clear();
+    m_Normals.clear();
+    m_CenterCoordinates.resize(0, 3);
+    m_Patches.clear();
+
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetDescription("Distance image creation aborted.");
+    throw e;
+  }
+}
+
+double mitk::CreateDistanceImageFromSurfaceFilter::CalculateDistanceValue(PointType p) const
 {
-  double distanceValue(0);
-  PointType p1;
-  PointType p2;
-  double norm;
+  if (PartitionOfUnitySolver != m_Solver)
+  {
+    return ((m_CenterCoordinates.col(0).array() - p[0]).square() +
+            (m_CenterCoordinates.col(1).array() - p[1]).square() +
+            (m_CenterCoordinates.col(2).array() - p[2]).square()).sqrt().matrix().dot(m_Weights);
+  }
 
-  CenterList::iterator centerIter;
+  // Blend the local distance functions of all patches containing p. The weights are products of smooth bumps
+  // that vanish at the borders of the patches.
+  const Eigen::Vector3d point(p[0], p[1], p[2]);
+  double weightedSum = 0.0;
+  double sumOfWeights = 0.0;
 
-  unsigned int count(0);
-  for (centerIter = m_Centers.begin(); centerIter != m_Centers.end(); centerIter++)
+  for (const auto &patch : m_Patches)
   {
-    p1 = *centerIter;
-    p2 = p - p1;
-    norm = p2.two_norm();
-    distanceValue = distanceValue + (norm * m_Weights[count]);
-    ++count;
+    const Eigen::Array3d t = (point - patch.Center).cwiseAbs().array() / patch.HalfSize.array();
+
+    if ((t >= 1.0).any())
+      continue;
+
+    const double weight = (1.0 - t.square()).square().prod();
+    const auto &coordinates = patch.CenterCoordinates;
+
+    weightedSum += weight * ((coordinates.col(0).array() - p[0]).square() +
+                             (coordinates.col(1).array() - p[1]).square() +
+                             (coordinates.col(2).array() - p[2]).square()).sqrt().matrix().dot(patch.Weights);
+    sumOfWeights += weight;
   }
-  return distanceValue;
+
+  // Points outside of all patches are far from the contours
+  return sumOfWeights > 0.0 ? weightedSum / sumOfWeights : m_DistanceImageDefaultBufferValue;
+}
+
+const mitk::CreateDistanceImageFromSurfaceFilter::Timings &mitk::CreateDistanceImageFromSurfaceFilter::GetTimings() const
+{
+  return m_Timings;
 }
 
 void mitk::CreateDistanceImageFromSurfaceFilter::GenerateOutputInformation()
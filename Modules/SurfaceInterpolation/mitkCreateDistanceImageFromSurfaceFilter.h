@@ -57,6 +57,18 @@ namespace mitk
          adjusted by calling SetDistanceImageVolume(unsigned int volume) which specifies the number ob pixels enclosed
   by the image.
 
+         The equation system is assembled and the distance function is evaluated in parallel if MITK is built
+         with OpenMP. The distance function is only evaluated in a narrow band around its zero level set. By
+         default, the equation system is solved with a dense LU decomposition, i.e. the solve scales cubically with
+         the number of contour points and dominates for large contour sets. SetSolver(PartitionOfUnitySolver)
+         enables a faster approximation: the centers are split into overlapping boxes of at most
+         SetMaximumNumberOfCentersPerPatch() centers each, a small dense system is solved per box and the local
+         distance functions are blended with smooth weights. The durations of the individual phases of the last
+         update are available via GetTimings().
+
+         The computation can be canceled from another thread by calling SetAbortGenerateData(true) while
+         Update() is running. In that case an itk::ProcessAborted exception is thrown.
+
   \ingroup Process
 
   $Author: fetzer$
@@ -74,6 +86,15 @@ namespace mitk
 
     typedef std::vector<Surface::Pointer> SurfaceList;
 
+    /**
+    \brief Method to determine the weights of the radial basis functions.
+    */
+    enum SolverType
+    {
+      DenseSolver,           ///< Global interpolation, exact but cubic in the number of centers (default)
+      PartitionOfUnitySolver ///< Blended local interpolations of overlapping boxes of centers
+    };
+
     mitkClassMacro(CreateDistanceImageFromSurfaceFilter, ImageSource);
     itkFactorylessNewMacro(Self);
     itkCloneMacro(Self);
@@ -99,6 +120,19 @@ namespace mitk
     */
     itkSetMacro(DistanceImageVolume, unsigned int);
 
+    /**
+    \brief Set the solver for the weights of the radial basis functions. Default is DenseSolver.
+    */
+    itkSetMacro(Solver, SolverType);
+    itkGetConstMacro(Solver, SolverType);
+
+    /**
+    \brief Set the number of centers up to which a box is not split any further by the PartitionOfUnitySolver.
+           The boxes are enlarged to overlap, so a local equation system contains more centers. Default is 300.
+    */
+    itkSetMacro(MaximumNumberOfCentersPerPatch, unsigned int);
+    itkGetConstMacro(MaximumNumberOfCentersPerPatch, unsigned int);
+
     void PrintEquationSystem();
 
     // Resets the filter, i.e. removes all inputs and outputs
@@ -120,6 +154,19 @@ namespace mitk
 
     void SetReferenceImage(itk::ImageBase<3>::Pointer referenceImage);
 
+    /**
+      \brief Wall-clock durations of the phases of the last update in milliseconds.
+    */
+    struct Timings
+    {
+      double Preprocessing = 0.0;  // Extraction of contour points and allocation of the distance image
+      double MatrixAssembly = 0.0;
+      double Solve = 0.0;
+      double Evaluation = 0.0;     // Narrow band evaluation of the distance function
+    };
+
+    const Timings &GetTimings() const;
+
   protected:
     CreateDistanceImageFromSurfaceFilter();
     ~CreateDistanceImageFromSurfaceFilter() override;
@@ -127,11 +174,40 @@ namespace mitk
     void GenerateOutputInformation() override;
 
   private:
+    /**
+    * \brief Local interpolation of the PartitionOfUnitySolver. It is valid within the box given by its
+    * center and half size.
+    */
+    struct Patch
+    {
+      Eigen::Vector3d Center;
+      Eigen::Vector3d HalfSize;
+      Eigen::Matrix<double, Eigen::Dynamic, 3> CenterCoordinates;
+      Eigen::VectorXd FunctionValues;
+      Eigen::VectorXd Weights;
+    };
+
     void CreateSolutionMatrixAndFunctionValues();
-    double CalculateDistanceValue(PointType p);
+    void SolveEquationSystem();
+    double CalculateDistanceValue(PointType p) const;
+
+    /**
+    * \brief Splits the box of the given centers at the median of its longest side until each box contains at
+    * most m_MaximumNumberOfCentersPerPatch centers. Creates an enlarged patch for each box.
+    */
+    void CreatePatches(std::vector<unsigned int> &indices,
+                       std::size_t begin,
+                       std::size_t end,
+                       const Eigen::Vector3d &lowerBound,
+                       const Eigen::Vector3d &upperBound);
 
     void FillDistanceImage();
 
+    /**
+    * \brief Throws itk::ProcessAborted if the generation of data was requested to be aborted.
+    */
+    void ThrowIfAborted();
+
     /**
     * \brief This method fills the given variables with the minimum and
     * maximum coordinates that contain all input-points in index- and
@@ -162,6 +238,15 @@ namespace mitk
     Eigen::VectorXd m_FunctionValues;
     Eigen::VectorXd m_Weights;
 
+    // Coordinates of m_Centers as columns (x, y, z)
+    Eigen::Matrix<double, Eigen::Dynamic, 3> m_CenterCoordinates;
+
+    SolverType m_Solver;
+    unsigned int m_MaximumNumberOfCentersPerPatch;
+    std::vector<Patch> m_Patches;
+
+    Timings m_Timings;
+
     DistanceImageType::Pointer m_DistanceImageITK;
     itk::ImageBase<3>::Pointer m_ReferenceImage;
 
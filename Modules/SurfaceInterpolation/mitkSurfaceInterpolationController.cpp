@@ -135,6 +135,7 @@ mitk::SurfaceInterpolationController::SurfaceInterpolationController()
 
   m_InterpolationResult = nullptr;
   m_CurrentNumberOfReducedContours = 0;
+  m_InterpolationCanceled = false;
 }
 
 mitk::SurfaceInterpolationController::~SurfaceInterpolationController()
@@ -562,10 +563,13 @@ void mitk::SurfaceInterpolationController::AddActiveLabelContoursForInterpolatio
 
 void mitk::SurfaceInterpolationController::Interpolate()
 {
+  if (m_InterpolationCanceled)
+    return;
+
   if (!m_SelectedSegmentation->GetTimeGeometry()->IsValidTimePoint(m_CurrentTimePoint))
   {
     MITK_WARN << "No interpolation possible, currently selected timepoint is not in the time bounds of currently selected segmentation. Time point: " << m_CurrentTimePoint;
-    m_InterpolationResult = nullptr;
+    this->SetInterpolationResult(nullptr);
     return;
   }
   const auto currentTimeStep = m_SelectedSegmentation->GetTimeGeometry()->TimePointToTimeStep(m_CurrentTimePoint);
@@ -581,6 +585,9 @@ void mitk::SurfaceInterpolationController::Interpolate()
     }
   }
 
+  if (m_InterpolationCanceled)
+    return;
+
   //  We use the timeSelector to get the segmentation image for the current segmentation.
   mitk::ImageTimeSelector::Pointer timeSelector = mitk::ImageTimeSelector::New();
   timeSelector->SetInput(m_SelectedSegmentation);
@@ -606,10 +613,13 @@ void mitk::SurfaceInterpolationController::Interpolate()
   {
     // If no interpolation is possible reset the interpolation result
     MITK_INFO << "Interpolation impossible: not enough contours.";
-    m_InterpolationResult = nullptr;
+    this->SetInterpolationResult(nullptr);
     return;
   }
 
+  if (m_InterpolationCanceled)
+    return;
+
   // Setting up progress bar
   mitk::ProgressBar::GetInstance()->AddStepsToDo(10);
 
@@ -619,7 +629,22 @@ void mitk::SurfaceInterpolationController::Interpolate()
   imageToSurfaceFilter->SetThreshold(0);
   imageToSurfaceFilter->SetSmooth(true);
   imageToSurfaceFilter->SetSmoothIteration(1);
-  imageToSurfaceFilter->Update();
+
+  try
+  {
+    imageToSurfaceFilter->Update();
+  }
+  catch (const itk::ProcessAborted &)
+  {
+    mitk::ProgressBar::GetInstance()->Progress(20);
+    return;
+  }
+
+  if (m_InterpolationCanceled)
+  {
+    mitk::ProgressBar::GetInstance()->Progress(20);
+    return;
+  }
 
   mitk::Surface::Pointer interpolationResult = mitk::Surface::New();
   interpolationResult->Expand(m_SelectedSegmentation->GetTimeSteps());
@@ -629,7 +654,7 @@ void mitk::SurfaceInterpolationController::Interpolate()
   interpolationResult->SetTimeGeometry(geometry);
 
   interpolationResult->SetVtkPolyData(imageToSurfaceFilter->GetOutput()->GetVtkPolyData(), currentTimeStep);
-  m_InterpolationResult = interpolationResult;
+  interpolationResult->DisconnectPipeline();
 
   m_DistanceImageSpacing = m_InterpolateSurfaceFilter->GetDistanceImageSpacing();
 
@@ -638,13 +663,33 @@ void mitk::SurfaceInterpolationController::Interpolate()
   contoursGeometry->SetFirstTimePoint(timeBounds[0]);
   contoursGeometry->SetStepDuration(timeBounds[1] - timeBounds[0]);
 
+  // The previous result stays available until the new one is complete
+  this->SetInterpolationResult(interpolationResult);
+
   // Last progress step
   mitk::ProgressBar::GetInstance()->Progress(20);
-  m_InterpolationResult->DisconnectPipeline();
+}
+
+void mitk::SurfaceInterpolationController::PrepareInterpolation()
+{
+  m_InterpolationCanceled = false;
+}
+
+void mitk::SurfaceInterpolationController::CancelInterpolation()
+{
+  m_InterpolationCanceled = true;
+  m_InterpolateSurfaceFilter->SetAbortGenerateData(true);
+}
+
+void mitk::SurfaceInterpolationController::SetInterpolationResult(Surface *interpolationResult)
+{
+  std::lock_guard<std::mutex> lock(m_InterpolationResultMutex);
+  m_InterpolationResult = interpolationResult;
 }
 
 mitk::Surface::Pointer mitk::SurfaceInterpolationController::GetInterpolationResult()
 {
+  std::lock_guard<std::mutex> lock(m_InterpolationResultMutex);
   return m_InterpolationResult;
 }
 
@@ -724,6 +769,7 @@ void mitk::SurfaceInterpolationController::SetCurrentInterpolationSession(mitk::
     return;
   }
   m_SelectedSegmentation = currentSegmentationImage.GetPointer();
+  m_NormalsFilter->ClearNormalsCache();
 
   try
   {
@@ -20,6 +20,9 @@ found in the LICENSE file.
 
 #include <MitkSurfaceInterpolationExports.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace mitk
 {
   class ComputeContourSetNormalsFilter;
@@ -177,9 +180,30 @@ namespace mitk
     /**
      * @brief Performs the interpolation.
      *
+     * Meant to be run in a background thread. The result of a previous call stays available via
+     * GetInterpolationResult() until the new result is complete. Normals of contours that did not
+     * change since the previous call are reused.
+     *
+     * Returns immediately if the interpolation has been canceled since the last call of PrepareInterpolation().
      */
     void Interpolate();
 
+    /**
+     * @brief Resets a previous cancellation before an Interpolate() call is scheduled.
+     *
+     * Call on the scheduling thread before the interpolation job is queued, so that a CancelInterpolation()
+     * call while the job is queued or running is not lost.
+     */
+    void PrepareInterpolation();
+
+    /**
+     * @brief Requests a running Interpolate() call to stop as soon as possible.
+     *
+     * Can be called from any thread. The canceled call keeps the previous interpolation result.
+     * Inputs of the interpolation pipeline must not be changed before the canceled call returned.
+     */
+    void CancelInterpolation();
+
     /**
      * @brief Get the Result of the interpolation operation.
      *
@@ -378,6 +402,11 @@ namespace mitk
      */
     void OnLayerChanged();
 
+    /**
+     * @brief Thread-safe replacement of the interpolation result.
+     */
+    void SetInterpolationResult(Surface *interpolationResult);
+
     itk::SmartPointer<ReduceContourSetFilter> m_ReduceFilter;
     itk::SmartPointer<ComputeContourSetNormalsFilter> m_NormalsFilter;
     itk::SmartPointer<CreateDistanceImageFromSurfaceFilter> m_InterpolateSurfaceFilter;
@@ -394,6 +423,8 @@ namespace mitk
     ContourListMap m_ListOfContours;
 
     mitk::Surface::Pointer m_InterpolationResult;
+    std::mutex m_InterpolationResultMutex;
+    std::atomic_bool m_InterpolationCanceled;
 
     unsigned int m_CurrentNumberOfReducedContours;
     unsigned int m_NumberOfConnectionsAdded;
@@ -375,6 +375,60 @@ int mitkToFDistanceImageToSurfaceFilterTest(int /* argc */, char* /*argv*/[])
   }
   MITK_TEST_CONDITION_REQUIRED(compareToInput,"Testing backward transformation compared to original image with interpixeldistance");
 
+  // test that changed intrinsics are not reconstructed with the back-projection of the previous update (Kinect mode)
+  filter->SetReconstructionMode(mitk::ToFDistanceImageToSurfaceFilter::Kinect);
+  cameraIntrinsics->SetFocalLength(2*focalLengthX,2*focalLengthY);
+  filter->Modified();
+  filter->Update();
+  result = filter->GetOutput()->GetVtkPolyData()->GetPoints();
+
+  mitk::ImagePixelReadAccessor<float,2> distanceAccess(image, image->GetSliceData());
+  bool kinectPointsEqual = true;
+  unsigned int numberOfValidQuads = 0;
+  for (unsigned int j=0; j<dimY; j++)
+  {
+    for (unsigned int i=0; i<dimX; i++)
+    {
+      itk::Index<2> index = {{ static_cast<itk::IndexValueType>(i), static_cast<itk::IndexValueType>(j) }};
+      float distance = distanceAccess.GetPixelByIndex(index);
+      if (distance <= mitk::eps)
+      {
+        continue;
+      }
+
+      ToFPoint3D expectedPoint = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(i,j,distance,2*focalLengthX,2*focalLengthY,principalPoint[0],principalPoint[1]);
+      double* res = result->GetPoint(filter->GetVertexIdList()->GetId(i+j*dimX));
+      ToFPoint3D resultPoint;
+      resultPoint[0] = res[0];
+      resultPoint[1] = res[1];
+      resultPoint[2] = res[2];
+
+      if (!mitk::Equal(expectedPoint,resultPoint))
+      {
+        kinectPointsEqual = false;
+      }
+
+      if (i > 0 && j > 0)
+      {
+        itk::Index<2> x_1y = {{ index[0]-1, index[1] }};
+        itk::Index<2> xy_1 = {{ index[0], index[1]-1 }};
+        itk::Index<2> x_1y_1 = {{ index[0]-1, index[1]-1 }};
+        if (distanceAccess.GetPixelByIndex(x_1y) > mitk::eps && distanceAccess.GetPixelByIndex(xy_1) > mitk::eps &&
+            distanceAccess.GetPixelByIndex(x_1y_1) > mitk::eps)
+        {
+          ++numberOfValidQuads;
+        }
+      }
+    }
+  }
+  MITK_TEST_CONDITION_REQUIRED(kinectPointsEqual,"Testing filter with changed intrinsics in Kinect mode");
+  MITK_TEST_CONDITION_REQUIRED(filter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() == 2*numberOfValidQuads,"Testing number of triangles of the mesh");
+
+  filter->SetGenerateTriangularMesh(false);
+  filter->Update();
+  MITK_TEST_CONDITION_REQUIRED(filter->GetOutput()->GetVtkPolyData()->GetNumberOfPolys() == 0,"Testing mesh without triangulation has no triangles");
+  MITK_TEST_CONDITION_REQUIRED(filter->GetOutput()->GetVtkPolyData()->GetNumberOfVerts() == result->GetNumberOfPoints(),"Testing mesh without triangulation has one vertex per point");
+
   //clean up
   delete[] point;
   //  expectedResult->Delete();
@@ -22,10 +22,15 @@ found in the LICENSE file.
 #include <vtkPolyData.h>
 #include <vtkPointData.h>
 #include <vtkFloatArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkSmartPointer.h>
 #include <vtkIdList.h>
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <numeric>
 #include <vtkMath.h>
 
 mitk::ToFDistanceImageToSurfaceFilter::ToFDistanceImageToSurfaceFilter() :
@@ -85,213 +90,375 @@ mitk::Image* mitk::ToFDistanceImageToSurfaceFilter::GetInput( unsigned int idx )
   return static_cast< mitk::Image*>(this->ProcessObject::GetInput(idx));
 }
 
-void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
+namespace
 {
-  mitk::Surface::Pointer output = this->GetOutput();
-  assert(output);
-  mitk::Image::Pointer input = this->GetInput();
-  assert(input);
-  // mesh points
-  int xDimension = input->GetDimension(0);
-  int yDimension = input->GetDimension(1);
-  unsigned int size = xDimension*yDimension; //size of the image-array
-  std::vector<bool> isPointValid;
-  isPointValid.resize(size);
-  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
-  points->SetDataTypeToDouble();
-  vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkCellArray> vertices = vtkSmartPointer<vtkCellArray>::New();
-  vtkSmartPointer<vtkFloatArray> scalarArray = vtkSmartPointer<vtkFloatArray>::New();
-  vtkSmartPointer<vtkFloatArray> textureCoords = vtkSmartPointer<vtkFloatArray>::New();
-  textureCoords->SetNumberOfComponents(2);
-  textureCoords->Allocate(size);
-
-  //Make a vtkIdList to save the ID's of the polyData corresponding to the image
-  //pixel ID's. See below for more documentation.
-  m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
-  //Allocate the object once else it would automatically allocate new memory
-  //for every vertex and perform a copy which is expensive.
-  m_VertexIdList->Allocate(size);
-  m_VertexIdList->SetNumberOfIds(size);
-  for(unsigned int i = 0; i < size; ++i)
+  enum CellMaskValue : unsigned char
   {
-    m_VertexIdList->SetId(i, 0);
-  }
+    NoCell = 0,
+    TriangleCells = 1, // two triangles
+    VertexCell = 2
+  };
+
+  // Back-projects one row of the distance image and returns the number of valid pixels.
+  // The loop has no dependencies between pixels, so it can be vectorized by the compiler.
+  vtkIdType BackProjectRow(const float* distances, const double* numerators, const double* denominators,
+                           double* coordinates, unsigned char* validityMask, int length)
+  {
+    vtkIdType numberOfValidPixels = 0;
 
-  float* scalarFloatData = nullptr;
+    for (int i = 0; i < length; ++i)
+    {
+      const double distance = distances[i];
 
-  if (this->m_IplScalarImage) // if scalar image is defined use it for texturing
-  {
-    scalarFloatData = (float*)this->m_IplScalarImage->imageData;
-  }
-  else if (this->GetInput(m_TextureIndex)) // otherwise use intensity image (input(2))
-  {
-    ImageReadAccessor inputAcc(this->GetInput(m_TextureIndex));
-    scalarFloatData = (float*)inputAcc.GetData();
-  }
+      coordinates[3 * i] = distance * numerators[3 * i] / denominators[3 * i];
+      coordinates[3 * i + 1] = distance * numerators[3 * i + 1] / denominators[3 * i + 1];
+      coordinates[3 * i + 2] = distance * numerators[3 * i + 2] / denominators[3 * i + 2];
 
-  ImageReadAccessor inputAcc(input, input->GetSliceData(0,0,0));
-  float* inputFloatData = (float*)inputAcc.GetData();
-  //calculate world coordinates
-  mitk::ToFProcessingCommon::ToFPoint2D focalLengthInPixelUnits;
-  mitk::ToFProcessingCommon::ToFScalarType focalLengthInMm;
-  if((m_ReconstructionMode == WithOutInterPixelDistance) || (m_ReconstructionMode == Kinect))
-  {
-    focalLengthInPixelUnits[0] = m_CameraIntrinsics->GetFocalLengthX();
-    focalLengthInPixelUnits[1] = m_CameraIntrinsics->GetFocalLengthY();
-    focalLengthInMm = 0.0;
+      //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
+      validityMask[i] = distance <= mitk::eps ? 0 : 1;
+      numberOfValidPixels += validityMask[i];
+    }
+
+    return numberOfValidPixels;
   }
-  else if( m_ReconstructionMode == WithInterPixelDistance)
+
+  vtkSmartPointer<vtkCellArray> CreateCellArray(vtkIdType numberOfCells, vtkIdType cellSize, vtkIdType*& connectivity)
   {
-    //convert focallength from pixel to mm
-    focalLengthInPixelUnits[0] = 0.0;
-    focalLengthInPixelUnits[1] = 0.0;
-    focalLengthInMm = (m_CameraIntrinsics->GetFocalLengthX()*m_InterPixelDistance[0]+m_CameraIntrinsics->GetFocalLengthY()*m_InterPixelDistance[1])/2.0;
+    auto offsetArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsetArray->SetNumberOfValues(numberOfCells + 1);
+    vtkIdType* offsets = offsetArray->GetPointer(0);
+
+    for (vtkIdType i = 0; i <= numberOfCells; ++i)
+      offsets[i] = i * cellSize;
+
+    auto connectivityArray = vtkSmartPointer<vtkIdTypeArray>::New();
+    connectivityArray->SetNumberOfValues(numberOfCells * cellSize);
+    connectivity = connectivityArray->GetPointer(0);
+
+    auto cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->SetData(offsetArray, connectivityArray);
+    return cells;
   }
-  else
+}
+
+void mitk::ToFDistanceImageToSurfaceFilter::UpdateRayCoefficients(int xDimension, int yDimension, const mitk::Point3D& origin, const mitk::Vector3D& spacing)
+{
+  const std::array<double, 11> parameters = {{
+    static_cast<double>(m_ReconstructionMode),
+    m_CameraIntrinsics->GetFocalLengthX(),
+    m_CameraIntrinsics->GetFocalLengthY(),
+    m_CameraIntrinsics->GetPrincipalPointX(),
+    m_CameraIntrinsics->GetPrincipalPointY(),
+    m_InterPixelDistance[0],
+    m_InterPixelDistance[1],
+    origin[0],
+    origin[1],
+    spacing[0],
+    spacing[1] }};
+
+  if (m_RayCoefficients.XDimension == xDimension && m_RayCoefficients.YDimension == yDimension &&
+      m_RayCoefficients.Parameters == parameters)
   {
-    focalLengthInPixelUnits[0] = 0.0;
-    focalLengthInPixelUnits[1] = 0.0;
-    focalLengthInMm = 0.0;
+    return;
   }
 
-  mitk::ToFProcessingCommon::ToFPoint2D principalPoint;
-  principalPoint[0] = m_CameraIntrinsics->GetPrincipalPointX();
-  principalPoint[1] = m_CameraIntrinsics->GetPrincipalPointY();
+  m_RayCoefficients.Parameters = parameters;
+  m_RayCoefficients.XDimension = xDimension;
+  m_RayCoefficients.YDimension = yDimension;
+
+  const std::size_t size = static_cast<std::size_t>(xDimension) * yDimension;
+  m_RayCoefficients.Numerators.assign(3 * size, 0.0);
+  m_RayCoefficients.Denominators.assign(3 * size, 1.0);
+
+  const double focalLengthX = m_CameraIntrinsics->GetFocalLengthX();
+  const double focalLengthY = m_CameraIntrinsics->GetFocalLengthY();
+  const double principalPointX = m_CameraIntrinsics->GetPrincipalPointX();
+  const double principalPointY = m_CameraIntrinsics->GetPrincipalPointY();
 
-  mitk::Point3D origin = input->GetGeometry()->GetOrigin();
-  mitk::Vector3D spacing = input->GetGeometry()->GetSpacing();
+  //convert focallength from pixel to mm
+  const double focalLengthInMm = (focalLengthX*m_InterPixelDistance[0]+focalLengthY*m_InterPixelDistance[1])/2.0;
 
-  for (int j=0; j<yDimension; j++)
+  if (m_ReconstructionMode != WithOutInterPixelDistance && m_ReconstructionMode != WithInterPixelDistance &&
+      m_ReconstructionMode != Kinect)
   {
-    for (int i=0; i<xDimension; i++)
-    {
-      unsigned int pixelID = i+j*xDimension;
+    MITK_ERROR << "Incorrect reconstruction mode!";
+    return;
+  }
 
-      mitk::ToFProcessingCommon::ToFScalarType distance = (double)inputFloatData[pixelID];
+#pragma omp parallel for
+  for (int j = 0; j < yDimension; ++j)
+  {
+    double* numerators = m_RayCoefficients.Numerators.data() + 3 * static_cast<std::size_t>(j) * xDimension;
+    double* denominators = m_RayCoefficients.Denominators.data() + 3 * static_cast<std::size_t>(j) * xDimension;
 
+    for (int i = 0; i < xDimension; ++i, numerators += 3, denominators += 3)
+    {
       /** Here we have to incorporate spacing and origin to allow processing of cropped/resampled images
       * Usually origin will be [0, 0, 0] and spacing will be [1, 1, 1], but just in case the image is moved
       * due to cropping or the spacing differes due to up- or downsampling.*/
       unsigned int completeIndexX = i*spacing[0]+origin[0];
       unsigned int completeIndexY = j*spacing[1]+origin[1];
 
-      mitk::ToFProcessingCommon::ToFPoint3D cartesianCoordinates;
+      // The terms mirror ToFProcessingCommon::IndexToCartesianCoordinates(), IndexToCartesianCoordinatesWithInterpixdist()
+      // and KinectIndexToCartesianCoordinates() operation by operation to produce identical points.
       switch (m_ReconstructionMode)
       {
       case WithOutInterPixelDistance:
       {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
+        const double imageX = completeIndexX - principalPointX;
+        const double imageY = completeIndexY - principalPointY;
+        const double imageY_in_pX = imageY * (focalLengthX / focalLengthY);
+        const double d_in_pX = sqrt(imageX*imageX + imageY_in_pX*imageY_in_pX + focalLengthX*focalLengthX);
+
+        numerators[0] = imageX;
+        numerators[1] = imageY_in_pX;
+        numerators[2] = focalLengthX;
+        denominators[0] = denominators[1] = denominators[2] = d_in_pX;
         break;
       }
       case WithInterPixelDistance:
       {
-        cartesianCoordinates = mitk::ToFProcessingCommon::IndexToCartesianCoordinatesWithInterpixdist(completeIndexX,completeIndexY,distance,focalLengthInMm,m_InterPixelDistance,principalPoint);
+        const double imageX = (completeIndexX - principalPointX) * m_InterPixelDistance[0];
+        const double imageY = (completeIndexY - principalPointY) * m_InterPixelDistance[1];
+        const double d = sqrt(imageX*imageX + imageY*imageY + focalLengthInMm*focalLengthInMm);
+
+        numerators[0] = imageX;
+        numerators[1] = imageY;
+        numerators[2] = focalLengthInMm;
+        denominators[0] = denominators[1] = denominators[2] = d;
         break;
       }
-      case Kinect:
+      default: // Kinect
       {
-        cartesianCoordinates = mitk::ToFProcessingCommon::KinectIndexToCartesianCoordinates(completeIndexX,completeIndexY,distance,focalLengthInPixelUnits,principalPoint);
-        break;
+        numerators[0] = completeIndexX - principalPointX;
+        numerators[1] = completeIndexY - principalPointY;
+        numerators[2] = 1.0;
+        denominators[0] = focalLengthX;
+        denominators[1] = focalLengthY;
+        denominators[2] = 1.0;
       }
-      default:
-      {
-        MITK_ERROR << "Incorrect reconstruction mode!";
       }
+    }
+  }
+}
+
+void mitk::ToFDistanceImageToSurfaceFilter::GenerateData()
+{
+  mitk::Surface::Pointer output = this->GetOutput();
+  assert(output);
+  mitk::Image::Pointer input = this->GetInput();
+  assert(input);
+  // mesh points
+  int xDimension = input->GetDimension(0);
+  int yDimension = input->GetDimension(1);
+  unsigned int size = xDimension*yDimension; //size of the image-array
+
+  const float* scalarFloatData = nullptr;
+  std::unique_ptr<ImageReadAccessor> scalarAcc;
+
+  if (this->m_IplScalarImage) // if scalar image is defined use it for texturing
+  {
+    scalarFloatData = (float*)this->m_IplScalarImage->imageData;
+  }
+  else if (this->GetInput(m_TextureIndex)) // otherwise use intensity image (input(2))
+  {
+    scalarAcc.reset(new ImageReadAccessor(this->GetInput(m_TextureIndex)));
+    scalarFloatData = (const float*)scalarAcc->GetData();
+  }
+
+  ImageReadAccessor inputAcc(input, input->GetSliceData(0,0,0));
+  const float* inputFloatData = (const float*)inputAcc.GetData();
+
+  //calculate world coordinates
+  this->UpdateRayCoefficients(xDimension, yDimension, input->GetGeometry()->GetOrigin(), input->GetGeometry()->GetSpacing());
+
+  m_Coordinates.resize(3 * static_cast<std::size_t>(size));
+  m_ValidityMask.resize(size);
+
+  // Rows are processed independently. Prefix sums over the per-row counts give the position of each row
+  // in the output arrays, so the mesh is identical to a serial pass over the image.
+  std::vector<vtkIdType> rowPointOffsets(yDimension + 1, 0);
+
+#pragma omp parallel for
+  for (int j = 0; j < yDimension; ++j)
+  {
+    const std::size_t rowOffset = static_cast<std::size_t>(j) * xDimension;
+
+    rowPointOffsets[j + 1] = BackProjectRow(inputFloatData + rowOffset,
+                                            m_RayCoefficients.Numerators.data() + 3 * rowOffset,
+                                            m_RayCoefficients.Denominators.data() + 3 * rowOffset,
+                                            m_Coordinates.data() + 3 * rowOffset,
+                                            m_ValidityMask.data() + rowOffset,
+                                            xDimension);
+  }
+
+  std::partial_sum(rowPointOffsets.begin(), rowPointOffsets.end(), rowPointOffsets.begin());
+  const vtkIdType numberOfPoints = rowPointOffsets[yDimension];
+
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numberOfPoints);
+  double* pointData = vtkDoubleArray::SafeDownCast(points->GetData())->GetPointer(0);
+
+  vtkSmartPointer<vtkFloatArray> scalarArray = vtkSmartPointer<vtkFloatArray>::New();
+  float* scalarData = nullptr;
+  if (scalarFloatData)
+  {
+    scalarArray->SetNumberOfValues(numberOfPoints);
+    scalarData = scalarArray->GetPointer(0);
+  }
+
+  vtkSmartPointer<vtkFloatArray> textureCoords = vtkSmartPointer<vtkFloatArray>::New();
+  textureCoords->SetNumberOfComponents(2);
+  textureCoords->SetNumberOfTuples(numberOfPoints);
+  float* textureCoordData = textureCoords->GetPointer(0);
+
+  //Make a vtkIdList to save the ID's of the polyData corresponding to the image
+  //pixel ID's. Invalid pixels are mapped to ID 0.
+  m_VertexIdList = vtkSmartPointer<vtkIdList>::New();
+  m_VertexIdList->SetNumberOfIds(size);
+  vtkIdType* vertexIds = m_VertexIdList->GetPointer(0);
+
+#pragma omp parallel for
+  for (int j = 0; j < yDimension; ++j)
+  {
+    vtkIdType pointID = rowPointOffsets[j];
+
+    for (int i = 0; i < xDimension; ++i)
+    {
+      const std::size_t pixelID = static_cast<std::size_t>(j) * xDimension + i;
+
+      if (!m_ValidityMask[pixelID])
+      {
+        vertexIds[pixelID] = 0;
+        continue;
       }
-      //Epsilon here, because we may have small float values like 0.00000001 which in fact represents 0.
-      if (distance<=mitk::eps)
+
+      //Points are inserted consecutively, so the ID's do not correspond to the image pixel ID's.
+      //Thus, we have to save them in the vertexIdList.
+      vertexIds[pixelID] = pointID;
+      std::copy_n(&m_Coordinates[3 * pixelID], 3, pointData + 3 * pointID);
+
+      //Scalar values are necessary for mapping colors/texture onto the surface
+      if (scalarData)
       {
-        isPointValid[pixelID] = false;
+        scalarData[pointID] = scalarFloatData[pixelID];
       }
-      else
+      //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
+      textureCoordData[2 * pointID] = ((float)i)/xDimension;// correct video texture scale for kinect
+      textureCoordData[2 * pointID + 1] = ((float)j)/yDimension; //don't flip. we don't need to flip.
+
+      ++pointID;
+    }
+  }
+
+  vtkSmartPointer<vtkCellArray> polys;
+  vtkSmartPointer<vtkCellArray> vertices;
+
+  if (m_GenerateTriangularMesh)
+  {
+    // The connectivity of the organized grid is implicit in the pixel ID's, so per frame only
+    // the cells of each quad have to be determined from the validity mask.
+    m_CellMask.assign(size, NoCell);
+    std::vector<vtkIdType> rowTriangleOffsets(yDimension + 1, 0);
+    std::vector<vtkIdType> rowVertexOffsets(yDimension + 1, 0);
+
+#pragma omp parallel for
+    for (int j = 1; j < yDimension; ++j)
+    {
+      for (int i = 1; i < xDimension; ++i)
       {
-        isPointValid[pixelID] = true;
-        //VTK would insert empty points into the polydata if we use
-        //points->InsertPoint(pixelID, cartesianCoordinates.GetDataPointer()).
-        //If we use points->InsertNextPoint(...) instead, the ID's do not
-        //correspond to the image pixel ID's. Thus, we have to save them
-        //in the vertexIdList.
-        m_VertexIdList->SetId(pixelID, points->InsertNextPoint(cartesianCoordinates.GetDataPointer()));
-
-        if (m_GenerateTriangularMesh)
+        //This little piece of art explains the ID's:
+        //
+        // P(x_1y_1)---P(xy_1)
+        // |           |
+        // |           |
+        // |           |
+        // P(x_1y)-----P(xy)
+        //
+        //We can only start triangulation if we are at vertex (1,1),
+        //because we need the other 3 vertices near this one.
+        //To go one pixel line back in the image array, we have to
+        //subtract 1x xDimension.
+        const std::size_t xy = static_cast<std::size_t>(j) * xDimension + i;
+        const std::size_t x_1y = xy-1;
+        const std::size_t xy_1 = xy-xDimension;
+        const std::size_t x_1y_1 = xy_1-1;
+
+        if (m_ValidityMask[xy]&&m_ValidityMask[x_1y]&&m_ValidityMask[x_1y_1]&&m_ValidityMask[xy_1]) // check if points of cell are valid
         {
-          if((i >= 1) && (j >= 1))
+          const double* pointXY = &m_Coordinates[3 * xy];
+          const double* pointX_1Y = &m_Coordinates[3 * x_1y];
+          const double* pointXY_1 = &m_Coordinates[3 * xy_1];
+          const double* pointX_1Y_1 = &m_Coordinates[3 * x_1y_1];
+
+          if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
+                                                               && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
+          {
+            m_CellMask[xy] = TriangleCells;
+            rowTriangleOffsets[j + 1] += 2;
+          }
+          else
           {
-            //This little piece of art explains the ID's:
-            //
-            // P(x_1y_1)---P(xy_1)
-            // |           |
-            // |           |
-            // |           |
-            // P(x_1y)-----P(xy)
-            //
-            //We can only start triangulation if we are at vertex (1,1),
-            //because we need the other 3 vertices near this one.
-            //To go one pixel line back in the image array, we have to
-            //subtract 1x xDimension.
-            vtkIdType xy = pixelID;
-            vtkIdType x_1y = pixelID-1;
-            vtkIdType xy_1 = pixelID-xDimension;
-            vtkIdType x_1y_1 = xy_1-1;
-
-            //Find the corresponding vertex ID's in the saved vertexIdList:
-            vtkIdType xyV = m_VertexIdList->GetId(xy);
-            vtkIdType x_1yV = m_VertexIdList->GetId(x_1y);
-            vtkIdType xy_1V = m_VertexIdList->GetId(xy_1);
-            vtkIdType x_1y_1V = m_VertexIdList->GetId(x_1y_1);
-
-            if (isPointValid[xy]&&isPointValid[x_1y]&&isPointValid[x_1y_1]&&isPointValid[xy_1]) // check if points of cell are valid
-            {
-              double pointXY[3], pointX_1Y[3], pointXY_1[3], pointX_1Y_1[3];
-
-              points->GetPoint(xyV, pointXY);
-              points->GetPoint(x_1yV, pointX_1Y);
-              points->GetPoint(xy_1V, pointXY_1);
-              points->GetPoint(x_1y_1V, pointX_1Y_1);
-
-              if( (mitk::Equal(m_TriangulationThreshold, 0.0)) || ((vtkMath::Distance2BetweenPoints(pointXY, pointX_1Y) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY, pointXY_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointX_1Y, pointX_1Y_1) <= m_TriangulationThreshold)
-                                                                   && (vtkMath::Distance2BetweenPoints(pointXY_1, pointX_1Y_1) <= m_TriangulationThreshold)))
-              {
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1yV);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(x_1y_1V);
-
-                polys->InsertNextCell(3);
-                polys->InsertCellPoint(x_1y_1V);
-                polys->InsertCellPoint(xyV);
-                polys->InsertCellPoint(xy_1V);
-              }
-              else
-              {
-                //We dont want triangulation, but we want to keep the vertex
-                vertices->InsertNextCell(1);
-                vertices->InsertCellPoint(xyV);
-              }
-            }
+            //We dont want triangulation, but we want to keep the vertex
+            m_CellMask[xy] = VertexCell;
+            ++rowVertexOffsets[j + 1];
           }
         }
-        else
+      }
+    }
+
+    std::partial_sum(rowTriangleOffsets.begin(), rowTriangleOffsets.end(), rowTriangleOffsets.begin());
+    std::partial_sum(rowVertexOffsets.begin(), rowVertexOffsets.end(), rowVertexOffsets.begin());
+
+    vtkIdType* triangleConnectivity = nullptr;
+    vtkIdType* vertexConnectivity = nullptr;
+    polys = CreateCellArray(rowTriangleOffsets[yDimension], 3, triangleConnectivity);
+    vertices = CreateCellArray(rowVertexOffsets[yDimension], 1, vertexConnectivity);
+
+#pragma omp parallel for
+    for (int j = 1; j < yDimension; ++j)
+    {
+      vtkIdType* triangles = triangleConnectivity + 3 * rowTriangleOffsets[j];
+      vtkIdType* vertex = vertexConnectivity + rowVertexOffsets[j];
+
+      for (int i = 1; i < xDimension; ++i)
+      {
+        const std::size_t xy = static_cast<std::size_t>(j) * xDimension + i;
+
+        if (m_CellMask[xy] == TriangleCells)
         {
-          //We dont want triangulation, we only want vertices
-          vertices->InsertNextCell(1);
-          vertices->InsertCellPoint(m_VertexIdList->GetId(pixelID));
+          //Find the corresponding vertex ID's in the saved vertexIdList:
+          vtkIdType xyV = vertexIds[xy];
+          vtkIdType x_1yV = vertexIds[xy-1];
+          vtkIdType xy_1V = vertexIds[xy-xDimension];
+          vtkIdType x_1y_1V = vertexIds[xy-xDimension-1];
+
+          *triangles++ = x_1yV;
+          *triangles++ = xyV;
+          *triangles++ = x_1y_1V;
+
+          *triangles++ = x_1y_1V;
+          *triangles++ = xyV;
+          *triangles++ = xy_1V;
         }
-        //Scalar values are necessary for mapping colors/texture onto the surface
-        if (scalarFloatData)
+        else if (m_CellMask[xy] == VertexCell)
         {
-          scalarArray->InsertTuple1(m_VertexIdList->GetId(pixelID), scalarFloatData[pixelID]);
+          *vertex++ = vertexIds[xy];
         }
-        //These Texture Coordinates will map color pixel and vertices 1:1 (e.g. for Kinect).
-        float xNorm = (((float)i)/xDimension);// correct video texture scale for kinect
-        float yNorm = ((float)j)/yDimension; //don't flip. we don't need to flip.
-        textureCoords->InsertTuple2(m_VertexIdList->GetId(pixelID), xNorm, yNorm);
       }
     }
   }
+  else
+  {
+    //We dont want triangulation, we only want vertices
+    vtkIdType* vertexConnectivity = nullptr;
+    polys = vtkSmartPointer<vtkCellArray>::New();
+    vertices = CreateCellArray(numberOfPoints, 1, vertexConnectivity);
+    std::iota(vertexConnectivity, vertexConnectivity + numberOfPoints, vtkIdType(0));
+  }
 
   vtkSmartPointer<vtkPolyData> mesh = vtkSmartPointer<vtkPolyData>::New();
   mesh->SetPoints(points);
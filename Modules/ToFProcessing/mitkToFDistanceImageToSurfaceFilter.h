@@ -26,6 +26,9 @@ found in the LICENSE file.
 
 #include <opencv2/core/types_c.h>
 
+#include <array>
+#include <vector>
+
 namespace mitk
 {
   /**
@@ -170,6 +173,32 @@ namespace mitk
     */
     void CreateOutputsForAllInputs();
 
+    /**
+    * \brief Back-projection coefficients of the organized pixel grid.
+    *
+    * The point of a pixel is calculated per component as distance * numerator / denominator, which yields exactly
+    * the results of the ToFProcessingCommon conversion functions. The coefficients only depend on the reconstruction
+    * mode, the camera intrinsics and the image geometry. They are cached and only recalculated if one of these changes.
+    */
+    struct RayCoefficients
+    {
+      std::array<double, 11> Parameters = {}; ///< Reconstruction mode, intrinsics and geometry of the cached coefficients
+      int XDimension = 0;
+      int YDimension = 0;
+      std::vector<double> Numerators; ///< Three per pixel
+      std::vector<double> Denominators; ///< Three per pixel
+    };
+
+    /*!
+    \brief Recalculates m_RayCoefficients if the reconstruction parameters or the image geometry changed.
+    */
+    void UpdateRayCoefficients(int xDimension, int yDimension, const mitk::Point3D& origin, const mitk::Vector3D& spacing);
+
+    RayCoefficients m_RayCoefficients;
+    std::vector<double> m_Coordinates; ///< Back-projected points of all pixels, reused between frames
+    std::vector<unsigned char> m_ValidityMask; ///< Pixels with a valid distance, reused between frames
+    std::vector<unsigned char> m_CellMask; ///< Cells generated per quad of the pixel grid, reused between frames
+
     IplImage* m_IplScalarImage; ///< Scalar image used for surface texturing
 
     mitk::CameraIntrinsics::Pointer m_CameraIntrinsics; ///< Specifies the intrinsic parameters
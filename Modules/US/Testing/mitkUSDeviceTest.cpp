@@ -13,6 +13,53 @@ found in the LICENSE file.
 #include "mitkUSVideoDevice.h"
 #include "mitkUSProbe.h"
 #include "mitkTestingMacros.h"
+#include "mitkImageReadAccessor.h"
+
+namespace
+{
+  /** Video device whose frames are set by the test instead of the acquisition thread. */
+  class TestUSDevice : public mitk::USVideoDevice
+  {
+  public:
+    mitkClassMacro(TestUSDevice, mitk::USVideoDevice);
+    mitkNewMacro3Param(Self, std::string, std::string, std::string);
+
+    void AcquireFrame(unsigned char value)
+    {
+      unsigned int dimensions[] = { 4, 3, 1 };
+      auto image = mitk::Image::New();
+      image->Initialize(mitk::MakeScalarPixelType<unsigned char>(), 3, dimensions);
+
+      std::vector<unsigned char> pixels(4 * 3, value);
+      image->SetImportVolume(pixels.data());
+
+      this->SetNextFrame({ image });
+    }
+
+    mitk::Image::Pointer GetLatestImage()
+    {
+      return m_ImageVector.empty() ? nullptr : m_ImageVector[0];
+    }
+
+  protected:
+    TestUSDevice(std::string videoFilePath, std::string manufacturer, std::string model)
+      : mitk::USVideoDevice(videoFilePath, manufacturer, model)
+    {
+    }
+  };
+
+  unsigned char GetFirstPixel(mitk::Image* image)
+  {
+    mitk::ImageReadAccessor accessor(image);
+    return static_cast<const unsigned char*>(accessor.GetData())[0];
+  }
+
+  const void* GetPixels(mitk::Image* image)
+  {
+    mitk::ImageReadAccessor accessor(image);
+    return accessor.GetData();
+  }
+}
 
 class mitkUSDeviceTestClass
 {
@@ -28,6 +75,69 @@ public:
     //MITK_TEST_CONDITION_REQUIRED((device->GetDeviceModel().compare("Model") == 0), "Model should be set correctly");
   }
 
+  static void TestFrameStatistics()
+  {
+    mitk::USVideoDevice::Pointer device = mitk::USVideoDevice::New("IllegalPath", "Manufacturer", "Model");
+    MITK_TEST_CONDITION_REQUIRED(device->GetFrameRate() == 0.0, "Acquisition should not be paced by default");
+    device->SetFrameRate(30.0);
+    MITK_TEST_CONDITION_REQUIRED(device->GetFrameRate() == 30.0, "Frame rate should be set correctly");
+
+    MITK_TEST_CONDITION_REQUIRED(device->GetNumberOfAcquiredFrames() == 0, "No frames should be acquired before activation");
+    MITK_TEST_CONDITION_REQUIRED(device->GetNumberOfDroppedFrames() == 0, "No frames should be dropped before activation");
+    MITK_TEST_CONDITION_REQUIRED(device->GetAverageFrameLatency() == 0.0, "Average latency should be zero without frames");
+  }
+
+  static void TestOutputLifetime()
+  {
+    TestUSDevice::Pointer device = TestUSDevice::New("IllegalPath", "Manufacturer", "Model");
+
+    device->AcquireFrame(1);
+    device->Update();
+    mitk::Image::Pointer output = device->GetOutput(0);
+    MITK_TEST_CONDITION_REQUIRED(output->IsInitialized(), "Output should be initialized after the first frame");
+    MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(output) == 1, "Output should hold the first frame");
+
+    // more acquisitions than frames in the pool must not touch the output
+    for (unsigned char value = 2; value <= 6; ++value)
+      device->AcquireFrame(value);
+
+    MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(output) == 1, "Output should keep the first frame until the next update");
+    MITK_TEST_CONDITION_REQUIRED(device->GetNumberOfAcquiredFrames() == 6, "Six frames should be acquired");
+    MITK_TEST_CONDITION_REQUIRED(device->GetNumberOfDroppedFrames() == 4, "Four frames should be dropped");
+
+    device->Update();
+    MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(output) == 6, "Output should hold the latest frame after the update");
+
+    device->AcquireFrame(7);
+    device->AcquireFrame(8);
+    device = nullptr;
+
+    MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(output) == 6, "Output should stay valid after the device is destroyed");
+  }
+
+  static void TestZeroCopyHandOff()
+  {
+    TestUSDevice::Pointer device = TestUSDevice::New("IllegalPath", "Manufacturer", "Model");
+
+    device->AcquireFrame(1);
+    device->Update();
+    mitk::Image::Pointer output = device->GetOutput(0);
+    mitk::Image::Pointer pooledImage = device->GetLatestImage();
+    MITK_TEST_CONDITION_REQUIRED(pooledImage.IsNotNull(), "Latest frame should be available");
+    MITK_TEST_CONDITION_REQUIRED(GetPixels(output) == GetPixels(pooledImage), "Output should reference the pixels of the pooled image");
+
+    // the pooled image is referenced here, so its frame must not be reused although the outputs moved on
+    for (unsigned char value = 2; value <= 9; ++value)
+    {
+      device->AcquireFrame(value);
+      device->Update();
+      MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(output) == value, "Output should hold the latest frame");
+    }
+
+    MITK_TEST_CONDITION_REQUIRED(GetFirstPixel(pooledImage) == 1, "Referenced pooled image should not be overwritten");
+    MITK_TEST_CONDITION_REQUIRED(GetPixels(output) != GetPixels(pooledImage), "Output should reference a later frame");
+  }
+
   static void TestAddProbe()
   {
   }
@@ -45,6 +155,9 @@ int mitkUSDeviceTest(int /* argc */, char* /*argv*/[])
   MITK_TEST_BEGIN("mitkUSDeviceTest");
 
   mitkUSDeviceTestClass::TestInstantiation();
+  mitkUSDeviceTestClass::TestFrameStatistics();
+  mitkUSDeviceTestClass::TestOutputLifetime();
+  mitkUSDeviceTestClass::TestZeroCopyHandOff();
   mitkUSDeviceTestClass::TestAddProbe();
   mitkUSDeviceTestClass::TestActivateProbe();
 
@@ -144,7 +144,8 @@ void mitk::USTelemedDevice::OnFreeze(bool freeze)
 void mitk::USTelemedDevice::GenerateData()
 {
   mitk::USTelemedImageSource::Pointer s = dynamic_cast<mitk::USTelemedImageSource*>(GetUSImageSource().GetPointer());
-  s->GetNextRawImage(m_ImageVector);
+  s->GetNextRawImage(m_RawImageVector);
+  this->SetNextFrame(m_RawImageVector);
   Superclass::GenerateData();
 }
 
@@ -192,6 +192,7 @@ namespace mitk {
     USTelemedDopplerControls::Pointer   m_ControlsDoppler;
 
     USTelemedImageSource::Pointer       m_ImageSource;
+    std::vector<mitk::Image::Pointer>   m_RawImageVector;
 
     Usgfw2Lib::IUsgfw2*                 m_UsgMainInterface;
     Usgfw2Lib::IProbe*                  m_Probe;
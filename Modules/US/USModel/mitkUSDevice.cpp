@@ -24,6 +24,8 @@ found in the LICENSE file.
 #include <usServiceProperties.h>
 #include <usModuleContext.h>
 
+#include <algorithm>
+
 mitk::USDevice::PropertyKeys mitk::USDevice::GetPropertyKeys()
 {
   static mitk::USDevice::PropertyKeys propertyKeys;
@@ -43,9 +45,68 @@ unsigned int mitk::USDevice::GetSizeOfImageVector()
   return m_ImageVector.size();
 }
 
+unsigned long mitk::USDevice::GetNumberOfAcquiredFrames()
+{
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  return m_NumberOfAcquiredFrames;
+}
+
+unsigned long mitk::USDevice::GetNumberOfDroppedFrames()
+{
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  return m_NumberOfDroppedFrames;
+}
+
+double mitk::USDevice::GetLastFrameLatency()
+{
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  return m_LastFrameLatency;
+}
+
+double mitk::USDevice::GetAverageFrameLatency()
+{
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  return m_NumberOfHandedOffFrames > 0
+    ? m_FrameLatencySum / m_NumberOfHandedOffFrames
+    : 0.0;
+}
+
+void mitk::USDevice::ResetFrameStatistics()
+{
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  m_NumberOfAcquiredFrames = 0;
+  m_NumberOfDroppedFrames = 0;
+  m_NumberOfHandedOffFrames = 0;
+  m_LastFrameLatency = 0.0;
+  m_FrameLatencySum = 0.0;
+}
+
+void mitk::USDevice::SetFrameRate(double frameRate)
+{
+  if (m_FrameRate != frameRate)
+  {
+    m_FrameRate = frameRate;
+    this->Modified();
+  }
+}
+
+double mitk::USDevice::GetFrameRate() const
+{
+  return m_FrameRate;
+}
+
 mitk::USDevice::USDevice(std::string manufacturer, std::string model)
   : mitk::ImageSource(),
   m_ImageVector(),
+  m_FramePool(3),
+  m_LatestFrame(-1),
+  m_OutputImages(),
+  m_FrameRate(0.0),
+  m_NumberOfAcquiredFrames(0),
+  m_NumberOfDroppedFrames(0),
+  m_NumberOfHandedOffFrames(0),
+  m_LastFrameLatency(0.0),
+  m_FrameLatencySum(0.0),
   m_Spacing(),
   m_IGTLServer(nullptr),
   m_IGTLMessageProvider(nullptr),
@@ -79,6 +140,15 @@ mitk::USDevice::USDevice(std::string manufacturer, std::string model)
 mitk::USDevice::USDevice(mitk::USImageMetadata::Pointer metadata)
   : mitk::ImageSource(),
   m_ImageVector(),
+  m_FramePool(3),
+  m_LatestFrame(-1),
+  m_OutputImages(),
+  m_FrameRate(0.0),
+  m_NumberOfAcquiredFrames(0),
+  m_NumberOfDroppedFrames(0),
+  m_NumberOfHandedOffFrames(0),
+  m_LastFrameLatency(0.0),
+  m_FrameLatencySum(0.0),
   m_Spacing(),
   m_IGTLServer(nullptr),
   m_IGTLMessageProvider(nullptr),
@@ -115,6 +185,8 @@ mitk::USDevice::~USDevice()
   if (m_Thread.joinable())
     m_Thread.detach();
 
+  this->DetachOutputs();
+
   // make sure that the us device is not registered at the micro service
   // anymore after it is destructed
   this->UnregisterOnService();
@@ -557,10 +629,110 @@ output->Graft( graft );
 
 void mitk::USDevice::GrabImage()
 {
-  std::vector<mitk::Image::Pointer> image = this->GetUSImageSource()->GetNextImage();
-  m_ImageMutex.lock();
-  this->SetImageVector(image);
-  m_ImageMutex.unlock();
+  this->SetNextFrame(this->GetUSImageSource()->GetNextImage());
+}
+
+void mitk::USDevice::SetNextFrame(const std::vector<mitk::Image::Pointer>& images)
+{
+  // image sources may deliver frames from the acquisition thread and from GenerateData()
+  std::lock_guard<std::mutex> acquisitionLock(m_AcquisitionMutex);
+
+  // pick a frame which is neither waiting for hand-off nor referenced outside of the pool
+  int frameIndex = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_ImageMutex);
+    const int poolSize = static_cast<int>(m_FramePool.size());
+
+    while (frameIndex < poolSize && (frameIndex == m_LatestFrame || IsFrameReferenced(m_FramePool[frameIndex])))
+      ++frameIndex;
+
+    if (frameIndex == poolSize)
+    {
+      MITK_DEBUG << "All " << poolSize << " frames of the frame pool are referenced. Adding a frame.";
+      m_FramePool.emplace_back();
+    }
+  }
+
+  // the free frame is not touched by GenerateData(), so copying does not block the outputs. The pool is
+  // only resized under the acquisition mutex, so the reference stays valid.
+  Frame& frame = m_FramePool[frameIndex];
+  this->CopyToFrame(images, frame);
+  frame.AcquisitionTime = std::chrono::steady_clock::now();
+
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  if (m_LatestFrame != -1)
+    ++m_NumberOfDroppedFrames;
+  ++m_NumberOfAcquiredFrames;
+  m_LatestFrame = frameIndex;
+  this->SetImageVector(frame.Images);
+}
+
+bool mitk::USDevice::IsFrameReferenced(const Frame& frame)
+{
+  return std::any_of(frame.Images.begin(), frame.Images.end(), [](const mitk::Image::Pointer& image) {
+    return image.IsNotNull() && image->GetReferenceCount() > 1;
+  });
+}
+
+void mitk::USDevice::DetachOutputs()
+{
+  std::lock_guard<std::mutex> outputLock(m_OutputMutex);
+
+  for (unsigned int i = 0; i < m_OutputImages.size() && i < this->GetNumberOfIndexedOutputs(); ++i)
+  {
+    auto& image = m_OutputImages[i];
+    mitk::Image::Pointer output = this->GetOutput(i);
+
+    // skip outputs which were re-initialized by someone else in the meantime
+    if (image.IsNull() || !image->IsInitialized() || output.IsNull() || !output->IsVolumeSet(0) ||
+      output->GetVolumeData(0)->GetManageMemory())
+    {
+      continue;
+    }
+
+    // re-initializing drops the slices which still point into the pooled image
+    mitk::TimeGeometry::Pointer timeGeometry = output->GetTimeGeometry()->Clone();
+    output->Initialize(image->GetPixelType(), image->GetDimension(), image->GetDimensions());
+
+    mitk::ImageReadAccessor inputReadAccessor(image);
+    output->SetImportVolume(inputReadAccessor.GetData());
+    output->SetTimeGeometry(timeGeometry);
+  }
+
+  m_OutputImages.clear();
+}
+
+void mitk::USDevice::CopyToFrame(const std::vector<mitk::Image::Pointer>& images, Frame& frame)
+{
+  frame.Images.resize(images.size());
+
+  for (size_t i = 0; i < images.size(); ++i)
+  {
+    auto& image = images[i];
+    auto& pooledImage = frame.Images[i];
+
+    if (image.IsNull() || !image->IsInitialized())
+    {
+      pooledImage = mitk::Image::New();
+      continue;
+    }
+
+    if (pooledImage.IsNull() || !pooledImage->IsInitialized() ||
+      pooledImage->GetDimension(0) != image->GetDimension(0) ||
+      pooledImage->GetDimension(1) != image->GetDimension(1) ||
+      pooledImage->GetDimension(2) != image->GetDimension(2) ||
+      pooledImage->GetPixelType() != image->GetPixelType())
+    {
+      pooledImage = mitk::Image::New();
+      pooledImage->Initialize(image->GetPixelType(), image->GetDimension(),
+        image->GetDimensions());
+    }
+
+    // the image source may reuse its buffers, hence the pixels are copied into the pool
+    mitk::ImageReadAccessor inputReadAccessor(image);
+    pooledImage->SetImportVolume(inputReadAccessor.GetData());
+    pooledImage->SetGeometry(image->GetGeometry());
+  }
 }
 
 //########### GETTER & SETTER ##################//
@@ -590,6 +762,7 @@ void mitk::USDevice::SetSpacing(double xSpacing, double ySpacing)
   m_Spacing[2] = 1;
 
 
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
   if( m_ImageVector.size() > 0 )
   {
     for( size_t index = 0; index < m_ImageVector.size(); ++index )
@@ -607,11 +780,30 @@ void mitk::USDevice::SetSpacing(double xSpacing, double ySpacing)
 
 void mitk::USDevice::GenerateData()
 {
-  m_ImageMutex.lock();
+  std::lock_guard<std::mutex> outputLock(m_OutputMutex);
+
+  // holding the images keeps the acquisition thread from writing into their frame
+  std::vector<mitk::Image::Pointer> images;
 
-  for (unsigned int i = 0; i < m_ImageVector.size() && i < this->GetNumberOfIndexedOutputs(); ++i)
   {
-    auto& image = m_ImageVector[i];
+    std::lock_guard<std::mutex> lock(m_ImageMutex);
+
+    if (m_LatestFrame == -1)
+      return; // outputs already reference the latest frame
+
+    const Frame& frame = m_FramePool[m_LatestFrame];
+    images = frame.Images;
+    m_LatestFrame = -1;
+
+    m_LastFrameLatency = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - frame.AcquisitionTime).count();
+    m_FrameLatencySum += m_LastFrameLatency;
+    ++m_NumberOfHandedOffFrames;
+  }
+
+  for (unsigned int i = 0; i < images.size() && i < this->GetNumberOfIndexedOutputs(); ++i)
+  {
+    auto& image = images[i];
     if (image.IsNull() || !image->IsInitialized())
     {
       // skip image
@@ -620,23 +812,19 @@ void mitk::USDevice::GenerateData()
     {
       mitk::Image::Pointer output = this->GetOutput(i);
 
-      if (!output->IsInitialized() ||
-        output->GetDimension(0) != image->GetDimension(0) ||
-        output->GetDimension(1) != image->GetDimension(1) ||
-        output->GetDimension(2) != image->GetDimension(2) ||
-        output->GetPixelType() != image->GetPixelType())
-      {
-        output->Initialize(image->GetPixelType(), image->GetDimension(),
-          image->GetDimensions());
-      }
+      // re-initializing drops the volume and the slices of the previous frame, so the output references the
+      // pixels of the pooled image instead of copying them into its former buffer
+      output->Initialize(image->GetPixelType(), image->GetDimension(), image->GetDimensions());
 
-      // copy contents of the given image into the member variable
       mitk::ImageReadAccessor inputReadAccessor(image);
-      output->SetImportVolume(inputReadAccessor.GetData());
+      output->SetImportVolume(const_cast<void*>(inputReadAccessor.GetData()), 0, 0, mitk::Image::ReferenceMemory);
       output->SetGeometry(image->GetGeometry());
     }
   }
-  m_ImageMutex.unlock();
+
+  // release the frame previously referenced by the outputs
+  std::lock_guard<std::mutex> lock(m_ImageMutex);
+  m_OutputImages.swap(images);
 };
 
 std::string mitk::USDevice::GetServicePropertyLabel()
@@ -656,13 +844,35 @@ std::string mitk::USDevice::GetServicePropertyLabel()
 
 void mitk::USDevice::Acquire()
 {
+  auto nextFrameTime = std::chrono::steady_clock::now();
+
   while (this->GetIsActive())
   {
-    // lock this thread when ultrasound device is freezed
-    std::unique_lock<std::mutex> lock(m_FreezeMutex);
-    m_FreezeBarrier.wait(lock, [this] { return !m_IsFreezed; });
+    {
+      // lock this thread when ultrasound device is freezed
+      std::unique_lock<std::mutex> lock(m_FreezeMutex);
+      if (m_IsFreezed)
+      {
+        m_FreezeBarrier.wait(lock, [this] { return !m_IsFreezed; });
+        nextFrameTime = std::chrono::steady_clock::now();
+      }
+
+      this->GrabImage();
+    }
 
-    this->GrabImage();
+    // pace acquisition to the frame rate of the device
+    const double frameRate = m_FrameRate;
+    if (frameRate > 0.0)
+    {
+      nextFrameTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / frameRate));
+
+      auto now = std::chrono::steady_clock::now();
+      if (nextFrameTime > now)
+        std::this_thread::sleep_until(nextFrameTime);
+      else
+        nextFrameTime = now; // do not try to catch up after falling behind
+    }
   }
 }
 
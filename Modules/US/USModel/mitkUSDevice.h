@@ -14,6 +14,8 @@ found in the LICENSE file.
 #define mitkUSDevice_h
 
 // STL
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -292,6 +294,31 @@ namespace mitk {
     /* @return Returns the size of the m_ImageVector of the ultrasound device.*/
     unsigned int GetSizeOfImageVector();
 
+    /**
+    * \brief Sets the rate (in frames per second) at which the acquisition thread grabs images.
+    * Should be set to the frame rate of the device. A value of zero (default) grabs images as fast
+    * as the image source delivers them.
+    */
+    void SetFrameRate(double frameRate);
+    double GetFrameRate() const;
+
+    /** \brief Number of frames grabbed from the image source since the last reset of the frame statistics. */
+    unsigned long GetNumberOfAcquiredFrames();
+
+    /**
+    * \brief Number of grabbed frames that were replaced by a newer frame before they were handed
+    * to the outputs, i.e. frames that never reached the pipeline.
+    */
+    unsigned long GetNumberOfDroppedFrames();
+
+    /** \brief Time in milliseconds between grabbing and handing off the most recent output frame. */
+    double GetLastFrameLatency();
+
+    /** \brief Mean time in milliseconds between grabbing and handing off a frame. */
+    double GetAverageFrameLatency();
+
+    void ResetFrameStatistics();
+
     /** @return Returns the current image source of this device. */
     virtual USImageSource::Pointer GetUSImageSource() = 0;
 
@@ -370,8 +397,45 @@ namespace mitk {
     std::condition_variable m_FreezeBarrier;
     std::mutex m_FreezeMutex;
     std::mutex m_ImageMutex; ///< mutex for images provided by the image source
+    std::mutex m_OutputMutex; ///< serializes the hand-off of frames to the outputs
+    std::mutex m_AcquisitionMutex; ///< serializes writing of frames into the frame pool
     std::thread m_Thread;
 
+    /**
+    * \brief Frame of the frame pool. Its images are reused for all frames written into this slot,
+    * so pixel buffers are only allocated if size or pixel type of the acquired images change. The slot is
+    * only written again once the pool holds the only reference to each of its images.
+    */
+    struct Frame
+    {
+      std::vector<mitk::Image::Pointer> Images;
+      std::chrono::steady_clock::time_point AcquisitionTime;
+    };
+
+    /**
+    * \brief Copies the given images into a free frame of the frame pool and marks it as the latest frame.
+    * The frame is handed to the outputs on the next call of GenerateData(). The given images are not
+    * referenced afterwards, so image sources may reuse them.
+    */
+    void SetNextFrame(const std::vector<mitk::Image::Pointer>& images);
+
+    /**
+    * \brief Returns whether the images of the frame are referenced outside of the frame pool, e.g. by the
+    * outputs or by the image vector.
+    */
+    static bool IsFrameReferenced(const Frame& frame);
+
+    /**
+    * \brief Lets the outputs own a copy of the pooled images they reference, so they stay valid after the
+    * frame pool is destroyed.
+    */
+    void DetachOutputs();
+
+    /**
+    * \brief Copies the images of the image source into the pooled images of the given frame.
+    */
+    void CopyToFrame(const std::vector<mitk::Image::Pointer>& images, Frame& frame);
+
     virtual void SetImageVector(std::vector<mitk::Image::Pointer> vec)
     {
       if (this->m_ImageVector != vec)
@@ -386,6 +450,25 @@ namespace mitk {
 
     std::vector<mitk::Image::Pointer> m_ImageVector;
 
+    /**
+    * \brief Frame pool. GenerateData() hands the latest frame to the outputs without copying: the outputs
+    * reference the pixels of the pooled images and m_OutputImages holds a reference to these images. A frame
+    * is only reused after all references outside of the pool are released, i.e. after the outputs switched to
+    * a later frame. Usually one frame holds the latest grabbed frame, one is referenced by the outputs and one
+    * is written by the acquisition thread. The pool grows if all frames are still referenced, e.g. because a
+    * consumer keeps images of the image vector.
+    */
+    std::vector<Frame> m_FramePool;
+    int m_LatestFrame; ///< index of the latest grabbed frame or -1 if it was handed off already
+    std::vector<mitk::Image::Pointer> m_OutputImages; ///< pooled images referenced by the outputs
+
+    std::atomic<double> m_FrameRate; ///< read by the acquisition thread
+    unsigned long m_NumberOfAcquiredFrames;
+    unsigned long m_NumberOfDroppedFrames;
+    unsigned long m_NumberOfHandedOffFrames;
+    double m_LastFrameLatency;
+    double m_FrameLatencySum;
+
     // Variables to determine if spacing was calibrated and needs to be applied to the incoming images
     mitk::Vector3D m_Spacing;
 
@@ -494,8 +577,10 @@ namespace mitk {
     ~USDevice() override;
 
     /**
-    * \brief Grabs the next frame from the Video input.
+    * \brief Hands the latest grabbed frame to the outputs.
     * This method is called internally, whenever Update() is invoked by an Output.
+    * The pixels are copied into the existing buffers of the outputs, which are only reallocated
+    * if size or pixel type change.
     */
     void GenerateData() override;
 
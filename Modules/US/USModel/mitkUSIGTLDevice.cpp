@@ -190,18 +190,19 @@ bool mitk::USIGTLDevice::OnDeactivation()
 void mitk::USIGTLDevice::GenerateData()
 {
   Superclass::GenerateData();
-  if (m_ImageVector.size() == 0 || this->GetNumberOfIndexedOutputs() == 0)
+  if (this->GetNumberOfIndexedOutputs() == 0)
   {
     return;
   }
 
-  m_ImageMutex.lock();
-  auto& image = m_ImageVector[0];
-  if (image.IsNotNull() && image->IsInitialized() && m_CurrentProbe.IsNotNull())
+  // the output shares the pixels with the pooled image, but has its own geometry, so the spacing of the probe is
+  // applied to a clone of the output geometry without touching the frame pool
+  mitk::Image::Pointer output = this->GetOutput(0);
+  if (output->IsInitialized() && m_CurrentProbe.IsNotNull())
   {
     //MITK_INFO << "Spacing CurrentProbe: " << m_CurrentProbe->GetSpacingForGivenDepth(m_CurrentProbe->GetCurrentDepth());
-    image->GetGeometry()->SetSpacing(m_CurrentProbe->GetSpacingForGivenDepth(m_CurrentProbe->GetCurrentDepth()));
-    this->GetOutput(0)->SetGeometry(image->GetGeometry());
+    mitk::BaseGeometry::Pointer geometry = output->GetGeometry()->Clone();
+    geometry->SetSpacing(m_CurrentProbe->GetSpacingForGivenDepth(m_CurrentProbe->GetCurrentDepth()));
+    output->SetGeometry(geometry);
   }
-  m_ImageMutex.unlock();
 }